@@ -22,17 +22,28 @@
 
 #pragma once
 
+#include <span>
+
 #include "analysis/token_stream.hpp"
 #include "utils/type_info.hpp"
 
 namespace irs::analysis {
 
+class TokenBatch;
+
 class analyzer : public token_stream {
  public:
   using ptr = std::unique_ptr<analyzer>;
 
   virtual bool reset(std::string_view data) = 0;
 
+  // Analyzes each of 'values' as if by reset(...) followed by next() until
+  // exhausted, replacing content of 'batch' with produced tokens.
+  // Default implementation does exactly that, analyzers override it to
+  // avoid per token overhead.
+  virtual void analyze(std::span<const std::string_view> values,
+                       TokenBatch& batch);
+
   virtual irs::type_info::type_id type() const noexcept = 0;
 };
 
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "analyzer_pool.hpp"
+
+#include <absl/strings/str_cat.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "analysis/analyzers.hpp"
+
+namespace irs::analysis {
+
+struct AnalyzerPool::Definition {
+  Definition(std::string_view type, const type_info& args_format,
+             std::string&& args, size_t pool_size)
+    : type{type},
+      args_format{args_format},
+      args{std::move(args)},
+      pool{pool_size} {}
+
+  std::string type;
+  type_info args_format;
+  // normalized arguments
+  std::string args;
+  std::atomic<uint64_t> created{};
+  std::atomic<uint64_t> failed{};
+  std::atomic<uint64_t> construction_nanos{};
+  std::atomic<uint64_t> checkouts{};
+  unbounded_object_pool<Maker> pool;
+};
+
+analyzer::ptr AnalyzerPool::Maker::make(Definition& definition) {
+  const auto start = std::chrono::steady_clock::now();
+  auto analyzer =
+    analyzers::get(definition.type, definition.args_format, definition.args);
+  const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  definition.construction_nanos.fetch_add(nanos.count(),
+                                          std::memory_order_relaxed);
+  (analyzer ? definition.created : definition.failed)
+    .fetch_add(1, std::memory_order_relaxed);
+  return analyzer;
+}
+
+AnalyzerPool::AnalyzerPool() : AnalyzerPool{Options{}} {}
+
+AnalyzerPool::AnalyzerPool(Options options) : options_{options} {}
+
+AnalyzerPool::~AnalyzerPool() = default;
+
+AnalyzerPool::Handle AnalyzerPool::Find(std::string_view type,
+                                        const type_info& args_format,
+                                        std::string_view args) {
+  auto make_key = [&](std::string_view args) {
+    constexpr std::string_view kSeparator{"\0", 1};
+    return absl::StrCat(type, kSeparator, args_format.name(), kSeparator,
+                        args);
+  };
+
+  // count lookups waiting for a concurrent registration of a definition
+  auto lock = [this]<typename Lock>(Lock& lock) {
+    if (!lock.try_lock()) {
+      contended_.fetch_add(1, std::memory_order_relaxed);
+      lock.lock();
+    }
+  };
+
+  // arguments seen before are resolved without normalization
+  auto raw_key = make_key(args);
+  {
+    std::shared_lock read_lock{mutex_, std::defer_lock};
+    lock(read_lock);
+    if (const auto it = aliases_.find(raw_key); it != aliases_.end()) {
+      return Handle{it->second};
+    }
+  }
+
+  std::string normalized;
+  if (!analyzers::normalize(normalized, type, args_format, args)) {
+    return {};
+  }
+  auto key = make_key(normalized);
+
+  std::unique_lock write_lock{mutex_, std::defer_lock};
+  lock(write_lock);
+  auto& definition = definitions_[std::move(key)];
+  if (!definition) {
+    definition = std::make_unique<Definition>(
+      type, args_format, std::move(normalized), options_.pool_size);
+  }
+  aliases_.try_emplace(std::move(raw_key), definition.get());
+  return Handle{definition.get()};
+}
+
+AnalyzerPool::ptr AnalyzerPool::Get(Handle handle) {
+  if (!handle) {
+    return {};
+  }
+  auto& definition = *handle.definition_;
+  auto analyzer = definition.pool.emplace(definition);
+  if (analyzer) {
+    definition.checkouts.fetch_add(1, std::memory_order_relaxed);
+  }
+  return analyzer;
+}
+
+bool AnalyzerPool::Warmup(Handle handle, size_t count) {
+  if (!handle) {
+    return false;
+  }
+  auto& definition = *handle.definition_;
+  // hold instances simultaneously, otherwise the same one is reused
+  count = std::min(count, options_.pool_size);
+  std::vector<ptr> analyzers;
+  analyzers.reserve(count);
+  while (analyzers.size() < count) {
+    auto analyzer = definition.pool.emplace(definition);
+    if (!analyzer) {
+      return false;
+    }
+    analyzers.emplace_back(std::move(analyzer));
+  }
+  return true;
+}
+
+AnalyzerPool::Stats AnalyzerPool::GetStats() const {
+  Stats stats{.contended = contended_.load(std::memory_order_relaxed)};
+  std::shared_lock lock{mutex_};
+  stats.definitions = definitions_.size();
+  for (const auto& [_, definition] : definitions_) {
+    stats.created += definition->created.load(std::memory_order_relaxed);
+    stats.failed += definition->failed.load(std::memory_order_relaxed);
+    stats.construction_nanos +=
+      definition->construction_nanos.load(std::memory_order_relaxed);
+    stats.checkouts += definition->checkouts.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void AnalyzerPool::Clear() {
+  std::shared_lock lock{mutex_};
+  for (auto& [_, definition] : definitions_) {
+    definition->pool.clear();
+  }
+}
+
+}  // namespace irs::analysis
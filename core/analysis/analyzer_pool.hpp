@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+#include "analysis/analyzer.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/object_pool.hpp"
+
+namespace irs::analysis {
+
+// Thread-safe pool of analyzers shared across threads, e.g. indexing ones.
+//
+// Analyzers are single-threaded and expensive to construct, e.g. "text"
+// analyzer loads stopwords and creates ICU and snowball state. The pool
+// keeps constructed instances per normalized analyzer definition, hence
+// equivalent definitions share instances. A definition is resolved once by
+// Find(...) under a lock, arguments are normalized only the first time they
+// are seen. Checking out an instance of a resolved definition by Get(...) is
+// lock-free: an idle instance is taken from a lock-free stack or a new one
+// is constructed if there is none. Checked out instances are used by
+// a single thread at a time and returned to the pool on release.
+class AnalyzerPool : private util::noncopyable {
+ private:
+  struct Definition;
+
+  struct Maker {
+    using ptr = analyzer::ptr;
+
+    static ptr make(Definition& definition);
+  };
+
+ public:
+  struct Options {
+    // Maximum number of idle instances kept per definition, should be
+    // not less than number of threads using the pool.
+    size_t pool_size{64};
+  };
+
+  struct Stats {
+    // Number of distinct definitions.
+    uint64_t definitions{};
+    // Number of analyzers constructed, including by Warmup(...).
+    uint64_t created{};
+    // Number of failed constructions.
+    uint64_t failed{};
+    // Total time spent constructing analyzers.
+    uint64_t construction_nanos{};
+    // Number of checked out analyzers.
+    uint64_t checkouts{};
+    // Number of lookups of definitions which waited for a lock.
+    uint64_t contended{};
+  };
+
+  // An analyzer returned to the pool once released, refers to the pool and
+  // hence must not outlive it.
+  using ptr = unbounded_object_pool<Maker>::ptr;
+
+  // A resolved analyzer definition, valid while the pool exists.
+  class Handle {
+   public:
+    Handle() = default;
+
+    explicit operator bool() const noexcept { return definition_ != nullptr; }
+
+   private:
+    friend class AnalyzerPool;
+
+    explicit Handle(Definition* definition) noexcept
+      : definition_{definition} {}
+
+    Definition* definition_{};
+  };
+
+  AnalyzerPool();
+  explicit AnalyzerPool(Options options);
+  ~AnalyzerPool();
+
+  // Returns a handle of the specified definition or an invalid handle if
+  // the definition can't be normalized.
+  Handle Find(std::string_view type, const type_info& args_format,
+              std::string_view args);
+
+  // Returns an idle analyzer or constructs a new one, nullptr if
+  // an analyzer can't be constructed. The pool must outlive all returned
+  // analyzers, they're put back into the pool on release.
+  ptr Get(Handle handle);
+
+  ptr Get(std::string_view type, const type_info& args_format,
+          std::string_view args) {
+    return Get(Find(type, args_format, args));
+  }
+
+  // Constructs up to 'count' idle analyzers ahead of time, returns false if
+  // an analyzer can't be constructed.
+  bool Warmup(Handle handle, size_t count);
+
+  Stats GetStats() const;
+
+  // Destroys idle analyzers, definitions are kept.
+  void Clear();
+
+ private:
+  Options options_;
+  mutable std::shared_mutex mutex_;
+  // definitions by normalized arguments
+  absl::flat_hash_map<std::string, std::unique_ptr<Definition>> definitions_;
+  // definitions by arguments as passed to Find(...)
+  absl::flat_hash_map<std::string, Definition*> aliases_;
+  std::atomic<uint64_t> contended_{};
+};
+
+}  // namespace irs::analysis
@@ -26,6 +26,7 @@
 #include <velocypack/Builder.h>
 #include <velocypack/Parser.h>
 
+#include "analysis/token_batch.hpp"
 #include "analysis/token_streams.hpp"
 #include "utils/hash_utils.hpp"
 #include "utils/register.hpp"
@@ -118,6 +119,11 @@ std::string_view GetType(velocypack::Slice& input) {
 
 }  // namespace
 
+void analyzer::analyze(std::span<const std::string_view> values,
+                       TokenBatch& batch) {
+  AnalyzeValues(*this, values, batch);
+}
+
 analyzer_registrar::analyzer_registrar(
   const type_info& type, const type_info& args_format,
   analyzer::ptr (*factory)(std::string_view args),
@@ -23,11 +23,20 @@
 
 #include "classification_stream.hpp"
 
+#include <absl/container/flat_hash_map.h>
 #include <fasttext.h>
+#include <hwy/contrib/math/math-inl.h>
+#include <hwy/highway.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
 #include <string_view>
 
+#include "analysis/token_batch.hpp"
 #include "store/store_utils.hpp"
+#include "utils/simd_utils.hpp"
 #include "utils/vpack_utils.hpp"
 #include "velocypack/Parser.h"
 #include "velocypack/Slice.h"
@@ -42,6 +51,94 @@ constexpr std::string_view THRESHOLD_PARAM_NAME{"threshold"};
 
 std::atomic<classification_stream::model_provider_f> MODEL_PROVIDER{nullptr};
 
+// Models loaded without a custom model provider, analyzers of the same model
+// location share a single immutable model.
+absl::flat_hash_map<std::string, std::weak_ptr<const fasttext::FastText>>
+  MODELS;
+std::mutex MODELS_MUTEX;
+
+classification_stream::model_ptr load_model(const std::string& location) {
+  {
+    std::lock_guard lock{MODELS_MUTEX};
+    if (const auto it = MODELS.find(location); it != MODELS.end()) {
+      if (auto model = it->second.lock()) {
+        return model;
+      }
+    }
+  }
+
+  // load outside of the lock, a model loaded concurrently takes precedence
+  auto new_model = std::make_shared<fasttext::FastText>();
+  new_model->loadModel(location);
+
+  std::lock_guard lock{MODELS_MUTEX};
+  auto& model = MODELS[location];
+  if (auto loaded = model.lock()) {
+    return loaded;
+  }
+  model = new_model;
+  for (auto it = MODELS.begin(); it != MODELS.end();) {
+    if (it->second.expired()) {
+      MODELS.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  return new_model;
+}
+
+// Same as fasttext::Loss::sigmoid(...)
+float sigmoid(float x) noexcept {
+  constexpr int64_t kTableSize = 512;
+  constexpr int64_t kMaxSigmoid = 8;
+
+  static const auto kTable = [] {
+    std::array<float, kTableSize + 1> table;
+    for (int64_t i = 0; i <= kTableSize; ++i) {
+      const float x = float(i * 2 * kMaxSigmoid) / kTableSize - kMaxSigmoid;
+      table[i] = 1.0 / (1.0 + std::exp(-x));
+    }
+    return table;
+  }();
+
+  if (x < -kMaxSigmoid) {
+    return 0.f;
+  }
+  if (x > kMaxSigmoid) {
+    return 1.f;
+  }
+  return kTable[int64_t((x + kMaxSigmoid) * kTableSize / kMaxSigmoid / 2)];
+}
+
+// Replaces 'size' label scores with exponents of their differences with
+// 'max', returns the sum of the exponents. Unlike fasttext::Loss::softmax(...)
+// exponents are computed by SIMD instructions, which may differ in the least
+// significant bit.
+float exp_sum(float* scores, size_t size, float max) noexcept {
+  namespace hn = hwy::HWY_NAMESPACE;
+  constexpr HWY_FULL(float) simd_tag;
+  constexpr size_t Step = hn::MaxLanes(simd_tag);
+
+  const auto max_vec = hn::Set(simd_tag, max);
+  auto sum_vec = hn::Zero(simd_tag);
+  size_t i = 0;
+  for (; i + Step <= size; i += Step) {
+    const auto value =
+      hn::Exp(simd_tag, hn::Sub(hn::LoadU(simd_tag, scores + i), max_vec));
+    hn::StoreU(value, simd_tag, scores + i);
+    sum_vec = hn::Add(sum_vec, value);
+  }
+  float sum = hn::GetLane(hn::SumOfLanes(simd_tag, sum_vec));
+  for (; i < size; ++i) {
+    scores[i] = std::exp(scores[i] - max);
+    sum += scores[i];
+  }
+  return sum;
+}
+
+// Same as fasttext::std_log(...)
+float std_log(float x) noexcept { return std::log(x + 1e-5); }
+
 bool parse_vpack_options(const VPackSlice slice,
                          classification_stream::Options& options,
                          const char* action) {
@@ -115,10 +212,7 @@ analyzer::ptr construct(const classification_stream::Options& options) {
     if (model_provider) {
       model = model_provider(options.model_location);
     } else {
-      auto new_model = std::make_shared<fasttext::FastText>();
-      new_model->loadModel(options.model_location);
-
-      model = new_model;
+      model = load_model(options.model_location);
     }
   } catch (const std::exception& e) {
     IRS_LOG_ERROR(
@@ -244,12 +338,32 @@ classification_stream::set_model_provider(model_provider_f provider) noexcept {
 }
 
 classification_stream::classification_stream(const Options& options,
-                                             model_ptr model) noexcept
+                                             model_ptr model)
   : model_{std::move(model)},
     predictions_it_{predictions_.end()},
-    threshold_{options.threshold},
+    threshold_{static_cast<float>(options.threshold)},
     top_k_{options.top_k} {
   IRS_ASSERT(model_);
+  dict_ = model_->getDictionary();
+  nlabels_ = dict_->nlabels();
+  labels_.resize(nlabels_);
+
+  // hierarchical softmax and quantized models are predicted by fastText
+  const auto args = model_->getArgs();
+  const bool flat_loss = args.loss == fasttext::loss_name::softmax ||
+                         args.loss == fasttext::loss_name::ova ||
+                         args.loss == fasttext::loss_name::ns;
+  if (args.model != fasttext::model_name::sup || !flat_loss ||
+      model_->isQuant() || nlabels_ <= 0 ||
+      (top_k_ <= 0 && top_k_ != fasttext::Model::kUnlimitedPredictions)) {
+    return;
+  }
+  input_ = model_->getInputMatrix();
+  output_ = model_->getOutputMatrix();
+  dim_ = args.dim;
+  softmax_ = args.loss == fasttext::loss_name::softmax;
+  IRS_ASSERT(input_->cols() == dim_ && output_->cols() == dim_);
+  IRS_ASSERT(output_->rows() == nlabels_);
 }
 
 bool classification_stream::next() {
@@ -258,9 +372,7 @@ bool classification_stream::next() {
   }
 
   auto& term = std::get<term_attribute>(attrs_);
-  term.value = {
-    reinterpret_cast<const byte_type*>(predictions_it_->second.c_str()),
-    predictions_it_->second.size()};
+  term.value = label(predictions_it_->second);
 
   auto& inc = std::get<increment>(attrs_);
   inc.value = uint32_t(predictions_it_ == predictions_.begin());
@@ -275,14 +387,170 @@ bool classification_stream::reset(std::string_view data) {
   offset.start = 0;
   offset.end = static_cast<uint32_t>(data.size());
 
+  predictions_.clear();
+  if (tokenize(data)) {
+    if (input_) {
+      hidden_.resize(dim_);
+      compute_hidden(hidden_.data());
+      compute_scores(1);
+      select(scores_.data());
+    } else {
+      model_->predict(top_k_, words_, predictions_, threshold_);
+    }
+  }
+  predictions_it_ = predictions_.begin();
+
+  return true;
+}
+
+void classification_stream::analyze(std::span<const std::string_view> values,
+                                    TokenBatch& batch) {
+  if (!input_) {
+    AnalyzeValues(*this, values, batch);
+    return;
+  }
+
+  // hidden vectors of a block and a row of the output matrix fit in cache
+  constexpr size_t kBlockSize = 16;
+
+  batch.reset(true);
+  for (size_t begin = 0; begin < values.size(); begin += kBlockSize) {
+    const auto block =
+      values.subspan(begin, std::min(kBlockSize, values.size() - begin));
+
+    // values without words have no predictions
+    std::array<bool, kBlockSize> predicted;
+    size_t count = 0;
+    hidden_.resize(block.size() * dim_);
+    for (size_t i = 0; i < block.size(); ++i) {
+      predicted[i] = tokenize(block[i]);
+      if (predicted[i]) {
+        compute_hidden(hidden_.data() + count++ * dim_);
+      }
+    }
+    compute_scores(count);
+
+    for (size_t i = 0, j = 0; i < block.size(); ++i) {
+      batch.add_value(true);
+      if (!predicted[i]) {
+        continue;
+      }
+      select(scores_.data() + j++ * nlabels_);
+      const auto end = static_cast<uint32_t>(block[i].size());
+      uint32_t inc = 1;
+      for (const auto& prediction : predictions_) {
+        batch.add_token(label(prediction.second), inc, 0, end);
+        inc = 0;
+      }
+    }
+  }
+
+  predictions_.clear();
+  predictions_it_ = predictions_.end();
+}
+
+bool classification_stream::tokenize(std::string_view data) {
+  if (data.empty()) {
+    words_.clear();
+    return false;
+  }
+
   bytes_view_input s_input{ViewCast<byte_type>(data)};
   input_buf buf{&s_input};
   std::istream ss{&buf};
+  dict_->getLine(ss, words_, line_labels_);
+  return !words_.empty();
+}
+
+// Same as fasttext::Model::computeHidden(...)
+void classification_stream::compute_hidden(float* hidden) const noexcept {
+  IRS_ASSERT(!words_.empty());
+  std::fill_n(hidden, dim_, 0.f);
+  for (const auto word : words_) {
+    const auto* row = input_->data() + int64_t{word} * dim_;
+    for (int32_t i = 0; i < dim_; ++i) {
+      hidden[i] += row[i];
+    }
+  }
+  const float scale = 1.0 / words_.size();
+  for (int32_t i = 0; i < dim_; ++i) {
+    hidden[i] *= scale;
+  }
+}
+
+void classification_stream::compute_scores(size_t count) {
+  scores_.resize(count * nlabels_);
+  const auto* row = output_->data();
+  for (int32_t label = 0; label < nlabels_; ++label, row += dim_) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      float dots[4];
+      simd::dot4(row, hidden_.data() + i * dim_, dim_, dim_, dots);
+      for (size_t j = 0; j < 4; ++j) {
+        scores_[(i + j) * nlabels_ + label] = dots[j];
+      }
+    }
+    for (; i < count; ++i) {
+      scores_[i * nlabels_ + label] =
+        simd::dot(row, hidden_.data() + i * dim_, dim_);
+    }
+  }
+}
+
+// Same as fasttext::Loss::predict(...) given label scores
+void classification_stream::select(float* scores) {
+  if (softmax_) {
+    const float max = *std::max_element(scores, scores + nlabels_);
+    const float z = exp_sum(scores, nlabels_, max);
+    for (int32_t i = 0; i < nlabels_; ++i) {
+      scores[i] /= z;
+    }
+  } else {
+    for (int32_t i = 0; i < nlabels_; ++i) {
+      scores[i] = sigmoid(scores[i]);
+    }
+  }
+
+  const int32_t k =
+    top_k_ == fasttext::Model::kUnlimitedPredictions ? nlabels_ : top_k_;
+  const auto less = [](const auto& lhs, const auto& rhs) noexcept {
+    return lhs.first > rhs.first;
+  };
+
+  // once top k labels are found, the logarithm of a label which is by far
+  // less probable than the least probable of them can't be even equal to
+  // the logarithm of the latter, so it isn't computed
+  double bound = 0.;
   predictions_.clear();
-  model_->predictLine(ss, predictions_, top_k_, static_cast<float>(threshold_));
-  predictions_it_ = predictions_.begin();
+  for (int32_t i = 0; i < nlabels_; ++i) {
+    if (scores[i] < threshold_ || scores[i] + 1e-5 < bound) {
+      continue;
+    }
+    const float score = std_log(scores[i]);
+    if (predictions_.size() == static_cast<size_t>(k) &&
+        score < predictions_.front().first) {
+      continue;
+    }
+    predictions_.emplace_back(score, i);
+    std::push_heap(predictions_.begin(), predictions_.end(), less);
+    if (predictions_.size() > static_cast<size_t>(k)) {
+      std::pop_heap(predictions_.begin(), predictions_.end(), less);
+      predictions_.pop_back();
+    }
+    if (predictions_.size() == static_cast<size_t>(k)) {
+      bound = (scores[predictions_.front().second] + 1e-5) * (1. - 1e-5);
+    }
+  }
+  std::sort_heap(predictions_.begin(), predictions_.end(), less);
+}
 
-  return true;
+bytes_view classification_stream::label(int32_t id) {
+  IRS_ASSERT(0 <= id && id < nlabels_);
+  auto& label = labels_[id];
+  if (label.empty()) {
+    label = dict_->getLabel(id);
+  }
+  return ViewCast<byte_type>(std::string_view{label});
 }
 
 }  // namespace analysis
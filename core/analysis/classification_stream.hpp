@@ -28,6 +28,8 @@
 #include "utils/attribute_helper.hpp"
 
 namespace fasttext {
+class DenseMatrix;
+class Dictionary;
 class FastText;
 }
 
@@ -40,6 +42,8 @@ class classification_stream final : public TypedAnalyzer<classification_stream>,
   using model_ptr = std::shared_ptr<const fasttext::FastText>;
   using model_provider_f = model_ptr (*)(std::string_view);
 
+  // Without a custom model provider, analyzers of the same model location
+  // share a single loaded model while any of them is alive.
   static model_provider_f set_model_provider(
     model_provider_f provider) noexcept;
 
@@ -55,8 +59,7 @@ class classification_stream final : public TypedAnalyzer<classification_stream>,
 
   static void init();  // for registration in a static build
 
-  explicit classification_stream(const Options& options,
-                                 model_ptr mode) noexcept;
+  explicit classification_stream(const Options& options, model_ptr model);
 
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
     return irs::get_mutable(attrs_, type);
@@ -65,15 +68,40 @@ class classification_stream final : public TypedAnalyzer<classification_stream>,
   bool next() final;
   bool reset(std::string_view data) final;
 
+  // Predicts labels of a block of values at once: output matrix rows are
+  // read once per block rather than once per value. Falls back to
+  // per-value prediction for hierarchical softmax and quantized models.
+  void analyze(std::span<const std::string_view> values,
+               TokenBatch& batch) final;
+
  private:
   using attributes = std::tuple<increment, offset, term_attribute>;
+  using predictions_t = std::vector<std::pair<float, int32_t>>;
+
+  bool tokenize(std::string_view data);
+  void compute_hidden(float* hidden) const noexcept;
+  void compute_scores(size_t count);
+  void select(float* scores);
+  bytes_view label(int32_t id);
 
   attributes attrs_;
   model_ptr model_;
-  std::vector<std::pair<float, std::string>> predictions_;
-  std::vector<std::pair<float, std::string>>::iterator predictions_it_;
-  double threshold_;
+  std::shared_ptr<const fasttext::Dictionary> dict_;
+  // matrices of a model supporting batched prediction, nullptr otherwise
+  std::shared_ptr<const fasttext::DenseMatrix> input_;
+  std::shared_ptr<const fasttext::DenseMatrix> output_;
+  std::vector<std::string> labels_;  // lazily filled label names
+  std::vector<int32_t> words_;
+  std::vector<int32_t> line_labels_;
+  std::vector<float> hidden_;  // hidden vectors of a block of values
+  std::vector<float> scores_;  // label scores of a block of values
+  predictions_t predictions_;
+  predictions_t::iterator predictions_it_;
+  float threshold_;
   int32_t top_k_;
+  int32_t dim_{};
+  int32_t nlabels_{};
+  bool softmax_{};
 };
 
 }  // namespace analysis
@@ -25,6 +25,7 @@
 
 #include <string_view>
 
+#include "analysis/token_batch.hpp"
 #include "utils/vpack_utils.hpp"
 #include "velocypack/Builder.h"
 #include "velocypack/Parser.h"
@@ -322,5 +323,10 @@ bool delimited_token_stream::reset(std::string_view data) {
   return true;
 }
 
+void delimited_token_stream::analyze(std::span<const std::string_view> values,
+                                     TokenBatch& batch) {
+  AnalyzeValues(*this, values, batch);
+}
+
 }  // namespace analysis
 }  // namespace irs
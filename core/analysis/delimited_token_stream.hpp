@@ -48,6 +48,8 @@ class delimited_token_stream final
   }
   bool next() final;
   bool reset(std::string_view data) final;
+  void analyze(std::span<const std::string_view> values,
+               TokenBatch& batch) final;
 
  private:
   using attributes = std::tuple<increment,
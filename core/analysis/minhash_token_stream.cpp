@@ -27,6 +27,7 @@
 
 #include "analysis/analyzers.hpp"
 #include "analysis/token_streams.hpp"
+#include "store/data_output.hpp"
 #include "utils/log.hpp"
 #include "utils/vpack_utils.hpp"
 
@@ -216,6 +217,9 @@ constexpr offset kEmptyOffset;
 
 constexpr uint32_t kMinHashes = 1;
 constexpr std::string_view kNumHashes = "numHashes";
+constexpr std::string_view kNumBands = "numBands";
+constexpr uint64_t kEmptyBin = std::numeric_limits<uint64_t>::max();
+constexpr size_t kHashBatchSize = 64;
 
 bool ParseNumHashes(velocypack::Slice input, uint32_t& num_hashes) {
   IRS_ASSERT(input.isObject());
@@ -234,12 +238,35 @@ bool ParseNumHashes(velocypack::Slice input, uint32_t& num_hashes) {
   return true;
 }
 
+bool ParseNumBands(velocypack::Slice input, uint32_t num_hashes,
+                   uint32_t& num_bands) {
+  IRS_ASSERT(input.isObject());
+  input = input.get(kNumBands);
+  if (input.isNone()) {
+    num_bands = 0;
+    return true;
+  }
+  if (!input.isNumber<uint32_t>()) {
+    IRS_LOG_ERROR(absl::StrCat(
+      kNumBands, " attribute must be non-negative integer", kParseError));
+    return false;
+  }
+  num_bands = input.getNumber<uint32_t>();
+  if (num_bands && num_hashes % num_bands) {
+    IRS_LOG_ERROR(absl::StrCat(kNumBands, " attribute must divide ",
+                               kNumHashes, kParseError));
+    return false;
+  }
+  return true;
+}
+
 bool ParseOptions(velocypack::Slice slice,
                   MinHashTokenStream::Options& options) {
   if (!slice.isObject()) {
     return false;
   }
-  if (!ParseNumHashes(slice, options.num_hashes)) {
+  if (!ParseNumHashes(slice, options.num_hashes) ||
+      !ParseNumBands(slice, options.num_hashes, options.num_bands)) {
     return false;
   }
   if (!analyzers::MakeAnalyzer(slice, options.analyzer)) {
@@ -272,11 +299,16 @@ bool NormalizeImpl(velocypack::Slice input, velocypack::Builder& output) {
     return false;
   }
   uint32_t num_hashes = 0;
-  if (!ParseNumHashes(input, num_hashes)) {
+  uint32_t num_bands = 0;
+  if (!ParseNumHashes(input, num_hashes) ||
+      !ParseNumBands(input, num_hashes, num_bands)) {
     return false;
   }
   velocypack::ObjectBuilder scope{&output};
   output.add(kNumHashes, velocypack::Value{num_hashes});
+  if (num_bands) {
+    output.add(kNumBands, velocypack::Value{num_bands});
+  }
   if (!analyzers::NormalizeAnalyzer(input, output)) {
     IRS_LOG_ERROR(absl::StrCat("Invalid analyzer definition in ",
                                slice_to_string(input), kParseError));
@@ -347,7 +379,9 @@ void MinHashTokenStream::init() {
 }
 
 MinHashTokenStream::MinHashTokenStream(Options&& opts)
-  : opts_{std::move(opts)}, minhash_{opts.num_hashes} {
+  : opts_{std::move(opts)},
+    minhash_{opts.num_hashes},
+    builder_{opts.num_hashes} {
   if (!opts_.analyzer) {
     // Fallback to default implementation
     opts_.analyzer = std::make_unique<string_token_stream>();
@@ -361,6 +395,13 @@ MinHashTokenStream::MinHashTokenStream(Options&& opts)
 
   offset_ = irs::get<offset>(*opts_.analyzer);
 
+  if (opts_.num_bands) {
+    const auto rows =
+      std::max(opts_.num_hashes / opts_.num_bands, uint32_t{1});
+    bins_.resize(size_t{rows} * opts_.num_bands);
+    bands_.reserve(opts_.num_bands);
+  }
+
   std::get<term_attribute>(attrs_).value = {
     reinterpret_cast<const byte_type*>(buf_.data()), buf_.size()};
 }
@@ -393,6 +434,14 @@ bool MinHashTokenStream::reset(std::string_view data) {
   return false;
 }
 
+void MinHashTokenStream::WriteSignature(data_output& out) const {
+  for (const auto hash_value : minhash_) {
+    byte_type buf[sizeof(uint64_t)];
+    absl::little_endian::Store64(buf, hash_value);
+    out.write_bytes(buf, sizeof buf);
+  }
+}
+
 void MinHashTokenStream::ComputeSignature() {
   minhash_.Clear();
   next_inc_.value = 1;
@@ -405,16 +454,92 @@ void MinHashTokenStream::ComputeSignature() {
     start = offs->start;
     end = offs->end;
 
+    std::fill(bins_.begin(), bins_.end(), kEmptyBin);
+    builder_.Clear();
+
+    // tokens are hashed in batches, most of hash values of a long document
+    // are rejected by a single SIMD compare
+    std::array<uint64_t, kHashBatchSize> hash_values;
+    auto insert = [&](size_t size) {
+      const std::span batch{hash_values.data(), size};
+      builder_.Insert(batch);
+      if (!bins_.empty()) {
+        for (const auto hash_value : batch) {
+          auto& bin = bins_[hash_value % bins_.size()];
+          bin = std::min(bin, hash_value);
+        }
+      }
+    };
+
+    size_t size = 0;
     do {
       const std::string_view value = ViewCast<char>(term_->value);
-      const auto hash_value = ::CityHash64(value.data(), value.size());
-
-      minhash_.Insert(hash_value);
+      hash_values[size] = ::CityHash64(value.data(), value.size());
+      if (++size == hash_values.size()) {
+        insert(size);
+        size = 0;
+      }
       end = offs->end;
     } while (opts_.analyzer->next());
+    insert(size);
+
+    minhash_.Assign(builder_.Finish());
+
+    if (bins_.empty()) {
+      begin_ = std::begin(minhash_);
+      end_ = std::end(minhash_);
+    } else {
+      ComputeBands();
+      begin_ = std::cbegin(bands_);
+      end_ = std::cend(bands_);
+    }
+  }
+}
 
-    begin_ = std::begin(minhash_);
-    end_ = std::end(minhash_);
+// Hash values are distributed over bins keeping the minimum value of each
+// bin (one permutation hashing), the minimums of 2 sets in a bin are equal
+// with probability of Jaccard coefficient of the sets. A band combines
+// a few consecutive bins, similar sets are likely to share at least one
+// band while dissimilar ones aren't.
+void MinHashTokenStream::ComputeBands() {
+  IRS_ASSERT(opts_.num_bands);
+  Densify();
+  bands_.clear();
+  const size_t rows = bins_.size() / opts_.num_bands;
+  for (size_t band = 0, bin = 0; band < opts_.num_bands; ++band) {
+    uint64_t value = band;
+    for (const auto last = bin + rows; bin < last; ++bin) {
+      value = ::HashLen16(value, bins_[bin]);
+    }
+    bands_.emplace_back(value);
+  }
+}
+
+// Short documents leave most of the bins empty, bands of empty bins would
+// match all short documents. An empty bin borrows the value of the nearest
+// non-empty bin to the right (rotation densification) mixed with the
+// distance to it, so the densified bins of 2 sets are still equal with
+// probability of Jaccard coefficient of the sets.
+void MinHashTokenStream::Densify() noexcept {
+  const auto size = bins_.size();
+  auto last = size;
+  while (last != 0 && bins_[last - 1] == kEmptyBin) {
+    --last;
+  }
+  if (last == 0) {
+    return;
+  }
+  // walk bins backwards circularly starting from the last non-empty one
+  uint64_t value = 0;
+  uint64_t distance = 0;
+  for (size_t i = 0, bin = last - 1; i < size; ++i) {
+    if (bins_[bin] != kEmptyBin) {
+      value = bins_[bin];
+      distance = 0;
+    } else {
+      bins_[bin] = ::HashLen16(value, ++distance);
+    }
+    bin = bin ? bin - 1 : size - 1;
   }
 }
 
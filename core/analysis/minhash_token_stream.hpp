@@ -28,7 +28,11 @@
 #include "utils/minhash_utils.hpp"
 #include "utils/noncopyable.hpp"
 
-namespace irs::analysis {
+namespace irs {
+
+struct data_output;
+
+namespace analysis {
 
 class MinHashTokenStream final : public TypedAnalyzer<MinHashTokenStream>,
                                  private util::noncopyable {
@@ -38,6 +42,9 @@ class MinHashTokenStream final : public TypedAnalyzer<MinHashTokenStream>,
     analysis::analyzer::ptr analyzer;
     // Number of min hashes to maintain
     uint32_t num_hashes{1};
+    // Number of LSH bands emitted instead of signature hashes, 0 - emit
+    // signature hashes. Must divide `num_hashes`.
+    uint32_t num_bands{0};
   };
 
   // Return analyzer type name.
@@ -65,14 +72,26 @@ class MinHashTokenStream final : public TypedAnalyzer<MinHashTokenStream>,
   // Return accumulated MinHash signature.
   const MinHash& signature() const noexcept { return minhash_; }
 
+  // Write accumulated MinHash signature to `out` as a sequence of
+  // little-endian 64-bit hash values, i.e. in the column format expected by
+  // `ByNearDuplicates`. Band tokens don't carry the signature, a field
+  // indexed and stored at once may write the signature of a value it has
+  // just been indexed with.
+  void WriteSignature(data_output& out) const;
+
  private:
   using attributes = std::tuple<term_attribute, increment, offset>;
   using iterator = std::vector<uint64_t>::const_iterator;
 
   void ComputeSignature();
+  void ComputeBands();
+  void Densify() noexcept;
 
   Options opts_;
   MinHash minhash_;
+  MinHashBuilder builder_;
+  std::vector<uint64_t> bins_;
+  std::vector<uint64_t> bands_;
   attributes attrs_;
   increment next_inc_;
   const term_attribute* term_{};
@@ -82,4 +101,5 @@ class MinHashTokenStream final : public TypedAnalyzer<MinHashTokenStream>,
   std::array<char, 11> buf_{};
 };
 
-}  // namespace irs::analysis
+}  // namespace analysis
+}  // namespace irs
@@ -0,0 +1,561 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "nearest_neighbors_index.hpp"
+
+#include <absl/strings/str_cat.h>
+#include <fasttext.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "utils/fasttext_utils.hpp"
+#include "utils/log.hpp"
+
+namespace irs::analysis {
+
+struct NearestNeighborsIndex::Header {
+  uint32_t magic;
+  uint32_t version;
+  // model the index is built for
+  int32_t words;
+  int32_t dim;
+  int32_t table_words;
+  int32_t table_top_k;
+  int32_t graph_degree;
+  int32_t ef_search;
+  // graph entry point, -1 if there is no graph
+  int32_t entry;
+  int32_t max_level;
+  // total number of links at upper levels
+  uint64_t upper_links;
+};
+
+namespace {
+
+using Neighbor = NearestNeighborsIndex::Neighbor;
+using Scratch = NearestNeighborsIndex::Scratch;
+
+constexpr uint32_t kMagic = 0x4E4E4958;  // "NNIX"
+constexpr uint32_t kVersion = 0;
+// keeps sizes of the file sections far from overflow
+constexpr int32_t kMaxTopK = 1 << 12;
+constexpr int32_t kMaxDegree = 1 << 8;
+constexpr int32_t kMaxLevel = std::numeric_limits<uint8_t>::max();
+// makes graphs reproducible
+constexpr uint32_t kSeed = 42;
+
+// Byte offsets of the file sections.
+struct Layout {
+  size_t table;
+  size_t levels;
+  size_t upper_offsets;
+  size_t lower_links;
+  size_t upper_links;
+  size_t size;
+};
+
+size_t Align(size_t size) noexcept { return (size + 7) & ~size_t{7}; }
+
+Layout MakeLayout(const auto& header) noexcept {
+  const auto words = static_cast<size_t>(header.words);
+  Layout layout;
+  layout.table = sizeof(header);
+  layout.levels = layout.table + sizeof(Neighbor) *
+                                   static_cast<size_t>(header.table_words) *
+                                   static_cast<size_t>(header.table_top_k);
+  if (!header.graph_degree) {
+    layout.upper_offsets = layout.lower_links = layout.upper_links =
+      layout.size = layout.levels;
+    return layout;
+  }
+  layout.upper_offsets = layout.levels + Align(words);
+  layout.lower_links = layout.upper_offsets + Align(sizeof(uint32_t) * words);
+  layout.upper_links =
+    layout.lower_links + sizeof(int32_t) * words * 2 *
+                           static_cast<size_t>(header.graph_degree);
+  layout.size = layout.upper_links + sizeof(int32_t) * header.upper_links;
+  return layout;
+}
+
+float Dot(const float* lhs, const float* rhs, int32_t dim) noexcept {
+  float sum = 0.f;
+  for (int32_t i = 0; i < dim; ++i) {
+    sum += lhs[i] * rhs[i];
+  }
+  return sum;
+}
+
+bool Closer(const Neighbor& lhs, const Neighbor& rhs) noexcept {
+  return lhs.similarity > rhs.similarity;
+}
+
+bool Farther(const Neighbor& lhs, const Neighbor& rhs) noexcept {
+  return lhs.similarity < rhs.similarity;
+}
+
+// Searches 'ef' words closest to 'query' at 'level' starting from the words
+// in 'scratch.results', results are in descending order of similarity.
+// 'links(word, level)' returns graph neighbors of a word, -1 terminates.
+template<typename Links>
+void SearchLevel(const float* vectors, int32_t dim, const float* query,
+                 const Links& links, int32_t level, size_t ef,
+                 Scratch& scratch) {
+  auto& visited = scratch.visited;
+  auto& candidates = scratch.candidates;
+  auto& results = scratch.results;
+
+  visited.clear();
+  for (const auto& result : results) {
+    visited.emplace(result.word);
+  }
+  // the best candidate and the worst result go first
+  candidates = results;
+  std::make_heap(candidates.begin(), candidates.end(), Farther);
+  std::make_heap(results.begin(), results.end(), Closer);
+
+  while (!candidates.empty()) {
+    std::pop_heap(candidates.begin(), candidates.end(), Farther);
+    const auto candidate = candidates.back();
+    candidates.pop_back();
+    if (results.size() >= ef &&
+        candidate.similarity < results.front().similarity) {
+      break;
+    }
+
+    for (const auto word : links(candidate.word, level)) {
+      if (word < 0) {
+        break;
+      }
+      if (!visited.emplace(word).second) {
+        continue;
+      }
+      const auto* vector = vectors + static_cast<size_t>(word) * dim;
+      const Neighbor neighbor{word, Dot(query, vector, dim)};
+      if (results.size() < ef ||
+          neighbor.similarity > results.front().similarity) {
+        candidates.emplace_back(neighbor);
+        std::push_heap(candidates.begin(), candidates.end(), Farther);
+        results.emplace_back(neighbor);
+        std::push_heap(results.begin(), results.end(), Closer);
+        if (results.size() > ef) {
+          std::pop_heap(results.begin(), results.end(), Closer);
+          results.pop_back();
+        }
+      }
+    }
+  }
+
+  std::sort(results.begin(), results.end(), Closer);
+}
+
+// Builds HNSW graph over normalized vectors, see "Efficient and robust
+// approximate nearest neighbor search using Hierarchical Navigable Small
+// World graphs" by Malkov and Yashunin.
+class GraphBuilder {
+ public:
+  GraphBuilder(const float* vectors, int32_t words, int32_t dim,
+               int32_t degree, int32_t ef_construction)
+    : vectors_{vectors},
+      dim_{dim},
+      degree_{static_cast<size_t>(degree)},
+      ef_{static_cast<size_t>(std::max(ef_construction, degree))},
+      links_(static_cast<size_t>(words)) {}
+
+  void Build() {
+    std::mt19937 rng{kSeed};
+    std::uniform_real_distribution<double> uniform{0., 1.};
+    const double mult = 1. / std::log(std::max(2., double(degree_)));
+    for (size_t word = 0; word < links_.size(); ++word) {
+      const auto level = std::min(
+        static_cast<int32_t>(-std::log(1. - uniform(rng)) * mult), kMaxLevel);
+      Insert(static_cast<int32_t>(word), level);
+    }
+  }
+
+  int32_t Entry() const noexcept { return entry_; }
+  int32_t MaxLevel() const noexcept { return max_level_; }
+
+  // Links of a word at each of its levels.
+  std::span<const std::vector<int32_t>> Links(int32_t word) const noexcept {
+    return links_[word];
+  }
+
+ private:
+  const float* Vector(int32_t word) const noexcept {
+    return vectors_ + static_cast<size_t>(word) * dim_;
+  }
+
+  size_t Capacity(int32_t level) const noexcept {
+    return level ? degree_ : 2 * degree_;
+  }
+
+  // Keeps candidates closer to the word than to already kept ones, this way
+  // links point in diverse directions.
+  void Select(std::span<const Neighbor> candidates, size_t size,
+              std::vector<int32_t>& links) const {
+    links.clear();
+    for (const auto& candidate : candidates) {
+      if (links.size() >= size) {
+        break;
+      }
+      const auto* vector = Vector(candidate.word);
+      const bool diverse =
+        std::all_of(links.begin(), links.end(), [&](int32_t word) {
+          return Dot(vector, Vector(word), dim_) <= candidate.similarity;
+        });
+      if (diverse) {
+        links.emplace_back(candidate.word);
+      }
+    }
+  }
+
+  void Insert(int32_t word, int32_t level) {
+    links_[word].resize(level + 1);
+    if (entry_ < 0) {
+      entry_ = word;
+      max_level_ = level;
+      return;
+    }
+
+    auto links = [this](int32_t word, int32_t level) {
+      return std::span<const int32_t>{links_[word][level]};
+    };
+    const auto* query = Vector(word);
+    auto& results = scratch_.results;
+    results.assign({Neighbor{entry_, Dot(query, Vector(entry_), dim_)}});
+    for (auto i = max_level_; i > level; --i) {
+      SearchLevel(vectors_, dim_, query, links, i, 1, scratch_);
+    }
+
+    for (auto i = std::min(level, max_level_); i >= 0; --i) {
+      SearchLevel(vectors_, dim_, query, links, i, ef_, scratch_);
+      const auto capacity = Capacity(i);
+      Select(results, degree_, links_[word][i]);
+
+      for (const auto neighbor : links_[word][i]) {
+        auto& neighbor_links = links_[neighbor][i];
+        neighbor_links.emplace_back(word);
+        if (neighbor_links.size() <= capacity) {
+          continue;
+        }
+        const auto* vector = Vector(neighbor);
+        pruned_.clear();
+        for (const auto linked : neighbor_links) {
+          pruned_.emplace_back(
+            Neighbor{linked, Dot(vector, Vector(linked), dim_)});
+        }
+        std::sort(pruned_.begin(), pruned_.end(), Closer);
+        Select(pruned_, capacity, neighbor_links);
+      }
+    }
+
+    if (level > max_level_) {
+      entry_ = word;
+      max_level_ = level;
+    }
+  }
+
+  const float* vectors_;
+  int32_t dim_;
+  size_t degree_;
+  size_t ef_;
+  std::vector<std::vector<std::vector<int32_t>>> links_;
+  Scratch scratch_;
+  std::vector<Neighbor> pruned_;
+  int32_t entry_{-1};
+  int32_t max_level_{-1};
+};
+
+bool WriteAligned(void* file, const void* data, size_t size) {
+  static constexpr char kPadding[8]{};
+  return file_utils::write(file, data, size) &&
+         file_utils::write(file, kPadding, Align(size) - size);
+}
+
+}  // namespace
+
+bool NearestNeighborsIndex::Write(const fasttext::ImmutableFastText& model,
+                                  const BuildOptions& options,
+                                  const path_char_t* path) {
+  IRS_ASSERT(path);
+  if (options.table_words < 0 || options.table_top_k < 0 ||
+      options.table_top_k > kMaxTopK || options.graph_degree < 0 ||
+      options.graph_degree > kMaxDegree || options.ef_construction <= 0 ||
+      options.ef_search <= 0) {
+    IRS_LOG_ERROR("Invalid options of nearest neighbors index");
+    return false;
+  }
+
+  const auto dict = model.getDictionary();
+  const auto& vectors = model.getWordVectors();
+  Header header{.magic = kMagic,
+                .version = kVersion,
+                .words = dict->nwords(),
+                .dim = model.getDimension(),
+                .table_words = std::min(options.table_words, dict->nwords()),
+                .table_top_k = options.table_top_k,
+                .graph_degree = options.graph_degree,
+                .ef_search = options.ef_search,
+                .entry = -1,
+                .max_level = -1,
+                .upper_links = 0};
+  if (!header.table_top_k) {
+    header.table_words = 0;
+  }
+
+  // exactly the same neighbors as brute force search yields
+  std::vector<Neighbor> table(static_cast<size_t>(header.table_words) *
+                                header.table_top_k,
+                              Neighbor{-1, 0.f});
+  for (int32_t word = 0; word < header.table_words; ++word) {
+    const auto neighbors = model.getNN(dict->getWord(word), header.table_top_k);
+    auto* row = table.data() + static_cast<size_t>(word) * header.table_top_k;
+    for (const auto& [similarity, neighbor] : neighbors) {
+      *row++ = Neighbor{dict->getId(neighbor), similarity};
+    }
+  }
+
+  std::vector<uint8_t> levels;
+  std::vector<uint32_t> upper_offsets;
+  std::vector<int32_t> lower_links;
+  std::vector<int32_t> upper_links;
+  if (header.graph_degree && header.words) {
+    GraphBuilder builder{vectors.data(), header.words, header.dim,
+                         header.graph_degree, options.ef_construction};
+    builder.Build();
+    header.entry = builder.Entry();
+    header.max_level = builder.MaxLevel();
+
+    const auto degree = static_cast<size_t>(header.graph_degree);
+    lower_links.resize(2 * degree * header.words, -1);
+    for (int32_t word = 0; word < header.words; ++word) {
+      const auto links = builder.Links(word);
+      levels.emplace_back(static_cast<uint8_t>(links.size() - 1));
+      upper_offsets.emplace_back(static_cast<uint32_t>(upper_links.size()));
+      std::copy(links[0].begin(), links[0].end(),
+                lower_links.begin() + 2 * degree * word);
+      for (const auto& level : links.subspan(1)) {
+        const auto offset = upper_links.size();
+        upper_links.resize(offset + degree, -1);
+        std::copy(level.begin(), level.end(), upper_links.begin() + offset);
+      }
+    }
+    header.upper_links = upper_links.size();
+    if (upper_links.size() > std::numeric_limits<uint32_t>::max()) {
+      IRS_LOG_ERROR("Too many links in nearest neighbors index");
+      return false;
+    }
+  } else {
+    header.graph_degree = 0;
+  }
+
+  auto file = file_utils::open(path, file_utils::OpenMode::Write,
+                               IR_FADVICE_NORMAL);
+  if (!file) {
+    IRS_LOG_ERROR(absl::StrCat("Failed to open nearest neighbors index: ",
+                               file_utils::ToStr(path)));
+    return false;
+  }
+
+  bool ok = WriteAligned(file.get(), &header, sizeof header) &&
+            WriteAligned(file.get(), table.data(),
+                         sizeof(Neighbor) * table.size());
+  if (header.graph_degree) {
+    ok = ok && WriteAligned(file.get(), levels.data(), levels.size()) &&
+         WriteAligned(file.get(), upper_offsets.data(),
+                      sizeof(uint32_t) * upper_offsets.size()) &&
+         WriteAligned(file.get(), lower_links.data(),
+                      sizeof(int32_t) * lower_links.size()) &&
+         WriteAligned(file.get(), upper_links.data(),
+                      sizeof(int32_t) * upper_links.size());
+  }
+  if (!ok) {
+    IRS_LOG_ERROR(absl::StrCat("Failed to write nearest neighbors index: ",
+                               file_utils::ToStr(path)));
+  }
+  return ok;
+}
+
+std::unique_ptr<NearestNeighborsIndex> NearestNeighborsIndex::Open(
+  const fasttext::ImmutableFastText& model, const path_char_t* path) {
+  IRS_ASSERT(path);
+  std::unique_ptr<NearestNeighborsIndex> index{
+    new NearestNeighborsIndex{model, IResourceManager::kNoop}};
+  if (!index->file_.open(path)) {
+    return nullptr;
+  }
+  if (!index->Init()) {
+    IRS_LOG_ERROR(absl::StrCat("Invalid nearest neighbors index: ",
+                               file_utils::ToStr(path)));
+    return nullptr;
+  }
+  index->file_.advise(IR_MADVICE_RANDOM);
+  return index;
+}
+
+bool NearestNeighborsIndex::Init() {
+  const auto* data = static_cast<const byte_type*>(file_.addr());
+  if (file_.size() < sizeof(Header)) {
+    return false;
+  }
+  header_ = reinterpret_cast<const Header*>(data);
+
+  const auto& h = *header_;
+  if (h.magic != kMagic || h.version != kVersion ||
+      h.words != model_->getDictionary()->nwords() ||
+      h.dim != model_->getDimension() || h.table_words < 0 ||
+      h.table_words > h.words || h.table_top_k < 0 ||
+      h.table_top_k > kMaxTopK || h.graph_degree < 0 ||
+      h.graph_degree > kMaxDegree || h.ef_search <= 0 ||
+      h.upper_links > std::numeric_limits<uint32_t>::max() ||
+      (h.graph_degree && (h.entry < 0 || h.entry >= h.words ||
+                          h.max_level < 0 || h.max_level > kMaxLevel))) {
+    return false;
+  }
+
+  const auto layout = MakeLayout(h);
+  if (layout.size != file_.size()) {
+    return false;
+  }
+
+  const auto words = static_cast<size_t>(h.words);
+  table_ = {reinterpret_cast<const Neighbor*>(data + layout.table),
+            static_cast<size_t>(h.table_words) * h.table_top_k};
+  if (h.graph_degree) {
+    levels_ = {data + layout.levels, words};
+    upper_offsets_ = {
+      reinterpret_cast<const uint32_t*>(data + layout.upper_offsets), words};
+    lower_links_ = {reinterpret_cast<const int32_t*>(data + layout.lower_links),
+                    2 * words * h.graph_degree};
+    upper_links_ = {reinterpret_cast<const int32_t*>(data + layout.upper_links),
+                    h.upper_links};
+  }
+  vectors_ = model_->getWordVectors().data();
+  dim_ = h.dim;
+  return Validate();
+}
+
+bool NearestNeighborsIndex::Validate() const noexcept {
+  // words and links are used as indexes without checks by Lookup/Search
+  const auto& h = *header_;
+  for (const auto& neighbor : table_) {
+    if (neighbor.word >= h.words) {
+      return false;
+    }
+  }
+
+  if (!h.graph_degree) {
+    return true;
+  }
+
+  if (levels_[h.entry] != h.max_level) {
+    return false;
+  }
+
+  const auto degree = static_cast<size_t>(h.graph_degree);
+  // a word linked at some level must be present at this level too
+  auto valid = [&](std::span<const int32_t> links, int32_t level) noexcept {
+    return std::all_of(links.begin(), links.end(), [&](int32_t link) {
+      return link < h.words && (link < 0 || levels_[link] >= level);
+    });
+  };
+  for (int32_t word = 0; word < h.words; ++word) {
+    const auto levels = levels_[word];
+    if (levels > h.max_level ||
+        uint64_t{upper_offsets_[word]} + levels * degree > h.upper_links ||
+        !valid(lower_links_.subspan(2 * degree * word, 2 * degree), 0)) {
+      return false;
+    }
+    for (int32_t level = 1; level <= levels; ++level) {
+      if (!valid(upper_links_.subspan(
+                   upper_offsets_[word] + (level - 1) * degree, degree),
+                 level)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::span<const NearestNeighborsIndex::Neighbor> NearestNeighborsIndex::Lookup(
+  int32_t word, int32_t k) const noexcept {
+  IRS_ASSERT(header_);
+  if (word < 0 || word >= header_->table_words || k <= 0 ||
+      k > header_->table_top_k) {
+    return {};
+  }
+  const auto row =
+    table_.subspan(static_cast<size_t>(word) * header_->table_top_k, k);
+  // rows are padded if vocabulary is small
+  const auto end = std::find_if(row.begin(), row.end(), [](const Neighbor& n) {
+    return n.word < 0;
+  });
+  return row.first(static_cast<size_t>(end - row.begin()));
+}
+
+bool NearestNeighborsIndex::HasGraph() const noexcept {
+  IRS_ASSERT(header_);
+  return header_->graph_degree != 0;
+}
+
+bool NearestNeighborsIndex::Search(int32_t word, int32_t k, Scratch& scratch,
+                                   std::vector<Neighbor>& neighbors) const {
+  IRS_ASSERT(header_);
+  neighbors.clear();
+  if (!HasGraph() || word < 0 || word >= header_->words || k <= 0) {
+    return false;
+  }
+
+  const auto degree = static_cast<size_t>(header_->graph_degree);
+  auto links = [&](int32_t word, int32_t level) {
+    if (!level) {
+      return lower_links_.subspan(2 * degree * word, 2 * degree);
+    }
+    IRS_ASSERT(level <= levels_[word]);
+    return upper_links_.subspan(upper_offsets_[word] + (level - 1) * degree,
+                                degree);
+  };
+
+  const auto* query = vectors_ + static_cast<size_t>(word) * dim_;
+  const auto entry = header_->entry;
+  const auto* entry_vector = vectors_ + static_cast<size_t>(entry) * dim_;
+  scratch.results.assign({Neighbor{entry, Dot(query, entry_vector, dim_)}});
+  for (auto level = header_->max_level; level > 0; --level) {
+    SearchLevel(vectors_, dim_, query, links, level, 1, scratch);
+  }
+  // the word itself is most likely among the results
+  const auto ef = std::max<size_t>(header_->ef_search, size_t(k) + 1);
+  SearchLevel(vectors_, dim_, query, links, 0, ef, scratch);
+
+  for (const auto& result : scratch.results) {
+    if (neighbors.size() == static_cast<size_t>(k)) {
+      break;
+    }
+    if (result.word != word) {
+      neighbors.emplace_back(result);
+    }
+  }
+  return true;
+}
+
+}  // namespace irs::analysis
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_set.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "utils/mmap_utils.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace fasttext {
+class ImmutableFastText;
+}  // namespace fasttext
+
+namespace irs::analysis {
+
+// Accelerates nearest neighbors lookups of words of a fastText model.
+//
+// Neighbors of the most frequent words are precomputed exactly, neighbors of
+// the rest of words are searched approximately in an HNSW graph built over
+// normalized word vectors of the model. Both are built offline by Write(...)
+// into a single file which is memory mapped by Open(...). The file uses
+// native byte order and is valid only for the model it was built for.
+class NearestNeighborsIndex : private util::noncopyable {
+ public:
+  struct Neighbor {
+    int32_t word;
+    float similarity;
+  };
+
+  struct BuildOptions {
+    // Number of the most frequent words having precomputed neighbors.
+    int32_t table_words{10000};
+    // Number of precomputed neighbors per word.
+    int32_t table_top_k{10};
+    // Maximum number of graph neighbors of a word at upper levels, twice
+    // as many at the bottom level, 0 disables the graph.
+    int32_t graph_degree{16};
+    // Size of a candidate list while building the graph.
+    int32_t ef_construction{100};
+    // Size of a candidate list while searching the graph.
+    int32_t ef_search{64};
+  };
+
+  // Reusable state of a graph search.
+  struct Scratch {
+    absl::flat_hash_set<int32_t> visited;
+    std::vector<Neighbor> candidates;
+    std::vector<Neighbor> results;
+  };
+
+  static bool Write(const fasttext::ImmutableFastText& model,
+                    const BuildOptions& options, const path_char_t* path);
+
+  // Returns nullptr if an index at 'path' can't be opened or doesn't match
+  // 'model'. 'model' must outlive the index.
+  static std::unique_ptr<NearestNeighborsIndex> Open(
+    const fasttext::ImmutableFastText& model, const path_char_t* path);
+
+  // Returns 'k' nearest neighbors of 'word' in descending order of
+  // similarity if they're precomputed, or an empty span otherwise.
+  std::span<const Neighbor> Lookup(int32_t word, int32_t k) const noexcept;
+
+  bool HasGraph() const noexcept;
+
+  // Searches 'k' approximate nearest neighbors of 'word' excluding the word
+  // itself, results are in descending order of similarity. Returns false if
+  // there is no graph or 'word' isn't a word of the model.
+  bool Search(int32_t word, int32_t k, Scratch& scratch,
+              std::vector<Neighbor>& neighbors) const;
+
+ private:
+  struct Header;
+
+  NearestNeighborsIndex(const fasttext::ImmutableFastText& model,
+                        IResourceManager& rm)
+    : model_{&model}, file_{rm} {}
+
+  bool Init();
+  // Checks that words and links of a mapped file stay within the model.
+  bool Validate() const noexcept;
+
+  const fasttext::ImmutableFastText* model_;
+  mmap_utils::mmap_handle file_;
+  const Header* header_{};
+  std::span<const Neighbor> table_;
+  std::span<const uint8_t> levels_;
+  std::span<const uint32_t> upper_offsets_;
+  std::span<const int32_t> lower_links_;
+  std::span<const int32_t> upper_links_;
+  const float* vectors_{};
+  int32_t dim_{};
+};
+
+}  // namespace irs::analysis
@@ -25,6 +25,7 @@
 
 #include <fasttext.h>
 
+#include <filesystem>
 #include <string_view>
 
 #include "store/store_utils.hpp"
@@ -37,6 +38,7 @@ namespace irs::analysis {
 namespace {
 
 constexpr std::string_view MODEL_LOCATION_PARAM_NAME{"model_location"};
+constexpr std::string_view NEIGHBORS_INDEX_PARAM_NAME{"neighbors_index"};
 constexpr std::string_view TOP_K_PARAM_NAME{"top_k"};
 
 std::atomic<nearest_neighbors_stream::model_provider_f> MODEL_PROVIDER{nullptr};
@@ -54,6 +56,17 @@ bool parse_vpack_options(const VPackSlice slice,
       return false;
     }
     options.model_location = model_location_slice.stringView();
+    auto neighbors_index_slice = slice.get(NEIGHBORS_INDEX_PARAM_NAME);
+    if (!neighbors_index_slice.isNone()) {
+      if (!neighbors_index_slice.isString()) {
+        IRS_LOG_ERROR(absl::StrCat(
+          "Invalid vpack while ", action,
+          " nearest_neighbors_stream from VPack arguments. ",
+          NEIGHBORS_INDEX_PARAM_NAME, " value should be a string."));
+        return false;
+      }
+      options.neighbors_index = neighbors_index_slice.stringView();
+    }
     auto top_k_slice = slice.get(TOP_K_PARAM_NAME);
     if (!top_k_slice.isNone()) {
       if (!top_k_slice.isNumber()) {
@@ -110,7 +123,20 @@ analyzer::ptr construct(const nearest_neighbors_stream::options& options) {
     return nullptr;
   }
 
-  return std::make_unique<nearest_neighbors_stream>(options, std::move(model));
+  std::unique_ptr<const NearestNeighborsIndex> index;
+  if (!options.neighbors_index.empty()) {
+    const std::filesystem::path path{options.neighbors_index};
+    index = NearestNeighborsIndex::Open(*model, path.c_str());
+    if (!index) {
+      IRS_LOG_ERROR(
+        absl::StrCat("Failed to load nearest neighbors index from: ",
+                     options.neighbors_index));
+      return nullptr;
+    }
+  }
+
+  return std::make_unique<nearest_neighbors_stream>(options, std::move(model),
+                                                    std::move(index));
 }
 
 analyzer::ptr make_vpack(const VPackSlice slice) {
@@ -151,6 +177,10 @@ bool make_vpack_config(const nearest_neighbors_stream::options& options,
   VPackObjectBuilder object{builder};
   {
     builder->add(MODEL_LOCATION_PARAM_NAME, VPackValue(options.model_location));
+    if (!options.neighbors_index.empty()) {
+      builder->add(NEIGHBORS_INDEX_PARAM_NAME,
+                   VPackValue(options.neighbors_index));
+    }
     builder->add(TOP_K_PARAM_NAME, VPackValue(options.top_k));
   }
   return true;
@@ -218,9 +248,11 @@ nearest_neighbors_stream::set_model_provider(
   return MODEL_PROVIDER.exchange(provider, std::memory_order_relaxed);
 }
 
-nearest_neighbors_stream::nearest_neighbors_stream(const options& options,
-                                                   model_ptr model) noexcept
+nearest_neighbors_stream::nearest_neighbors_stream(
+  const options& options, model_ptr model,
+  std::unique_ptr<const NearestNeighborsIndex> index) noexcept
   : model_{std::move(model)},
+    index_{std::move(index)},
     neighbors_it_{neighbors_.end()},
     n_tokens_{0},
     current_token_ind_{0},
@@ -236,8 +268,7 @@ bool nearest_neighbors_stream::next() {
     if (current_token_ind_ == n_tokens_) {
       return false;
     }
-    neighbors_ = model_->getNN(
-      model_dict_->getWord(line_token_ids_[current_token_ind_]), top_k_);
+    find_neighbors(line_token_ids_[current_token_ind_]);
     neighbors_it_ = neighbors_.begin();
     ++current_token_ind_;
   }
@@ -255,6 +286,25 @@ bool nearest_neighbors_stream::next() {
   return true;
 }
 
+void nearest_neighbors_stream::find_neighbors(int32_t word) {
+  if (index_) {
+    auto found = index_->Lookup(word, top_k_);
+    if (found.empty() && index_->Search(word, top_k_, scratch_, found_)) {
+      found = found_;
+    }
+    if (!found.empty()) {
+      neighbors_.clear();
+      for (const auto& neighbor : found) {
+        neighbors_.emplace_back(neighbor.similarity,
+                                model_dict_->getWord(neighbor.word));
+      }
+      return;
+    }
+  }
+
+  neighbors_ = model_->getNN(model_dict_->getWord(word), top_k_);
+}
+
 bool nearest_neighbors_stream::reset(std::string_view data) {
   auto& offset = std::get<irs::offset>(attrs_);
   offset.start = 0;
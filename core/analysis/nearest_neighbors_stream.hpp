@@ -24,6 +24,7 @@
 #pragma once
 
 #include "analysis/analyzers.hpp"
+#include "analysis/nearest_neighbors_index.hpp"
 #include "analysis/token_attributes.hpp"
 #include "utils/attribute_helper.hpp"
 
@@ -47,6 +48,9 @@ class nearest_neighbors_stream final
 
   struct options {
     std::string model_location;
+    // Optional NearestNeighborsIndex built for the model, words missing in
+    // the index are looked up by brute force.
+    std::string neighbors_index;
     int32_t top_k{1};
   };
 
@@ -56,8 +60,9 @@ class nearest_neighbors_stream final
 
   static void init();  // for registration in a static build
 
-  explicit nearest_neighbors_stream(const options& options,
-                                    model_ptr model_provider) noexcept;
+  explicit nearest_neighbors_stream(
+    const options& options, model_ptr model_provider,
+    std::unique_ptr<const NearestNeighborsIndex> index = nullptr) noexcept;
 
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
     return irs::get_mutable(attrs_, type);
@@ -69,8 +74,13 @@ class nearest_neighbors_stream final
  private:
   using attributes = std::tuple<increment, offset, term_attribute>;
 
+  void find_neighbors(int32_t word);
+
   model_ptr model_;
   std::shared_ptr<const fasttext::Dictionary> model_dict_;
+  std::unique_ptr<const NearestNeighborsIndex> index_;
+  NearestNeighborsIndex::Scratch scratch_;
+  std::vector<NearestNeighborsIndex::Neighbor> found_;
   std::vector<std::pair<float, std::string>> neighbors_;
   std::vector<std::pair<float, std::string>>::iterator neighbors_it_;
   std::vector<int32_t> line_token_ids_;
@@ -27,7 +27,9 @@
 
 #include <string_view>
 
+#include "analysis/token_batch.hpp"
 #include "utils/hash_utils.hpp"
+#include "utils/simd_utils.hpp"
 #include "utils/utf8_utils.hpp"
 #include "utils/vpack_utils.hpp"
 #include "velocypack/Builder.h"
@@ -340,6 +342,7 @@ void ngram_token_stream_base::init() {
 ngram_token_stream_base::ngram_token_stream_base(
   const ngram_token_stream_base::Options& options)
   : options_(options),
+    start_marked_(options.start_marker),
     start_marker_empty_(options.start_marker.empty()),
     end_marker_empty_(options.end_marker.empty()) {
   options_.min_gram = std::max(options_.min_gram, size_t(1));
@@ -367,15 +370,7 @@ void ngram_token_stream_base::emit_original() noexcept {
       inc.value = next_inc_val_;
       break;
     case EmitOriginal::WithEndMarker:
-      marked_term_buffer_.clear();
-      IRS_ASSERT(marked_term_buffer_.capacity() >=
-                 (options_.end_marker.size() + data_.size()));
-      marked_term_buffer_.append(data_.data(), data_end_);
-      marked_term_buffer_.append(options_.end_marker.begin(),
-                                 options_.end_marker.end());
-      term.value = marked_term_buffer_;
-      IRS_ASSERT(marked_term_buffer_.size() <=
-                 std::numeric_limits<uint32_t>::max());
+      term.value = end_marked(data_.data());
       offset.start = 0;
       offset.end = uint32_t(data_.size());
       emit_original_ = EmitOriginal::None;  // end marker is emitted last, so we
@@ -383,15 +378,7 @@ void ngram_token_stream_base::emit_original() noexcept {
       inc.value = next_inc_val_;
       break;
     case EmitOriginal::WithStartMarker:
-      marked_term_buffer_.clear();
-      IRS_ASSERT(marked_term_buffer_.capacity() >=
-                 (options_.start_marker.size() + data_.size()));
-      marked_term_buffer_.append(options_.start_marker.begin(),
-                                 options_.start_marker.end());
-      marked_term_buffer_.append(data_.data(), data_end_);
-      term.value = marked_term_buffer_;
-      IRS_ASSERT(marked_term_buffer_.size() <=
-                 std::numeric_limits<uint32_t>::max());
+      term.value = start_marked(data_end_);
       offset.start = 0;
       offset.end = uint32_t(data_.size());
       emit_original_ = options_.end_marker.empty()
@@ -406,6 +393,32 @@ void ngram_token_stream_base::emit_original() noexcept {
   next_inc_val_ = 0;
 }
 
+bytes_view ngram_token_stream_base::start_marked(
+  const byte_type* end) noexcept {
+  IRS_ASSERT(data_.data() <= end && end <= data_end_);
+  const size_t marker_size = options_.start_marker.size();
+  const size_t size = marker_size + std::distance(data_.data(), end);
+  if (start_marked_.size() < size) {
+    // copy only bytes which aren't copied yet
+    start_marked_.append(data_.data() + (start_marked_.size() - marker_size),
+                         end);
+  }
+  return {start_marked_.data(), size};
+}
+
+bytes_view ngram_token_stream_base::end_marked(
+  const byte_type* begin) noexcept {
+  IRS_ASSERT(data_.data() <= begin && begin <= data_end_);
+  const size_t offset = std::distance(data_.data(), begin);
+  if (offset < end_marked_offset_) {
+    // happens once per value as ngrams don't move backwards
+    end_marked_.assign(begin, data_end_);
+    end_marked_.append(options_.end_marker.begin(), options_.end_marker.end());
+    end_marked_offset_ = offset;
+  }
+  return bytes_view{end_marked_}.substr(offset - end_marked_offset_);
+}
+
 bool ngram_token_stream_base::reset(std::string_view value) noexcept {
   if (value.size() > std::numeric_limits<uint32_t>::max()) {
     // can't handle data which is longer than
@@ -443,19 +456,13 @@ bool ngram_token_stream_base::reset(std::string_view value) noexcept {
   }
   next_inc_val_ = 1;
   IRS_ASSERT(length_ < options_.min_gram);
-  const size_t max_marker_size =
-    std::max(options_.start_marker.size(), options_.end_marker.size());
-  if (max_marker_size > 0) {
-    // we have at least one marker. As we need to append marker to ngram and
-    // provide term value as continious buffer, we can`t return pointer to some
-    // byte inside input stream but rather we return pointer to buffer with
-    // copied values of ngram and marker For sake of performance we allocate
-    // requested memory right now
-    size_t buffer_size = options_.preserve_original
-                           ? data_.size()
-                           : std::min(data_.size(), options_.max_gram);
-    buffer_size += max_marker_size;
-    marked_term_buffer_.reserve(buffer_size);
+  // marked buffers keep their capacity, so we don't allocate once warmed up
+  start_marked_.resize(options_.start_marker.size());
+  end_marked_offset_ = data_.size();
+  if (options_.stream_bytes_type == InputType::UTF8) {
+    // find all symbols at once instead of decoding them for every ngram
+    next_offsets_.resize(data_.size());
+    simd::utf8_next(data_.data(), data_.size(), next_offsets_.data());
   }
   return true;
 }
@@ -470,7 +477,7 @@ bool ngram_token_stream<StreamType>::next_symbol(
   if constexpr (StreamType == InputType::Binary) {
     ++it;
   } else if constexpr (StreamType == InputType::UTF8) {
-    it = utf8_utils::Next(it, data_end_);
+    it = data_.data() + next_offsets_[std::distance(data_.data(), it)];
   }
   return true;
 }
@@ -500,15 +507,7 @@ bool ngram_token_stream<StreamType>::next() noexcept {
               (end_marker_empty_ || ngram_end_ != data_end_)) {
             term.value = irs::bytes_view(begin_, ngram_byte_len);
           } else if (0 == offset.start && !start_marker_empty_) {
-            marked_term_buffer_.clear();
-            IRS_ASSERT(marked_term_buffer_.capacity() >=
-                       (options_.start_marker.size() + ngram_byte_len));
-            marked_term_buffer_.append(options_.start_marker.begin(),
-                                       options_.start_marker.end());
-            marked_term_buffer_.append(begin_, ngram_byte_len);
-            term.value = marked_term_buffer_;
-            IRS_ASSERT(marked_term_buffer_.size() <=
-                       std::numeric_limits<uint32_t>::max());
+            term.value = start_marked(ngram_end_);
             if (ngram_byte_len == data_.size() && !end_marker_empty_) {
               // this term is whole original stream and we have end marker, so
               // we need to emit this term again with end marker just like
@@ -517,13 +516,7 @@ bool ngram_token_stream<StreamType>::next() noexcept {
             }
           } else {
             IRS_ASSERT(!end_marker_empty_ && ngram_end_ == data_end_);
-            marked_term_buffer_.clear();
-            IRS_ASSERT(marked_term_buffer_.capacity() >=
-                       (options_.end_marker.size() + ngram_byte_len));
-            marked_term_buffer_.append(begin_, ngram_byte_len);
-            marked_term_buffer_.append(options_.end_marker.begin(),
-                                       options_.end_marker.end());
-            term.value = marked_term_buffer_;
+            term.value = end_marked(begin_);
           }
         } else {
           // if ngram covers original stream we need to process it specially
@@ -551,6 +544,86 @@ bool ngram_token_stream<StreamType>::next() noexcept {
   return false;
 }
 
+// Produces the same tokens as next() without its state machine: ngrams of
+// each position are written straight to the batch, so there are neither
+// attribute updates nor a dispatch on emit_original_ per token.
+template<irs::analysis::ngram_token_stream_base::InputType StreamType>
+void ngram_token_stream<StreamType>::analyze(
+  std::span<const std::string_view> values, TokenBatch& batch) {
+  batch.reset(true);
+  for (const auto value : values) {
+    const bool valid = reset(value);
+    batch.add_value(valid);
+    if (valid) {
+      analyze_value(batch);
+    }
+  }
+  // leave the stream exhausted as if next() returned false
+  begin_ = data_end_;
+  emit_original_ = EmitOriginal::None;
+}
+
+template<irs::analysis::ngram_token_stream_base::InputType StreamType>
+void ngram_token_stream<StreamType>::analyze_value(TokenBatch& batch) {
+  const auto* data = data_.data();
+  const auto size = static_cast<uint32_t>(data_.size());
+  bool original = options_.preserve_original;
+
+  auto emit_original = [&](uint32_t inc) {
+    if (!start_marker_empty_) {
+      batch.add_token(start_marked(data_end_), inc, 0, size);
+      inc = 0;
+    }
+    if (!end_marker_empty_) {
+      batch.add_token(end_marked(data), inc, 0, size);
+    } else if (start_marker_empty_) {
+      batch.add_token(data_, inc, 0, size);
+    }
+  };
+
+  for (const byte_type* begin = data; begin != data_end_;
+       next_symbol(begin)) {
+    const auto start = static_cast<uint32_t>(std::distance(data, begin));
+    uint32_t inc = 1;
+    const byte_type* end = begin;
+    for (size_t length = 1;
+         length <= options_.max_gram && next_symbol(end); ++length) {
+      if (length < options_.min_gram) {
+        continue;
+      }
+      const auto ngram_end = static_cast<uint32_t>(std::distance(data, end));
+      if (end == data_end_ && 0 == start) {
+        // ngram covering the whole value is emitted as the original
+        if (original) {
+          break;
+        }
+        if (!start_marker_empty_) {
+          batch.add_token(start_marked(end), inc, start, ngram_end);
+          inc = 0;
+          if (!end_marker_empty_) {
+            batch.add_token(end_marked(begin), inc, start, ngram_end);
+          }
+          break;
+        }
+      }
+      if (end == data_end_ && !end_marker_empty_) {
+        batch.add_token(end_marked(begin), inc, start, ngram_end);
+      } else if (0 == start && !start_marker_empty_) {
+        batch.add_token(start_marked(end), inc, start, ngram_end);
+      } else {
+        batch.add_token({begin, static_cast<size_t>(end - begin)}, inc, start,
+                        ngram_end);
+      }
+      inc = 0;
+    }
+    if (original) {
+      // original is emitted after ngrams of the first position
+      emit_original(inc);
+      original = false;
+    }
+  }
+}
+
 }  // namespace analysis
 }  // namespace irs
 
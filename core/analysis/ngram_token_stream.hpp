@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "analysis/analyzers.hpp"
 #include "analysis/token_attributes.hpp"
 #include "utils/attribute_helper.hpp"
@@ -86,6 +88,12 @@ class ngram_token_stream_base : public TypedAnalyzer<ngram_token_stream_base>,
 
   void emit_original() noexcept;
 
+  // Returns ngram [data_.data(), end) prefixed by start marker.
+  bytes_view start_marked(const byte_type* end) noexcept;
+
+  // Returns ngram [begin, data_end_) suffixed by end marker.
+  bytes_view end_marked(const byte_type* begin) noexcept;
+
   Options options_;
   bytes_view data_;  // data to process
   attributes attrs_;
@@ -103,10 +111,16 @@ class ngram_token_stream_base : public TypedAnalyzer<ngram_token_stream_base>,
 
   EmitOriginal emit_original_{EmitOriginal::None};
 
-  // buffer for emitting ngram with start/stop marker
-  // we need continious memory for value so can not use
-  // pointers to input memory block
-  bstring marked_term_buffer_;
+  // Terms with markers need continuous memory, so they're views into
+  // buffers holding a copy of the data surrounded by a marker. The buffers
+  // are filled at most once per value: ngrams with start marker only grow,
+  // ngrams with end marker only shrink.
+  bstring start_marked_;  // start marker followed by a prefix of data
+  bstring end_marked_;    // suffix of data followed by end marker
+  size_t end_marked_offset_{};  // offset of the suffix in data
+
+  // Offsets of the next code point for code points of UTF-8 data.
+  std::vector<uint32_t> next_offsets_;
 
   // increment value for next token
   uint32_t next_inc_val_{0};
@@ -124,9 +138,12 @@ class ngram_token_stream : public ngram_token_stream_base {
   explicit ngram_token_stream(const ngram_token_stream_base::Options& options);
 
   bool next() noexcept final;
+  void analyze(std::span<const std::string_view> values,
+               TokenBatch& batch) final;
 
  private:
   inline bool next_symbol(const byte_type*& it) const noexcept;
+  void analyze_value(TokenBatch& batch);
 };
 
 }  // namespace analysis
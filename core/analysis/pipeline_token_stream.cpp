@@ -23,6 +23,7 @@
 
 #include "pipeline_token_stream.hpp"
 
+#include <limits>
 #include <string_view>
 
 #include "utils/vpack_utils.hpp"
@@ -297,6 +298,60 @@ bool all_have_offset(std::span<const irs::analysis::analyzer::ptr> pipeline) {
                      });
 }
 
+// Tokens of a value of a pipeline member batch, counterpart of sub_analyzer_t
+// used by analyze(...).
+struct batch_cursor {
+  explicit batch_cursor(const irs::analysis::TokenBatch& batch,
+                        bool track_offset) noexcept
+    : batch{&batch}, track_offset{track_offset} {}
+
+  bool reset(size_t value, uint32_t start, uint32_t end,
+             size_t size) noexcept {
+    data_size = size;
+    data_start = start;
+    data_end = end;
+    pos = std::numeric_limits<uint32_t>::max();
+    if (!batch->valid(value)) {
+      return false;
+    }
+    next_token = batch->first(value);
+    end_token = next_token + batch->tokens(value).size();
+    return true;
+  }
+
+  bool next() noexcept {
+    if (next_token == end_token) {
+      return false;
+    }
+    token = &batch->tokens()[next_token];
+    current = next_token++;
+    pos += token->increment;
+    return true;
+  }
+
+  uint32_t start() const noexcept {
+    return data_start + (track_offset ? token->start : 0);
+  }
+
+  uint32_t end() const noexcept {
+    const auto token_start = track_offset ? token->start : 0;
+    const auto token_end = track_offset ? token->end : 0;
+    return token_end == data_size ? data_end
+                                  : start() + token_end - token_start;
+  }
+
+  const irs::analysis::TokenBatch* batch;
+  const irs::analysis::TokenBatch::Token* token{};
+  size_t current{};  // index of the current token in a batch
+  size_t next_token{};
+  size_t end_token{};
+  size_t data_size{};
+  uint32_t data_start{};
+  uint32_t data_end{};
+  uint32_t pos{std::numeric_limits<uint32_t>::max()};
+  bool track_offset;
+};
+
 }  // namespace
 
 namespace irs {
@@ -405,6 +460,104 @@ bool pipeline_token_stream::reset(std::string_view data) {
   return pipeline_.front().reset(0, static_cast<uint32_t>(data.size()), data);
 }
 
+void pipeline_token_stream::analyze(std::span<const std::string_view> values,
+                                    TokenBatch& batch) {
+  const auto track_offset = irs::get<offset>(*this) != nullptr;
+  const auto size = pipeline_.size();
+  batches_.resize(size);
+
+  // analyze terms of all tokens of a member by the next member at once
+  pipeline_.front().analyze(values, batches_.front());
+  for (size_t i = 1; i < size; ++i) {
+    const auto& prev = batches_[i - 1];
+    terms_.clear();
+    terms_.reserve(prev.tokens().size());
+    for (const auto& token : prev.tokens()) {
+      terms_.emplace_back(ViewCast<char>(prev.term(token)));
+    }
+    pipeline_[i].analyze(terms_, batches_[i]);
+  }
+
+  std::vector<batch_cursor> cursors;
+  cursors.reserve(size);
+  for (const auto& member : batches_) {
+    cursors.emplace_back(member, track_offset);
+  }
+
+  // derived flag comes from the nearest to end provider, as in get_mutable()
+  auto derived = size;
+  for (auto i = size; i != 0; --i) {
+    if (irs::get<derived_token>(pipeline_[i - 1].get_stream())) {
+      derived = i - 1;
+      break;
+    }
+  }
+
+  // assemble tokens exactly as next() does, see comments there
+  batch.reset(track_offset);
+  const auto bottom = size - 1;
+  for (size_t value = 0; value < values.size(); ++value) {
+    const auto data = values[value];
+    const bool valid = cursors.front().reset(
+      value, 0, static_cast<uint32_t>(data.size()), data.size());
+    batch.add_value(valid);
+    if (!valid) {
+      continue;
+    }
+
+    size_t current = 0;
+    for (bool done = false; !done;) {
+      uint32_t pipeline_inc = 0;
+      bool step_for_rollback{false};
+      do {
+        while (!cursors[current].next()) {
+          if (current == 0) {
+            done = true;
+            break;
+          }
+          --current;
+        }
+        if (done) {
+          break;
+        }
+        pipeline_inc = cursors[current].token->increment;
+        const auto top_holds_position = pipeline_inc == 0;
+        while (current != bottom) {
+          const auto& parent = cursors[current];
+          auto& child = cursors[++current];
+          step_for_rollback |=
+            top_holds_position && child.pos != 0 &&
+            child.pos != std::numeric_limits<uint32_t>::max();
+          if (!child.reset(parent.current, parent.start(), parent.end(),
+                           parent.token->term_size)) {
+            done = true;
+            break;
+          }
+          if (!child.next()) {
+            --current;
+            break;
+          }
+          pipeline_inc += child.token->increment;
+          IRS_ASSERT(pipeline_inc > 0);
+          pipeline_inc--;
+        }
+      } while (!done && current != bottom);
+
+      if (done) {
+        break;
+      }
+      if (step_for_rollback) {
+        pipeline_inc++;
+      }
+      const auto& bottom_cursor = cursors[bottom];
+      batch.add_token(batches_[bottom].term(*bottom_cursor.token), pipeline_inc,
+                      track_offset ? bottom_cursor.start() : 0,
+                      track_offset ? bottom_cursor.end() : 0,
+                      derived != size && cursors[derived].token->derived);
+    }
+  }
+}
+
 void pipeline_token_stream::init() {
   REGISTER_ANALYZER_JSON(pipeline_token_stream, make_json,
                          normalize_json_config);  // match registration above
@@ -26,6 +26,7 @@
 #include "analyzers.hpp"
 #include "shared.hpp"
 #include "token_attributes.hpp"
+#include "token_batch.hpp"
 #include "token_stream.hpp"
 #include "utils/attribute_helper.hpp"
 
@@ -61,6 +62,12 @@ class pipeline_token_stream final : public TypedAnalyzer<pipeline_token_stream>,
   bool next() final;
   bool reset(std::string_view data) final;
 
+  // Analyzes 'values' member by member: each member analyzes terms of all
+  // tokens of the previous one at once, tokens are then assembled following
+  // the same rules as next() does.
+  void analyze(std::span<const std::string_view> values,
+               TokenBatch& batch) final;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief calls visitor on pipeline members in respective order. Visiting is
   /// interrupted on first visitor returning false.
@@ -96,6 +103,9 @@ class pipeline_token_stream final : public TypedAnalyzer<pipeline_token_stream>,
       pos = std::numeric_limits<uint32_t>::max();
       return analyzer->reset(data);
     }
+    void analyze(std::span<const std::string_view> values, TokenBatch& batch) {
+      analyzer->analyze(values, batch);
+    }
     bool next() {
       if (analyzer->next()) {
         pos += inc->value;
@@ -142,6 +152,8 @@ class pipeline_token_stream final : public TypedAnalyzer<pipeline_token_stream>,
   pipeline_t::iterator bottom_;
   offset offs_;
   attributes attrs_;
+  std::vector<TokenBatch> batches_;  // tokens of each member for analyze()
+  std::vector<std::string_view> terms_;
 };
 
 }  // namespace analysis
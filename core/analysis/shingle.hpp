@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "utils/string.hpp"
+
+namespace irs::analysis {
+
+// Shingle is a pair of adjacent terms indexed as a single derived term at
+// the position of the first term, see derived_token. Shingles are used by
+// phrase queries to narrow down candidate documents before checking
+// positions, hence a collision with a regular term only costs a false
+// candidate.
+inline constexpr byte_type kShingleSeparator = 0x1F;  // ASCII unit separator
+
+inline void MakeShingle(bstring& buf, bytes_view lhs, bytes_view rhs) {
+  buf.clear();
+  buf.reserve(lhs.size() + 1 + rhs.size());
+  buf.append(lhs);
+  buf.push_back(kShingleSeparator);
+  buf.append(rhs);
+}
+
+}  // namespace irs::analysis
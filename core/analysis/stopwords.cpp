@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "stopwords.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+
+#include "utils/simd_utils.hpp"
+
+namespace irs::analysis {
+namespace {
+
+// Average number of stopwords per bucket.
+constexpr size_t kBucketSize = 4;
+// Number of displacements tried per bucket before trying another seed.
+constexpr uint64_t kMaxDisplacements = 1 << 16;
+// Number of seeds tried before adding more slots.
+constexpr uint64_t kSeedsPerSize = 4;
+
+// Compiled sets by hashes of their words, sets are destroyed with their last
+// user.
+absl::flat_hash_map<uint64_t, std::vector<std::weak_ptr<const Stopwords>>>
+  STOPWORDS;
+std::mutex STOPWORDS_MUTEX;
+
+// Hash of 'words' independent of their iteration order.
+uint64_t HashWords(const Stopwords::words_t& words) noexcept {
+  uint64_t hash = absl::Hash<size_t>{}(words.size());
+  for (const auto& word : words) {
+    hash += absl::Hash<std::string_view>{}(word);
+  }
+  return hash;
+}
+
+bool Equal(const Stopwords& stopwords,
+           const Stopwords::words_t& words) noexcept {
+  return stopwords.size() == words.size() &&
+         std::all_of(words.begin(), words.end(), [&](const auto& word) {
+           return stopwords.Contains(word);
+         });
+}
+
+}  // namespace
+
+Stopwords::ptr Stopwords::Make(const words_t& words) {
+  const auto hash = HashWords(words);
+
+  std::lock_guard lock{STOPWORDS_MUTEX};
+  auto& sets = STOPWORDS[hash];
+  for (const auto& set : sets) {
+    if (auto stopwords = set.lock(); stopwords && Equal(*stopwords, words)) {
+      return stopwords;
+    }
+  }
+  auto stopwords = std::make_shared<const Stopwords>(words);
+  sets.emplace_back(stopwords);
+  for (auto it = STOPWORDS.begin(); it != STOPWORDS.end();) {
+    auto& entries = it->second;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const auto& set) { return set.expired(); }),
+                  entries.end());
+    if (entries.empty()) {
+      STOPWORDS.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  return stopwords;
+}
+
+bool Stopwords::Find(std::string_view word) const noexcept {
+  const uint64_t hash = Hash(word, seed_);
+  const auto& slot = slots_[Reduce(
+    Mix(hash ^ displacements_[Reduce(hash, displacements_.size())]),
+    slots_.size())];
+  return slot.size == word.size() &&
+         simd::equal_bytes(
+           reinterpret_cast<const byte_type*>(data_.data() + slot.offset),
+           reinterpret_cast<const byte_type*>(word.data()), word.size());
+}
+
+Stopwords::Stopwords(const words_t& words) : size_{words.size()} {
+  if (words.empty()) {
+    return;
+  }
+
+  size_t data_size = 0;
+  for (const auto& word : words) {
+    data_size += word.size();
+    lengths_ |= uint64_t{1} << std::min<size_t>(word.size(), 63);
+  }
+  IRS_ASSERT(data_size <= std::numeric_limits<uint32_t>::max());
+
+  std::vector<std::string_view> views;
+  views.reserve(words.size());
+  data_.reserve(data_size);
+  for (const auto& word : words) {
+    views.emplace_back(data_.data() + data_.size(), word.size());
+    data_ += word;
+  }
+
+  // load factor of 0.8 lets displacements be found quickly
+  for (size_t num_slots = words.size() + words.size() / 4 + 1;;
+       num_slots += num_slots / 4 + 1) {
+    for (uint64_t i = 0; i < kSeedsPerSize; ++i, ++seed_) {
+      if (Build(views, num_slots)) {
+        return;
+      }
+    }
+  }
+}
+
+bool Stopwords::Build(const std::vector<std::string_view>& words,
+                      size_t num_slots) {
+  std::vector<uint64_t> hashes(words.size());
+  std::vector<std::vector<size_t>> buckets(
+    (words.size() + kBucketSize - 1) / kBucketSize);
+  for (size_t i = 0; i < words.size(); ++i) {
+    hashes[i] = Hash(words[i], seed_);
+    buckets[Reduce(hashes[i], buckets.size())].emplace_back(i);
+  }
+
+  // place the largest buckets first while most slots are free
+  std::vector<size_t> order(buckets.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  std::vector<bool> taken(num_slots);
+  std::vector<size_t> positions;
+  displacements_.assign(buckets.size(), 0);
+  slots_.assign(num_slots, {});
+  for (const auto bucket : order) {
+    const auto& keys = buckets[bucket];
+    if (keys.empty()) {
+      break;
+    }
+    uint64_t displacement = 0;
+    for (uint64_t pilot = 0;; ++pilot) {
+      if (pilot == kMaxDisplacements) {
+        return false;
+      }
+      displacement = pilot * 0x9E3779B97F4A7C15ULL;
+      positions.clear();
+      for (const auto key : keys) {
+        const auto position =
+          Reduce(Mix(hashes[key] ^ displacement), num_slots);
+        if (taken[position] || std::find(positions.begin(), positions.end(),
+                                         position) != positions.end()) {
+          break;
+        }
+        positions.emplace_back(position);
+      }
+      if (positions.size() == keys.size()) {
+        break;
+      }
+    }
+    displacements_[bucket] = displacement;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const auto& word = words[keys[i]];
+      taken[positions[i]] = true;
+      slots_[positions[i]] = {
+        .offset = static_cast<uint32_t>(word.data() - data_.data()),
+        .size = static_cast<uint32_t>(word.size())};
+    }
+  }
+  return true;
+}
+
+}  // namespace irs::analysis
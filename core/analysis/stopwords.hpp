@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_set.h>
+#include <absl/numeric/int128.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+namespace irs::analysis {
+
+// Immutable set of stopwords compiled into a perfect hash table.
+//
+// A lookup rejects words of lengths no stopword has without hashing, the
+// rest are hashed once and compared with the only candidate the word can
+// match: a hash selects a bucket, a displacement found for the bucket at
+// construction maps all stopwords of the bucket to distinct slots.
+class Stopwords : private util::noncopyable {
+ public:
+  using ptr = std::shared_ptr<const Stopwords>;
+  using words_t = absl::flat_hash_set<std::string>;
+
+  // Returns compiled 'words' shared with other callers compiling the same
+  // words while any of them holds the returned set.
+  static ptr Make(const words_t& words);
+
+  explicit Stopwords(const words_t& words);
+
+  bool Contains(std::string_view word) const noexcept {
+    const auto length = uint64_t{1} << std::min<size_t>(word.size(), 63);
+    return 0 != (lengths_ & length) && Find(word);
+  }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return 0 == size_; }
+
+ private:
+  struct Slot {
+    uint32_t offset{};
+    uint32_t size{};
+  };
+
+  static uint64_t Hash(std::string_view word, uint64_t seed) noexcept {
+    return absl::Hash<std::pair<uint64_t, std::string_view>>{}({seed, word});
+  }
+
+  static uint64_t Mix(uint64_t value) noexcept {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+  // Maps 'hash' to [0, size) without division.
+  static size_t Reduce(uint64_t hash, size_t size) noexcept {
+    return absl::Uint128High64(absl::uint128{hash} * size);
+  }
+
+  // Returns true if 'word' is a stopword, 'word' must be of a length some
+  // stopword has.
+  bool Find(std::string_view word) const noexcept;
+
+  bool Build(const std::vector<std::string_view>& words, size_t num_slots);
+
+  std::string data_;  // concatenated stopwords
+  std::vector<Slot> slots_;
+  std::vector<uint64_t> displacements_;
+  uint64_t lengths_{};  // bit 'i' is set if a stopword of length 'i' exists,
+                        // bit 63 for lengths of 63 and more
+  uint64_t seed_{};
+  size_t size_{};
+};
+
+}  // namespace irs::analysis
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <string>
+
+#include "utils/string.hpp"
+
+namespace irs::analysis {
+
+// Bounded cache of analysis results keyed by raw tokens. Words of a natural
+// language follow Zipf's law, hence a few thousands of entries serve most
+// of lookups. The cache is dropped once full, frequent words are cached
+// again almost immediately.
+class TermCache {
+ public:
+  struct Stats {
+    uint64_t hits{};
+    uint64_t misses{};
+  };
+
+  struct Entry {
+    std::string term;
+    // token is filtered out, e.g. a stopword
+    bool skip{};
+  };
+
+  explicit TermCache(size_t capacity = 0) : capacity_{capacity} {}
+
+  bool enabled() const noexcept { return capacity_ != 0; }
+
+  // Returns cached result of the specified token or nullptr.
+  const Entry* Find(bytes_view token) {
+    IRS_ASSERT(enabled());
+    if (const auto it = entries_.find(ViewCast<char>(token));
+        it != entries_.end()) {
+      ++stats_.hits;
+      return &it->second;
+    }
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  void Emplace(bytes_view token, bytes_view term, bool skip) {
+    IRS_ASSERT(enabled());
+    if (entries_.size() >= capacity_) {
+      entries_.clear();
+    }
+    entries_.try_emplace(std::string{ViewCast<char>(token)},
+                         Entry{.term = std::string{ViewCast<char>(term)},
+                               .skip = skip});
+  }
+
+  size_t size() const noexcept { return entries_.size(); }
+  size_t capacity() const noexcept { return capacity_; }
+  const Stats& stats() const noexcept { return stats_; }
+
+ private:
+  absl::flat_hash_map<std::string, Entry> entries_;
+  size_t capacity_;
+  Stats stats_;
+};
+
+}  // namespace irs::analysis
@@ -38,6 +38,7 @@ namespace {
 using namespace irs;
 
 constexpr std::string_view LOCALE_PARAM_NAME{"locale"};
+constexpr std::string_view CACHE_SIZE_PARAM_NAME{"cacheSize"};
 
 bool locale_from_slice(VPackSlice slice, icu::Locale& locale) {
   if (!slice.isString()) {
@@ -96,7 +97,25 @@ bool parse_vpack_options(
       return false;
     }
 
-    return locale_from_slice(locale_slice, opts.locale);
+    if (!locale_from_slice(locale_slice, opts.locale)) {
+      return false;
+    }
+
+    if (auto cache_slice = slice.get(CACHE_SIZE_PARAM_NAME);
+        !cache_slice.isNone()) {
+      if (!cache_slice.isNumber<decltype(opts.cache_size)>()) {
+        IRS_LOG_WARN(
+          absl::StrCat("Non-numeric value in '", CACHE_SIZE_PARAM_NAME,
+                       "' while constructing text_token_stemming_stream from "
+                       "VPack arguments"));
+
+        return false;
+      }
+
+      opts.cache_size = cache_slice.getNumber<decltype(opts.cache_size)>();
+    }
+
+    return true;
   } catch (const std::exception& ex) {
     IRS_LOG_ERROR(absl::StrCat(
       "Caught error '", ex.what(),
@@ -112,6 +131,7 @@ bool parse_vpack_options(
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief args is a jSON encoded object with the following attributes:
 ///        "locale"(string): the locale to use for stemming <required>
+///        "cacheSize"(number): max number of cached stems, 0 disables cache
 ////////////////////////////////////////////////////////////////////////////////
 analysis::analyzer::ptr make_vpack(const VPackSlice slice) {
   analysis::stemming_token_stream::options_t opts;
@@ -140,6 +160,10 @@ bool make_vpack_config(const analysis::stemming_token_stream::options_t& opts,
     const auto* locale_name = opts.locale.getName();
     builder->add(LOCALE_PARAM_NAME, VPackValue(locale_name));
   }
+  if (opts.cache_size) {
+    builder->add(CACHE_SIZE_PARAM_NAME,
+                 VPackValue(static_cast<uint64_t>(opts.cache_size)));
+  }
   return true;
 }
 
@@ -219,7 +243,7 @@ namespace irs {
 namespace analysis {
 
 stemming_token_stream::stemming_token_stream(const options_t& options)
-  : options_{options}, term_eof_{true} {}
+  : options_{options}, cache_{options.cache_size}, term_eof_{true} {}
 
 void stemming_token_stream::init() {
   REGISTER_ANALYZER_JSON(stemming_token_stream, make_json,
@@ -263,6 +287,15 @@ bool stemming_token_stream::reset(std::string_view data) {
       return false;
     }
 
+    const auto token = ViewCast<byte_type>(utf8_data);
+    const auto* entry = cache_.enabled() ? cache_.Find(token) : nullptr;
+
+    if (entry) {
+      term.value = ViewCast<byte_type>(std::string_view{entry->term});
+
+      return true;
+    }
+
     static_assert(sizeof(sb_symbol) == sizeof(char));
     const auto* value = reinterpret_cast<const sb_symbol*>(utf8_data.data());
 
@@ -274,6 +307,10 @@ bool stemming_token_stream::reset(std::string_view data) {
       term.value = bytes_view(reinterpret_cast<const byte_type*>(value),
                               sb_stemmer_length(stemmer_.get()));
 
+      if (cache_.enabled()) {
+        cache_.Emplace(token, term.value, false);
+      }
+
       return true;
     }
   }
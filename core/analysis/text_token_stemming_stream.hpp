@@ -26,6 +26,7 @@
 #include <unicode/locid.h>
 
 #include "analyzers.hpp"
+#include "term_cache.hpp"
 #include "token_attributes.hpp"
 #include "utils/attribute_helper.hpp"
 #include "utils/snowball_stemmer.hpp"
@@ -44,6 +45,8 @@ class stemming_token_stream final : public TypedAnalyzer<stemming_token_stream>,
  public:
   struct options_t {
     icu::Locale locale;
+    // max number of cached stems, 0 disables cache
+    size_t cache_size{};
 
     options_t() : locale{"C"} { locale.setToBogus(); }
   };
@@ -58,6 +61,11 @@ class stemming_token_stream final : public TypedAnalyzer<stemming_token_stream>,
   bool next() final;
   bool reset(std::string_view data) final;
 
+  // Returns hit/miss counters of the stems cache.
+  const TermCache::Stats& cache_stats() const noexcept {
+    return cache_.stats();
+  }
+
  private:
   using attributes =
     std::tuple<increment, offset,
@@ -67,6 +75,7 @@ class stemming_token_stream final : public TypedAnalyzer<stemming_token_stream>,
   options_t options_;
   std::string buf_;
   stemmer_ptr stemmer_;
+  TermCache cache_;
   bool term_eof_;
 };
 
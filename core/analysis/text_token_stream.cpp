@@ -28,7 +28,10 @@
 #include <frozen/unordered_map.h>
 #include <libstemmer.h>
 #include <unicode/brkiter.h>  // for icu::BreakIterator
+#include <unicode/ustring.h>  // for u_strFromUTF8WithSub
 
+#include <algorithm>
+#include <array>
 #include <cctype>  // for std::isspace(...)
 #include <filesystem>
 #include <fstream>
@@ -36,11 +39,14 @@
 #include <string_view>
 
 #include "absl/strings/str_cat.h"
+#include "analysis/shingle.hpp"
+#include "analysis/token_batch.hpp"
 #include "utils/file_utils.hpp"
 #include "utils/hash_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/misc.hpp"
 #include "utils/runtime_utils.hpp"
+#include "utils/simd_utils.hpp"
 #include "utils/snowball_stemmer.hpp"
 #include "utils/thread_utils.hpp"
 #include "utils/utf8_utils.hpp"
@@ -73,11 +79,25 @@
 #pragma warning(default : 4229)
 #endif
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 
 namespace irs {
 namespace analysis {
 
+// Word break properties of ASCII characters, see UAX #29
+enum class WordClass : uint8_t {
+  kOther,
+  kLetter,
+  kNumeric,
+  kMidLetter,
+  kMidNumLet,
+  kMidNum,
+  kExtendNumLet,
+};
+
+using AsciiWordClasses = std::array<WordClass, 128>;
+
 struct icu_objects {
   bool valid() const noexcept {
     // 'break_iterator' indicates that 'icu_objects' struct initialized
@@ -89,12 +109,19 @@ struct icu_objects {
     break_iterator.reset();
     normalizer = nullptr;
     stemmer.reset();
+    ascii_words = nullptr;
+    ascii_case = false;
   }
 
   std::unique_ptr<icu::Transliterator> transliterator;
   std::unique_ptr<icu::BreakIterator> break_iterator;
   const icu::Normalizer2* normalizer{};  // reusable object owned by ICU
   stemmer_ptr stemmer;
+  // word break properties reproducing ICU word boundaries of ASCII text,
+  // nullptr if ICU boundaries can't be reproduced for a locale
+  const AsciiWordClasses* ascii_words{};
+  // ASCII case conversion matches the one of a locale
+  bool ascii_case{};
 };
 
 struct text_token_stream::state_t : icu_objects {
@@ -105,17 +132,26 @@ struct text_token_stream::state_t : icu_objects {
 
   icu::UnicodeString data;
   icu::UnicodeString token;
+  std::string_view input;
+  uint32_t ascii_pos{};  // position in ASCII input processed without ICU
+  TermCache cache;
   const options_t& options;
-  const stopwords_t& stopwords;
+  Stopwords::ptr stopwords;
   bstring term_buf;
   std::string tmp_buf;  // used by processTerm(...)
   ngram_state_t ngram;
   bytes_view term;
+  bstring prev_term;  // previous word for shingles
+  uint32_t prev_start{};
   uint32_t start{};
   uint32_t end{};
+  bool has_prev_term{};
+  bool word_pending{};  // current word to emit after its shingle
+  bool ascii{};            // input is tokenized without ICU
+  bool valid_utf8{};       // offsets of ICU data match offsets of input
 
-  state_t(const options_t& opts, const stopwords_t& stopw)
-    : options(opts), stopwords(stopw) {}
+  state_t(const options_t& opts, Stopwords::ptr stopw)
+    : cache{opts.cache_size}, options(opts), stopwords(std::move(stopw)) {}
 
   bool is_search_ngram() const {
     // if min or max or preserveOriginal are set then search ngram
@@ -136,12 +172,12 @@ namespace {
 using namespace irs;
 
 struct cached_options_t : public analysis::text_token_stream::options_t {
-  analysis::text_token_stream::stopwords_t stopwords_;
+  analysis::Stopwords::ptr stopwords_;
 
   cached_options_t(analysis::text_token_stream::options_t&& options,
                    analysis::text_token_stream::stopwords_t&& stopwords)
     : analysis::text_token_stream::options_t(std::move(options)),
-      stopwords_(std::move(stopwords)) {}
+      stopwords_(analysis::Stopwords::Make(stopwords)) {}
 };
 
 struct StringHash {
@@ -353,8 +389,235 @@ analysis::analyzer::ptr construct(icu::Locale&& locale) {
   return nullptr;
 }
 
+constexpr analysis::AsciiWordClasses make_ascii_words(
+  bool colon_mid_letter) noexcept {
+  using analysis::WordClass;
+
+  analysis::AsciiWordClasses classes{};
+  for (size_t c = 'a'; c <= 'z'; ++c) {
+    classes[c] = WordClass::kLetter;
+  }
+  for (size_t c = 'A'; c <= 'Z'; ++c) {
+    classes[c] = WordClass::kLetter;
+  }
+  for (size_t c = '0'; c <= '9'; ++c) {
+    classes[c] = WordClass::kNumeric;
+  }
+  classes['@'] = WordClass::kLetter;  // ICU tailoring
+  classes['.'] = WordClass::kMidNumLet;
+  classes['\''] = WordClass::kMidNumLet;
+  classes[','] = WordClass::kMidNum;
+  classes[';'] = WordClass::kMidNum;
+  classes['_'] = WordClass::kExtendNumLet;
+  if (colon_mid_letter) {
+    classes[':'] = WordClass::kMidLetter;  // e.g. Swedish, Finnish
+  }
+  return classes;
+}
+
+constexpr analysis::AsciiWordClasses kAsciiWords = make_ascii_words(false);
+constexpr analysis::AsciiWordClasses kAsciiWordsColon = make_ascii_words(true);
+
+// Finds the next word of ASCII 'data' starting from 'pos' following
+// Unicode word boundary rules, returns false if there are no more words.
+bool next_ascii_word(const analysis::AsciiWordClasses& classes,
+                     std::string_view data, uint32_t& pos,
+                     uint32_t& begin) noexcept {
+  using analysis::WordClass;
+
+  const auto size = static_cast<uint32_t>(data.size());
+  auto word_class = [&](uint32_t i) noexcept {
+    return i < size ? classes[static_cast<byte_type>(data[i])]
+                    : WordClass::kOther;
+  };
+
+  while (pos < size) {
+    begin = pos;
+    auto prev = word_class(pos++);
+
+    if (prev != WordClass::kLetter && prev != WordClass::kNumeric &&
+        prev != WordClass::kExtendNumLet) {
+      continue;
+    }
+
+    for (bool joined = true; joined && pos < size;) {
+      switch (const auto next = word_class(pos); next) {
+        case WordClass::kLetter:
+        case WordClass::kNumeric:
+        case WordClass::kExtendNumLet:
+          prev = next;
+          ++pos;
+          break;
+        case WordClass::kMidLetter:
+          joined = prev == WordClass::kLetter &&
+                   word_class(pos + 1) == WordClass::kLetter;
+          pos += 2 * joined;
+          break;
+        case WordClass::kMidNumLet:
+          joined =
+            (prev == WordClass::kLetter || prev == WordClass::kNumeric) &&
+            word_class(pos + 1) == prev;
+          pos += 2 * joined;
+          break;
+        case WordClass::kMidNum:
+          joined = prev == WordClass::kNumeric &&
+                   word_class(pos + 1) == WordClass::kNumeric;
+          pos += 2 * joined;
+          break;
+        default:
+          joined = false;
+          break;
+      }
+    }
+
+    // a single '_' isn't a word
+    if (pos - begin > 1 || prev != WordClass::kExtendNumLet) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Checks that 'classes' reproduce ICU word boundaries of every ASCII
+// character in typical contexts.
+bool match_icu_words(icu::BreakIterator& break_iterator,
+                     const analysis::AsciiWordClasses& classes) {
+  std::string probe;
+  for (int c = 1; c < 128; ++c) {
+    for (const auto context :
+         {"a_b", "1_2", "__", "a_", "_a", "___", "a__b", "1__2"}) {
+      for (const auto* p = context; *p; ++p) {
+        probe += *p == '_' ? static_cast<char>(c) : *p;
+      }
+      probe += '\n';
+    }
+  }
+
+  const auto data = icu::UnicodeString::fromUTF8(
+    icu::StringPiece{probe.data(), static_cast<int32_t>(probe.size())});
+  break_iterator.setText(data);
+
+  uint32_t pos = 0;
+  uint32_t begin = 0;
+  for (auto start = break_iterator.first(), end = break_iterator.next();
+       icu::BreakIterator::DONE != end;
+       start = end, end = break_iterator.next()) {
+    if (UWordBreak::UBRK_WORD_NONE == break_iterator.getRuleStatus()) {
+      continue;
+    }
+
+    // UTF-16 offsets are equal to byte offsets for ASCII
+    if (!next_ascii_word(classes, probe, pos, begin) ||
+        begin != static_cast<uint32_t>(start) ||
+        pos != static_cast<uint32_t>(end)) {
+      return false;
+    }
+  }
+
+  return !next_ascii_word(classes, probe, pos, begin);
+}
+
+// Returns ASCII word break properties reproducing ICU word boundaries for
+// a locale of 'break_iterator', or nullptr.
+const analysis::AsciiWordClasses* get_ascii_words(
+  const icu::Locale& locale, icu::BreakIterator& break_iterator) {
+  static absl::flat_hash_map<std::string, const analysis::AsciiWordClasses*>
+    cache;
+  static std::mutex cache_mutex;
+
+  std::lock_guard lock{cache_mutex};
+  auto [it, inserted] = cache.try_emplace(locale.getName(), nullptr);
+  if (inserted) {
+    for (const auto* classes : {&kAsciiWords, &kAsciiWordsColon}) {
+      if (match_icu_words(break_iterator, *classes)) {
+        it->second = classes;
+        break;
+      }
+    }
+  }
+  return it->second;
+}
+
+char convert_ascii_case(char c,
+                        analysis::text_token_stream::case_convert_t convert) {
+  switch (convert) {
+    case analysis::text_token_stream::LOWER:
+      return 'A' <= c && c <= 'Z' ? c + ('a' - 'A') : c;
+    case analysis::text_token_stream::UPPER:
+      return 'a' <= c && c <= 'z' ? c - ('a' - 'A') : c;
+    case analysis::text_token_stream::NONE:
+      return c;
+  }
+  return c;
+}
+
+// Filters out stopwords and stems the UTF-8 token stored in 'state.tmp_buf'.
+bool process_utf8_term(analysis::text_token_stream::state_t& state) {
+  const std::string& word_utf8 = state.tmp_buf;
+
+  // skip ignored tokens
+  if (state.stopwords->Contains(word_utf8)) {
+    return false;
+  }
+
+  // find the token stem
+  if (state.stemmer) {
+    static_assert(sizeof(sb_symbol) == sizeof(char));
+    const sb_symbol* value =
+      reinterpret_cast<const sb_symbol*>(word_utf8.c_str());
+
+    value = sb_stemmer_stem(state.stemmer.get(), value,
+                            static_cast<int>(word_utf8.size()));
+
+    if (value) {
+      static_assert(sizeof(byte_type) == sizeof(sb_symbol));
+      state.term = bytes_view(reinterpret_cast<const byte_type*>(value),
+                              sb_stemmer_length(state.stemmer.get()));
+
+      return true;
+    }
+  }
+
+  // use the value of the unstemmed token
+  static_assert(sizeof(byte_type) == sizeof(char));
+  state.term_buf.assign(reinterpret_cast<const byte_type*>(word_utf8.c_str()),
+                        word_utf8.size());
+  state.term = state.term_buf;
+
+  return true;
+}
+
+// Converts ASCII token bypassing ICU, normalization and accent removal
+// are no-op for ASCII.
+bool process_ascii_term(analysis::text_token_stream::state_t& state,
+                        std::string_view data) {
+  auto& word_utf8 = state.tmp_buf;
+  word_utf8.resize(data.size());
+  std::transform(data.begin(), data.end(), word_utf8.begin(),
+                 [convert = state.options.case_convert](char c) {
+                   return convert_ascii_case(c, convert);
+                 });
+  return process_utf8_term(state);
+}
+
 bool process_term(analysis::text_token_stream::state_t& state,
                   icu::UnicodeString&& data) {
+  if (state.ascii_case) {
+    const auto* begin = data.getBuffer();
+    const auto* end = begin + data.length();
+    if (std::all_of(begin, end, [](char16_t c) { return c < 0x80; })) {
+      auto& word_utf8 = state.tmp_buf;
+      word_utf8.resize(data.length());
+      std::transform(begin, end, word_utf8.begin(),
+                     [convert = state.options.case_convert](char16_t c) {
+                       return convert_ascii_case(static_cast<char>(c),
+                                                 convert);
+                     });
+      return process_utf8_term(state);
+    }
+  }
+
   // normalize unicode
   auto err =
     UErrorCode::U_ZERO_ERROR;  // a value that passes the U_SUCCESS() test
@@ -388,36 +651,32 @@ bool process_term(analysis::text_token_stream::state_t& state,
   word_utf8.clear();
   state.token.toUTF8String(word_utf8);
 
-  // skip ignored tokens
-  if (state.stopwords.contains(word_utf8)) {
-    return false;
-  }
-
-  // find the token stem
-  if (state.stemmer) {
-    static_assert(sizeof(sb_symbol) == sizeof(char));
-    const sb_symbol* value =
-      reinterpret_cast<const sb_symbol*>(word_utf8.c_str());
+  return process_utf8_term(state);
+}
 
-    value = sb_stemmer_stem(state.stemmer.get(), value,
-                            static_cast<int>(word_utf8.size()));
+// Analyzes a token by 'analyze' unless the result for the raw 'token' is
+// already cached.
+template<typename Analyze>
+bool process_cached_term(analysis::text_token_stream::state_t& state,
+                         std::string_view token, Analyze&& analyze) {
+  auto& cache = state.cache;
 
-    if (value) {
-      static_assert(sizeof(byte_type) == sizeof(sb_symbol));
-      state.term = bytes_view(reinterpret_cast<const byte_type*>(value),
-                              sb_stemmer_length(state.stemmer.get()));
+  if (!cache.enabled() || token.empty()) {
+    return analyze();
+  }
 
-      return true;
+  if (const auto* entry = cache.Find(ViewCast<byte_type>(token)); entry) {
+    if (entry->skip) {
+      return false;
     }
+    state.term = ViewCast<byte_type>(std::string_view{entry->term});
+    return true;
   }
 
-  // use the value of the unstemmed token
-  static_assert(sizeof(byte_type) == sizeof(char));
-  state.term_buf.assign(reinterpret_cast<const byte_type*>(word_utf8.c_str()),
-                        word_utf8.size());
-  state.term = state.term_buf;
-
-  return true;
+  const bool accepted = analyze();
+  cache.Emplace(ViewCast<byte_type>(token),
+                accepted ? state.term : bytes_view{}, !accepted);
+  return accepted;
 }
 
 constexpr std::string_view LOCALE_PARAM_NAME{"locale"};
@@ -430,6 +689,8 @@ constexpr std::string_view EDGE_NGRAM_PARAM_NAME{"edgeNgram"};
 constexpr std::string_view MIN_PARAM_NAME{"min"};
 constexpr std::string_view MAX_PARAM_NAME{"max"};
 constexpr std::string_view PRESERVE_ORIGINAL_PARAM_NAME{"preserveOriginal"};
+constexpr std::string_view SHINGLES_PARAM_NAME{"shingles"};
+constexpr std::string_view CACHE_SIZE_PARAM_NAME{"cacheSize"};
 
 constexpr frozen::unordered_map<std::string_view,
                                 analysis::text_token_stream::case_convert_t, 3>
@@ -503,6 +764,16 @@ bool init_from_options(const analysis::text_token_stream::options_t& options,
     return false;
   }
 
+  // case conversion of ASCII letters is locale specific in Turkic languages
+  const std::string_view language{options.locale.getLanguage()};
+  objects->ascii_case =
+    options.case_convert == analysis::text_token_stream::NONE ||
+    (language != "tr" && language != "az");
+  if (objects->ascii_case) {
+    objects->ascii_words =
+      get_ascii_words(options.locale, *objects->break_iterator);
+  }
+
   // optional since not available for all locales
   if (options.stemming) {
     // reusable object owned by *this
@@ -677,11 +948,49 @@ bool parse_vpack_options(const VPackSlice slice,
         options.preserve_original_set = true;
       }
 
-      if (options.min_gram_set && options.max_gram_set) {
-        return options.min_gram <= options.max_gram;
+      if (options.min_gram_set && options.max_gram_set &&
+          options.min_gram > options.max_gram) {
+        return false;
       }
     }
 
+    if (auto shingles_slice = slice.get(SHINGLES_PARAM_NAME);
+        !shingles_slice.isNone()) {
+      if (!shingles_slice.isBool()) {
+        IRS_LOG_WARN(absl::StrCat(
+          "Non-boolean value in '", SHINGLES_PARAM_NAME,
+          "' while constructing text_token_stream from VPack arguments"));
+
+        return false;
+      }
+
+      options.shingles = shingles_slice.getBool();
+
+      if (options.shingles && (options.min_gram_set || options.max_gram_set ||
+                               options.preserve_original_set)) {
+        IRS_LOG_WARN(absl::StrCat(
+          "'", SHINGLES_PARAM_NAME, "' can't be used together with '",
+          EDGE_NGRAM_PARAM_NAME,
+          "' while constructing text_token_stream from VPack arguments"));
+
+        return false;
+      }
+    }
+
+    if (auto cache_slice = slice.get(CACHE_SIZE_PARAM_NAME);
+        !cache_slice.isNone()) {
+      if (!cache_slice.isNumber<decltype(options.cache_size)>()) {
+        IRS_LOG_WARN(absl::StrCat(
+          "Non-numeric value in '", CACHE_SIZE_PARAM_NAME,
+          "' while constructing text_token_stream from VPack arguments"));
+
+        return false;
+      }
+
+      options.cache_size =
+        cache_slice.getNumber<decltype(options.cache_size)>();
+    }
+
     analysis::icu_objects obj;
     init_from_options(options, &obj, true);
 
@@ -764,6 +1073,17 @@ bool make_vpack_config(const analysis::text_token_stream::options_t& options,
       builder->add(STOPWORDS_PATH_PARAM_NAME,
                    VPackValue(options.stopwordsPath));
     }
+
+    // shingles
+    if (options.shingles) {
+      builder->add(SHINGLES_PARAM_NAME, VPackValue(options.shingles));
+    }
+
+    // cache size
+    if (options.cache_size) {
+      builder->add(CACHE_SIZE_PARAM_NAME,
+                   VPackValue(static_cast<uint64_t>(options.cache_size)));
+    }
   }
 
   // ensure disambiguating casts below are safe. Casts required for clang
@@ -808,6 +1128,8 @@ bool make_vpack_config(const analysis::text_token_stream::options_t& options,
 ///        "min" (number): minimum ngram size
 ///        "max" (number): maximum ngram size
 ///        "preserveOriginal" (boolean): preserve or not the original term
+///        "shingles" (boolean): emit pairs of adjacent words as tokens
+///        "cacheSize" (number): max number of cached analysis results
 ///  if none of stopwords and stopwordsPath specified, stopwords are loaded from
 ///  default location
 ////////////////////////////////////////////////////////////////////////////////
@@ -961,7 +1283,13 @@ const char* text_token_stream::STOPWORD_PATH_ENV_VARIABLE =
 
 text_token_stream::text_token_stream(const options_t& options,
                                      const stopwords_t& stopwords)
-  : state_{new state_t{options, stopwords}} {}
+  : text_token_stream{options, Stopwords::Make(stopwords)} {}
+
+text_token_stream::text_token_stream(const options_t& options,
+                                     Stopwords::ptr stopwords)
+  : state_{new state_t{options, std::move(stopwords)}} {
+  IRS_ASSERT(state_->stopwords);
+}
 
 void text_token_stream::init() {
   REGISTER_ANALYZER_VPACK(analysis::text_token_stream, make_vpack,
@@ -1000,16 +1328,49 @@ bool text_token_stream::reset(std::string_view data) {
     return false;
   }
 
-  state_->data = icu::UnicodeString::fromUTF8(
-    icu::StringPiece{data.data(), static_cast<int32_t>(data.size())});
+  // ASCII input is tokenised without ICU
+  state_->ascii =
+    state_->ascii_words &&
+    simd::all_ascii(reinterpret_cast<const byte_type*>(data.data()),
+                    data.size());
+
+  state_->input = data;
+
+  if (state_->ascii) {
+    state_->ascii_pos = 0;
+  } else {
+    // UTF-16 data never takes more code units than UTF-8 input takes bytes
+    const auto capacity = std::max(static_cast<int32_t>(data.size()), 1);
+    auto* buf = state_->data.getBuffer(capacity);
+    if (!buf) {
+      return false;
+    }
+    int32_t length = 0;
+    int32_t substitutions = 0;
+    auto status = U_ZERO_ERROR;
+    u_strFromUTF8WithSub(buf, capacity, &length, data.data(),
+                         static_cast<int32_t>(data.size()), 0xFFFD,
+                         &substitutions, &status);
+    state_->data.releaseBuffer(U_SUCCESS(status) ? length : 0);
+    if (!U_SUCCESS(status)) {
+      return false;
+    }
+
+    // invalid sequences are replaced, raw tokens can't be cache keys
+    state_->valid_utf8 = 0 == substitutions;
 
-  // tokenise the unicode data
-  state_->break_iterator->setText(state_->data);
+    // tokenise the unicode data
+    state_->break_iterator->setText(state_->data);
+  }
 
   // reset term state for ngrams
   state_->term = {};
+  state_->prev_term.clear();
+  state_->prev_start = 0;
   state_->start = 0;
   state_->end = 0;
+  state_->has_prev_term = false;
+  state_->word_pending = false;
   state_->set_ngram_finished();
   std::get<increment>(attrs_).value = 1;
 
@@ -1028,6 +1389,8 @@ bool text_token_stream::next() {
         return true;
       }
     }
+  } else if (state_->options.shingles) {
+    return next_shingle();
   } else if (next_word()) {
     std::get<term_attribute>(attrs_).value = state_->term;
 
@@ -1041,16 +1404,85 @@ bool text_token_stream::next() {
   return false;
 }
 
+void text_token_stream::analyze(std::span<const std::string_view> values,
+                                TokenBatch& batch) {
+  if (state_->is_search_ngram() || state_->options.shingles) {
+    AnalyzeValues(*this, values, batch);
+    return;
+  }
+
+  // words go straight to the batch bypassing attributes
+  const auto& inc = std::get<increment>(attrs_);
+  batch.reset(true);
+  for (const auto value : values) {
+    const bool valid = reset(value);
+    batch.add_value(valid);
+    if (!valid) {
+      continue;
+    }
+    while (next_word()) {
+      batch.add_token(state_->term, inc.value, state_->start, state_->end);
+    }
+  }
+}
+
+bool text_token_stream::next_shingle() {
+  auto& inc = std::get<increment>(attrs_);
+  auto& offset = std::get<irs::offset>(attrs_);
+  auto& derived = std::get<derived_token>(attrs_);
+
+  if (state_->word_pending) {
+    // emit the current word after its shingle
+    state_->word_pending = false;
+    std::get<term_attribute>(attrs_).value = state_->term;
+    inc.value = 1;
+    offset.start = state_->start;
+    offset.end = state_->end;
+    derived.value = false;
+    return true;
+  }
+
+  if (!next_word()) {
+    return false;
+  }
+
+  if (state_->has_prev_term) {
+    // emit shingle at the position of the previous word, hence start
+    // offsets of tokens never decrease
+    MakeShingle(term_buf_, state_->prev_term, state_->term);
+    std::get<term_attribute>(attrs_).value = term_buf_;
+    inc.value = 0;
+    offset.start = state_->prev_start;
+    offset.end = state_->end;
+    derived.value = true;
+    state_->word_pending = true;
+  } else {
+    // first word, nothing to pair with yet
+    std::get<term_attribute>(attrs_).value = state_->term;
+    inc.value = 1;
+    offset.start = state_->start;
+    offset.end = state_->end;
+    derived.value = false;
+    state_->has_prev_term = true;
+  }
+
+  state_->prev_term = state_->term;
+  state_->prev_start = state_->start;
+  return true;
+}
+
 bool text_token_stream::next_word() {
+  if (state_->ascii) {
+    return next_ascii_word();
+  }
+
   // find boundaries of the next word
   for (auto start = state_->break_iterator->current(), prev_end = start,
             end = state_->break_iterator->next();
        icu::BreakIterator::DONE != end;
        start = end, end = state_->break_iterator->next()) {
-    // skip whitespace and unsuccessful terms
-    if (UWordBreak::UBRK_WORD_NONE == state_->break_iterator->getRuleStatus() ||
-        !process_term(*state_,
-                      state_->data.tempSubString(start, end - start))) {
+    // skip whitespace
+    if (UWordBreak::UBRK_WORD_NONE == state_->break_iterator->getRuleStatus()) {
       continue;
     }
 
@@ -1070,8 +1502,24 @@ bool text_token_stream::next_word() {
       return length;
     };
 
-    state_->start = state_->end + utf8_length(prev_end, start);
-    state_->end = state_->start + utf8_length(start, end);
+    const auto token_start = state_->end + utf8_length(prev_end, start);
+    const auto token_end = token_start + utf8_length(start, end);
+
+    // skip unsuccessful terms
+    if (!process_cached_term(
+          *state_,
+          state_->valid_utf8 && token_end <= state_->input.size()
+            ? state_->input.substr(token_start, token_end - token_start)
+            : std::string_view{},
+          [&] {
+            return process_term(*state_,
+                                state_->data.tempSubString(start, end - start));
+          })) {
+      continue;
+    }
+
+    state_->start = token_start;
+    state_->end = token_end;
 
     return true;
   }
@@ -1079,6 +1527,30 @@ bool text_token_stream::next_word() {
   return false;
 }
 
+const TermCache::Stats& text_token_stream::cache_stats() const noexcept {
+  return state_->cache.stats();
+}
+
+bool text_token_stream::next_ascii_word() {
+  IRS_ASSERT(state_->ascii_words);
+  const auto data = state_->input;
+  uint32_t begin = 0;
+
+  while (::next_ascii_word(*state_->ascii_words, data, state_->ascii_pos,
+                           begin)) {
+    const auto token = data.substr(begin, state_->ascii_pos - begin);
+    if (process_cached_term(*state_, token, [&] {
+          return process_ascii_term(*state_, token);
+        })) {
+      state_->start = begin;
+      state_->end = state_->ascii_pos;
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool text_token_stream::next_ngram() {
   auto begin = state_->term.data();
   auto end = state_->term.data() + state_->term.size();
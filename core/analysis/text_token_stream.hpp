@@ -29,6 +29,8 @@
 
 #include "analyzers.hpp"
 #include "shared.hpp"
+#include "stopwords.hpp"
+#include "term_cache.hpp"
 #include "token_attributes.hpp"
 #include "token_stream.hpp"
 #include "utils/attribute_helper.hpp"
@@ -45,7 +47,7 @@ namespace analysis {
 class text_token_stream final : public TypedAnalyzer<text_token_stream>,
                                 private util::noncopyable {
  public:
-  using stopwords_t = absl::flat_hash_set<std::string>;
+  using stopwords_t = Stopwords::words_t;
 
   enum case_convert_t { LOWER, NONE, UPPER };
 
@@ -74,6 +76,11 @@ class text_token_stream final : public TypedAnalyzer<text_token_stream>,
     // needed for mark empty preserve_original as valid and prevent loading from
     // defaults
     bool preserve_original_set{};
+    // additionally emit each pair of adjacent words as a single token,
+    // see shingle.hpp, not applicable together with edge ngrams
+    bool shingles{};
+    // max number of cached analysis results of raw tokens, 0 disables cache
+    size_t cache_size{};
 
     options_t() : locale{"C"} { locale.setToBogus(); }
   };
@@ -88,21 +95,30 @@ class text_token_stream final : public TypedAnalyzer<text_token_stream>,
   static void clear_cache();
 
   text_token_stream(const options_t& options, const stopwords_t& stopwords);
+  text_token_stream(const options_t& options, Stopwords::ptr stopwords);
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
     return irs::get_mutable(attrs_, type);
   }
   bool next() final;
   bool reset(std::string_view data) final;
+  void analyze(std::span<const std::string_view> values,
+               TokenBatch& batch) final;
+
+  // Returns hit/miss counters of the analysis results cache.
+  const TermCache::Stats& cache_stats() const noexcept;
 
  private:
-  using attributes = std::tuple<increment, offset, term_attribute>;
+  using attributes =
+    std::tuple<increment, offset, term_attribute, derived_token>;
 
   struct state_deleter_t {
     void operator()(state_t*) const noexcept;
   };
 
   bool next_word();
+  bool next_ascii_word();
   bool next_ngram();
+  bool next_shingle();
 
   bstring term_buf_;  // buffer for value if value cannot be referenced directly
   attributes attrs_;
@@ -53,6 +53,17 @@ struct increment final : attribute {
   uint32_t value{1};
 };
 
+// Denotes a token derived from other tokens of a stream, e.g. a shingle.
+// Derived tokens are indexed but don't contribute to a field length, hence
+// norms of a field are the same as without them.
+struct derived_token final : attribute {
+  static constexpr std::string_view type_name() noexcept {
+    return "derived_token";
+  }
+
+  bool value{false};
+};
+
 // Represents term value in a stream
 struct term_attribute final : attribute {
   static constexpr std::string_view type_name() noexcept {
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "analysis/analyzer.hpp"
+#include "analysis/token_attributes.hpp"
+#include "utils/string.hpp"
+
+namespace irs::analysis {
+
+// Tokens of many values analyzed at once, stored in packed arrays: terms of
+// all tokens share a single buffer, tokens of all values share a single
+// array. Payloads aren't preserved.
+class TokenBatch {
+ public:
+  struct Token {
+    size_t term_begin;
+    uint32_t term_size : 31;
+    uint32_t derived : 1;  // see derived_token
+    uint32_t increment;
+    uint32_t start;
+    uint32_t end;
+  };
+
+  // Removes all values keeping allocated memory, 'offsets' denotes whether
+  // tokens carry offsets.
+  void reset(bool offsets) noexcept {
+    terms_.clear();
+    tokens_.clear();
+    values_.clear();
+    offsets_ = offsets;
+  }
+
+  // Starts tokens of a next value, 'valid' is false if a value can't be
+  // analyzed, i.e. analyzer::reset(...) fails.
+  void add_value(bool valid) {
+    values_.emplace_back(
+      Value{.begin = tokens_.size(), .end = tokens_.size(), .valid = valid});
+  }
+
+  void add_token(bytes_view term, uint32_t increment, uint32_t start,
+                 uint32_t end, bool derived = false) {
+    IRS_ASSERT(!values_.empty() && values_.back().valid);
+    IRS_ASSERT(term.size() <= std::numeric_limits<int32_t>::max());
+    tokens_.emplace_back(Token{.term_begin = terms_.size(),
+                               .term_size = static_cast<uint32_t>(term.size()),
+                               .derived = derived,
+                               .increment = increment,
+                               .start = start,
+                               .end = end});
+    terms_.append(term);
+    ++values_.back().end;
+  }
+
+  // Returns number of values.
+  size_t size() const noexcept { return values_.size(); }
+  bool empty() const noexcept { return values_.empty(); }
+  bool offsets() const noexcept { return offsets_; }
+
+  bool valid(size_t value) const noexcept {
+    IRS_ASSERT(value < values_.size());
+    return values_[value].valid;
+  }
+
+  // Returns index of the first token of the specified value in tokens().
+  size_t first(size_t value) const noexcept {
+    IRS_ASSERT(value < values_.size());
+    return values_[value].begin;
+  }
+
+  std::span<const Token> tokens() const noexcept { return tokens_; }
+
+  std::span<const Token> tokens(size_t value) const noexcept {
+    IRS_ASSERT(value < values_.size());
+    const auto& v = values_[value];
+    return {tokens_.data() + v.begin, tokens_.data() + v.end};
+  }
+
+  bytes_view term(const Token& token) const noexcept {
+    IRS_ASSERT(token.term_begin + token.term_size <= terms_.size());
+    return {terms_.data() + token.term_begin, token.term_size};
+  }
+
+ private:
+  struct Value {
+    size_t begin;
+    size_t end;
+    bool valid;
+  };
+
+  bstring terms_;
+  std::vector<Token> tokens_;
+  std::vector<Value> values_;
+  bool offsets_{};
+};
+
+// Tokens of a value of a batch. Fields providing get_batch_tokens() instead
+// of get_tokens() are inverted by segment_writer straight from a batch.
+struct BatchTokens {
+  const TokenBatch* batch;
+  size_t value;
+};
+
+// Analyzes 'values' one by one reading attributes of 'stream' once per batch.
+// Being called with a final 'Impl' makes reset(...) and next() calls direct.
+template<typename Impl>
+void AnalyzeValues(Impl& stream, std::span<const std::string_view> values,
+                   TokenBatch& batch) {
+  const auto* term = irs::get<term_attribute>(stream);
+  const auto* inc = irs::get<increment>(stream);
+  const auto* offs = irs::get<offset>(stream);
+  const auto* derived = irs::get<derived_token>(stream);
+
+  batch.reset(offs != nullptr);
+  for (const auto value : values) {
+    // tokens without a term or an increment can't be indexed
+    const bool valid = term && inc && stream.reset(value);
+    batch.add_value(valid);
+    if (!valid) {
+      continue;
+    }
+    while (stream.next()) {
+      batch.add_token(term->value, inc->value, offs ? offs->start : 0,
+                      offs ? offs->end : 0, derived && derived->value);
+    }
+  }
+}
+
+}  // namespace irs::analysis
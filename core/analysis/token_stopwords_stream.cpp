@@ -120,8 +120,7 @@ irs::analysis::analyzer::ptr construct(const VPackArrayIterator& mask,
       return nullptr;  // hex-decoding failed
     }
   }
-  return std::make_unique<irs::analysis::token_stopwords_stream>(
-    std::move(tokens));
+  return std::make_unique<irs::analysis::token_stopwords_stream>(tokens);
 }
 
 constexpr std::string_view STOPWORDS_PARAM_NAME{"stopwords"};
@@ -280,8 +279,14 @@ namespace irs {
 namespace analysis {
 
 token_stopwords_stream::token_stopwords_stream(
-  token_stopwords_stream::stopwords_set&& stopwords)
-  : stopwords_(std::move(stopwords)), term_eof_(true) {}
+  const token_stopwords_stream::stopwords_set& stopwords)
+  : token_stopwords_stream(Stopwords::Make(stopwords)) {}
+
+token_stopwords_stream::token_stopwords_stream(
+  Stopwords::ptr stopwords) noexcept
+  : stopwords_(std::move(stopwords)), term_eof_(true) {
+  IRS_ASSERT(stopwords_);
+}
 
 void token_stopwords_stream::init() {
   REGISTER_ANALYZER_VPACK(irs::analysis::token_stopwords_stream, make_vpack,
@@ -306,7 +311,7 @@ bool token_stopwords_stream::reset(std::string_view data) {
   offset.end = uint32_t(data.size());
   auto& term = std::get<term_attribute>(attrs_);
   term.value = irs::ViewCast<irs::byte_type>(data);
-  term_eof_ = stopwords_.contains(data);
+  term_eof_ = stopwords_->Contains(data);
   return true;
 }
 
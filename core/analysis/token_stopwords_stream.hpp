@@ -24,6 +24,7 @@
 #pragma once
 
 #include "analyzers.hpp"
+#include "stopwords.hpp"
 #include "token_attributes.hpp"
 #include "utils/attribute_helper.hpp"
 #include "utils/hash_utils.hpp"
@@ -39,13 +40,14 @@ class token_stopwords_stream final
   : public TypedAnalyzer<token_stopwords_stream>,
     private util::noncopyable {
  public:
-  using stopwords_set = absl::flat_hash_set<std::string>;
+  using stopwords_set = Stopwords::words_t;
 
   static constexpr std::string_view type_name() noexcept { return "stopwords"; }
 
   static void init();  // for trigering registration in a static build
 
-  explicit token_stopwords_stream(stopwords_set&& mask);
+  explicit token_stopwords_stream(const stopwords_set& mask);
+  explicit token_stopwords_stream(Stopwords::ptr mask) noexcept;
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
     return irs::get_mutable(attrs_, type);
   }
@@ -57,7 +59,7 @@ class token_stopwords_stream final
     std::tuple<increment, offset,
                term_attribute>;  // token value with evaluated quotes
 
-  stopwords_set stopwords_;
+  Stopwords::ptr stopwords_;  // shared with instances having the same mask
   attributes attrs_;
   bool term_eof_;
 };
@@ -80,6 +80,7 @@ struct SegmentWriterOptions {
   ScorersView scorers;
   const Comparer* const comparator{};
   IResourceManager& resource_manager{IResourceManager::kNoop};
+  const TermsInfoProvider* terms_info{};
 };
 
 // Represents metadata associated with the term
@@ -464,12 +465,18 @@ struct flush_state {
   const size_t doc_count;
   // Accumulated segment index features
   IndexFeatures index_features{IndexFeatures::NONE};
+  // Provides term dictionary options of a field
+  const TermsInfoProvider* terms_info{};
 };
 
 struct ReaderState {
   const directory* dir;
   const SegmentMeta* meta;
   ScorersView scorers;
+  // Optional cache of decoded blocks
+  std::shared_ptr<BlockCache> block_cache;
+  // Load term index of a field on first access
+  bool lazy_term_index{false};
 };
 
 namespace formats {
@@ -40,6 +40,7 @@ extern "C" {
 #include "index/index_meta.hpp"
 #include "index/index_reader.hpp"
 #include "search/cost.hpp"
+#include "search/doc_bitmap.hpp"
 #include "search/score.hpp"
 #include "shared.hpp"
 #include "skip_list.hpp"
@@ -48,6 +49,8 @@ extern "C" {
 #include "utils/attribute_helper.hpp"
 #include "utils/bit_utils.hpp"
 #include "utils/bitpack.hpp"
+#include "utils/block_cache.hpp"
+#include "utils/elias_fano.hpp"
 #include "utils/log.hpp"
 #include "utils/memory.hpp"
 #include "utils/timer_utils.hpp"
@@ -128,6 +131,81 @@ struct format_traits {
   IRS_FORCE_INLINE static void skip_block(index_input& in) {
     bitpack::skip_block32(in, block_size());
   }
+
+  IRS_FORCE_INLINE static void write_doc_block(index_output& out,
+                                               doc_id_t* docs, doc_id_t prev,
+                                               uint32_t* buf) {
+    simd::delta_encode<block_size(), false>(docs, prev);
+    write_block(out, docs, buf);
+  }
+
+  IRS_FORCE_INLINE static void read_doc_block(index_input& in, uint32_t* buf,
+                                              doc_id_t* docs) {
+    read_block(in, buf, docs);
+  }
+
+  IRS_FORCE_INLINE static void skip_doc_block(index_input& in) {
+    skip_block(in);
+  }
+
+  template<typename Word>
+  IRS_FORCE_INLINE static bool union_doc_block(index_input& in, uint32_t* buf,
+                                               doc_id_t* docs,
+                                               doc_id_t /*offset*/,
+                                               doc_id_t /*limit*/,
+                                               Word* /*set*/) {
+    read_doc_block(in, buf, docs);
+    return false;
+  }
+};
+
+// Stores document blocks as partitioned Elias-Fano sequences, every block of
+// 'block_size()' documents is a separate partition encoded relative to the
+// last document of the previous block. Frequencies, positions, payloads and
+// offsets are stored using 'Base' traits.
+template<typename Base>
+struct format_traits_pef : Base {
+  IRS_FORCE_INLINE static void write_doc_block(index_output& out,
+                                               doc_id_t* docs, doc_id_t prev,
+                                               uint32_t* /*buf*/) {
+    for (auto* doc = docs, *end = docs + Base::block_size(); doc != end;
+         ++doc) {
+      *doc -= prev;
+    }
+    elias_fano::write_block32<Base::block_size()>(out, docs);
+  }
+
+  IRS_FORCE_INLINE static void read_doc_block(index_input& in,
+                                              uint32_t* /*buf*/,
+                                              doc_id_t* docs) {
+    elias_fano::read_block32<Base::block_size()>(in, docs);
+    // doc iterators operate on deltas
+    for (auto i = Base::block_size() - 1; i; --i) {
+      docs[i] -= docs[i - 1];
+    }
+  }
+
+  IRS_FORCE_INLINE static void skip_doc_block(index_input& in) {
+    elias_fano::skip_block32<Base::block_size()>(in);
+  }
+
+  // Dense blocks stored as runs or bitmaps are ORed into 'set' directly,
+  // the last element of 'docs' then contains a distance between the last
+  // document of the previous block and the last document of this block.
+  template<typename Word>
+  IRS_FORCE_INLINE static bool union_doc_block(index_input& in,
+                                               uint32_t* /*buf*/,
+                                               doc_id_t* docs, doc_id_t offset,
+                                               doc_id_t limit, Word* set) {
+    if (elias_fano::union_block32<Base::block_size()>(in, docs, offset, limit,
+                                                      set)) {
+      return true;
+    }
+    for (auto i = Base::block_size() - 1; i; --i) {
+      docs[i] -= docs[i - 1];
+    }
+    return false;
+  }
 };
 
 template<typename T, typename M>
@@ -309,7 +387,14 @@ enum class PostingsFormat : int32_t {
   // store block max scores, sse used
   WAND_SSE,
 
-  MAX = WAND_SSE
+  // store block max scores, documents are stored as partitioned Elias-Fano
+  WAND_PEF,
+
+  // store block max scores, documents are stored as partitioned Elias-Fano,
+  // sse used
+  WAND_SSE_PEF,
+
+  MAX = WAND_SSE_PEF
 };
 
 // Assume that doc_count = 28, skip_n = skip_0 = 12
@@ -869,9 +954,8 @@ void postings_writer<FormatTraits>::BeginDocument() {
 
     if (doc_.full()) {
       // FIXME do aligned?
-      simd::delta_encode<FormatTraits::block_size(), false>(doc_.docs.data(),
-                                                            doc_.block_last);
-      FormatTraits::write_block(*doc_out_, doc_.docs.data(), buf_);
+      FormatTraits::write_doc_block(*doc_out_, doc_.docs.data(),
+                                    doc_.block_last, buf_);
       if (features_.HasFrequency()) {
         FormatTraits::write_block(*doc_out_, doc_.freqs.data(), buf_);
       }
@@ -1717,8 +1801,16 @@ template<typename IteratorTraits, typename FieldTraits>
 class doc_iterator_base : public irs::doc_iterator {
   static_assert((IteratorTraits::features() & FieldTraits::features()) ==
                 IteratorTraits::features());
+  static_assert(std::is_trivially_copyable_v<buffer_type<IteratorTraits>>);
+
+  void read_block();
+  void read_cached_block();
   void read_tail_block();
 
+ public:
+  // Sets an optional cache of decoded blocks
+  void cache(const BlockCache::File* cache) noexcept { cache_ = cache; }
+
  protected:
   // returns current position in the document block 'docs_'
   doc_id_t relative_pos() noexcept {
@@ -1734,19 +1826,51 @@ class doc_iterator_base : public irs::doc_iterator {
   uint32_t* freq_{};  // pointer into docs_ to the frequency attribute value for
                       // the current doc
   index_input::ptr doc_in_;
+  const BlockCache::File* cache_{};
   doc_id_t left_{};
 };
 
+template<typename IteratorTraits, typename FieldTraits>
+void doc_iterator_base<IteratorTraits, FieldTraits>::read_block() {
+  // read doc deltas
+  IteratorTraits::read_doc_block(*doc_in_, enc_buf_, buf_.docs);
+
+  if constexpr (IteratorTraits::frequency()) {
+    IteratorTraits::read_block(*doc_in_, enc_buf_, buf_.freqs);
+  } else if constexpr (FieldTraits::frequency()) {
+    IteratorTraits::skip_block(*doc_in_);
+  }
+}
+
+template<typename IteratorTraits, typename FieldTraits>
+void doc_iterator_base<IteratorTraits, FieldTraits>::read_cached_block() {
+  IRS_ASSERT(cache_);
+
+  // decoded doc deltas followed by frequencies if requested
+  auto* block = reinterpret_cast<byte_type*>(&buf_);
+  constexpr size_t kBlockSize = sizeof buf_;
+
+  const uint64_t offset = doc_in_->file_pointer();
+  uint64_t end{};
+  if (cache_->Visit(offset, [&](bytes_view cached, uint64_t cached_end) {
+        IRS_ASSERT(cached.size() == kBlockSize);
+        std::memcpy(block, cached.data(), kBlockSize);
+        end = cached_end;
+      })) {
+    doc_in_->seek(end);
+  } else {
+    read_block();
+    cache_->Put(offset, doc_in_->file_pointer(), {block, kBlockSize});
+  }
+}
+
 template<typename IteratorTraits, typename FieldTraits>
 void doc_iterator_base<IteratorTraits, FieldTraits>::refill() {
   if (IRS_LIKELY(left_ >= IteratorTraits::block_size())) {
-    // read doc deltas
-    IteratorTraits::read_block(*doc_in_, enc_buf_, buf_.docs);
-
-    if constexpr (IteratorTraits::frequency()) {
-      IteratorTraits::read_block(*doc_in_, enc_buf_, buf_.freqs);
-    } else if constexpr (FieldTraits::frequency()) {
-      IteratorTraits::skip_block(*doc_in_);
+    if (!cache_) {
+      read_block();
+    } else {
+      read_cached_block();
     }
 
     static_assert(std::size(decltype(buf_.docs){}) ==
@@ -2027,7 +2151,8 @@ class doc_iterator : public doc_iterator_base<IteratorTraits, FieldTraits> {
 
   doc_iterator(WandExtent extent)
     : skip_{IteratorTraits::block_size(), postings_writer_base::kSkipN,
-            ReadSkip{extent}} {
+            ReadSkip{extent}},
+      bitmap_{this, &FillBitmap} {
     IRS_ASSERT(
       std::all_of(std::begin(this->buf_.docs), std::end(this->buf_.docs),
                   [](doc_id_t doc) { return !doc_limits::valid(doc); }));
@@ -2047,7 +2172,7 @@ class doc_iterator : public doc_iterator_base<IteratorTraits, FieldTraits> {
     auto old_offset = std::numeric_limits<size_t>::max();
     if (meta.docs_count == FieldTraits::block_size()) {
       old_offset = this->doc_in_->file_pointer();
-      FieldTraits::skip_block(*this->doc_in_);
+      FieldTraits::skip_doc_block(*this->doc_in_);
       if constexpr (FieldTraits::frequency()) {
         FieldTraits::skip_block(*this->doc_in_);
       }
@@ -2070,6 +2195,11 @@ class doc_iterator : public doc_iterator_base<IteratorTraits, FieldTraits> {
 
  private:
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
+    if constexpr (!IteratorTraits::frequency()) {
+      if (irs::type<doc_bitmap>::id() == type) {
+        return &bitmap_;
+      }
+    }
     return irs::get_mutable(attrs_, type);
   }
 
@@ -2079,6 +2209,9 @@ class doc_iterator : public doc_iterator_base<IteratorTraits, FieldTraits> {
     return std::get<document>(attrs_).value;
   }
 
+  static bool FillBitmap(void* ctx, doc_id_t base, doc_id_t max,
+                         uint64_t* words);
+
 #if defined(_MSC_VER)
 #pragma warning(disable : 4706)
 #elif defined(__GNUC__)
@@ -2207,9 +2340,59 @@ class doc_iterator : public doc_iterator_base<IteratorTraits, FieldTraits> {
   uint64_t skip_offs_{};
   SkipReader<ReadSkip> skip_;
   Attributes attrs_;
+  doc_bitmap bitmap_;
   uint32_t docs_count_{};
 };
 
+template<typename IteratorTraits, typename FieldTraits, typename WandExtent>
+bool doc_iterator<IteratorTraits, FieldTraits, WandExtent>::FillBitmap(
+  void* ctx, doc_id_t base, doc_id_t max, uint64_t* words) {
+  constexpr auto kBits = bits_required<uint64_t>();
+
+  auto& self = *static_cast<doc_iterator*>(ctx);
+  auto& doc_value = std::get<document>(self.attrs_).value;
+  IRS_ASSERT(doc_limits::valid(doc_value) && !doc_limits::eof(doc_value));
+  IRS_ASSERT(base <= doc_value);
+
+  for (;;) {
+    if (doc_value >= max) {
+      return true;
+    }
+
+    const doc_id_t offset = doc_value - base;
+    irs::set_bit(words[offset / kBits], offset % kBits);
+
+    if (self.begin_ == std::end(self.buf_.docs)) {
+      if (IRS_UNLIKELY(!self.left_)) {
+        doc_value = doc_limits::eof();
+        return false;
+      }
+
+      if (self.left_ < IteratorTraits::block_size()) {
+        self.refill();  // tail block
+      } else {
+        // Dense blocks are ORed into the window without decoding
+        const bool unioned = IteratorTraits::union_doc_block(
+          *self.doc_in_, self.enc_buf_, self.buf_.docs, offset, max - base,
+          words);
+        if constexpr (FieldTraits::frequency()) {
+          IteratorTraits::skip_block(*self.doc_in_);
+        }
+        self.left_ -= IteratorTraits::block_size();
+
+        if (unioned) {
+          doc_value += self.buf_.docs[IteratorTraits::block_size() - 1];
+          continue;
+        }
+
+        self.begin_ = std::begin(self.buf_.docs);
+      }
+    }
+
+    doc_value += *self.begin_++;
+  }
+}
+
 template<typename IteratorTraits, typename FieldTraits, typename WandExtent>
 void doc_iterator<IteratorTraits, FieldTraits, WandExtent>::ReadSkip::Read(
   size_t level, index_input& in) {
@@ -3342,10 +3525,24 @@ class postings_reader_base : public irs::postings_reader {
   explicit postings_reader_base(size_t block_size) noexcept
     : block_size_{block_size} {}
 
+  template<typename IteratorTraits, typename FieldTraits>
+  void prepare_cache(doc_iterator_base<IteratorTraits, FieldTraits>& it) const
+    noexcept {
+    if constexpr (IteratorTraits::frequency()) {
+      it.cache(freqs_cache_ ? &freqs_cache_ : nullptr);
+    } else {
+      it.cache(docs_cache_ ? &docs_cache_ : nullptr);
+    }
+  }
+
   ScorersView scorers_;
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  // Cached blocks of decoded doc deltas
+  BlockCache::File docs_cache_;
+  // Cached blocks of decoded doc deltas followed by frequencies
+  BlockCache::File freqs_cache_;
   size_t block_size_;
 };
 
@@ -3416,6 +3613,14 @@ void postings_reader_base::prepare(index_input& in, const ReaderState& state,
 
   scorers_ =
     state.scorers.subspan(0, std::min(state.scorers.size(), kMaxScorers));
+
+  if (state.block_cache) {
+    irs::file_name(buf, state.meta->name, postings_writer_base::kDocExt);
+    docs_cache_ = BlockCache::File{
+      state.block_cache, BlockCache::MakeName(*state.dir, buf, "docs")};
+    freqs_cache_ = BlockCache::File{
+      state.block_cache, BlockCache::MakeName(*state.dir, buf, "freqs")};
+  }
 }
 
 size_t postings_reader_base::decode(const byte_type* in, IndexFeatures features,
@@ -3512,6 +3717,7 @@ class postings_reader final : public postings_reader_base {
             auto it = memory::make_managed<
               doc_iterator<IteratorTraits, FieldTraits, Extent>>(
               std::forward<Extent>(extent));
+            prepare_cache(*it);
             it->prepare(meta, doc_in_.get(), pos_in_.get(), pay_in_.get());
             return it;
           });
@@ -3580,6 +3786,7 @@ class postings_reader final : public postings_reader_base {
                       options.factory, scorer, extent, info.mapped_index,
                       ctx.strict);
 
+                    prepare_cache(*it);
                     it->WandPrepare(meta, doc_in_.get(), pos_in_.get(),
                                     pay_in_.get());
 
@@ -3589,6 +3796,7 @@ class postings_reader final : public postings_reader_base {
             }
             auto it = memory::make_managed<
               doc_iterator<IteratorTraits, FieldTraits, WandExtent>>(extent);
+            prepare_cache(*it);
             it->WandPrepare(meta, doc_in_.get(), pos_in_.get(), pay_in_.get(),
                             options.factory, scorer, info.mapped_index);
             return it;
@@ -3721,15 +3929,18 @@ void bit_union(index_input& doc_in, doc_id_t docs_count, uint32_t (&docs)[N],
 
   doc_id_t doc = doc_limits::min();
   while (num_blocks--) {
-    FieldTraits::read_block(doc_in, enc_buf, docs);
-    if constexpr (FieldTraits::frequency()) {
-      FieldTraits::skip_block(doc_in);
+    if (FieldTraits::union_doc_block(doc_in, enc_buf, docs, doc,
+                                     doc_limits::eof(), set)) {
+      doc += docs[FieldTraits::block_size() - 1];
+    } else {
+      for (const auto delta : docs) {
+        doc += delta;
+        irs::set_bit(set[doc / BITS], doc % BITS);
+      }
     }
 
-    // FIXME optimize
-    for (const auto delta : docs) {
-      doc += delta;
-      irs::set_bit(set[doc / BITS], doc % BITS);
+    if constexpr (FieldTraits::frequency()) {
+      FieldTraits::skip_block(doc_in);
     }
   }
 
@@ -4081,13 +4292,13 @@ class format15 : public format14 {
   static ptr make();
 
   irs::field_writer::ptr get_field_writer(bool consolidation,
-                                          IResourceManager& rm) const final;
+                                          IResourceManager& rm) const override;
 
-  irs::postings_writer::ptr get_postings_writer(bool consolidation,
-                                                IResourceManager&) const final;
-  irs::postings_reader::ptr get_postings_reader() const final;
+  irs::postings_writer::ptr get_postings_writer(
+    bool consolidation, IResourceManager&) const override;
+  irs::postings_reader::ptr get_postings_reader() const override;
 
-  irs::type_info::type_id type() const noexcept final {
+  irs::type_info::type_id type() const noexcept override {
     return irs::type<format15>::id();
   }
 };
@@ -4117,6 +4328,51 @@ irs::format::ptr format15::make() {
 
 REGISTER_FORMAT_MODULE(::format15, MODULE_NAME);
 
+class format15pef final : public format15 {
+ public:
+  using format_traits = ::format_traits_pef<format15::format_traits>;
+
+  static constexpr std::string_view type_name() noexcept { return "1_5pef"; }
+
+  static ptr make();
+
+  irs::field_writer::ptr get_field_writer(bool consolidation,
+                                          IResourceManager&) const final;
+
+  irs::postings_writer::ptr get_postings_writer(bool consolidation,
+                                                IResourceManager&) const final;
+  irs::postings_reader::ptr get_postings_reader() const final;
+
+  irs::type_info::type_id type() const noexcept final {
+    return irs::type<format15pef>::id();
+  }
+};
+
+static const ::format15pef FORMAT15PEF_INSTANCE;
+
+irs::field_writer::ptr format15pef::get_field_writer(bool consolidation,
+                                                   IResourceManager& rm) const {
+  return burst_trie::make_writer(burst_trie::Version::FST_STATES_SIZE,
+                                 get_postings_writer(consolidation, rm), rm,
+                                 consolidation);
+}
+
+irs::postings_writer::ptr format15pef::get_postings_writer(
+  bool consolidation, IResourceManager& rm) const {
+  return std::make_unique<::postings_writer<format_traits>>(
+    PostingsFormat::WAND_PEF, consolidation, rm);
+}
+
+irs::postings_reader::ptr format15pef::get_postings_reader() const {
+  return std::make_unique<::postings_reader<format_traits>>();
+}
+
+irs::format::ptr format15pef::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15PEF_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15pef, MODULE_NAME);
+
 #ifdef IRESEARCH_SSE2
 
 template<bool Wand, uint32_t PosMin>
@@ -4154,8 +4410,35 @@ struct format_traits_sse4 {
   IRS_FORCE_INLINE static void skip_block(index_input& in) {
     bitpack::skip_block32(in, block_size());
   }
+
+  IRS_FORCE_INLINE static void write_doc_block(index_output& out,
+                                               doc_id_t* docs, doc_id_t prev,
+                                               uint32_t* buf) {
+    simd::delta_encode<block_size(), false>(docs, prev);
+    write_block(out, docs, buf);
+  }
+
+  IRS_FORCE_INLINE static void read_doc_block(index_input& in, uint32_t* buf,
+                                              doc_id_t* docs) {
+    read_block(in, buf, docs);
+  }
+
+  IRS_FORCE_INLINE static void skip_doc_block(index_input& in) {
+    skip_block(in);
+  }
+
+  template<typename Word>
+  IRS_FORCE_INLINE static bool union_doc_block(index_input& in, uint32_t* buf,
+                                               doc_id_t* docs,
+                                               doc_id_t /*offset*/,
+                                               doc_id_t /*limit*/,
+                                               Word* /*set*/) {
+    read_doc_block(in, buf, docs);
+    return false;
+  }
 };
 
+
 class format12simd final : public format12 {
  public:
   using format_traits = format_traits_sse4<false, pos_limits::min()>;
@@ -4280,13 +4563,13 @@ class format15simd : public format14simd {
   static ptr make();
 
   irs::field_writer::ptr get_field_writer(bool consolidation,
-                                          IResourceManager&) const final;
+                                          IResourceManager&) const override;
 
-  irs::postings_writer::ptr get_postings_writer(bool consolidation,
-                                                IResourceManager&) const final;
-  irs::postings_reader::ptr get_postings_reader() const final;
+  irs::postings_writer::ptr get_postings_writer(
+    bool consolidation, IResourceManager&) const override;
+  irs::postings_reader::ptr get_postings_reader() const override;
 
-  irs::type_info::type_id type() const noexcept final {
+  irs::type_info::type_id type() const noexcept override {
     return irs::type<format15simd>::id();
   }
 };
@@ -4316,6 +4599,53 @@ irs::format::ptr format15simd::make() {
 
 REGISTER_FORMAT_MODULE(::format15simd, MODULE_NAME);
 
+class format15simdpef final : public format15simd {
+ public:
+  using format_traits = ::format_traits_pef<format15simd::format_traits>;
+
+  static constexpr std::string_view type_name() noexcept {
+    return "1_5simdpef";
+  }
+
+  static ptr make();
+
+  irs::field_writer::ptr get_field_writer(bool consolidation,
+                                          IResourceManager&) const final;
+
+  irs::postings_writer::ptr get_postings_writer(bool consolidation,
+                                                IResourceManager&) const final;
+  irs::postings_reader::ptr get_postings_reader() const final;
+
+  irs::type_info::type_id type() const noexcept final {
+    return irs::type<format15simdpef>::id();
+  }
+};
+
+static const ::format15simdpef FORMAT15SIMDPEF_INSTANCE;
+
+irs::field_writer::ptr format15simdpef::get_field_writer(
+  bool consolidation, IResourceManager& rm) const {
+  return burst_trie::make_writer(burst_trie::Version::FST_STATES_SIZE,
+                                 get_postings_writer(consolidation, rm), rm,
+                                 consolidation);
+}
+
+irs::postings_writer::ptr format15simdpef::get_postings_writer(
+  bool consolidation, IResourceManager& rm) const {
+  return std::make_unique<::postings_writer<format_traits>>(
+    PostingsFormat::WAND_SSE_PEF, consolidation, rm);
+}
+
+irs::postings_reader::ptr format15simdpef::get_postings_reader() const {
+  return std::make_unique<::postings_reader<format_traits>>();
+}
+
+irs::format::ptr format15simdpef::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15SIMDPEF_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15simdpef, MODULE_NAME);
+
 #endif  // IRESEARCH_SSE2
 
 }  // namespace
@@ -4330,11 +4660,13 @@ void init() {
   REGISTER_FORMAT(::format13);
   REGISTER_FORMAT(::format14);
   REGISTER_FORMAT(::format15);
+  REGISTER_FORMAT(::format15pef);
 #ifdef IRESEARCH_SSE2
   REGISTER_FORMAT(::format12simd);
   REGISTER_FORMAT(::format13simd);
   REGISTER_FORMAT(::format14simd);
   REGISTER_FORMAT(::format15simd);
+  REGISTER_FORMAT(::format15simdpef);
 #endif  // IRESEARCH_SSE2
 }
 
@@ -22,6 +22,7 @@
 
 #include "formats_burst_trie.hpp"
 
+#include <mutex>
 #include <variant>
 
 #include "utils/assert.hpp"
@@ -86,6 +87,7 @@
 #include "utils/timer_utils.hpp"
 #include "utils/bit_utils.hpp"
 #include "utils/bitset.hpp"
+#include "utils/block_cache.hpp"
 #include "utils/attribute_helper.hpp"
 #include "utils/string.hpp"
 #include "utils/log.hpp"
@@ -781,8 +783,7 @@ inline void prepare_output(std::string& str, index_output::ptr& out,
 inline int32_t prepare_input(std::string& str, index_input::ptr& in,
                              irs::IOAdvice advice, const ReaderState& state,
                              std::string_view ext, std::string_view format,
-                             const int32_t min_ver, const int32_t max_ver,
-                             int64_t* checksum = nullptr) {
+                             const int32_t min_ver, const int32_t max_ver) {
   IRS_ASSERT(!in);
 
   file_name(str, state.meta->name, ext);
@@ -792,10 +793,6 @@ inline int32_t prepare_input(std::string& str, index_input::ptr& in,
     throw io_error{absl::StrCat("Failed to open file, path: ", str)};
   }
 
-  if (checksum) {
-    *checksum = format_utils::checksum(*in);
-  }
-
   return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
@@ -953,6 +950,12 @@ class field_writer final : public irs::field_writer {
   static constexpr uint32_t DEFAULT_MIN_BLOCK_SIZE = 25;
   static constexpr uint32_t DEFAULT_MAX_BLOCK_SIZE = 48;
 
+  // Adaptive mode bounds for a number of entries in a block
+  static constexpr uint32_t kAdaptiveMinBlockSize = 8;
+  static constexpr uint32_t kAdaptiveMaxBlockSize = 128;
+  // Adaptive mode target for a number of suffix bytes per block
+  static constexpr size_t kAdaptiveScanBytes = 256;
+
   static constexpr std::string_view FORMAT_TERMS = "block_tree_terms_dict";
   static constexpr std::string_view TERMS_EXT = "tm";
   static constexpr std::string_view FORMAT_TERMS_INDEX =
@@ -999,6 +1002,12 @@ class field_writer final : public irs::field_writer {
 
   void Push(bytes_view term);
 
+  // Sets block size limits for a field with a specified name.
+  void SetupBlockSize(std::string_view name);
+
+  // Adjusts block size limits according to the suffix lengths seen so far.
+  void AdaptBlockSize(size_t suffix) noexcept;
+
   absl::flat_hash_map<irs::type_info::type_id, size_t> feature_map_;
   OutputBuffer output_buffer_;
   Blocks blocks_;
@@ -1014,9 +1023,15 @@ class field_writer final : public irs::field_writer {
   volatile_byte_ref last_term_;  // last pushed term
   std::vector<size_t> prefixes_;
   size_t fields_count_{};
+  const TermsInfoProvider* terms_info_{};
+  size_t suffix_bytes_{};  // total suffix length of a field terms
+  size_t suffix_count_{};  // number of a field terms
   const burst_trie::Version version_;
-  const uint32_t min_block_size_;
-  const uint32_t max_block_size_;
+  const uint32_t default_min_block_size_;
+  const uint32_t default_max_block_size_;
+  uint32_t min_block_size_;
+  uint32_t max_block_size_;
+  bool adaptive_{false};
   const bool consolidation_;
 };
 
@@ -1191,6 +1206,10 @@ void field_writer::Push(bytes_view term) {
     ++pos;
   }
 
+  if (adaptive_) {
+    AdaptBlockSize(term.size() - pos);
+  }
+
   for (size_t i = last.empty() ? 0 : last.size() - 1; i > pos;) {
     --i;  // should use it here as we use size_t
     const size_t top = stack_.size() - prefixes_[i];
@@ -1205,6 +1224,55 @@ void field_writer::Push(bytes_view term) {
   last_term_.assign(term, consolidation_);
 }
 
+void field_writer::SetupBlockSize(std::string_view name) {
+  min_block_size_ = default_min_block_size_;
+  max_block_size_ = default_max_block_size_;
+  adaptive_ = false;
+  suffix_bytes_ = 0;
+  suffix_count_ = 0;
+
+  if (!terms_info_ || !*terms_info_) {
+    return;
+  }
+
+  const auto info = (*terms_info_)(name);
+
+  if (info.adaptive) {
+    // block sizes are adjusted on the fly, see AdaptBlockSize
+    adaptive_ = true;
+    return;
+  }
+
+  if (info.min_block_size) {
+    min_block_size_ = std::max(info.min_block_size, 2U);
+  }
+  if (info.max_block_size) {
+    max_block_size_ = info.max_block_size;
+  }
+  // ensure blocks can always be split
+  max_block_size_ = std::max(max_block_size_, 2 * (min_block_size_ - 1));
+}
+
+void field_writer::AdaptBlockSize(size_t suffix) noexcept {
+  // Seeking a term costs an FST traversal followed by a linear scan of
+  // a block. The former grows with the number of blocks, while the latter
+  // grows with the number of suffix bytes in a block. Keep the number of
+  // suffix bytes per block roughly constant, i.e. use larger blocks for
+  // terms sharing long prefixes (e.g. numeric terms) and smaller blocks
+  // for terms with long distinct suffixes (e.g. UUIDs).
+  suffix_bytes_ += suffix;
+  ++suffix_count_;
+
+  const auto avg_suffix = std::max<size_t>(1, suffix_bytes_ / suffix_count_);
+  const auto size = static_cast<uint32_t>(
+    std::clamp(kAdaptiveScanBytes / avg_suffix, size_t{kAdaptiveMinBlockSize},
+               size_t{kAdaptiveMaxBlockSize}));
+
+  max_block_size_ = size;
+  min_block_size_ = size / 2 + 1;
+  IRS_ASSERT(2 * (min_block_size_ - 1) <= max_block_size_);
+}
+
 field_writer::field_writer(
   irs::postings_writer::ptr&& pw, bool consolidation, IResourceManager& rm,
   burst_trie::Version version /* = Format::MAX */,
@@ -1219,6 +1287,8 @@ field_writer::field_writer(
     fst_buf_(new fst_buffer(rm)),
     prefixes_(DEFAULT_SIZE, 0),
     version_(version),
+    default_min_block_size_(min_block_size),
+    default_max_block_size_(max_block_size),
     min_block_size_(min_block_size),
     max_block_size_(max_block_size),
     consolidation_(consolidation) {
@@ -1242,6 +1312,7 @@ void field_writer::prepare(const flush_state& state) {
   stats_.reset();
   suffix_.reset();
   fields_count_ = 0;
+  terms_info_ = state.terms_info;
 
   std::string filename;
   bstring enc_header;
@@ -1297,6 +1368,7 @@ void field_writer::write(const basic_term_reader& reader,
   const auto& reader_meta = reader.meta();
   const auto index_features = reader_meta.index_features;
   BeginField(index_features, features);
+  SetupBlockSize(reader_meta.name);
 
   uint64_t term_count = 0;
   uint64_t sum_dfreq = 0;
@@ -1415,7 +1487,9 @@ void field_writer::EndField(std::string_view name, IndexFeatures index_features,
   // write FST
   bool ok;
   if (version_ > burst_trie::Version::ENCRYPTION_MIN) {
-    ok = immutable_byte_fst::Write(fst, *index_out_, fst_stats);
+    ok = immutable_byte_fst::Write(
+      fst, *index_out_, fst_stats,
+      version_ >= burst_trie::Version::FST_STATES_SIZE);
   } else {
     // wrap stream to be OpenFST compliant
     output_buf isb(index_out_.get());
@@ -1473,9 +1547,16 @@ class term_reader_base : public irs::term_reader, private util::noncopyable {
 
   uint8_t WandCount() const noexcept { return wand_count_; }
 
+  // Returns cache of decoded term dictionary blocks if any
+  const BlockCache::File* TermsCache() const noexcept {
+    return terms_cache_ && *terms_cache_ ? terms_cache_ : nullptr;
+  }
+
  protected:
   uint8_t WandIndex(uint8_t i) const noexcept;
 
+  const BlockCache::File* terms_cache_{};
+
  private:
   field_meta field_;
   bstring min_term_;
@@ -1565,7 +1646,9 @@ class block_iterator : util::noncopyable {
     IRS_ASSERT(prefix <= std::numeric_limits<uint32_t>::max());
   }
 
-  void load(index_input& in, encryption::stream* cipher);
+  // Loads current block, decoded block is taken from 'cache' if possible
+  void load(index_input& in, encryption::stream* cipher,
+            const BlockCache::File* cache);
 
   template<bool ReadHeader>
   bool next_sub_block() noexcept {
@@ -1712,6 +1795,10 @@ class block_iterator : util::noncopyable {
     suffix_.assert_block_boundaries();
   }
 
+  void read(index_input& in, encryption::stream* cipher,
+            const BlockCache::File* cache);
+  bool read_cached(const BlockCache::File& cache);
+
   template<typename Reader>
   SeekResult scan_to_term_nonleaf(bytes_view term, Reader&& reader);
   template<typename Reader>
@@ -1763,19 +1850,35 @@ block_iterator::block_iterator(byte_weight&& header, size_t prefix) noexcept
   header_.assert_block_boundaries();
 }
 
-void block_iterator::load(index_input& in, irs::encryption::stream* cipher) {
+void block_iterator::load(index_input& in, irs::encryption::stream* cipher,
+                          const BlockCache::File* cache) {
   if (!dirty_) {
     return;
   }
 
+  if (!cache || !read_cached(*cache)) {
+    read(in, cipher, cache);
+  }
+
+  cur_ent_ = 0;
+  cur_block_start_ = UNDEFINED_ADDRESS;
+  term_count_ = 0;
+  cur_stats_ent_ = 0;
+  dirty_ = false;
+}
+
+void block_iterator::read(index_input& in, irs::encryption::stream* cipher,
+                          const BlockCache::File* cache) {
   in.seek(cur_start_);
-  if (shift_unpack_32(in.read_vint(), ent_count_)) {
-    sub_count_ = 0;  // no sub-blocks
+  const bool no_sub_blocks = shift_unpack_32(in.read_vint(), ent_count_);
+  if (no_sub_blocks) {
+    sub_count_ = 0;
   }
 
   // read suffix block
   uint64_t block_size;
   leaf_ = shift_unpack_64(in.read_vlong(), block_size);
+  const uint64_t suffix_size = block_size;
 
   // for non-encrypted index try direct buffer access first
   suffix_.begin =
@@ -1818,11 +1921,59 @@ void block_iterator::load(index_input& in, irs::encryption::stream* cipher) {
   stats_.assert_block_boundaries();
 
   cur_end_ = in.file_pointer();
-  cur_ent_ = 0;
-  cur_block_start_ = UNDEFINED_ADDRESS;
-  term_count_ = 0;
-  cur_stats_ent_ = 0;
-  dirty_ = false;
+
+  if (cache) {
+    // see read_cached(...) for the layout
+    bstring buf;
+    buf.reserve(suffix_size + block_size +
+                2 * bytes_io<uint64_t>::const_max_vsize +
+                bytes_io<uint32_t>::const_max_vsize + 1);
+    bytes_output out{buf};
+    out.write_vint(ent_count_);
+    out.write_byte(static_cast<byte_type>(uint32_t{no_sub_blocks} |
+                                          (uint32_t{leaf_} << 1)));
+    out.write_vlong(suffix_size);
+    out.write_bytes(suffix_.begin, suffix_size);
+    out.write_vlong(block_size);
+    out.write_bytes(stats_.begin, block_size);
+
+    cache->Put(cur_start_, cur_end_, buf);
+  }
+}
+
+// Cached block layout:
+//   ent_count: vint
+//   flags: byte (no sub-blocks, leaf)
+//   suffix block size: vlong
+//   decrypted suffix block
+//   stats block size: vlong
+//   stats block
+bool block_iterator::read_cached(const BlockCache::File& cache) {
+  return cache.Visit(cur_start_, [&](bytes_view block, uint64_t end) {
+    const auto* p = block.data();
+    ent_count_ = vread<uint32_t>(p);
+    const byte_type flags = *p++;
+    if (flags & 1) {
+      sub_count_ = 0;
+    }
+    leaf_ = (flags & 2) != 0;
+
+    auto read_block = [&p](data_block& out) {
+      const auto size = vread<uint64_t>(p);
+      out.block.assign(p, size);
+      out.begin = out.block.c_str();
+#ifdef IRESEARCH_DEBUG
+      out.end = out.begin + size;
+#endif
+      out.assert_block_boundaries();
+      p += size;
+    };
+
+    read_block(suffix_);
+    read_block(stats_);
+    IRS_ASSERT(p == block.data() + block.size());
+    cur_end_ = end;
+  });
 }
 
 template<typename Reader>
@@ -2163,6 +2314,10 @@ class term_iterator_base : public seek_term_iterator {
     return terms_cipher_;
   }
 
+  const BlockCache::File* terms_cache() const noexcept {
+    return field_->TermsCache();
+  }
+
  protected:
   using attributes =
     std::tuple<version10::term_meta, term_attribute, attribute_ptr<payload>>;
@@ -2329,7 +2484,7 @@ bool term_iterator<FST>::next() {
     if (value().empty()) {
       // iterator at the beginning
       cur_block_ = push_block(fst_->Final(fst_->Start()), 0);
-      cur_block_->load(terms_input(), terms_cipher());
+      cur_block_->load(terms_input(), terms_cipher(), terms_cache());
     } else {
       IRS_ASSERT(false);
       // FIXME(gnusi): consider removing this, as that seems to be impossible
@@ -2349,7 +2504,7 @@ bool term_iterator<FST>::next() {
   // pop finished blocks
   while (cur_block_->done()) {
     if (cur_block_->next_sub_block<false>()) {
-      cur_block_->load(terms_input(), terms_cipher());
+      cur_block_->load(terms_input(), terms_cipher(), terms_cache());
     } else if (&block_stack_.front() == cur_block_) {  // root
       reset_value();
       cur_block_->reset();
@@ -2364,7 +2519,7 @@ bool term_iterator<FST>::next() {
         IRS_ASSERT(cur_block_->prefix() < term_buf_.size());
         // to sub-block
         cur_block_->scan_to_sub_block(term_buf_[cur_block_->prefix()]);
-        cur_block_->load(terms_input(), terms_cipher());
+        cur_block_->load(terms_input(), terms_cipher(), terms_cache());
         cur_block_->scan_to_block(start);
       }
     }
@@ -2380,7 +2535,7 @@ bool term_iterator<FST>::next() {
   for (cur_block_->next(copy_suffix); EntryType::ET_BLOCK == cur_block_->type();
        cur_block_->next(copy_suffix)) {
     cur_block_ = push_block(cur_block_->block_start(), term_buf_.size());
-    cur_block_->load(terms_input(), terms_cipher());
+    cur_block_->load(terms_input(), terms_cipher(), terms_cache());
   }
 
   refresh_value();
@@ -2547,7 +2702,7 @@ SeekResult term_iterator<FST>::seek_equal(bytes_view term, bool exact) {
     std::memcpy(term_buf_.data() + prefix, suffix, suffix_size);
   };
 
-  cur_block_->load(terms_input(), terms_cipher());
+  cur_block_->load(terms_input(), terms_cipher(), terms_cache());
 
   Finally refresh_value = [this]() noexcept { this->refresh_value(); };
 
@@ -2569,7 +2724,7 @@ SeekResult term_iterator<FST>::seek_ge(bytes_view term) {
         case ET_BLOCK:
           // we're at the greater block, load it and call next
           cur_block_ = push_block(cur_block_->block_start(), term_buf_.size());
-          cur_block_->load(terms_input(), terms_cipher());
+          cur_block_->load(terms_input(), terms_cipher(), terms_cache());
           break;
         default:
           IRS_ASSERT(false);
@@ -2695,7 +2850,7 @@ bool single_term_iterator<FST>::seek(bytes_view term) {
     return false;
   }
 
-  cur_block.load(*terms_in_, cipher_);
+  cur_block.load(*terms_in_, cipher_, field_->TermsCache());
 
   if (SeekResult::FOUND == cur_block.scan_to_term(term, [](auto, auto) {})) {
     cur_block.load_data(field_->meta(), meta_, *postings_);
@@ -2888,7 +3043,7 @@ bool automaton_term_iterator<FST>::next() {
       const auto fst_start = fst.Start();
       cur_block_ = push_block(fst.Final(fst_start), *fst_, 0, 0,
                               acceptor_->Start(), fst_start);
-      cur_block_->load(terms_input(), terms_cipher());
+      cur_block_->load(terms_input(), terms_cipher(), terms_cache());
     } else {
       IRS_ASSERT(false);
       // FIXME(gnusi): consider removing this, as that seems to be impossible
@@ -3013,7 +3168,7 @@ bool automaton_term_iterator<FST>::next() {
           cur_block_->scan_to_sub_block(data.arcs->min);
         }
 
-        cur_block_->load(terms_input(), terms_cipher());
+        cur_block_->load(terms_input(), terms_cipher(), terms_cache());
       }
     }
 
@@ -3068,7 +3223,7 @@ bool automaton_term_iterator<FST>::next() {
           cur_block_->template next_sub_block<true>();
         }
 
-        cur_block_->load(terms_input(), terms_cipher());
+        cur_block_->load(terms_input(), terms_cipher(), terms_cache());
       } else if (&block_stack_.front() == cur_block_) {  // root
         reset_value();
         cur_block_->reset();
@@ -3082,7 +3237,7 @@ bool automaton_term_iterator<FST>::next() {
           IRS_ASSERT(cur_block_->prefix() < term_buf_.size());
           // to sub-block
           cur_block_->scan_to_sub_block(term_buf_[cur_block_->prefix()]);
-          cur_block_->load(terms_input(), terms_cipher());
+          cur_block_->load(terms_input(), terms_cipher(), terms_cache());
           cur_block_->scan_to_block(start);
         }
       }
@@ -3113,6 +3268,17 @@ bool automaton_term_iterator<FST>::next() {
 #pragma GCC diagnostic pop
 #endif
 
+// Returns true if data of a specified input is directly accessible
+bool HasDirectAccess(index_input& in) {
+  if (!in.length()) {
+    return false;
+  }
+  const auto pos = in.file_pointer();
+  const bool direct = in.read_buffer(0, 1, BufferHint::PERSISTENT) != nullptr;
+  in.seek(pos);
+  return direct;
+}
+
 class field_reader final : public irs::field_reader {
  public:
   explicit field_reader(irs::postings_reader::ptr&& pr, IResourceManager& rm);
@@ -3125,6 +3291,9 @@ class field_reader final : public irs::field_reader {
     if (terms_in_ != nullptr) {
       mapped += terms_in_->CountMappedMemory();
     }
+    if (index_in_ != nullptr) {
+      mapped += index_in_->CountMappedMemory();
+    }
     return mapped;
   }
 
@@ -3138,7 +3307,9 @@ class field_reader final : public irs::field_reader {
   template<typename FST>
   class term_reader final : public term_reader_base {
    public:
-    explicit term_reader(field_reader& owner) noexcept : owner_(&owner) {}
+    explicit term_reader(field_reader& owner) noexcept : owner_(&owner) {
+      terms_cache_ = &owner.terms_cache_;
+    }
     term_reader(term_reader&& rhs) = default;
     term_reader& operator=(term_reader&& rhs) = delete;
 
@@ -3146,6 +3317,19 @@ class field_reader final : public irs::field_reader {
                  const feature_map_t& features) final {
       term_reader_base::prepare(version, in, features);
 
+      if constexpr (std::is_same_v<FST, immutable_byte_fst>) {
+        if (owner_->index_in_) {
+          // defer reading FST until first access
+          fst_offset_ = in.file_pointer();
+          if (!FST::Skip(in)) {
+            throw index_error{absl::StrCat(
+              "Failed to read term index for field '", meta().name, "'")};
+          }
+          fst_load_ = std::make_unique<std::once_flag>();
+          return;
+        }
+      }
+
       // read FST
       input_buf isb(&in);
       std::istream input(&isb);  // wrap stream to be OpenFST compliant
@@ -3171,18 +3355,18 @@ class field_reader final : public irs::field_reader {
 
         return memory::make_managed<single_term_iterator<FST>>(
           *this, *owner_->pr_, std::move(terms_in),
-          owner_->terms_in_cipher_.get(), *fst_);
+          owner_->terms_in_cipher_.get(), GetFst());
       }
 
       return memory::make_managed<term_iterator<FST>>(
         *this, *owner_->pr_, *owner_->terms_in_, owner_->terms_in_cipher_.get(),
-        *fst_);
+        GetFst());
     }
 
     term_meta term(bytes_view term) const final {
       single_term_iterator<FST> it{*this, *owner_->pr_,
                                    owner_->terms_in_->reopen(),
-                                   owner_->terms_in_cipher_.get(), *fst_};
+                                   owner_->terms_in_cipher_.get(), GetFst()};
 
       it.seek(term);
       return it.meta();
@@ -3197,7 +3381,7 @@ class field_reader final : public irs::field_reader {
 
       single_term_iterator<FST> it{*this, *owner_->pr_,
                                    owner_->terms_in_->reopen(),
-                                   owner_->terms_in_cipher_.get(), *fst_};
+                                   owner_->terms_in_cipher_.get(), GetFst()};
 
       if (!it.seek(term)) {
         return 0;
@@ -3276,7 +3460,7 @@ class field_reader final : public irs::field_reader {
 
       return memory::make_managed<automaton_term_iterator<FST>>(
         *this, *owner_->pr_, std::move(terms_in),
-        owner_->terms_in_cipher_.get(), *fst_, matcher);
+        owner_->terms_in_cipher_.get(), GetFst(), matcher);
     }
 
     doc_iterator::ptr postings(const seek_cookie& cookie,
@@ -3297,8 +3481,33 @@ class field_reader final : public irs::field_reader {
     }
 
    private:
+    const FST& GetFst() const {
+      if (fst_load_) {
+        std::call_once(*fst_load_, [this] { LoadFst(); });
+      }
+      IRS_ASSERT(fst_);
+      return *fst_;
+    }
+
+    void LoadFst() const {
+      if constexpr (std::is_same_v<FST, immutable_byte_fst>) {
+        // weights are referenced in place, use the shared term index input
+        std::lock_guard lock{owner_->index_in_mutex_};
+        auto& in = *owner_->index_in_;
+        in.seek(fst_offset_);
+        fst_.reset(FST::ReadInPlace(in, owner_->resource_manager_));
+      }
+      if (!fst_) {
+        throw index_error{absl::StrCat("Failed to read term index for field '",
+                                       meta().name, "'")};
+      }
+    }
+
     field_reader* owner_;
-    std::unique_ptr<FST> fst_;
+    mutable std::unique_ptr<FST> fst_;
+    // set if FST is loaded on first access
+    std::unique_ptr<std::once_flag> fst_load_;
+    uint64_t fst_offset_{};
   };
 
   using vector_fst_reader = term_reader<vector_byte_fst>;
@@ -3312,6 +3521,12 @@ class field_reader final : public irs::field_reader {
   irs::postings_reader::ptr pr_;
   encryption::stream::ptr terms_in_cipher_;
   index_input::ptr terms_in_;
+  // Term index input, kept open only if term index is loaded lazily
+  encryption::stream::ptr index_in_cipher_;
+  index_input::ptr index_in_;
+  std::mutex index_in_mutex_;
+  // Cache of decoded term dictionary blocks
+  BlockCache::File terms_cache_;
   IResourceManager& resource_manager_;
 };
 
@@ -3327,13 +3542,18 @@ void field_reader::prepare(const ReaderState& state) {
   // check index header
   index_input::ptr index_in;
 
-  int64_t checksum = 0;
   std::string filename;
   const auto term_index_version = burst_trie::Version(prepare_input(
-    filename, index_in, irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE,
+    filename, index_in,
+    state.lazy_term_index ? irs::IOAdvice::RANDOM
+                          : irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE,
     state, field_writer::TERMS_INDEX_EXT, field_writer::FORMAT_TERMS_INDEX,
     static_cast<int32_t>(burst_trie::Version::MIN),
-    static_cast<int32_t>(burst_trie::Version::MAX), &checksum));
+    static_cast<int32_t>(burst_trie::Version::MAX)));
+
+  // term readers load FST on first access
+  const bool lazy = state.lazy_term_index &&
+                    term_index_version >= burst_trie::Version::IMMUTABLE_FST;
 
   constexpr const size_t FOOTER_LEN = sizeof(uint64_t)  // fields count
                                       + format_utils::kFooterLen;
@@ -3347,8 +3567,14 @@ void field_reader::prepare(const ReaderState& state) {
 
     fields_count = index_in->read_long();
 
-    // check index checksum
-    format_utils::check_footer(*index_in, checksum);
+    // Lazily loaded term index isn't read in full at open, verifying
+    // checksum of the entire file would defeat that. Here we perform
+    // cheap error detection which could recognize some forms of corruption.
+    if (lazy) {
+      format_utils::read_checksum(*index_in);
+    } else {
+      format_utils::check_footer(*index_in, format_utils::checksum(*index_in));
+    }
 
     index_in->seek(ptr);
   }
@@ -3368,12 +3594,19 @@ void field_reader::prepare(const ReaderState& state) {
     }
   }
 
+  if (lazy) {
+    // keep term index input open
+    index_in_cipher_ = std::move(index_in_cipher);
+    index_in_ = std::move(index_in);
+  }
+  auto& in = index_in_ ? *index_in_ : *index_in;
+
   feature_map_t feature_map;
   IndexFeatures features{IndexFeatures::NONE};
   if (IRS_LIKELY(term_index_version >= burst_trie::Version::IMMUTABLE_FST)) {
-    read_segment_features(*index_in, features, feature_map);
+    read_segment_features(in, features, feature_map);
   } else {
-    read_segment_features_legacy(*index_in, features, feature_map);
+    read_segment_features_legacy(in, features, feature_map);
   }
 
   // read terms for each indexed field
@@ -3391,7 +3624,7 @@ void field_reader::prepare(const ReaderState& state) {
       for (std::string_view previous_field_name{""}; fields_count;
            --fields_count) {
         auto& field = fields.emplace_back(*this);
-        field.prepare(term_index_version, *index_in, feature_map);
+        field.prepare(term_index_version, in, feature_map);
 
         const auto& name = field.meta().name;
 
@@ -3437,6 +3670,14 @@ void field_reader::prepare(const ReaderState& state) {
     }
   }
 
+  // Directly accessible (e.g. memory mapped) blocks of a non-encrypted
+  // terms dictionary are already zero-copy, cache only ones we decode
+  if (state.block_cache &&
+      (terms_in_cipher_ || !HasDirectAccess(*terms_in_))) {
+    terms_cache_ = BlockCache::File{
+      state.block_cache, BlockCache::MakeName(*state.dir, filename)};
+  }
+
   // prepare postings reader
   pr_->prepare(*terms_in_, state, features);
 
@@ -44,8 +44,11 @@ enum class Version : int32_t {
   // * WAND support
   WAND = 3,
 
+  // * Term index FSTs store the size of their encoded states
+  FST_STATES_SIZE = 4,
+
   // Max supported version
-  MAX = WAND
+  MAX = FST_STATES_SIZE
 };
 
 irs::field_writer::ptr make_writer(Version version,
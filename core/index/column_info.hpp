@@ -43,4 +43,16 @@ struct ColumnInfo {
 
 using ColumnInfoProvider = std::function<ColumnInfo(const std::string_view)>;
 
+struct TermsInfo {
+  // Minimum and maximum number of entries in a term dictionary block,
+  // 0 stands for a format default
+  uint32_t min_block_size{0};
+  uint32_t max_block_size{0};
+  // Choose block sizes according to the term distribution of a field,
+  // i.e. trade term index size for linear scan of term dictionary blocks
+  bool adaptive{false};
+};
+
+using TermsInfoProvider = std::function<TermsInfo(const std::string_view)>;
+
 }  // namespace irs
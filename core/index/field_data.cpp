@@ -28,6 +28,7 @@
 
 #include "analysis/analyzer.hpp"
 #include "analysis/token_attributes.hpp"
+#include "analysis/token_batch.hpp"
 #include "analysis/token_streams.hpp"
 #include "formats/formats.hpp"
 #include "index/buffered_column_iterator.hpp"
@@ -982,12 +983,74 @@ void field_data::add_term_random_access(posting& p, doc_id_t did,
   }
 }
 
+IRS_FORCE_INLINE bool field_data::invert_token(bytes_view term, uint32_t inc,
+                                               const payload* pay,
+                                               const offset* offs,
+                                               doc_id_t id, bool derived) {
+  pos_ += inc;
+
+  if (pos_ < last_pos_) {
+    IRS_LOG_ERROR(absl::StrCat("invalid position ", pos_, " < ", last_pos_,
+                               " in field '", meta_.name, "'"));
+    return false;
+  }
+
+  if (pos_ >= pos_limits::eof()) {
+    IRS_LOG_ERROR(absl::StrCat("invalid position ", pos_,
+                               " >= ", pos_limits::eof(), " in field '",
+                               meta_.name, "'"));
+    return false;
+  }
+
+  if (0 == inc) {
+    ++stats_.num_overlap;
+  }
+
+  if (offs) {
+    const uint32_t start_offset = offs_ + offs->start;
+    const uint32_t end_offset = offs_ + offs->end;
+
+    if (start_offset < last_start_offs_ || end_offset < start_offset) {
+      IRS_LOG_ERROR(absl::StrCat("invalid offset start=", start_offset,
+                                 " end=", end_offset, " in field '",
+                                 meta_.name, "'"));
+      return false;
+    }
+
+    last_start_offs_ = start_offset;
+  }
+
+  auto* p = terms_.emplace(term);
+
+  if (p == nullptr) {
+    IRS_LOG_WARN(absl::StrCat("skipping too long term of size: ", term.size(),
+                              " in field: ", meta_.name));
+    IRS_LOG_TRACE(absl::StrCat("field: ", meta_.name,
+                               " contains too long term: ",
+                               ViewCast<char>(term)));
+    return true;
+  }
+
+  (this->*proc_table_[!doc_limits::valid(p->doc)])(*p, id, pay, offs);
+  IRS_ASSERT(doc_limits::valid(p->doc));
+
+  if (!derived && 0 == ++stats_.len) {
+    IRS_LOG_ERROR(absl::StrCat("too many tokens in field: ", meta_.name,
+                               ", document: ", id));
+    return false;
+  }
+
+  last_pos_ = pos_;
+  return true;
+}
+
 bool field_data::invert(token_stream& stream, doc_id_t id) {
   REGISTER_TIMER_DETAILED();
   IRS_ASSERT(id < doc_limits::eof());  // 0-based document id
 
   const auto* term = get<term_attribute>(stream);
   const auto* inc = get<increment>(stream);
+  const auto* derived = get<derived_token>(stream);
   const offset* offs = nullptr;
   const payload* pay = nullptr;
 
@@ -1016,64 +1079,49 @@ bool field_data::invert(token_stream& stream, doc_id_t id) {
   reset(id);  // initialize field_data for the supplied doc_id
 
   while (stream.next()) {
-    pos_ += inc->value;
-
-    if (pos_ < last_pos_) {
-      IRS_LOG_ERROR(absl::StrCat("invalid position ", pos_, " < ", last_pos_,
-                                 " in field '", meta_.name, "'"));
+    if (!invert_token(term->value, inc->value, pay, offs, id,
+                      derived && derived->value)) {
       return false;
     }
+  }
 
-    if (pos_ >= pos_limits::eof()) {
-      IRS_LOG_ERROR(absl::StrCat("invalid position ", pos_,
-                                 " >= ", pos_limits::eof(), " in field '",
-                                 meta_.name, "'"));
-      return false;
-    }
-
-    if (0 == inc->value) {
-      ++stats_.num_overlap;
-    }
-
-    if (offs) {
-      const uint32_t start_offset = offs_ + offs->start;
-      const uint32_t end_offset = offs_ + offs->end;
+  if (offs) {
+    offs_ += offs->end;
+  }
 
-      if (start_offset < last_start_offs_ || end_offset < start_offset) {
-        IRS_LOG_ERROR(absl::StrCat("invalid offset start=", start_offset,
-                                   " end=", end_offset, " in field '",
-                                   meta_.name, "'"));
-        return false;
-      }
+  return true;
+}
 
-      last_start_offs_ = start_offset;
-    }
+bool field_data::invert(const analysis::BatchTokens& tokens, doc_id_t id) {
+  REGISTER_TIMER_DETAILED();
+  IRS_ASSERT(id < doc_limits::eof());  // 0-based document id
+  IRS_ASSERT(tokens.batch);
+  const auto& batch = *tokens.batch;
 
-    auto* p = terms_.emplace(term->value);
+  if (!batch.valid(tokens.value)) {
+    IRS_LOG_ERROR(absl::StrCat("field '", meta_.name,
+                               "' got value failed to be analyzed"));
+    return false;
+  }
 
-    if (p == nullptr) {
-      IRS_LOG_WARN(absl::StrCat("skipping too long term of size: ",
-                                term->value.size(), " in field: ", meta_.name));
-      IRS_LOG_TRACE(
-        absl::StrCat("field: ", meta_.name,
-                     " contains too long term: ", ViewCast<char>(term->value)));
-      continue;
-    }
+  const bool track_offsets =
+    batch.offsets() &&
+    IndexFeatures::NONE != (requested_features_ & IndexFeatures::OFFS);
 
-    (this->*proc_table_[!doc_limits::valid(p->doc)])(*p, id, pay, offs);
-    IRS_ASSERT(doc_limits::valid(p->doc));
+  reset(id);  // initialize field_data for the supplied doc_id
 
-    if (0 == ++stats_.len) {
-      IRS_LOG_ERROR(absl::StrCat("too many tokens in field: ", meta_.name,
-                                 ", document: ", id));
+  offset offs;
+  for (const auto& token : batch.tokens(tokens.value)) {
+    offs.start = token.start;
+    offs.end = token.end;
+    if (!invert_token(batch.term(token), token.increment, nullptr,
+                      track_offsets ? &offs : nullptr, id, token.derived)) {
       return false;
     }
-
-    last_pos_ = pos_;
   }
 
-  if (offs) {
-    offs_ += offs->end;
+  if (track_offsets) {
+    offs_ += offs.end;
   }
 
   return true;
@@ -50,6 +50,7 @@ struct flush_state;
 
 namespace analysis {
 class analyzer;
+struct BatchTokens;
 }
 
 using int_block_pool = block_pool<size_t, 8192, ManagedTypedAllocator<size_t>>;
@@ -122,6 +123,7 @@ class field_data : util::noncopyable {
   bool empty() const noexcept { return !doc_limits::valid(last_doc_); }
 
   bool invert(token_stream& tokens, doc_id_t id);
+  bool invert(const analysis::BatchTokens& tokens, doc_id_t id);
 
   const field_stats& stats() const noexcept { return stats_; }
 
@@ -160,6 +162,11 @@ class field_data : util::noncopyable {
 
   void reset(doc_id_t doc_id);
 
+  // Returns false if a document must not be indexed. Derived tokens don't
+  // contribute to a field length, see derived_token.
+  bool invert_token(bytes_view term, uint32_t inc, const payload* pay,
+                    const offset* offs, doc_id_t id, bool derived);
+
   void new_term(posting& p, doc_id_t did, const payload* pay,
                 const offset* offs);
   void add_term(posting& p, doc_id_t did, const payload* pay,
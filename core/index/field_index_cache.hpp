@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+
+#include "index/segment_cache.hpp"
+#include "resource_manager.hpp"
+
+namespace irs {
+
+// Per-segment cache of in-memory indexes built over term dictionaries.
+// An index is built from a field on the first request and shared by all
+// queries using the same cache. Indexes may copy whole term dictionaries,
+// hence their memory is always accounted by the specified resource manager,
+// e.g. ResourceManagementOptions::readers.
+template<typename Index>
+class FieldIndexCache : public SegmentCache<Index> {
+ public:
+  explicit FieldIndexCache(IResourceManager& resource_manager) noexcept
+    : resource_manager_{resource_manager} {}
+
+  using SegmentCache<Index>::Get;
+
+  // Returns index of the specified field, builds it on a miss.
+  std::shared_ptr<const Index> Get(const SubReader& segment,
+                                   const term_reader& field) {
+    return Get(segment, field.meta().name, [&] {
+      return std::make_shared<const Index>(field, resource_manager_);
+    });
+  }
+
+  IResourceManager& ResourceManager() const noexcept {
+    return resource_manager_;
+  }
+
+ private:
+  IResourceManager& resource_manager_;
+};
+
+}  // namespace irs
@@ -24,6 +24,7 @@
 
 #include <function2/function2.hpp>
 #include <functional>
+#include <memory>
 
 #include "resource_manager.hpp"
 #include "search/scorer.hpp"
@@ -31,6 +32,7 @@
 
 namespace irs {
 
+class BlockCache;
 struct SegmentMeta;
 struct field_reader;
 struct column_reader;
@@ -74,6 +76,14 @@ struct IndexReaderOptions {
 
   // Read document mask
   bool doc_mask{true};
+
+  // Optional cache of decoded postings and term dictionary blocks,
+  // may be shared across readers.
+  std::shared_ptr<BlockCache> block_cache;
+
+  // Load term index of a field on first access instead of reading all
+  // term indices on open, memory mapped term index data is used in place.
+  bool lazy_term_index{false};
 };
 
 }  // namespace irs
@@ -1137,12 +1137,13 @@ IndexWriter::IndexWriter(
   index_file_refs::ref_t&& lock_file_ref, directory& dir, format::ptr codec,
   size_t segment_pool_size, const SegmentOptions& segment_limits,
   const Comparer* comparator, const ColumnInfoProvider& column_info,
-  const FeatureInfoProvider& feature_info,
+  const FeatureInfoProvider& feature_info, const TermsInfoProvider& terms_info,
   const PayloadProvider& meta_payload_provider,
   std::shared_ptr<const DirectoryReaderImpl>&& committed_reader,
   const ResourceManagementOptions& rm)
   : feature_info_{feature_info},
     column_info_{column_info},
+    terms_info_{terms_info},
     meta_payload_provider_{meta_payload_provider},
     comparator_{comparator},
     codec_{std::move(codec)},
@@ -1291,7 +1292,7 @@ IndexWriter::ptr IndexWriter::Make(directory& dir, format::ptr codec,
     options.comparator,
     options.column_info ? options.column_info : kDefaultColumnInfo,
     options.features ? options.features : kDefaultFeatureInfo,
-    options.meta_payload_provider, std::move(reader),
+    options.terms_info, options.meta_payload_provider, std::move(reader),
     options.reader_options.resource_manager);
 
   // Remove non-index files from directory
@@ -1808,6 +1809,7 @@ SegmentWriterOptions IndexWriter::GetSegmentWriterOptions(
     .comparator = comparator_,
     .resource_manager = consolidation ? *resource_manager_.consolidations
                                       : *resource_manager_.transactions,
+    .terms_info = &terms_info_,
   };
 }
 
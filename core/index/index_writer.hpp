@@ -150,6 +150,9 @@ struct IndexWriterOptions : public SegmentOptions {
   // Returns column info the writer should use for columnstore
   ColumnInfoProvider column_info;
 
+  // Returns term dictionary options the writer should use for a field
+  TermsInfoProvider terms_info;
+
   // Provides payload for index_meta created by writer
   PayloadProvider meta_payload_provider;
 
@@ -576,6 +579,7 @@ class IndexWriter : private util::noncopyable {
               const SegmentOptions& segment_limits, const Comparer* comparator,
               const ColumnInfoProvider& column_info,
               const FeatureInfoProvider& feature_info,
+              const TermsInfoProvider& terms_info,
               const PayloadProvider& meta_payload_provider,
               std::shared_ptr<const DirectoryReaderImpl>&& committed_reader,
               const ResourceManagementOptions& rm);
@@ -920,6 +924,7 @@ class IndexWriter : private util::noncopyable {
   ScorersView wand_scorers_;
   FeatureInfoProvider feature_info_;
   ColumnInfoProvider column_info_;
+  TermsInfoProvider terms_info_;
   PayloadProvider meta_payload_provider_;  // provides payload for new segments
   const Comparer* comparator_;
   format::ptr codec_;
@@ -39,6 +39,7 @@
 #include "index/index_meta.hpp"
 #include "index/norm.hpp"
 #include "index/segment_reader.hpp"
+#include "search/doc_bitmap.hpp"
 #include "store/store_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/log.hpp"
@@ -163,8 +164,11 @@ class RemappingDocIterator : public doc_iterator {
   }
 
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
-    return irs::type<irs::document>::id() == type ? &doc_
-                                                  : it_->get_mutable(type);
+    if (irs::type<irs::document>::id() == type) {
+      return &doc_;
+    }
+    return irs::type<irs::doc_bitmap>::id() == type ? nullptr
+                                                    : it_->get_mutable(type);
   }
 
  private:
@@ -1603,7 +1607,8 @@ bool MergeWriter::FlushUnsorted(TrackingDirectory& dir, SegmentMeta& segment,
                           .name = segment.name,
                           .scorers = scorers_,
                           .doc_count = segment.docs_count,
-                          .index_features = index_features};
+                          .index_features = index_features,
+                          .terms_info = terms_info_};
 
   // Write field meta and field term data
   IRS_ASSERT(scorers_features_);
@@ -1837,7 +1842,8 @@ bool MergeWriter::FlushSorted(TrackingDirectory& dir, SegmentMeta& segment,
                           .name = segment.name,
                           .scorers = scorers_,
                           .doc_count = segment.docs_count,
-                          .index_features = index_features};
+                          .index_features = index_features,
+                          .terms_info = terms_info_};
 
   // Write field meta and field term data
   IRS_ASSERT(scorers_features_);
@@ -61,7 +61,8 @@ class MergeWriter : public util::noncopyable {
       feature_info_{&options.feature_info},
       scorers_{options.scorers},
       scorers_features_{&options.scorers_features},
-      comparator_{options.comparator} {
+      comparator_{options.comparator},
+      terms_info_{options.terms_info} {
     IRS_ASSERT(column_info_);
   }
   MergeWriter(MergeWriter&&) = default;
@@ -103,6 +104,7 @@ class MergeWriter : public util::noncopyable {
   ScorersView scorers_;
   const feature_set_t* scorers_features_{};
   const Comparer* const comparator_{};
+  const TermsInfoProvider* terms_info_{};
 };
 
 static_assert(std::is_nothrow_move_constructible_v<MergeWriter>);
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
+
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "index/index_reader.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace irs {
+
+// Per-segment cache of values derived from segment data, e.g. in-memory
+// indexes or evaluated filters. A value is identified by a segment, its
+// version and a caller provided key, it's built on the first request and
+// shared by all queries using the same cache. A cache may be bounded by
+// a number of values, least recently used values are evicted then.
+template<typename Value>
+class SegmentCache : private util::noncopyable {
+ public:
+  static constexpr size_t kUnbounded = std::numeric_limits<size_t>::max();
+
+  explicit SegmentCache(size_t max_size = kUnbounded) noexcept
+    : max_size_{std::max(size_t{1}, max_size)} {}
+
+  // Returns value cached under the specified key, builds it by 'factory'
+  // on a miss. Null values aren't cached.
+  template<typename Factory>
+  std::shared_ptr<const Value> Get(const SubReader& segment,
+                                   std::string_view key, Factory&& factory) {
+    const auto& meta = segment.Meta();
+    Key entry{.segment = meta.name,
+              .version = meta.version,
+              .key = std::string{key}};
+
+    {
+      std::lock_guard lock{mutex_};
+      if (auto it = values_.find(entry); it != values_.end()) {
+        return Touch(it->second);
+      }
+    }
+
+    // build value without holding a lock
+    std::shared_ptr<const Value> value = factory();
+
+    if (!value) {
+      return nullptr;
+    }
+
+    std::lock_guard lock{mutex_};
+    // value may be built by a concurrent query
+    auto [it, emplaced] =
+      values_.try_emplace(std::move(entry), Slot{.value = std::move(value)});
+    if (!emplaced) {
+      return Touch(it->second);
+    }
+
+    lru_.emplace_front(&it->first);
+    it->second.position = lru_.begin();
+    if (values_.size() > max_size_) {
+      values_.erase(*lru_.back());
+      lru_.pop_back();
+    }
+    return it->second.value;
+  }
+
+  // Drops values of segments not present in the specified index.
+  void Retain(const IndexReader& index) {
+    absl::flat_hash_map<std::string_view, uint64_t> segments;
+    for (auto& segment : index) {
+      const auto& meta = segment.Meta();
+      segments.emplace(meta.name, meta.version);
+    }
+
+    std::lock_guard lock{mutex_};
+    for (auto it = values_.begin(); it != values_.end();) {
+      const auto segment = segments.find(it->first.segment);
+      if (segment == segments.end() || segment->second != it->first.version) {
+        lru_.erase(it->second.position);
+        values_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void Clear() {
+    std::lock_guard lock{mutex_};
+    values_.clear();
+    lru_.clear();
+  }
+
+  size_t size() const {
+    std::lock_guard lock{mutex_};
+    return values_.size();
+  }
+
+ private:
+  struct Key {
+    std::string segment;
+    uint64_t version;
+    std::string key;
+
+    bool operator==(const Key&) const = default;
+
+    template<typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.segment, key.version, key.key);
+    }
+  };
+
+  // keys of values from the most to the least recently used one
+  using Recency = std::list<const Key*>;
+
+  struct Slot {
+    std::shared_ptr<const Value> value;
+    typename Recency::iterator position;
+  };
+
+  const std::shared_ptr<const Value>& Touch(Slot& slot) noexcept {
+    lru_.splice(lru_.begin(), lru_, slot.position);
+    return slot.value;
+  }
+
+  const size_t max_size_;
+  mutable std::mutex mutex_;
+  // node based to keep keys referenced by 'lru_' stable
+  absl::node_hash_map<Key, Slot> values_;
+  Recency lru_;
+};
+
+}  // namespace irs
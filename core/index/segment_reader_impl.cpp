@@ -26,6 +26,7 @@
 
 #include "analysis/token_attributes.hpp"
 #include "index/index_meta.hpp"
+#include "search/doc_bitmap.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/type_limits.hpp"
 
@@ -96,7 +97,9 @@ class MaskDocIterator : public doc_iterator {
   doc_id_t value() const final { return it_->value(); }
 
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
-    return it_->get_mutable(type);
+    // masked documents can't be skipped within a bitmap window
+    return irs::type<doc_bitmap>::id() == type ? nullptr
+                                               : it_->get_mutable(type);
   }
 
  private:
@@ -177,7 +180,11 @@ std::shared_ptr<const SegmentReaderImpl> SegmentReaderImpl::Open(
     meta.codec->get_field_reader(*options.resource_manager.readers);
   if (options.index) {
     reader->field_reader_->prepare(
-      ReaderState{.dir = &dir, .meta = &meta, .scorers = options.scorers});
+      ReaderState{.dir = &dir,
+                  .meta = &meta,
+                  .scorers = options.scorers,
+                  .block_cache = options.block_cache,
+                  .lazy_term_index = options.lazy_term_index});
   }
   // open column store
   reader->data_ = std::make_shared<ColumnData>();
@@ -170,13 +170,16 @@ segment_writer::segment_writer(ConstructToken, directory& dir,
             options.resource_manager, options.comparator},
     columns_{{options.resource_manager}},
     column_info_{&options.column_info},
+    terms_info_{options.terms_info},
     dir_{dir} {
   docs_mask_.set = decltype(docs_mask_.set){{options.resource_manager}};
 }
 
-bool segment_writer::index(const hashed_string_view& name, const doc_id_t doc,
-                           IndexFeatures index_features,
-                           const features_t& features, token_stream& tokens) {
+template<typename Tokens>
+bool segment_writer::index_tokens(const hashed_string_view& name,
+                                  const doc_id_t doc,
+                                  IndexFeatures index_features,
+                                  const features_t& features, Tokens& tokens) {
   REGISTER_TIMER_DETAILED();
   IRS_ASSERT(col_writer_);
 
@@ -198,6 +201,19 @@ bool segment_writer::index(const hashed_string_view& name, const doc_id_t doc,
   return false;
 }
 
+bool segment_writer::index(const hashed_string_view& name, const doc_id_t doc,
+                           IndexFeatures index_features,
+                           const features_t& features, token_stream& tokens) {
+  return index_tokens(name, doc, index_features, features, tokens);
+}
+
+bool segment_writer::index(const hashed_string_view& name, const doc_id_t doc,
+                           IndexFeatures index_features,
+                           const features_t& features,
+                           const analysis::BatchTokens& tokens) {
+  return index_tokens(name, doc, index_features, features, tokens);
+}
+
 column_output& segment_writer::stream(const hashed_string_view& name,
                                       const doc_id_t doc_id) {
   REGISTER_TIMER_DETAILED();
@@ -236,7 +252,8 @@ void segment_writer::FlushFields(flush_state& state) {
                     .columns = this,
                     .name = seg_name_,
                     .scorers = scorers_,
-                    .doc_count = buffered_docs()};
+                    .doc_count = buffered_docs(),
+                    .terms_info = terms_info_};
 
   DocMap docmap;
   if (fields_.comparator() != nullptr) {
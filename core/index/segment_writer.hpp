@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "analysis/token_batch.hpp"
 #include "analysis/token_stream.hpp"
 #include "index/buffered_column.hpp"
 #include "index/column_info.hpp"
@@ -249,6 +250,31 @@ class segment_writer : public ColumnProvider, util::noncopyable {
   bool index(const hashed_string_view& name, const doc_id_t doc,
              IndexFeatures index_features, const features_t& features,
              token_stream& tokens);
+  bool index(const hashed_string_view& name, const doc_id_t doc,
+             IndexFeatures index_features, const features_t& features,
+             const analysis::BatchTokens& tokens);
+
+  template<typename Tokens>
+  bool index_tokens(const hashed_string_view& name, const doc_id_t doc,
+                    IndexFeatures index_features, const features_t& features,
+                    Tokens& tokens);
+
+  // Fields providing tokens of a value of an analyzed batch are inverted
+  // without a token_stream, see analysis::TokenBatch.
+  template<typename Field>
+  bool index_field(const hashed_string_view& name, const doc_id_t doc,
+                   Field& field) {
+    const auto& features = static_cast<const features_t&>(field.features());
+    const IndexFeatures index_features = field.index_features();
+
+    if constexpr (requires { field.get_batch_tokens(); }) {
+      const analysis::BatchTokens tokens = field.get_batch_tokens();
+      return index(name, doc, index_features, features, tokens);
+    } else {
+      auto& tokens = static_cast<token_stream&>(field.get_tokens());
+      return index(name, doc, index_features, features, tokens);
+    }
+  }
 
   template<typename Writer>
   bool store_sorted(const doc_id_t doc, Writer& writer) {
@@ -321,15 +347,11 @@ class segment_writer : public ColumnProvider, util::noncopyable {
     const hashed_string_view field_name{
       static_cast<std::string_view>(field.name())};
 
-    auto& tokens = static_cast<token_stream&>(field.get_tokens());
-    const auto& features = static_cast<const features_t&>(field.features());
-    const IndexFeatures index_features = field.index_features();
-
     // user should check return of begin() != eof()
     IRS_ASSERT(LastDocId() < doc_limits::eof());
     const auto doc_id = LastDocId();
 
-    return index(field_name, doc_id, index_features, features, tokens);
+    return index_field(field_name, doc_id, field);
   }
 
   template<bool Sorted, typename Field>
@@ -339,16 +361,11 @@ class segment_writer : public ColumnProvider, util::noncopyable {
     const hashed_string_view field_name{
       static_cast<std::string_view>(field.name())};
 
-    auto& tokens = static_cast<token_stream&>(field.get_tokens());
-    const auto& features = static_cast<const features_t&>(field.features());
-    const IndexFeatures index_features = field.index_features();
-
     // user should check return of begin() != eof()
     IRS_ASSERT(LastDocId() < doc_limits::eof());
     const auto doc_id = LastDocId();
 
-    if (IRS_UNLIKELY(
-          !index(field_name, doc_id, index_features, features, tokens))) {
+    if (IRS_UNLIKELY(!index_field(field_name, doc_id, field))) {
       return false;  // indexing failed
     }
 
@@ -393,6 +410,7 @@ class segment_writer : public ColumnProvider, util::noncopyable {
   std::string seg_name_;
   field_writer::ptr field_writer_;
   const ColumnInfoProvider* column_info_;
+  const TermsInfoProvider* terms_info_;
   columnstore_writer::ptr col_writer_;
   TrackingDirectory dir_;
   bool initialized_{false};
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "term_ordinals.hpp"
+
+#include "formats/formats.hpp"
+
+namespace irs {
+
+TermOrdinals::TermOrdinals(const term_reader& field,
+                           IResourceManager& resource_manager)
+  : terms_{{resource_manager}}, offsets_{{resource_manager}} {
+  offsets_.reserve(field.size() + 1);
+  offsets_.emplace_back(0);
+
+  auto terms = field.iterator(SeekMode::NORMAL);
+
+  if (IRS_UNLIKELY(!terms)) {
+    return;
+  }
+
+  while (terms->next()) {
+    const auto value = terms->value();
+    terms_.insert(terms_.end(), value.begin(), value.end());
+    offsets_.emplace_back(terms_.size());
+  }
+  IRS_ASSERT(offsets_.size() - 1 <= kInvalid);
+}
+
+uint32_t TermOrdinals::find(bytes_view term) const noexcept {
+  const auto ord = lower_bound(term);
+  return ord < size() && this->term(ord) == term ? ord : kInvalid;
+}
+
+uint32_t TermOrdinals::lower_bound(bytes_view term) const noexcept {
+  uint32_t begin = 0;
+  for (uint32_t count = size(); count != 0;) {
+    const auto step = count / 2;
+    if (this->term(begin + step) < term) {
+      begin += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return begin;
+}
+
+uint32_t TermOrdinals::upper_bound(bytes_view term) const noexcept {
+  uint32_t begin = 0;
+  for (uint32_t count = size(); count != 0;) {
+    const auto step = count / 2;
+    if (!(term < this->term(begin + step))) {
+      begin += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return begin;
+}
+
+seek_term_iterator::ptr TermOrdinals::iterator(const term_reader& field) const {
+  auto it = field.iterator(SeekMode::NORMAL);
+
+  if (IRS_UNLIKELY(!it)) {
+    return seek_term_iterator::empty();
+  }
+
+  return memory::make_managed<OrdinalTermIterator>(*this, std::move(it));
+}
+
+bool OrdinalTermIterator::seek(uint32_t ord) {
+  if (ord >= ords_->size() || !it_->seek(ords_->term(ord))) {
+    ord_ = TermOrdinals::kInvalid;
+    return false;
+  }
+
+  ord_ = ord;
+  return true;
+}
+
+bool OrdinalTermIterator::next() {
+  if (!it_->next()) {
+    ord_ = TermOrdinals::kInvalid;
+    return false;
+  }
+
+  if (IRS_LIKELY(ord_ != TermOrdinals::kInvalid)) {
+    ++ord_;
+  } else {
+    // iterator is either fresh or positioned by a failed seek
+    ord_ = ords_->find(it_->value());
+  }
+  IRS_ASSERT(ord_ < ords_->size() && ords_->term(ord_) == it_->value());
+  return true;
+}
+
+SeekResult OrdinalTermIterator::seek_ge(bytes_view value) {
+  const auto ord = ords_->lower_bound(value);
+
+  if (!seek(ord)) {
+    return SeekResult::END;
+  }
+
+  return ords_->term(ord) == value ? SeekResult::FOUND : SeekResult::NOT_FOUND;
+}
+
+bool OrdinalTermIterator::seek(bytes_view value) {
+  const auto ord = ords_->find(value);
+
+  if (ord == TermOrdinals::kInvalid) {
+    ord_ = TermOrdinals::kInvalid;
+    return false;
+  }
+
+  return seek(ord);
+}
+
+}  // namespace irs
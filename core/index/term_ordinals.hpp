@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <limits>
+
+#include "index/field_index_cache.hpp"
+#include "index/iterators.hpp"
+#include "resource_manager.hpp"
+#include "utils/assert.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+namespace irs {
+
+struct term_reader;
+
+// Dense index of a term dictionary assigning ordinals to terms, ordinals
+// follow the dictionary order starting from 0. Index holds a copy of all
+// terms of a field, its memory is accounted by the specified resource
+// manager.
+class TermOrdinals : private util::noncopyable {
+ public:
+  static constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+
+  TermOrdinals(const term_reader& field, IResourceManager& resource_manager);
+
+  bytes_view term(uint32_t ord) const noexcept {
+    IRS_ASSERT(ord < size());
+    return {terms_.data() + offsets_[ord], offsets_[ord + 1] - offsets_[ord]};
+  }
+
+  // Returns ordinal of the specified term or kInvalid if there is no such
+  // term in the dictionary.
+  uint32_t find(bytes_view term) const noexcept;
+
+  // Returns ordinal of the first term not less than the specified one,
+  // or size() if there is no such term.
+  uint32_t lower_bound(bytes_view term) const noexcept;
+
+  // Returns ordinal of the first term greater than the specified one,
+  // or size() if there is no such term.
+  uint32_t upper_bound(bytes_view term) const noexcept;
+
+  // Returns iterator over the specified field tracking ordinals of terms.
+  // Field must be the one the ordinals were built for.
+  seek_term_iterator::ptr iterator(const term_reader& field) const;
+
+  // Returns total number of terms.
+  uint32_t size() const noexcept {
+    return static_cast<uint32_t>(offsets_.size() - 1);
+  }
+
+ private:
+  ManagedVector<byte_type> terms_;
+  ManagedVector<size_t> offsets_;
+};
+
+// Term iterator providing an ordinal of the current term and seeking by
+// an ordinal, byte seeks are resolved by the ordinals first.
+class OrdinalTermIterator : public seek_term_iterator {
+ public:
+  OrdinalTermIterator(const TermOrdinals& ords,
+                      seek_term_iterator::ptr&& it) noexcept
+    : ords_{&ords}, it_{std::move(it)} {
+    IRS_ASSERT(it_);
+  }
+
+  // Returns ordinal of the current term, or TermOrdinals::kInvalid if
+  // iterator isn't positioned.
+  uint32_t ord() const noexcept { return ord_; }
+
+  // Positions iterator at a term with the specified ordinal, iterator is
+  // unpositioned on failure.
+  bool seek(uint32_t ord);
+
+  bytes_view value() const noexcept final { return it_->value(); }
+
+  bool next() final;
+
+  SeekResult seek_ge(bytes_view value) final;
+
+  bool seek(bytes_view value) final;
+
+  void read() final { it_->read(); }
+
+  doc_iterator::ptr postings(IndexFeatures features) const final {
+    return it_->postings(features);
+  }
+
+  seek_cookie::ptr cookie() const final { return it_->cookie(); }
+
+  attribute* get_mutable(type_info::type_id type) noexcept final {
+    return it_->get_mutable(type);
+  }
+
+ private:
+  const TermOrdinals* ords_;
+  seek_term_iterator::ptr it_;
+  uint32_t ord_{TermOrdinals::kInvalid};
+};
+
+// Declared as a class to allow forward declarations in filter headers.
+class TermOrdinalsCache final : public FieldIndexCache<TermOrdinals> {
+ public:
+  using FieldIndexCache::FieldIndexCache;
+};
+
+}  // namespace irs
@@ -0,0 +1,506 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "aggregations.hpp"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <memory>
+
+#include "analysis/token_attributes.hpp"
+#include "index/index_reader.hpp"
+#include "search/bitset_doc_iterator.hpp"
+#include "utils/type_limits.hpp"
+
+namespace irs {
+namespace {
+
+using DocsBlock = std::array<doc_id_t, DocAggregator::kBlockSize>;
+using ValuesBlock = std::array<double, DocAggregator::kBlockSize>;
+
+// Aggregation state of a single request in a segment.
+class SegmentAggregation {
+ public:
+  virtual ~SegmentAggregation() = default;
+
+  // Collects a block of matched documents sorted in ascending order.
+  virtual void Collect(std::span<const doc_id_t> docs) = 0;
+
+  // Finishes aggregation, 'matched' holds all matched documents if
+  // the aggregation requires it, nullptr otherwise.
+  virtual void Finish(const bitset* /*matched*/) {}
+
+  virtual bool RequiresMatched() const noexcept { return false; }
+};
+
+// Reads values of documents sorted in ascending order, the only column
+// iterator is used for a segment, hence column blocks are decoded once.
+class ColumnValues {
+ public:
+  explicit ColumnValues(const column_reader& column)
+    : it_{column.iterator(ColumnHint::kNormal)},
+      payload_{irs::get<payload>(*it_)} {
+    IRS_ASSERT(it_);
+    IRS_ASSERT(payload_);
+  }
+
+  template<typename Visitor>
+  void Read(std::span<const doc_id_t> docs, Visitor&& visitor) {
+    for (const auto doc : docs) {
+      const auto value = it_->seek(doc);
+
+      if (IRS_UNLIKELY(doc_limits::eof(value))) {
+        return;
+      }
+
+      if (value == doc) {
+        visitor(payload_->value);
+      }
+    }
+  }
+
+ private:
+  doc_iterator::ptr it_;
+  const payload* payload_;
+};
+
+class TermsColumnAggregation final : public SegmentAggregation {
+ public:
+  TermsColumnAggregation(const column_reader& column, TermsCounts& result)
+    : values_{column}, counts_{&result.counts} {}
+
+  void Collect(std::span<const doc_id_t> docs) final {
+    values_.Read(docs, [this](bytes_view value) {
+      // reuse key buffer to avoid allocations for known values
+      key_.assign(value);
+      if (auto it = counts_->find(key_); it != counts_->end()) {
+        ++it->second;
+      } else {
+        counts_->emplace(key_, 1);
+      }
+    });
+  }
+
+ private:
+  ColumnValues values_;
+  absl::flat_hash_map<bstring, uint64_t>* counts_;
+  bstring key_;
+};
+
+class TermsFieldAggregation final : public SegmentAggregation {
+ public:
+  TermsFieldAggregation(const term_reader& field, TermsCounts& result) noexcept
+    : field_{&field}, counts_{&result.counts} {}
+
+  void Collect(std::span<const doc_id_t>) final {}
+
+  void Finish(const bitset* matched) final {
+    IRS_ASSERT(matched);
+    if (matched->none()) {
+      return;
+    }
+
+    auto terms = field_->iterator(SeekMode::NORMAL);
+
+    if (IRS_UNLIKELY(!terms)) {
+      return;
+    }
+
+    while (terms->next()) {
+      terms->read();
+      auto docs = terms->postings(IndexFeatures::NONE);
+
+      // leapfrog postings and matched documents, hence the work per term is
+      // bounded by the smaller of both rather than by the postings
+      uint64_t count = 0;
+      bitset_doc_iterator it{matched->begin(), matched->end()};
+      auto target = it.next() ? it.value() : doc_limits::eof();
+      while (!doc_limits::eof(target)) {
+        const auto doc = docs->seek(target);
+        if (doc == target) {
+          ++count;
+          target = it.next() ? it.value() : doc_limits::eof();
+        } else if (!doc_limits::eof(doc)) {
+          target = it.seek(doc);
+        } else {
+          break;
+        }
+      }
+
+      if (count) {
+        (*counts_)[bstring{terms->value()}] += count;
+      }
+    }
+  }
+
+  bool RequiresMatched() const noexcept final { return true; }
+
+ private:
+  const term_reader* field_;
+  absl::flat_hash_map<bstring, uint64_t>* counts_;
+};
+
+// Base class for aggregations over numeric values, values of a block
+// are decoded at once and then aggregated in a tight loop.
+class NumericAggregation : public SegmentAggregation {
+ public:
+  NumericAggregation(const column_reader& column,
+                     NumericDecoder decoder) noexcept
+    : values_{column}, decoder_{decoder} {
+    IRS_ASSERT(decoder_);
+  }
+
+  void Collect(std::span<const doc_id_t> docs) final {
+    IRS_ASSERT(docs.size() <= block_.size());
+    size_t size = 0;
+    values_.Read(docs, [&](bytes_view value) {
+      size += decoder_(value, block_[size]);
+    });
+    Aggregate({block_.data(), size});
+  }
+
+ protected:
+  virtual void Aggregate(std::span<const double> values) = 0;
+
+ private:
+  ColumnValues values_;
+  NumericDecoder decoder_;
+  ValuesBlock block_;
+};
+
+class StatsColumnAggregation final : public NumericAggregation {
+ public:
+  StatsColumnAggregation(const column_reader& column, NumericDecoder decoder,
+                         NumericStats& result) noexcept
+    : NumericAggregation{column, decoder}, stats_{&result} {}
+
+ private:
+  void Aggregate(std::span<const double> values) final {
+    double sum = 0.;
+    double min = stats_->min;
+    double max = stats_->max;
+    for (const auto value : values) {
+      sum += value;
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+    stats_->count += values.size();
+    stats_->sum += sum;
+    stats_->min = min;
+    stats_->max = max;
+  }
+
+  NumericStats* stats_;
+};
+
+class HistogramColumnAggregation final : public NumericAggregation {
+ public:
+  HistogramColumnAggregation(const column_reader& column,
+                             const HistogramAggregation& request,
+                             HistogramCounts& result) noexcept
+    : NumericAggregation{column, request.decoder},
+      offset_{request.offset},
+      scale_{1. / request.interval},
+      buckets_{&result.buckets} {
+    IRS_ASSERT(request.interval > 0.);
+  }
+
+ private:
+  void Aggregate(std::span<const double> values) final {
+    // bounds of doubles representable as int64_t
+    constexpr double kMinKey = -0x1p63;
+    constexpr double kMaxKey = 0x1p63;
+
+    std::array<int64_t, DocAggregator::kBlockSize> keys;
+    IRS_ASSERT(values.size() <= keys.size());
+    size_t size = 0;
+    for (const auto value : values) {
+      // non-finite values don't fall into any bucket, out of range ones
+      // fall into the outermost buckets
+      const auto key = std::floor((value - offset_) * scale_);
+      if (IRS_UNLIKELY(!std::isfinite(key))) {
+        continue;
+      }
+      keys[size++] = key < kMinKey    ? std::numeric_limits<int64_t>::min()
+                     : key >= kMaxKey ? std::numeric_limits<int64_t>::max()
+                                      : static_cast<int64_t>(key);
+    }
+
+    // neighbouring documents often fall into the same bucket
+    for (size_t i = 0; i < size;) {
+      const auto key = keys[i];
+      size_t j = i + 1;
+      while (j < size && keys[j] == key) {
+        ++j;
+      }
+      (*buckets_)[key] += j - i;
+      i = j;
+    }
+  }
+
+  double offset_;
+  double scale_;
+  absl::flat_hash_map<int64_t, uint64_t>* buckets_;
+};
+
+using SegmentAggregations = std::vector<std::unique_ptr<SegmentAggregation>>;
+
+SegmentAggregations MakeAggregations(
+  const SubReader& segment, std::span<const AggregationRequest> requests,
+  std::span<AggregationResult> results) {
+  IRS_ASSERT(requests.size() == results.size());
+  SegmentAggregations aggregations;
+  aggregations.reserve(requests.size());
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    auto& result = results[i];
+    auto aggregation = std::visit(
+      [&]<typename T>(const T& request) -> std::unique_ptr<SegmentAggregation> {
+        if constexpr (std::is_same_v<T, FieldTermsAggregation>) {
+          const auto* field = segment.field(request.field);
+          if (!field) {
+            return nullptr;
+          }
+          return std::make_unique<TermsFieldAggregation>(
+            *field, std::get<TermsCounts>(result));
+        } else {
+          const auto* column = segment.column(request.column);
+          if (!column) {
+            return nullptr;
+          }
+
+          std::unique_ptr<SegmentAggregation> aggregation;
+          if constexpr (std::is_same_v<T, TermsAggregation>) {
+            aggregation = std::make_unique<TermsColumnAggregation>(
+              *column, std::get<TermsCounts>(result));
+          } else if constexpr (std::is_same_v<T, HistogramAggregation>) {
+            aggregation = std::make_unique<HistogramColumnAggregation>(
+              *column, request, std::get<HistogramCounts>(result));
+          } else {
+            static_assert(std::is_same_v<T, StatsAggregation>);
+            aggregation = std::make_unique<StatsColumnAggregation>(
+              *column, request.decoder, std::get<NumericStats>(result));
+          }
+          return aggregation;
+        }
+      },
+      requests[i]);
+
+    if (aggregation) {
+      aggregations.emplace_back(std::move(aggregation));
+    }
+  }
+
+  return aggregations;
+}
+
+bool RequiresMatched(const SegmentAggregations& aggregations) noexcept {
+  return std::any_of(
+    aggregations.begin(), aggregations.end(),
+    [](const auto& aggregation) { return aggregation->RequiresMatched(); });
+}
+
+void CollectBlock(const SegmentAggregations& aggregations,
+                  std::span<const doc_id_t> docs) {
+  for (auto& aggregation : aggregations) {
+    aggregation->Collect(docs);
+  }
+}
+
+void Finish(const SegmentAggregations& aggregations, const bitset* matched) {
+  for (auto& aggregation : aggregations) {
+    aggregation->Finish(matched);
+  }
+}
+
+}  // namespace
+
+bool DecodeDouble(bytes_view value, double& out) noexcept {
+  if (IRS_UNLIKELY(value.size() != sizeof(double))) {
+    return false;
+  }
+  std::memcpy(&out, value.data(), sizeof(double));
+  return true;
+}
+
+bool DecodeInt64(bytes_view value, double& out) noexcept {
+  if (IRS_UNLIKELY(value.size() != sizeof(int64_t))) {
+    return false;
+  }
+  int64_t v;
+  std::memcpy(&v, value.data(), sizeof(int64_t));
+  out = static_cast<double>(v);
+  return true;
+}
+
+void TermsCounts::Merge(const TermsCounts& rhs) {
+  for (const auto& [term, count] : rhs.counts) {
+    counts[term] += count;
+  }
+}
+
+void HistogramCounts::Merge(const HistogramCounts& rhs) {
+  for (const auto& [bucket, count] : rhs.buckets) {
+    buckets[bucket] += count;
+  }
+}
+
+void NumericStats::Merge(const NumericStats& rhs) noexcept {
+  count += rhs.count;
+  sum += rhs.sum;
+  min = std::min(min, rhs.min);
+  max = std::max(max, rhs.max);
+}
+
+std::vector<AggregationResult> DocAggregator::MakeResults() const {
+  std::vector<AggregationResult> results;
+  results.reserve(requests_.size());
+  for (const auto& request : requests_) {
+    std::visit(
+      [&]<typename T>(const T&) {
+        if constexpr (std::is_same_v<T, HistogramAggregation>) {
+          results.emplace_back(HistogramCounts{});
+        } else if constexpr (std::is_same_v<T, StatsAggregation>) {
+          results.emplace_back(NumericStats{});
+        } else {
+          results.emplace_back(TermsCounts{});
+        }
+      },
+      request);
+  }
+  return results;
+}
+
+void DocAggregator::Collect(const SubReader& segment, doc_iterator& docs,
+                            std::span<AggregationResult> results) const {
+  const auto aggregations = MakeAggregations(segment, requests_, results);
+
+  if (aggregations.empty()) {
+    return;
+  }
+
+  bitset matched;
+  const bool requires_matched = RequiresMatched(aggregations);
+  if (requires_matched) {
+    matched.reset(doc_limits::min() + segment.docs_count());
+  }
+
+  DocsBlock block;
+  size_t size = 0;
+  while (docs.next()) {
+    const auto doc = docs.value();
+    block[size] = doc;
+    if (requires_matched) {
+      matched.set(doc);
+    }
+    if (++size == block.size()) {
+      CollectBlock(aggregations, block);
+      size = 0;
+    }
+  }
+  CollectBlock(aggregations, {block.data(), size});
+
+  Finish(aggregations, requires_matched ? &matched : nullptr);
+}
+
+void DocAggregator::Collect(const SubReader& segment, const bitset& docs,
+                            std::span<AggregationResult> results) const {
+  const auto aggregations = MakeAggregations(segment, requests_, results);
+
+  if (aggregations.empty()) {
+    return;
+  }
+
+  DocsBlock block;
+  size_t size = 0;
+  for (size_t i = 0, words = docs.words(); i < words; ++i) {
+    for (auto word = docs[i]; word; word &= word - 1) {
+      block[size] = static_cast<doc_id_t>(bitset::bit_offset(i) +
+                                          std::countr_zero(word));
+      if (++size == block.size()) {
+        CollectBlock(aggregations, block);
+        size = 0;
+      }
+    }
+  }
+  CollectBlock(aggregations, {block.data(), size});
+
+  Finish(aggregations, RequiresMatched(aggregations) ? &docs : nullptr);
+}
+
+void DocAggregator::Merge(std::span<AggregationResult> results,
+                          std::span<const AggregationResult> partial) {
+  IRS_ASSERT(results.size() == partial.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    std::visit(
+      [&]<typename T>(T& result) { result.Merge(std::get<T>(partial[i])); },
+      results[i]);
+  }
+}
+
+std::vector<AggregationResult> DocAggregator::Execute(
+  const IndexReader& index, const filter::prepared& query,
+  ThreadPool* pool) const {
+  auto collect = [&](const SubReader& segment) {
+    auto results = MakeResults();
+    auto docs = segment.mask(query.execute({.segment = segment}));
+    Collect(segment, *docs, results);
+    return results;
+  };
+
+  auto results = MakeResults();
+
+  if (!pool || index.size() < 2) {
+    for (const auto& segment : index) {
+      Merge(results, collect(segment));
+    }
+    return results;
+  }
+
+  std::vector<std::future<std::vector<AggregationResult>>> partials;
+  partials.reserve(index.size());
+  for (const auto& segment : index) {
+    auto task =
+      std::make_shared<std::packaged_task<std::vector<AggregationResult>()>>(
+        [&collect, &segment] { return collect(segment); });
+    partials.emplace_back(task->get_future());
+    if (!pool->run([task] { (*task)(); })) {
+      // a stopped pool rejects tasks
+      (*task)();
+    }
+  }
+
+  // tasks reference 'collect', wait for all of them before rethrowing
+  // an error of any
+  for (auto& partial : partials) {
+    partial.wait();
+  }
+
+  // merge in segment order to get results independent of scheduling
+  for (auto& partial : partials) {
+    Merge(results, partial.get());
+  }
+  return results;
+}
+
+}  // namespace irs
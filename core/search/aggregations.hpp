@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <limits>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "search/filter.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/bitset.hpp"
+#include "utils/string.hpp"
+
+namespace irs {
+
+// Decodes a numeric value stored in a column, returns false if a value
+// can't be decoded.
+using NumericDecoder = bool (*)(bytes_view value, double& out) noexcept;
+
+// Decodes a double stored in a native byte order.
+bool DecodeDouble(bytes_view value, double& out) noexcept;
+
+// Decodes an int64_t stored in a native byte order.
+bool DecodeInt64(bytes_view value, double& out) noexcept;
+
+// Counts matched documents by distinct values of a stored column.
+struct TermsAggregation {
+  std::string column;
+};
+
+// Counts matched documents by terms of an indexed field. Postings of every
+// term are intersected with matched documents, which is cheaper than reading
+// stored values for fields with a few terms.
+struct FieldTermsAggregation {
+  std::string field;
+};
+
+// Counts matched documents by buckets of numeric values of a stored column,
+// a value 'v' falls into a bucket 'floor((v - offset) / interval)'.
+// Values yielding a non-finite bucket are skipped.
+struct HistogramAggregation {
+  std::string column;
+  double interval{1.};
+  double offset{0.};
+  NumericDecoder decoder{&DecodeDouble};
+};
+
+// Computes count, min, max and sum of numeric values of a stored column.
+struct StatsAggregation {
+  std::string column;
+  NumericDecoder decoder{&DecodeDouble};
+};
+
+using AggregationRequest =
+  std::variant<TermsAggregation, FieldTermsAggregation, HistogramAggregation,
+               StatsAggregation>;
+
+struct TermsCounts {
+  absl::flat_hash_map<bstring, uint64_t> counts;
+
+  void Merge(const TermsCounts& rhs);
+};
+
+struct HistogramCounts {
+  absl::flat_hash_map<int64_t, uint64_t> buckets;
+
+  void Merge(const HistogramCounts& rhs);
+};
+
+struct NumericStats {
+  uint64_t count{};
+  double sum{};
+  double min{std::numeric_limits<double>::infinity()};
+  double max{-std::numeric_limits<double>::infinity()};
+
+  void Merge(const NumericStats& rhs) noexcept;
+};
+
+// TermsCounts is a result of both TermsAggregation and FieldTermsAggregation.
+using AggregationResult =
+  std::variant<TermsCounts, HistogramCounts, NumericStats>;
+
+// Computes aggregations over documents matched in a segment, values of
+// matched documents are read block by block in ascending order, segment
+// partials are merged into final results.
+class DocAggregator {
+ public:
+  using ThreadPool = async_utils::ThreadPool<false>;
+
+  // Number of documents processed at once.
+  static constexpr size_t kBlockSize = 256;
+
+  explicit DocAggregator(std::vector<AggregationRequest> requests)
+    : requests_{std::move(requests)} {}
+
+  // Returns empty results, one per request.
+  std::vector<AggregationResult> MakeResults() const;
+
+  // Aggregates documents produced by 'docs' in 'segment' into 'results'.
+  void Collect(const SubReader& segment, doc_iterator& docs,
+               std::span<AggregationResult> results) const;
+
+  // Aggregates documents set in 'docs' in 'segment' into 'results'.
+  void Collect(const SubReader& segment, const bitset& docs,
+               std::span<AggregationResult> results) const;
+
+  // Merges segment partial results into 'results'.
+  static void Merge(std::span<AggregationResult> results,
+                    std::span<const AggregationResult> partial);
+
+  // Aggregates live documents matched by 'query' in all segments of 'index',
+  // segments are processed concurrently by 'pool' if specified.
+  std::vector<AggregationResult> Execute(const IndexReader& index,
+                                         const filter::prepared& query,
+                                         ThreadPool* pool = nullptr) const;
+
+  const std::vector<AggregationRequest>& requests() const noexcept {
+    return requests_;
+  }
+
+ private:
+  std::vector<AggregationRequest> requests_;
+};
+
+}  // namespace irs
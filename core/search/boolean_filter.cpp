@@ -96,12 +96,35 @@ void boolean_filter::group_filters(AllDocsProvider::Ptr& all_docs_zero_boost,
   excl.reserve(incl.capacity());
 
   const filter* empty_filter = nullptr;
+  if (!group_filters(*this, all_docs_zero_boost, incl, excl, empty_filter)) {
+    incl.clear();
+    return;
+  }
+  if (empty_filter != nullptr) {
+    incl.push_back(empty_filter);
+  }
+}
+
+bool boolean_filter::group_filters(const boolean_filter& node,
+                                   AllDocsProvider::Ptr& all_docs_zero_boost,
+                                   std::vector<const filter*>& incl,
+                                   std::vector<const filter*>& excl,
+                                   const filter*& empty_filter) const {
   const auto is_or = type() == irs::type<Or>::id();
-  for (const auto& filter : *this) {
+  for (const auto& filter : node) {
     if (irs::type<Empty>::id() == filter->type()) {
       empty_filter = filter.get();
       continue;
     }
+    if (can_flatten(*filter)) {
+      // nested filters of the same kind are merged into a single node,
+      // e.g. the least costly iterator of the whole tree drives conjunction
+      if (!group_filters(DownCast<boolean_filter>(*filter),
+                         all_docs_zero_boost, incl, excl, empty_filter)) {
+        return false;
+      }
+      continue;
+    }
     if (irs::type<Not>::id() == filter->type()) {
       const auto res = optimize_not(DownCast<Not>(*filter));
 
@@ -116,8 +139,7 @@ void boolean_filter::group_filters(AllDocsProvider::Ptr& all_docs_zero_boost,
 
         if (*all_docs_zero_boost == *res.first) {
           // not all -> empty result
-          incl.clear();
-          return;
+          return false;
         }
         excl.push_back(res.first);
         if (is_or) {
@@ -132,9 +154,36 @@ void boolean_filter::group_filters(AllDocsProvider::Ptr& all_docs_zero_boost,
       incl.push_back(filter.get());
     }
   }
-  if (empty_filter != nullptr) {
-    incl.push_back(empty_filter);
+  return true;
+}
+
+bool boolean_filter::can_flatten(const filter& node) const noexcept {
+  if (node.type() != type()) {
+    return false;
   }
+
+  const auto& typed_node = DownCast<boolean_filter>(node);
+
+  if (typed_node.boost() != kNoBoost ||
+      typed_node.merge_type() != merge_type() || typed_node.empty()) {
+    return false;
+  }
+
+  const auto is_not = [](const filter::ptr& filter) noexcept {
+    return irs::type<Not>::id() == filter->type();
+  };
+
+  if (type() == irs::type<Or>::id()) {
+    // nested exclusions are applied only to a nested disjunction,
+    // nested match counts differ from the top-level ones
+    return 1 == DownCast<Or>(*this).min_match_count() &&
+           1 == DownCast<Or>(node).min_match_count() &&
+           std::none_of(typed_node.begin(), typed_node.end(), is_not);
+  }
+
+  // negative only conjunction matches all documents but the excluded ones
+  // contributing to a score
+  return !std::all_of(typed_node.begin(), typed_node.end(), is_not);
 }
 
 filter::prepared::ptr And::PrepareBoolean(std::vector<const filter*>& incl,
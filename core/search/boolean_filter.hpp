@@ -71,6 +71,17 @@ class boolean_filter : public FilterWithBoost, public AllDocsProvider {
                      std::vector<const filter*>& incl,
                      std::vector<const filter*>& excl) const;
 
+  // Returns false if 'node' matches no documents.
+  bool group_filters(const boolean_filter& node,
+                     AllDocsProvider::Ptr& all_docs_zero_boost,
+                     std::vector<const filter*>& incl,
+                     std::vector<const filter*>& excl,
+                     const filter*& empty_filter) const;
+
+  // Returns true if 'node' may be replaced with its sub-filters without
+  // affecting matched documents and their scores.
+  bool can_flatten(const filter& node) const noexcept;
+
   std::vector<filter::ptr> filters_;
   ScoreMergeType merge_type_{ScoreMergeType::kSum};
 };
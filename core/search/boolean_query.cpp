@@ -22,13 +22,152 @@
 
 #include "search/boolean_query.hpp"
 
+#include "search/bitset_doc_iterator.hpp"
 #include "search/conjunction.hpp"
 #include "search/disjunction.hpp"
 #include "search/prepared_state_visitor.hpp"
+#include "utils/bitset.hpp"
 
 namespace irs {
 namespace {
 
+// Unscored disjunctions of more iterators than a small disjunction accepts
+// are materialized into a bitset if they're expected to match at least
+// a document per this many documents of a segment
+constexpr cost::cost_t kBitsetDensity = bits_required<bitset::word_t>();
+
+// Block disjunction fills a window of this many documents at once, merging
+// sparser iterators document by document is cheaper
+constexpr cost::cost_t kBlockWindow =
+  block_disjunction_traits<MatchType::kMatch, false>::kNumBlocks *
+  bits_required<uint64_t>();
+
+// Conjunction applies exclusion to the driving iterator if excluded documents
+// are expected to cover at least this fraction of a segment per each
+// iterator verifying candidates of the driving one
+constexpr cost::cost_t kExclusionPushDownRatio = 1;
+
+// Unscored disjunction materialized into a bitset on first access
+class bitset_disjunction : public bitset_doc_iterator {
+ public:
+  bitset_disjunction(const SubReader& segment, ScoreAdapters&& itrs,
+                     cost::cost_t estimation) noexcept
+    : bitset_doc_iterator{estimation},
+      itrs_{std::move(itrs)},
+      segment_{&segment} {
+    IRS_ASSERT(!itrs_.empty());
+  }
+
+  attribute* get_mutable(irs::type_info::type_id id) noexcept final {
+    return irs::type<score>::id() == id ? &score_
+                                        : bitset_doc_iterator::get_mutable(id);
+  }
+
+ protected:
+  bool refill(const word_t** begin, const word_t** end) final;
+
+ private:
+  score score_;
+  std::unique_ptr<word_t[]> set_;
+  ScoreAdapters itrs_;
+  const SubReader* segment_;
+};
+
+bool bitset_disjunction::refill(const word_t** begin, const word_t** end) {
+  static_assert(sizeof(word_t) == sizeof(uint64_t));
+
+  if (itrs_.empty()) {
+    return false;
+  }
+
+  const size_t bits = segment_->docs_count() + doc_limits::min();
+  const size_t words = bitset::bits_to_words(bits);
+  set_ = std::make_unique<word_t[]>(words);
+  std::memset(set_.get(), 0, sizeof(word_t) * words);
+
+  bool empty = true;
+  for (auto& it : itrs_) {
+    if (!it->next()) {
+      continue;
+    }
+
+    empty = false;
+
+    if (it.bitmap && *it.bitmap) {
+      (*it.bitmap)(0, static_cast<doc_id_t>(bits),
+                   reinterpret_cast<uint64_t*>(set_.get()));
+      continue;
+    }
+
+    do {
+      const auto doc = it.value();
+      IRS_ASSERT(doc < bits);
+      set_bit(set_[doc / bits_required<word_t>()],
+              doc % bits_required<word_t>());
+    } while (it->next());
+  }
+
+  ScoreAdapters{}.swap(itrs_);
+
+  if (empty) {
+    return false;
+  }
+
+  *begin = set_.get();
+  *end = set_.get() + words;
+  return true;
+}
+
+// Returns sum of costs of the specified iterators or cost::kMax if any of
+// them isn't known without evaluation
+cost::cost_t PeekCosts(const ScoreAdapters& itrs, BooleanPlan* plan) {
+  cost::cost_t total = 0;
+  for (auto& it : itrs) {
+    const auto est = cost::peek(it);
+    if (plan) {
+      plan->costs.emplace_back(est);
+    }
+    total = (cost::kMax == est || cost::kMax - total < est) ? cost::kMax
+                                                            : total + est;
+  }
+  return total;
+}
+
+// Chooses disjunction implementation based on known costs of sub-iterators,
+// costs are never evaluated since disjunction might not need them
+BooleanStrategy PlanDisjunction(const ExecutionContext& ctx,
+                                const ScoreAdapters& itrs, BooleanPlan* plan) {
+  const auto total = PeekCosts(itrs, plan);
+  const auto size = itrs.size();
+
+  if (1 == size) {
+    return BooleanStrategy::kUnary;
+  }
+
+  if (2 == size) {
+    // both implementations fall back to the same 2-way disjunction
+    return BooleanStrategy::kSmallDisjunction;
+  }
+
+  if (cost::kMax == total || ctx.wand.Enabled()) {
+    return BooleanStrategy::kBlockDisjunction;
+  }
+
+  const auto docs_count = ctx.segment.docs_count();
+
+  if (size > disjunction<doc_iterator::ptr, NoopAggregator>::
+               kSmallDisjunctionUpperBound) {
+    return ctx.scorers.empty() && docs_count != 0 &&
+               total >= docs_count / kBitsetDensity
+             ? BooleanStrategy::kBitset
+             : BooleanStrategy::kBlockDisjunction;
+  }
+
+  return total < docs_count / kBlockWindow
+           ? BooleanStrategy::kSmallDisjunction
+           : BooleanStrategy::kBlockDisjunction;
+}
+
 template<bool Conjunction, typename It>
 irs::ScoreAdapters MakeScoreAdapters(const irs::ExecutionContext& ctx, It begin,
                                      It end) {
@@ -63,11 +202,11 @@ irs::ScoreAdapters MakeScoreAdapters(const irs::ExecutionContext& ctx, It begin,
 }
 
 // Returns disjunction iterator created from the specified queries
-template<typename QueryIterator, typename... Args>
+template<typename QueryIterator>
 irs::doc_iterator::ptr make_disjunction(const irs::ExecutionContext& ctx,
                                         irs::ScoreMergeType merge_type,
                                         QueryIterator begin, QueryIterator end,
-                                        Args&&... args) {
+                                        BooleanPlan* plan = nullptr) {
   IRS_ASSERT(begin <= end);
   const size_t size = std::distance(begin, end);
   // check the size before the execution
@@ -81,24 +220,44 @@ irs::doc_iterator::ptr make_disjunction(const irs::ExecutionContext& ctx,
     return irs::doc_iterator::empty();
   }
 
+  const auto strategy = PlanDisjunction(ctx, itrs, plan);
+  if (plan) {
+    plan->strategy = strategy;
+  }
+
+  if (BooleanStrategy::kBitset == strategy) {
+    const auto estimation = PeekCosts(itrs, nullptr);
+    return memory::make_managed<bitset_disjunction>(
+      ctx.segment, std::move(itrs), estimation);
+  }
+
   return irs::ResoveMergeType(
     merge_type, ctx.scorers.buckets().size(),
     [&]<typename A>(A&& aggregator) -> irs::doc_iterator::ptr {
+      if (BooleanStrategy::kSmallDisjunction == strategy) {
+        using disjunction_t = irs::disjunction<irs::doc_iterator::ptr, A>;
+
+        return irs::MakeDisjunction<disjunction_t>(ctx.wand, std::move(itrs),
+                                                   std::forward<A>(aggregator));
+      }
+
       using disjunction_t =
         irs::disjunction_iterator<irs::doc_iterator::ptr, A>;
 
       return irs::MakeDisjunction<disjunction_t>(ctx.wand, std::move(itrs),
-                                                 std::forward<A>(aggregator),
-                                                 std::forward<Args>(args)...);
+                                                 std::forward<A>(aggregator));
     });
 }
 
-// Returns conjunction iterator created from the specified queries
-template<typename QueryIterator, typename... Args>
+// Returns conjunction iterator created from the specified queries,
+// exclusion 'excl' is applied to the least costly iterator driving
+// conjunction if it's expected to reject enough of its candidates
+template<typename QueryIterator>
 irs::doc_iterator::ptr make_conjunction(const irs::ExecutionContext& ctx,
                                         irs::ScoreMergeType merge_type,
                                         QueryIterator begin, QueryIterator end,
-                                        Args&&... args) {
+                                        doc_iterator::ptr* excl = nullptr,
+                                        BooleanPlan* plan = nullptr) {
   IRS_ASSERT(begin <= end);
   const size_t size = std::distance(begin, end);
   // check size before the execution
@@ -106,6 +265,9 @@ irs::doc_iterator::ptr make_conjunction(const irs::ExecutionContext& ctx,
     case 0:
       return irs::doc_iterator::empty();
     case 1:
+      if (plan) {
+        plan->strategy = BooleanStrategy::kUnary;
+      }
       return (*begin)->execute(ctx);
   }
 
@@ -114,17 +276,78 @@ irs::doc_iterator::ptr make_conjunction(const irs::ExecutionContext& ctx,
     return irs::doc_iterator::empty();
   }
 
+  // conjunction evaluates costs of all iterators anyway
+  size_t driver = 0;
+  cost::cost_t driver_cost = cost::kMax;
+  for (size_t i = 0; auto& it : itrs) {
+    const auto est = cost::extract(it);
+    if (plan) {
+      plan->costs.emplace_back(est);
+    }
+    if (est < driver_cost) {
+      driver = i;
+      driver_cost = est;
+    }
+    ++i;
+  }
+
+  if (plan) {
+    plan->strategy = BooleanStrategy::kConjunction;
+    plan->driver = driver;
+  }
+
+  if (excl && *excl &&
+      cost::extract(**excl, 0) * (itrs.size() - 1) >=
+        ctx.segment.docs_count() * kExclusionPushDownRatio) {
+    auto& lead = itrs[driver];
+    lead = {memory::make_managed<exclusion>(std::move(lead), std::move(*excl))};
+    if (plan) {
+      plan->exclusion_pushed_down = true;
+    }
+  }
+
   return irs::ResoveMergeType(
     merge_type, ctx.scorers.buckets().size(),
     [&]<typename A>(A&& aggregator) -> irs::doc_iterator::ptr {
       return irs::MakeConjunction(ctx.wand, std::forward<A>(aggregator),
-                                  std::move(itrs), std::forward<Args>(args)...);
+                                  std::move(itrs));
     });
 }
 
 }  // namespace
 
+std::string_view ToString(BooleanStrategy strategy) noexcept {
+  switch (strategy) {
+    case BooleanStrategy::kEmpty:
+      return "empty";
+    case BooleanStrategy::kUnary:
+      return "unary";
+    case BooleanStrategy::kConjunction:
+      return "conjunction";
+    case BooleanStrategy::kBlockDisjunction:
+      return "block_disjunction";
+    case BooleanStrategy::kSmallDisjunction:
+      return "small_disjunction";
+    case BooleanStrategy::kBitset:
+      return "bitset";
+    case BooleanStrategy::kMinMatch:
+      return "min_match";
+  }
+  return {};
+}
+
 doc_iterator::ptr BooleanQuery::execute(const ExecutionContext& ctx) const {
+  return Execute(ctx, nullptr);
+}
+
+BooleanPlan BooleanQuery::Explain(const ExecutionContext& ctx) const {
+  BooleanPlan plan;
+  Execute(ctx, &plan);
+  return plan;
+}
+
+doc_iterator::ptr BooleanQuery::Execute(const ExecutionContext& ctx,
+                                        BooleanPlan* plan) const {
   if (empty()) {
     return doc_iterator::empty();
   }
@@ -133,20 +356,23 @@ doc_iterator::ptr BooleanQuery::execute(const ExecutionContext& ctx) const {
   const auto excl_begin = this->excl_begin();
   const auto end = this->end();
 
-  auto incl = execute(ctx, begin(), excl_begin);
+  doc_iterator::ptr excl;
+  if (excl_begin != end) {
+    // exclusion part does not affect scoring at all
+    excl = make_disjunction(
+      {.segment = ctx.segment, .scorers = Scorers::kUnordered, .ctx = ctx.ctx},
+      irs::ScoreMergeType::kNoop, excl_begin, end);
 
-  if (excl_begin == end) {
-    return incl;
+    // got empty iterator for excluded
+    if (doc_limits::eof(excl->value())) {
+      excl = nullptr;
+    }
   }
 
-  // exclusion part does not affect scoring at all
-  auto excl = make_disjunction(
-    {.segment = ctx.segment, .scorers = Scorers::kUnordered, .ctx = ctx.ctx},
-    irs::ScoreMergeType::kNoop, excl_begin, end);
+  auto incl = execute(ctx, begin(), excl_begin, excl, plan);
 
-  // got empty iterator for excluded
-  if (doc_limits::eof(excl->value())) {
-    // pure conjunction/disjunction
+  if (!excl) {
+    // pure conjunction/disjunction or exclusion has been applied
     return incl;
   }
 
@@ -200,17 +426,21 @@ void BooleanQuery::prepare(const PrepareContext& ctx, ScoreMergeType merge_type,
 }
 
 doc_iterator::ptr AndQuery::execute(const ExecutionContext& ctx, iterator begin,
-                                    iterator end) const {
-  return make_conjunction(ctx, merge_type(), begin, end);
+                                    iterator end, doc_iterator::ptr& excl,
+                                    BooleanPlan* plan) const {
+  return make_conjunction(ctx, merge_type(), begin, end, &excl, plan);
 }
 
 doc_iterator::ptr OrQuery::execute(const ExecutionContext& ctx, iterator begin,
-                                   iterator end) const {
-  return make_disjunction(ctx, merge_type(), begin, end);
+                                   iterator end, doc_iterator::ptr& /*excl*/,
+                                   BooleanPlan* plan) const {
+  return make_disjunction(ctx, merge_type(), begin, end, plan);
 }
 
 doc_iterator::ptr MinMatchQuery::execute(const ExecutionContext& ctx,
-                                         iterator begin, iterator end) const {
+                                         iterator begin, iterator end,
+                                         doc_iterator::ptr& /*excl*/,
+                                         BooleanPlan* plan) const {
   IRS_ASSERT(std::distance(begin, end) >= 0);
   const auto size = size_t(std::distance(begin, end));
 
@@ -223,7 +453,7 @@ doc_iterator::ptr MinMatchQuery::execute(const ExecutionContext& ctx,
     return doc_iterator::empty();
   } else if (min_match_count == size) {
     // pure conjunction
-    return make_conjunction(ctx, merge_type(), begin, end);
+    return make_conjunction(ctx, merge_type(), begin, end, nullptr, plan);
   }
 
   // min_match_count <= size
@@ -234,6 +464,11 @@ doc_iterator::ptr MinMatchQuery::execute(const ExecutionContext& ctx,
     return irs::doc_iterator::empty();
   }
 
+  if (plan) {
+    plan->strategy = BooleanStrategy::kMinMatch;
+    PeekCosts(itrs, plan);
+  }
+
   return ResoveMergeType(merge_type(), ctx.scorers.buckets().size(),
                          [&]<typename A>(A&& aggregator) -> doc_iterator::ptr {
                            // FIXME(gnusi): use FAST version
@@ -24,11 +24,44 @@
 
 #include <vector>
 
+#include "search/cost.hpp"
 #include "search/exclusion.hpp"
 #include "search/filter.hpp"
 
 namespace irs {
 
+// Strategy of boolean query execution chosen for a segment
+enum class BooleanStrategy : uint8_t {
+  // No documents match
+  kEmpty,
+  // Single included query, no iterators are combined
+  kUnary,
+  // Leap-frog conjunction driven by the least costly iterator
+  kConjunction,
+  // Block disjunction, default for disjunctions
+  kBlockDisjunction,
+  // Disjunction of a few sparse iterators merged document by document
+  kSmallDisjunction,
+  // Unscored disjunction of many dense iterators materialized into a bitset
+  kBitset,
+  // Disjunction with the minimum number of matched iterators
+  kMinMatch,
+};
+
+std::string_view ToString(BooleanStrategy strategy) noexcept;
+
+// Execution plan of a boolean query for a segment, intended for debugging
+struct BooleanPlan {
+  BooleanStrategy strategy{BooleanStrategy::kEmpty};
+  // Estimated costs of included iterators in order of execution,
+  // cost::kMax denotes costs which weren't known at planning time
+  std::vector<cost::cost_t> costs;
+  // Index of an iterator driving conjunction in "costs"
+  size_t driver{0};
+  // Exclusion is applied to the driving iterator rather than to the result
+  bool exclusion_pushed_down{false};
+};
+
 // Base class for boolean queries
 class BooleanQuery : public filter::prepared {
  public:
@@ -37,6 +70,9 @@ class BooleanQuery : public filter::prepared {
 
   doc_iterator::ptr execute(const ExecutionContext& ctx) const final;
 
+  // Returns execution plan chosen for a segment specified by 'ctx'.
+  BooleanPlan Explain(const ExecutionContext& ctx) const;
+
   void visit(const irs::SubReader& segment, irs::PreparedStateVisitor& visitor,
              score_t boost) const final;
 
@@ -57,12 +93,20 @@ class BooleanQuery : public filter::prepared {
   size_t size() const { return queries_.size(); }
 
  protected:
+  // Returns iterator over included queries, an implementation may take
+  // ownership of iterator over excluded documents 'excl' to apply it
+  // before combining iterators, chosen strategy is reported to 'plan'
+  // unless it's nullptr.
   virtual doc_iterator::ptr execute(const ExecutionContext& ctx, iterator begin,
-                                    iterator end) const = 0;
+                                    iterator end, doc_iterator::ptr& excl,
+                                    BooleanPlan* plan) const = 0;
 
   ScoreMergeType merge_type() const noexcept { return merge_type_; }
 
  private:
+  doc_iterator::ptr Execute(const ExecutionContext& ctx,
+                            BooleanPlan* plan) const;
+
   // 0..excl_-1 - included queries
   // excl_..queries.end() - excluded queries
   queries_t queries_;
@@ -76,14 +120,16 @@ class BooleanQuery : public filter::prepared {
 class AndQuery : public BooleanQuery {
  public:
   doc_iterator::ptr execute(const ExecutionContext& ctx, iterator begin,
-                            iterator end) const final;
+                            iterator end, doc_iterator::ptr& excl,
+                            BooleanPlan* plan) const final;
 };
 
 // Represent a set of queries joint by "Or"
 class OrQuery : public BooleanQuery {
  public:
   doc_iterator::ptr execute(const ExecutionContext& ctx, iterator begin,
-                            iterator end) const final;
+                            iterator end, doc_iterator::ptr& excl,
+                            BooleanPlan* plan) const final;
 };
 
 // Represent a set of queries joint by "Or" with the specified
@@ -96,7 +142,8 @@ class MinMatchQuery : public BooleanQuery {
   }
 
   doc_iterator::ptr execute(const ExecutionContext& ctx, iterator begin,
-                            iterator end) const final;
+                            iterator end, doc_iterator::ptr& excl,
+                            BooleanPlan* plan) const final;
 
  private:
   size_t min_match_count_;
@@ -24,6 +24,7 @@
 
 #include "analysis/token_attributes.hpp"
 #include "search/cost.hpp"
+#include "search/doc_bitmap.hpp"
 #include "search/score.hpp"
 #include "utils/attribute_helper.hpp"
 #include "utils/empty.hpp"
@@ -38,7 +39,8 @@ struct ScoreAdapter {
   ScoreAdapter(DocIterator&& it) noexcept
     : it{std::move(it)},
       doc{irs::get<irs::document>(*this->it)},
-      score{&irs::score::get(*this->it)} {
+      score{&irs::score::get(*this->it)},
+      bitmap{irs::get<irs::doc_bitmap>(*this->it)} {
     IRS_ASSERT(doc);
   }
 
@@ -65,6 +67,7 @@ struct ScoreAdapter {
   DocIterator it;
   const irs::document* doc{};
   const irs::score* score{};
+  const irs::doc_bitmap* bitmap{};
 };
 
 using ScoreAdapters = std::vector<ScoreAdapter<>>;
@@ -176,9 +179,17 @@ class Conjunction : public ConjunctionBase<DocIterator, Merger> {
       this->PrepareScore(score, Base::Score2, Base::ScoreN,
                          ScoreFunction::DefaultMin);
     }
+
+    if (std::all_of(this->itrs_.begin(), this->itrs_.end(),
+                    [](const auto& it) noexcept { return it.bitmap; })) {
+      bitmap_ = doc_bitmap{this, &FillBitmap};
+    }
   }
 
   attribute* get_mutable(irs::type_info::type_id type) noexcept final {
+    if (irs::type<doc_bitmap>::id() == type) {
+      return bitmap_ ? &bitmap_ : nullptr;
+    }
     return irs::get_mutable(attrs_, type);
   }
 
@@ -222,9 +233,44 @@ class Conjunction : public ConjunctionBase<DocIterator, Merger> {
     return target;
   }
 
+  // Intersects bitmap windows of all sub-iterators
+  static bool FillBitmap(void* ctx, doc_id_t base, doc_id_t max,
+                         uint64_t* words) {
+    constexpr auto kBits = bits_required<uint64_t>();
+
+    auto& self = *static_cast<Conjunction*>(ctx);
+    const size_t count = (max - base + kBits - 1) / kBits;
+    self.bitmap_buf_.assign(2 * count, 0);
+    auto* lhs = self.bitmap_buf_.data();
+    auto* rhs = lhs + count;
+
+    auto it = self.itrs_.begin();
+    const auto end = self.itrs_.end();
+    bool exhausted = !(*it->bitmap)(base, max, lhs);
+    for (++it; it != end; ++it) {
+      std::memset(rhs, 0, count * sizeof(uint64_t));
+      exhausted |= !(*it->bitmap)(base, max, rhs);
+      for (size_t i = 0; i < count; ++i) {
+        lhs[i] &= rhs[i];
+      }
+    }
+    for (size_t i = 0; i < count; ++i) {
+      words[i] |= lhs[i];
+    }
+
+    if (exhausted) {
+      self.front_->seek(doc_limits::eof());
+      return false;
+    }
+
+    return !doc_limits::eof(self.converge(*self.front_doc_));
+  }
+
   Attributes attrs_;
   doc_iterator* front_;
   const doc_id_t* front_doc_{};
+  doc_bitmap bitmap_;
+  std::vector<uint64_t> bitmap_buf_;
 };
 
 template<bool Root, typename DocIterator, typename Merger>
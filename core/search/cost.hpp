@@ -63,6 +63,18 @@ class cost final : public attribute {
     }
   }
 
+  // Returns a value of the "cost" attribute in the specified "src"
+  // collection if it's already known, i.e. doesn't require evaluation of
+  // an estimation rule, or "def" value otherwise.
+  template<typename Provider>
+  static cost_t peek(const Provider& src, cost_t def = kMax) noexcept {
+    if (auto* attr = irs::get<irs::cost>(src); attr && !attr->func_) {
+      return attr->value_;
+    } else {
+      return def;
+    }
+  }
+
   // Sets the estimation value.
   void reset(cost_t value) noexcept {
     value_ = value;
@@ -1318,6 +1318,19 @@ class block_disjunction : public doc_iterator,
       return false;
     }
 
+    if constexpr (!Score && !traits_type::kMinMatch) {
+      if (it.bitmap) {
+        // OR the whole window at once
+        empty &= *doc >= max_;
+        if (!(*it.bitmap)(doc_base_, max_, mask_)) {
+          // exhausted
+          return false;
+        }
+        min_ = std::min(*doc, min_);
+        return true;
+      }
+    }
+
     for (;;) {
       const auto value = *doc;
 
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "utils/assert.hpp"
+#include "utils/attribute_provider.hpp"
+#include "utils/type_limits.hpp"
+
+namespace irs {
+
+// Allows to union documents of an iterator into a bitmap window at once,
+// without iterating them one by one. Exposed by iterators capable of
+// producing bitmap words directly, e.g. postings with dense blocks.
+// Iterators changing the set of documents of an underlying iterator
+// must not forward this attribute.
+class doc_bitmap final : public attribute {
+ public:
+  // Sets bit 'doc - base' in 'words' for the current document and all the
+  // subsequent documents less than 'max', then positions the iterator at the
+  // first document not less than 'max'.
+  // Iterator must be positioned at a valid document not less than 'base'.
+  // Returns 'false' if iterator is exhausted.
+  using fill_f = bool (*)(void* ctx, doc_id_t base, doc_id_t max,
+                          uint64_t* words);
+
+  static constexpr std::string_view type_name() noexcept {
+    return "irs::doc_bitmap";
+  }
+
+  doc_bitmap() = default;
+  doc_bitmap(void* ctx, fill_f func) noexcept : ctx_{ctx}, func_{func} {
+    IRS_ASSERT(func_);
+  }
+
+  explicit operator bool() const noexcept { return func_ != nullptr; }
+
+  bool operator()(doc_id_t base, doc_id_t max, uint64_t* words) const {
+    IRS_ASSERT(func_);
+    return func_(ctx_, base, max, words);
+  }
+
+ private:
+  void* ctx_{};
+  fill_f func_{};
+};
+
+}  // namespace irs
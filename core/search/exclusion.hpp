@@ -24,6 +24,7 @@
 
 #include "analysis/token_attributes.hpp"
 #include "index/iterators.hpp"
+#include "search/doc_bitmap.hpp"
 
 namespace irs {
 
@@ -65,7 +66,9 @@ class exclusion : public doc_iterator {
   }
 
   attribute* get_mutable(type_info::type_id type) noexcept final {
-    return incl_->get_mutable(type);
+    // excluded documents can't be skipped within a bitmap window
+    return irs::type<doc_bitmap>::id() == type ? nullptr
+                                               : incl_->get_mutable(type);
   }
 
  private:
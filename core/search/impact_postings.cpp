@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "impact_postings.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "analysis/token_attributes.hpp"
+#include "index/index_reader.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+#include "utils/type_limits.hpp"
+
+namespace irs {
+namespace {
+
+// Accumulated scores of documents touched in a segment.
+using Accumulator = absl::flat_hash_map<doc_id_t, score_t>;
+
+struct Cursor {
+  // estimated impact
+  score_t impact;
+  uint32_t freq;
+  size_t segment;
+  size_t term;
+  const ImpactPostings* postings;
+  const ImpactPostings::Group* group;
+};
+
+std::string MakeKey(std::string_view field, bytes_view term, size_t levels) {
+  // field names never contain '\0', hence keys are unambiguous
+  return absl::StrCat(levels, ":", field, std::string_view{"\0", 1},
+                      ViewCast<char>(term));
+}
+
+// Collects 'k' documents with the highest accumulated scores.
+std::vector<AnytimeHit> TopK(std::span<const Accumulator> accumulators,
+                             size_t k) {
+  // lower score or a later document goes first
+  auto greater = [](const AnytimeHit& lhs, const AnytimeHit& rhs) noexcept {
+    if (lhs.score != rhs.score) {
+      return lhs.score > rhs.score;
+    }
+    return lhs.segment != rhs.segment ? lhs.segment < rhs.segment
+                                      : lhs.doc < rhs.doc;
+  };
+
+  std::vector<AnytimeHit> hits;
+  if (!k) {
+    return hits;
+  }
+  hits.reserve(k);
+
+  for (size_t segment = 0; segment < accumulators.size(); ++segment) {
+    for (const auto& [doc, score] : accumulators[segment]) {
+      const AnytimeHit hit{segment, doc, score};
+      if (hits.size() < k) {
+        hits.emplace_back(hit);
+        std::push_heap(hits.begin(), hits.end(), greater);
+      } else if (greater(hit, hits.front())) {
+        std::pop_heap(hits.begin(), hits.end(), greater);
+        hits.back() = hit;
+        std::push_heap(hits.begin(), hits.end(), greater);
+      }
+    }
+  }
+
+  std::sort_heap(hits.begin(), hits.end(), greater);
+  return hits;
+}
+
+// Scores documents of a term in a segment sought in ascending order.
+class TermScorer {
+ public:
+  TermScorer(doc_iterator::ptr&& it, const Scorers& scorers)
+    : it_{std::move(it)},
+      score_{scorers.empty() ? nullptr : irs::get<irs::score>(*it_)},
+      buf_(std::max(size_t{1}, scorers.buckets().size())) {}
+
+  // Returns current document.
+  doc_id_t value() const noexcept { return it_->value(); }
+
+  // Returns false if 'doc' doesn't match, e.g. it's deleted.
+  bool Score(doc_id_t doc, score_t& value) {
+    if (it_->seek(doc) != doc) {
+      return false;
+    }
+    value = 0.f;
+    if (score_) {
+      score_->Score(buf_.data());
+      value = std::max(0.f, buf_.front());
+    }
+    return true;
+  }
+
+ private:
+  doc_iterator::ptr it_;
+  const score* score_;
+  std::vector<score_t> buf_;
+};
+
+}  // namespace
+
+ImpactPostings::ImpactPostings(const term_reader& field, bytes_view term,
+                               IResourceManager& resource_manager,
+                               size_t levels)
+  : docs_{{resource_manager}}, groups_{{resource_manager}} {
+  IRS_ASSERT(levels > 0);
+  IRS_ASSERT(levels <= std::numeric_limits<uint32_t>::max());
+  auto terms = field.iterator(SeekMode::RANDOM_ONLY);
+
+  if (IRS_UNLIKELY(!terms) || !terms->seek(term)) {
+    return;
+  }
+
+  terms->read();
+  const bool has_freq =
+    IndexFeatures::NONE != (field.meta().index_features & IndexFeatures::FREQ);
+  auto it =
+    terms->postings(has_freq ? IndexFeatures::FREQ : IndexFeatures::NONE);
+  const auto* freq = has_freq ? irs::get<frequency>(*it) : nullptr;
+
+  // documents follow in ascending order, hence a stable sort keeps them so
+  std::vector<std::pair<uint32_t, doc_id_t>> postings;
+  while (it->next()) {
+    const auto level = freq ? std::clamp<uint32_t>(
+                                freq->value, 1, static_cast<uint32_t>(levels))
+                            : 1;
+    postings.emplace_back(level, it->value());
+  }
+
+  std::stable_sort(postings.begin(), postings.end(),
+                   [](const auto& lhs, const auto& rhs) noexcept {
+                     return lhs.first > rhs.first;
+                   });
+
+  docs_.reserve(postings.size());
+  for (auto begin = postings.begin(); begin != postings.end();) {
+    Group group{.freq = begin->first,
+                .begin = static_cast<uint32_t>(docs_.size()),
+                .end = 0};
+    auto end = begin;
+    for (; end != postings.end() && end->first == begin->first; ++end) {
+      docs_.emplace_back(end->second);
+    }
+    group.end = static_cast<uint32_t>(docs_.size());
+    groups_.emplace_back(group);
+    begin = end;
+  }
+}
+
+AnytimeResult AnytimeSearch(const IndexReader& index, std::string_view field,
+                            std::span<const bytes_view> terms,
+                            const Scorers& scorers, ImpactPostingsCache& cache,
+                            const AnytimeOptions& options) {
+  using clock = std::chrono::steady_clock;
+  const auto start = clock::now();
+  const bool timed = options.max_time != clock::duration::max();
+  // number of postings processed between checks of the time budget
+  constexpr size_t kTimeCheckInterval = 1024;
+
+  std::vector<filter::prepared::ptr> queries;
+  queries.reserve(terms.size());
+  for (const auto term : terms) {
+    queries.emplace_back(
+      by_term::prepare({.index = index, .scorers = scorers}, field, term));
+  }
+
+  auto make_scorer = [&](const SubReader& segment, size_t term, bool masked) {
+    auto it = queries[term]->execute({.segment = segment, .scorers = scorers});
+    return TermScorer{masked ? segment.mask(std::move(it)) : std::move(it),
+                      scorers};
+  };
+
+  AnytimeResult result;
+  auto exhausted = [&] {
+    return result.postings >= options.max_postings ||
+           (timed && clock::now() - start >= options.max_time);
+  };
+
+  std::vector<std::shared_ptr<const ImpactPostings>> postings;
+  std::vector<Cursor> cursors;
+  std::vector<std::pair<doc_id_t, size_t>> first_docs;
+  for (size_t segment = 0; segment < index.size() && !exhausted(); ++segment) {
+    const auto& reader = index[segment];
+    const auto* field_reader = reader.field(field);
+    if (!field_reader) {
+      continue;
+    }
+
+    for (size_t i = 0; i < terms.size() && !exhausted(); ++i) {
+      bool built = false;
+      const auto& term_postings = postings.emplace_back(
+        cache.Get(reader, MakeKey(field, terms[i], options.levels), [&] {
+          built = true;
+          return std::make_shared<const ImpactPostings>(
+            *field_reader, terms[i], cache.ResourceManager(), options.levels);
+        }));
+      if (built) {
+        result.postings += term_postings->size();
+        if (exhausted()) {
+          break;
+        }
+      }
+
+      const auto groups = term_postings->groups();
+      if (groups.empty()) {
+        continue;
+      }
+
+      // score the first document of every group in a single pass
+      first_docs.clear();
+      for (size_t j = 0; j < groups.size(); ++j) {
+        first_docs.emplace_back(term_postings->docs(groups[j]).front(), j);
+      }
+      std::sort(first_docs.begin(), first_docs.end());
+      result.postings += first_docs.size();
+
+      const auto offset = cursors.size();
+      cursors.resize(offset + groups.size());
+      auto scorer = make_scorer(reader, i, false);
+      for (const auto& [doc, j] : first_docs) {
+        score_t impact = 0.f;
+        [[maybe_unused]] const bool found = scorer.Score(doc, impact);
+        IRS_ASSERT(found);
+        cursors[offset + j] = Cursor{.impact = impact,
+                                     .freq = groups[j].freq,
+                                     .segment = segment,
+                                     .term = i,
+                                     .postings = term_postings.get(),
+                                     .group = &groups[j]};
+      }
+    }
+  }
+
+  // process highest impacts first, higher frequencies break ties
+  std::stable_sort(cursors.begin(), cursors.end(),
+                   [](const Cursor& lhs, const Cursor& rhs) noexcept {
+                     return lhs.impact != rhs.impact ? lhs.impact > rhs.impact
+                                                     : lhs.freq > rhs.freq;
+                   });
+
+  // scorers of terms in segments are reused by subsequent groups unless
+  // a group starts before the current document of a scorer
+  std::vector<std::optional<TermScorer>> term_scorers(index.size() *
+                                                      terms.size());
+  std::vector<Accumulator> accumulators(index.size());
+
+  auto cursor = cursors.begin();
+  for (; cursor != cursors.end() && !exhausted(); ++cursor) {
+    auto& scores = accumulators[cursor->segment];
+    auto docs = cursor->postings->docs(*cursor->group);
+    auto& scorer = term_scorers[cursor->segment * terms.size() + cursor->term];
+    if (!scorer || scorer->value() >= docs.front()) {
+      scorer.emplace(make_scorer(index[cursor->segment], cursor->term, true));
+    }
+    while (!docs.empty()) {
+      const auto budget = std::min(options.max_postings - result.postings,
+                                   kTimeCheckInterval);
+      const auto chunk = docs.first(std::min(docs.size(), budget));
+      for (const auto doc : chunk) {
+        score_t value;
+        if (scorer->Score(doc, value)) {
+          // documents are tracked even if they don't score
+          scores[doc] += value;
+        }
+      }
+      result.postings += chunk.size();
+      docs = docs.subspan(chunk.size());
+
+      if (!docs.empty() && exhausted()) {
+        break;
+      }
+    }
+
+    if (!docs.empty()) {
+      // the group is processed partially
+      break;
+    }
+  }
+
+  result.complete = cursor == cursors.end();
+  result.hits = TopK(accumulators, options.top_k);
+  return result;
+}
+
+}  // namespace irs
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "index/segment_cache.hpp"
+#include "resource_manager.hpp"
+#include "search/filter.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace irs {
+
+// Postings of a term in a segment ordered by impact, i.e. grouped by
+// quantized term frequency. Groups follow in descending order of frequency,
+// documents of a group follow in ascending order. The order depends neither
+// on scorers nor on index statistics, hence it's built once per segment and
+// shared by all queries through ImpactPostingsCache. Memory of postings is
+// accounted by the specified resource manager.
+class ImpactPostings : private util::noncopyable {
+ public:
+  static constexpr size_t kDefaultLevels = 256;
+
+  struct Group {
+    // Term frequency of documents in the group, the last of 'levels'
+    // groups holds all higher frequencies as well.
+    uint32_t freq;
+    uint32_t begin;
+    uint32_t end;
+
+    uint32_t size() const noexcept { return end - begin; }
+  };
+
+  // Reads all postings of 'term' of 'field' including deleted documents,
+  // frequencies are quantized into 'levels' levels. Postings of a field
+  // without frequencies form a single group.
+  ImpactPostings(const term_reader& field, bytes_view term,
+                 IResourceManager& resource_manager,
+                 size_t levels = kDefaultLevels);
+
+  std::span<const Group> groups() const noexcept { return groups_; }
+
+  std::span<const doc_id_t> docs(const Group& group) const noexcept {
+    IRS_ASSERT(group.end <= docs_.size());
+    return {docs_.data() + group.begin, docs_.data() + group.end};
+  }
+
+  // Returns total number of postings.
+  size_t size() const noexcept { return docs_.size(); }
+
+ private:
+  ManagedVector<doc_id_t> docs_;
+  ManagedVector<Group> groups_;
+};
+
+// Cache of impact ordered postings of terms, bounded by a number of cached
+// postings lists since terms of queries are unbounded.
+class ImpactPostingsCache final : public SegmentCache<ImpactPostings> {
+ public:
+  static constexpr size_t kDefaultMaxSize = 4096;
+
+  explicit ImpactPostingsCache(IResourceManager& resource_manager,
+                               size_t max_size = kDefaultMaxSize) noexcept
+    : SegmentCache{max_size}, resource_manager_{resource_manager} {}
+
+  IResourceManager& ResourceManager() const noexcept {
+    return resource_manager_;
+  }
+
+ private:
+  IResourceManager& resource_manager_;
+};
+
+struct AnytimeOptions {
+  size_t top_k{10};
+  // Stop after processing the specified number of postings.
+  size_t max_postings{std::numeric_limits<size_t>::max()};
+  // Stop after spending the specified time processing postings.
+  std::chrono::steady_clock::duration max_time{
+    std::chrono::steady_clock::duration::max()};
+  size_t levels{ImpactPostings::kDefaultLevels};
+};
+
+struct AnytimeHit {
+  size_t segment;
+  doc_id_t doc;
+  score_t score;
+};
+
+struct AnytimeResult {
+  // Hits in descending order of score.
+  std::vector<AnytimeHit> hits;
+  // Number of processed postings, including postings read to build
+  // impact ordered postings and scored to estimate impacts.
+  size_t postings{};
+  // All postings were processed, scores are exact.
+  bool complete{};
+};
+
+// Evaluates a disjunction of 'terms' of 'field' score-at-a-time: groups of
+// impact ordered postings of all terms in all segments are processed in
+// descending order of estimated impact until either all postings are
+// processed or a budget is exhausted, returning approximate top-K documents.
+// An impact of a group is estimated by a score of its first document,
+// documents are scored only while being processed. Impact ordered postings
+// are taken from 'cache' and built there on the first use in a segment.
+// Postings read to build impact ordered postings and documents scored to
+// estimate impacts count against the budget as processed postings.
+AnytimeResult AnytimeSearch(const IndexReader& index, std::string_view field,
+                            std::span<const bytes_view> terms,
+                            const Scorers& scorers, ImpactPostingsCache& cache,
+                            const AnytimeOptions& options = {});
+
+}  // namespace irs
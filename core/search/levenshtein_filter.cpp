@@ -32,6 +32,7 @@
 #include "shared.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/hash_utils.hpp"
+#include "utils/levenshtein_cache.hpp"
 #include "utils/levenshtein_default_pdp.hpp"
 #include "utils/levenshtein_utils.hpp"
 #include "utils/noncopyable.hpp"
@@ -52,6 +53,10 @@ IRS_FORCE_INLINE score_t similarity(uint32_t distance, uint32_t size) noexcept {
   return 1.f - static_cast<score_t>(distance) / static_cast<score_t>(size);
 }
 
+// Maximum number of terms in a field to verify one by one instead of
+// intersecting a term dictionary with an automaton
+constexpr size_t kBitParallelMaxTerms = 4096;
+
 template<typename Invalid, typename Term, typename Levenshtein>
 inline auto executeLevenshtein(uint8_t max_distance,
                                by_edit_distance_options::pdp_f provider,
@@ -73,7 +78,8 @@ inline auto executeLevenshtein(uint8_t max_distance,
     return inv();
   }
 
-  return lev(d, prefix, target);
+  // only automata built by the default provider are cached
+  return lev(d, provider == &default_pdp, prefix, target);
 }
 
 template<typename StatesType>
@@ -165,26 +171,134 @@ void VisitImpl(const SubReader& segment, const term_reader& reader,
   }
 }
 
-template<typename Collector>
-bool collect_terms(const IndexReader& index, std::string_view field,
-                   bytes_view prefix, bytes_view term,
-                   const parametric_description& d, Collector& collector) {
-  const auto acceptor = make_levenshtein_automaton(d, prefix, term);
+//////////////////////////////////////////////////////////////////////////////
+/// @brief visitation logic for levenshtein filter verifying terms starting
+///        with a specified prefix one by one
+//////////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+void VisitImpl(const SubReader& segment, const term_reader& reader,
+               bytes_view prefix, uint8_t max_distance,
+               const uint32_t utf8_target_size,
+               const bit_parallel_levenshtein& matcher, Visitor&& visitor) {
+  auto terms = reader.iterator(SeekMode::NORMAL);
 
-  if (!Validate(acceptor)) {
-    return false;
+  if (IRS_UNLIKELY(!terms)) {
+    return;
   }
 
-  auto matcher = MakeAutomatonMatcher(acceptor);
-  const auto utf8_term_size =
-    std::max(1U, static_cast<uint32_t>(utf8_utils::Length(prefix) +
-                                       utf8_utils::Length(term)));
-  const uint8_t max_distance = d.max_distance() + 1;
+  if (prefix.empty() ? !terms->next()
+                     : SeekResult::END == terms->seek_ge(prefix)) {
+    return;
+  }
+
+  bool prepared = false;
+  do {
+    const bytes_view value = terms->value();
+
+    if (!value.starts_with(prefix)) {
+      break;
+    }
 
+    const auto distance =
+      matcher.distance(value.substr(prefix.size()), max_distance);
+
+    if (distance > max_distance) {
+      continue;
+    }
+
+    if (!prepared) {
+      visitor.prepare(segment, reader, *terms);
+      prepared = true;
+    }
+
+    terms->read();
+
+    const auto utf8_value_size =
+      static_cast<uint32_t>(utf8_utils::Length(value));
+    const auto boost =
+      similarity(distance, std::min(utf8_value_size, utf8_target_size));
+
+    visitor.visit(boost);
+  } while (terms->next());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief levenshtein matching state shared by all segments, small term
+///        dictionaries are verified term by term with a bit-parallel
+///        algorithm, others are intersected with an automaton, both
+///        matchers are built on demand
+//////////////////////////////////////////////////////////////////////////////
+class levenshtein_matcher : util::noncopyable {
+ public:
+  levenshtein_matcher(const parametric_description& d, bool cacheable,
+                      bool with_transpositions, bytes_view prefix,
+                      bytes_view term)
+    : d_{&d},
+      prefix_{prefix},
+      term_{term},
+      utf8_term_size_{
+        std::max(1U, static_cast<uint32_t>(utf8_utils::Length(prefix) +
+                                           utf8_utils::Length(term)))},
+      with_transpositions_{with_transpositions},
+      cacheable_{cacheable} {}
+
+  // Returns false if an automaton is required but is invalid.
+  template<typename Visitor>
+  bool operator()(const SubReader& segment, const term_reader& reader,
+                  Visitor&& visitor) {
+    const auto max_distance = d_->max_distance();
+
+    if (reader.size() <= kBitParallelMaxTerms) {
+      if (!bit_parallel_) {
+        bit_parallel_.emplace(term_, with_transpositions_);
+      }
+
+      if (bit_parallel_->valid()) {
+        VisitImpl(segment, reader, prefix_, max_distance, utf8_term_size_,
+                  *bit_parallel_, visitor);
+        return true;
+      }
+    }
+
+    if (!matcher_) {
+      acceptor_ =
+        cacheable_ ? by_edit_distance::automaton_cache().Get(
+                       *d_, with_transpositions_, prefix_, term_)
+                   : std::make_shared<const automaton>(
+                       make_levenshtein_automaton(*d_, prefix_, term_));
+
+      if (!Validate(*acceptor_)) {
+        return false;
+      }
+
+      matcher_.emplace(*acceptor_, kTestAutomatonProps);
+    }
+
+    VisitImpl(segment, reader, max_distance + 1, utf8_term_size_, *matcher_,
+              visitor);
+    return true;
+  }
+
+ private:
+  const parametric_description* d_;
+  bstring prefix_;
+  bstring term_;
+  std::optional<bit_parallel_levenshtein> bit_parallel_;
+  std::shared_ptr<const automaton> acceptor_;
+  std::optional<automaton_table_matcher> matcher_;
+  uint32_t utf8_term_size_;
+  bool with_transpositions_;
+  bool cacheable_;
+};
+
+template<typename Collector>
+bool collect_terms(const IndexReader& index, std::string_view field,
+                   levenshtein_matcher& matcher, Collector& collector) {
   for (auto& segment : index) {
     if (auto* reader = segment.field(field); reader) {
-      VisitImpl(segment, *reader, max_distance, utf8_term_size, matcher,
-                collector);
+      if (!matcher(segment, *reader, collector)) {
+        return false;
+      }
     }
   }
 
@@ -192,8 +306,8 @@ bool collect_terms(const IndexReader& index, std::string_view field,
 }
 
 filter::prepared::ptr prepare_levenshtein_filter(
-  const PrepareContext& ctx, std::string_view field, bytes_view prefix,
-  bytes_view term, size_t terms_limit, const parametric_description& d) {
+  const PrepareContext& ctx, std::string_view field, size_t terms_limit,
+  levenshtein_matcher& matcher) {
   field_collectors field_stats{ctx.scorers};
   term_collectors term_stats{ctx.scorers, 1};
   MultiTermQuery::States states{ctx.memory, ctx.index.size()};
@@ -202,13 +316,13 @@ filter::prepared::ptr prepare_levenshtein_filter(
     all_terms_collector term_collector{states, field_stats, term_stats};
     term_collector.stat_index(0);  // aggregate stats from different terms
 
-    if (!collect_terms(ctx.index, field, prefix, term, d, term_collector)) {
+    if (!collect_terms(ctx.index, field, matcher, term_collector)) {
       return filter::prepared::empty();
     }
   } else {
     top_terms_collector term_collector(terms_limit, field_stats);
 
-    if (!collect_terms(ctx.index, field, prefix, term, d, term_collector)) {
+    if (!collect_terms(ctx.index, field, matcher, term_collector)) {
       return filter::prepared::empty();
     }
 
@@ -248,38 +362,24 @@ field_visitor by_edit_distance::visitor(
         return by_term::visit(segment, field, target, visitor);
       };
     },
-    [](const parametric_description& d, const bytes_view prefix,
-       const bytes_view term) -> field_visitor {
-      struct automaton_context : util::noncopyable {
-        automaton_context(const parametric_description& d, bytes_view prefix,
-                          bytes_view term)
-          : acceptor(make_levenshtein_automaton(d, prefix, term)),
-            matcher(MakeAutomatonMatcher(acceptor)) {}
-
-        automaton acceptor;
-        automaton_table_matcher matcher;
-      };
-
-      auto ctx = std::make_shared<automaton_context>(d, prefix, term);
-
-      if (!Validate(ctx->acceptor)) {
-        return [](const SubReader&, const term_reader&, filter_visitor&) {};
-      }
-
-      const auto utf8_term_size =
-        std::max(1U, static_cast<uint32_t>(utf8_utils::Length(prefix) +
-                                           utf8_utils::Length(term)));
-      const uint8_t max_distance = d.max_distance() + 1;
-
-      return [ctx = std::move(ctx), utf8_term_size, max_distance](
-               const SubReader& segment, const term_reader& field,
-               filter_visitor& visitor) mutable {
-        return VisitImpl(segment, field, max_distance, utf8_term_size,
-                         ctx->matcher, visitor);
+    [&opts](const parametric_description& d, bool cacheable,
+            const bytes_view prefix, const bytes_view term) -> field_visitor {
+      auto matcher = std::make_shared<levenshtein_matcher>(
+        d, cacheable, opts.with_transpositions, prefix, term);
+
+      return [matcher = std::move(matcher)](const SubReader& segment,
+                                            const term_reader& field,
+                                            filter_visitor& visitor) {
+        (*matcher)(segment, field, visitor);
       };
     });
 }
 
+LevenshteinAutomatonCache& by_edit_distance::automaton_cache() noexcept {
+  static LevenshteinAutomatonCache kCache;
+  return kCache;
+}
+
 filter::prepared::ptr by_edit_distance::prepare(
   const PrepareContext& ctx, std::string_view field, bytes_view term,
   size_t scored_terms_limit, uint8_t max_distance, options_type::pdp_f provider,
@@ -298,11 +398,13 @@ filter::prepared::ptr by_edit_distance::prepare(
 
       return by_term::prepare(ctx, field, prefix.empty() ? term : prefix);
     },
-    [&, scored_terms_limit](const parametric_description& d,
+    [&, scored_terms_limit](const parametric_description& d, bool cacheable,
                             const bytes_view prefix,
                             const bytes_view term) -> prepared::ptr {
-      return prepare_levenshtein_filter(ctx, field, prefix, term,
-                                        scored_terms_limit, d);
+      levenshtein_matcher matcher{d, cacheable, with_transpositions, prefix,
+                                  term};
+      return prepare_levenshtein_filter(ctx, field, scored_terms_limit,
+                                        matcher);
     });
 }
 
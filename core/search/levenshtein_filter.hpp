@@ -29,6 +29,7 @@ namespace irs {
 
 class by_edit_distance;
 class parametric_description;
+class LevenshteinAutomatonCache;
 struct filter_visitor;
 
 struct by_edit_distance_all_options {
@@ -101,6 +102,10 @@ class by_edit_distance final
 
   static field_visitor visitor(const by_edit_distance_all_options& options);
 
+  // Returns process-wide cache of automata built by the default parametric
+  // description provider.
+  static LevenshteinAutomatonCache& automaton_cache() noexcept;
+
   prepared::ptr prepare(const PrepareContext& ctx) const final {
     auto sub_ctx = ctx;
     sub_ctx.boost *= boost();
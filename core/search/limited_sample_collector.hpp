@@ -302,4 +302,31 @@ class multiterm_visitor {
   const decltype(term_meta::docs_count)* docs_count_ = nullptr;
 };
 
+// Prepares a multiterm query of terms of a specified field visited by
+// 'visit(segment, reader, visitor)' in every segment of an index.
+template<typename Visit>
+filter::prepared::ptr PrepareMultiTermQuery(const PrepareContext& ctx,
+                                            std::string_view field,
+                                            size_t scored_terms_limit,
+                                            Visit&& visit) {
+  // object for collecting order stats
+  limited_sample_collector<term_frequency> collector(
+    ctx.scorers.empty() ? 0 : scored_terms_limit);
+  MultiTermQuery::States states{ctx.memory, ctx.index.size()};
+  multiterm_visitor mtv{collector, states};
+
+  for (const auto& segment : ctx.index) {
+    if (const auto* reader = segment.field(field); reader) {
+      visit(segment, *reader, mtv);
+    }
+  }
+
+  MultiTermQuery::Stats stats{{ctx.memory}};
+  collector.score(ctx.index, ctx.scorers, stats);
+
+  return memory::make_tracked<MultiTermQuery>(ctx.memory, std::move(states),
+                                              std::move(stats), ctx.boost,
+                                              ScoreMergeType::kSum, size_t{1});
+}
+
 }  // namespace irs
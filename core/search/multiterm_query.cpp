@@ -22,6 +22,8 @@
 
 #include "multiterm_query.hpp"
 
+#include <bit>
+
 #include "search/bitset_doc_iterator.hpp"
 #include "search/disjunction.hpp"
 #include "search/min_match_disjunction.hpp"
@@ -33,17 +35,35 @@ namespace {
 
 using namespace irs;
 
+// Heap based disjunction spends O(log(n)) per matched document, while
+// bitset costs O(1) per word of a segment, materialize a union of unscored
+// postings once it is expected to cover at least a document per word.
+constexpr cost::cost_t kBitsetDensity = bits_required<bitset::word_t>();
+
+bool IsDenseUnion(const SubReader& segment, size_t num_terms,
+                  cost::cost_t estimation) noexcept {
+  const auto docs_count = segment.docs_count();
+  if (num_terms < 2 || 0 == docs_count) {
+    return false;
+  }
+  const auto log_terms = static_cast<cost::cost_t>(std::bit_width(num_terms));
+  return estimation >= docs_count / kBitsetDensity / log_terms;
+}
+
 class lazy_bitset_iterator : public bitset_doc_iterator {
  public:
-  lazy_bitset_iterator(
-    const SubReader& segment, const term_reader& field,
-    std::span<const MultiTermState::UnscoredTermState> states,
-    cost::cost_t estimation) noexcept
-    : bitset_doc_iterator(estimation),
-      field_(&field),
+  // Unions postings of either all terms of a 'state' or unscored terms only
+  lazy_bitset_iterator(const SubReader& segment, const MultiTermState& state,
+                       bool unscored_only) noexcept
+    : bitset_doc_iterator(unscored_only ? state.unscored_states_estimation
+                                        : state.estimation()),
+      field_(state.reader),
       segment_(&segment),
-      states_(states) {
-    IRS_ASSERT(!states_.empty());
+      scored_states_(unscored_only ? std::span<const ScoredTermState>{}
+                                   : std::span{state.scored_states}),
+      unscored_terms_(state.unscored_terms) {
+    IRS_ASSERT(field_);
+    IRS_ASSERT(!scored_states_.empty() || !unscored_terms_.empty());
   }
 
   attribute* get_mutable(irs::type_info::type_id id) noexcept final {
@@ -55,11 +75,14 @@ class lazy_bitset_iterator : public bitset_doc_iterator {
   bool refill(const word_t** begin, const word_t** end) final;
 
  private:
+  using ScoredTermState = MultiTermState::ScoredTermState;
+
   score score_;
   std::unique_ptr<word_t[]> set_;
   const term_reader* field_;
   const SubReader* segment_;
-  std::span<const MultiTermState::UnscoredTermState> states_;
+  std::span<const ScoredTermState> scored_states_;
+  std::span<const MultiTermState::UnscoredTermState> unscored_terms_;
 };
 
 bool lazy_bitset_iterator::refill(const word_t** begin, const word_t** end) {
@@ -72,13 +95,21 @@ bool lazy_bitset_iterator::refill(const word_t** begin, const word_t** end) {
   set_ = std::make_unique<word_t[]>(words);
   std::memset(set_.get(), 0, sizeof(word_t) * words);
 
-  auto provider = [begin = states_.begin(),
-                   end =
-                     states_.end()]() mutable noexcept -> const seek_cookie* {
-    if (begin != end) {
-      auto* cookie = begin->get();
+  auto provider = [scored = scored_states_.begin(),
+                   scored_end = scored_states_.end(),
+                   unscored = unscored_terms_.begin(),
+                   unscored_end = unscored_terms_.end()]() mutable noexcept
+    -> const seek_cookie* {
+    if (scored != scored_end) {
+      auto* cookie = scored->cookie.get();
       // cppcheck-suppress unreadVariable
-      ++begin;
+      ++scored;
+      return cookie;
+    }
+    if (unscored != unscored_end) {
+      auto* cookie = unscored->get();
+      // cppcheck-suppress unreadVariable
+      ++unscored;
       return cookie;
     }
     return nullptr;
@@ -130,13 +161,23 @@ doc_iterator::ptr MultiTermQuery::execute(const ExecutionContext& ctx) const {
   const IndexFeatures features = ord.features();
   const std::span stats{stats_};
 
+  const bool no_score = ord.empty();
+
+  if (no_score && min_match_ <= 1 &&
+      IsDenseUnion(segment,
+                   state->scored_states.size() + state->unscored_terms.size(),
+                   state->estimation())) {
+    // nothing to score, the whole union fits a segment-sized bitset
+    return memory::make_managed<::lazy_bitset_iterator>(segment, *state,
+                                                        false);
+  }
+
   const bool has_unscored_terms = !state->unscored_terms.empty();
 
   ScoreAdapters itrs(state->scored_states.size() + size_t(has_unscored_terms));
   auto it = std::begin(itrs);
 
   // add an iterator for each of the scored states
-  const bool no_score = ord.empty();
   for (auto& entry : state->scored_states) {
     IRS_ASSERT(entry.cookie);
     auto docs = reader->postings(*entry.cookie, features);
@@ -161,9 +202,8 @@ doc_iterator::ptr MultiTermQuery::execute(const ExecutionContext& ctx) const {
 
   if (has_unscored_terms) {
     IRS_ASSERT(it != std::end(itrs));
-    *it = {memory::make_managed<::lazy_bitset_iterator>(
-      segment, *state->reader, state->unscored_terms,
-      state->unscored_states_estimation)};
+    *it = {memory::make_managed<::lazy_bitset_iterator>(segment, *state,
+                                                         true)};
     ++it;
   }
 
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "near_duplicates_filter.hpp"
+
+#include <absl/base/internal/endian.h>
+
+#include "analysis/token_attributes.hpp"
+#include "index/index_reader.hpp"
+#include "search/doc_bitmap.hpp"
+#include "search/terms_filter.hpp"
+#include "utils/minhash_utils.hpp"
+
+namespace irs {
+namespace {
+
+// Verifies candidates sharing a band with a query by estimating Jaccard
+// coefficient of their signatures.
+class NearDuplicatesIterator : public doc_iterator {
+ public:
+  NearDuplicatesIterator(doc_iterator::ptr&& candidates,
+                         doc_iterator::ptr&& values, const MinHash& signature,
+                         double threshold)
+    : candidates_{std::move(candidates)},
+      values_{std::move(values)},
+      signature_{&signature},
+      threshold_{threshold} {
+    IRS_ASSERT(candidates_);
+    IRS_ASSERT(values_);
+    doc_ = irs::get<document>(*candidates_);
+    payload_ = irs::get<payload>(*values_);
+    IRS_ASSERT(doc_);
+    IRS_ASSERT(payload_);
+  }
+
+  doc_id_t value() const final { return doc_->value; }
+
+  bool next() final {
+    while (candidates_->next()) {
+      if (Accept(doc_->value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  doc_id_t seek(doc_id_t target) final {
+    if (target <= doc_->value) {
+      return doc_->value;
+    }
+    target = candidates_->seek(target);
+    if (doc_limits::eof(target) || Accept(target)) {
+      return target;
+    }
+    next();
+    return doc_->value;
+  }
+
+  attribute* get_mutable(type_info::type_id type) noexcept final {
+    // rejected candidates can't be skipped within a bitmap window
+    return irs::type<doc_bitmap>::id() == type
+             ? nullptr
+             : candidates_->get_mutable(type);
+  }
+
+ private:
+  bool Accept(doc_id_t doc) {
+    if (values_->seek(doc) != doc) {
+      return false;
+    }
+    const auto value = payload_->value;
+    hashes_.resize(value.size() / sizeof(uint64_t));
+    for (auto* it = value.data(); auto& hash : hashes_) {
+      hash = absl::little_endian::Load64(it);
+      it += sizeof(uint64_t);
+    }
+    return signature_->Jaccard(hashes_) >= threshold_;
+  }
+
+  doc_iterator::ptr candidates_;
+  doc_iterator::ptr values_;
+  const document* doc_;
+  const payload* payload_;
+  const MinHash* signature_;
+  std::vector<uint64_t> hashes_;
+  double threshold_;
+};
+
+class NearDuplicatesQuery : public filter::prepared {
+ public:
+  NearDuplicatesQuery(std::string_view field, prepared::ptr&& candidates,
+                      std::span<const uint64_t> signature, double threshold)
+    : field_{field},
+      candidates_{std::move(candidates)},
+      signature_{signature.size()},
+      threshold_{threshold} {
+    IRS_ASSERT(candidates_);
+    for (const auto hash : signature) {
+      signature_.Insert(hash);
+    }
+  }
+
+  doc_iterator::ptr execute(const ExecutionContext& ctx) const final {
+    const auto* column = ctx.segment.column(field_);
+
+    if (!column) {
+      return doc_iterator::empty();
+    }
+
+    auto candidates = candidates_->execute(ctx);
+
+    if (doc_limits::eof(candidates->value())) {
+      return candidates;
+    }
+
+    auto values = column->iterator(ColumnHint::kNormal);
+
+    if (IRS_UNLIKELY(!values || !irs::get<payload>(*values))) {
+      return doc_iterator::empty();
+    }
+
+    return memory::make_managed<NearDuplicatesIterator>(
+      std::move(candidates), std::move(values), signature_, threshold_);
+  }
+
+  void visit(const SubReader& segment, PreparedStateVisitor& visitor,
+             score_t boost) const final {
+    candidates_->visit(segment, visitor, boost);
+  }
+
+  score_t boost() const noexcept final { return candidates_->boost(); }
+
+ private:
+  std::string field_;
+  prepared::ptr candidates_;
+  MinHash signature_;
+  double threshold_;
+};
+
+}  // namespace
+
+filter::prepared::ptr ByNearDuplicates::prepare(
+  const PrepareContext& ctx) const {
+  const auto& [bands, signature, threshold] = options();
+
+  if (bands.empty() || signature.empty()) {
+    return prepared::empty();
+  }
+
+  by_terms_options terms;
+  for (const auto& band : bands) {
+    terms.terms.emplace(band);
+  }
+
+  auto candidates = by_terms::Prepare(ctx.Boost(boost()), field(), terms);
+
+  return memory::make_tracked<NearDuplicatesQuery>(
+    ctx.memory, field(), std::move(candidates), signature, threshold);
+}
+
+}  // namespace irs
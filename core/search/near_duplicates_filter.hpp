@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+#include "search/filter.hpp"
+#include "utils/string.hpp"
+
+namespace irs {
+
+class ByNearDuplicates;
+
+// Options for near duplicates filter
+struct ByNearDuplicatesOptions {
+  using filter_type = ByNearDuplicates;
+
+  // LSH band tokens of a query, i.e. tokens of "minhash" analyzer having
+  // "numBands" set.
+  std::vector<bstring> bands;
+  // MinHash signature of a query.
+  std::vector<uint64_t> signature;
+  // Minimum estimated Jaccard coefficient of a matched document.
+  double threshold{0.8};
+
+  bool operator==(const ByNearDuplicatesOptions& rhs) const noexcept {
+    return bands == rhs.bands && signature == rhs.signature &&
+           threshold == rhs.threshold;
+  }
+};
+
+// Matches documents sharing at least one LSH band with a query and having
+// MinHash signature similar enough to the signature of the query. Band
+// tokens are looked up in the field, signatures of candidates are read from
+// the column named as the field, a value of the column is a sequence of
+// little-endian 64-bit hash values as written by
+// `MinHashTokenStream::WriteSignature`. Documents without a signature aren't
+// matched.
+class ByNearDuplicates final : public FilterWithField<ByNearDuplicatesOptions> {
+ public:
+  prepared::ptr prepare(const PrepareContext& ctx) const final;
+};
+
+}  // namespace irs
@@ -22,11 +22,13 @@
 
 #include "nested_filter.hpp"
 
+#include <bit>
 #include <tuple>
 #include <utility>
 #include <variant>
 
 #include "analysis/token_attributes.hpp"
+#include "index/index_reader.hpp"
 #include "search/cost.hpp"
 #include "search/prepared_state_visitor.hpp"
 #include "search/prev_doc.hpp"
@@ -95,6 +97,149 @@ class ScorerWrapper : public doc_iterator {
   score score_;
 };
 
+// Iterates over cached parents, previous parent is resolved by a bit scan.
+class ParentsIterator : public doc_iterator {
+ public:
+  explicit ParentsIterator(
+    std::shared_ptr<const NestedParents> parents) noexcept
+    : parents_{std::move(parents)} {
+    IRS_ASSERT(parents_);
+    std::get<cost>(attrs_).reset(parents_->size());
+    std::get<prev_doc>(attrs_).reset(
+      [](const void* ctx) noexcept {
+        auto& self = *static_cast<const ParentsIterator*>(ctx);
+        return self.parents_->Prev(self.value());
+      },
+      this);
+  }
+
+  doc_id_t value() const noexcept final {
+    return std::get<document>(attrs_).value;
+  }
+
+  attribute* get_mutable(irs::type_info::type_id id) noexcept final {
+    return irs::get_mutable(attrs_, id);
+  }
+
+  doc_id_t seek(doc_id_t target) noexcept final {
+    auto& doc = std::get<document>(attrs_);
+
+    if (IRS_UNLIKELY(target <= doc.value)) {
+      return doc.value;
+    }
+
+    return doc.value = parents_->Next(target);
+  }
+
+  bool next() noexcept final {
+    auto& doc = std::get<document>(attrs_);
+
+    if (IRS_UNLIKELY(doc_limits::eof(doc.value))) {
+      return false;
+    }
+
+    doc.value = parents_->Next(doc.value + 1);
+    return !doc_limits::eof(doc.value);
+  }
+
+ private:
+  using Attributes = std::tuple<document, cost, prev_doc>;
+
+  std::shared_ptr<const NestedParents> parents_;
+  Attributes attrs_;
+};
+
+// Unscored join of any matching child to its parent using cached parents.
+// Children are mapped to parents in batches, all remaining children of a
+// matched parent are skipped with a single seek.
+class ParentsJoin : public doc_iterator {
+ public:
+  static constexpr size_t kBatchSize = 64;
+
+  ParentsJoin(std::shared_ptr<const NestedParents> parents,
+              doc_iterator::ptr&& child) noexcept
+    : parents_{std::move(parents)}, child_{std::move(child)} {
+    IRS_ASSERT(parents_);
+    IRS_ASSERT(child_);
+
+    std::get<attribute_ptr<cost>>(attrs_) =
+      irs::get_mutable<cost>(child_.get());
+  }
+
+  doc_id_t value() const noexcept final {
+    return std::get<document>(attrs_).value;
+  }
+
+  attribute* get_mutable(irs::type_info::type_id id) final {
+    return irs::get_mutable(attrs_, id);
+  }
+
+  doc_id_t seek(doc_id_t target) final {
+    auto& doc = std::get<document>(attrs_);
+
+    if (IRS_UNLIKELY(target <= doc.value)) {
+      return doc.value;
+    }
+
+    for (; begin_ != end_; ++begin_) {
+      if (*begin_ >= target) {
+        return doc.value = *begin_++;
+      }
+    }
+
+    // children of the target parent follow the parent preceding the target
+    next_child_ = std::max(next_child_, parents_->Prev(target) + 1);
+    next();
+    return doc.value;
+  }
+
+  bool next() final {
+    auto& doc = std::get<document>(attrs_);
+
+    if (IRS_UNLIKELY(begin_ == end_ && !Refill())) {
+      doc.value = doc_limits::eof();
+      return false;
+    }
+
+    doc.value = *begin_++;
+    return true;
+  }
+
+ private:
+  using Attributes = std::tuple<document, attribute_ptr<cost>, score>;
+
+  bool Refill() {
+    begin_ = end_ = std::begin(parents_buf_);
+
+    for (auto child = child_->seek(next_child_);
+         !doc_limits::eof(child) && end_ != std::end(parents_buf_);
+         child = child_->seek(next_child_)) {
+      const auto parent = parents_->Next(child);
+
+      if (doc_limits::eof(parent)) {
+        // no parents after the remaining children
+        next_child_ = doc_limits::eof();
+        break;
+      }
+
+      if (parent != child) {  // child filter may match parents
+        *end_++ = parent;
+      }
+      next_child_ = parent + 1;
+    }
+
+    return begin_ != end_;
+  }
+
+  std::shared_ptr<const NestedParents> parents_;
+  doc_iterator::ptr child_;
+  Attributes attrs_;
+  doc_id_t next_child_{doc_limits::min()};
+  doc_id_t* begin_{std::begin(parents_buf_)};
+  doc_id_t* end_{std::begin(parents_buf_)};
+  doc_id_t parents_buf_[kBatchSize];
+};
+
 class NoneMatcher;
 
 template<typename Matcher>
@@ -582,12 +727,89 @@ auto ResolveMatchType(const SubReader& segment,
 
 namespace irs {
 
+NestedParents::NestedParents(doc_iterator& parents, doc_id_t docs_count)
+  : set_{docs_count + doc_limits::min()} {
+  for (auto doc = parents.seek(doc_limits::min()); !doc_limits::eof(doc);
+       doc = parents.next() ? parents.value() : doc_limits::eof()) {
+    IRS_ASSERT(doc < set_.size());
+    set_.set(doc);
+    ++size_;
+  }
+}
+
+doc_id_t NestedParents::Next(doc_id_t doc) const noexcept {
+  if (doc >= set_.size()) {
+    return doc_limits::eof();
+  }
+
+  auto i = bitset::word(doc);
+  // doc_limits::invalid() is never set
+  if (const auto word = set_[i] >> bitset::bit(doc); word) {
+    return doc + static_cast<doc_id_t>(std::countr_zero(word));
+  }
+
+  for (const auto words = set_.words(); ++i < words;) {
+    if (const auto word = set_[i]; word) {
+      return static_cast<doc_id_t>(bitset::bit_offset(i) +
+                                   std::countr_zero(word));
+    }
+  }
+
+  return doc_limits::eof();
+}
+
+doc_id_t NestedParents::Prev(doc_id_t doc) const noexcept {
+  doc = std::min(doc, static_cast<doc_id_t>(set_.size()));
+
+  if (!doc) {
+    return doc_limits::invalid();
+  }
+
+  // the last candidate
+  --doc;
+
+  auto i = bitset::word(doc);
+  constexpr auto kLastBit = bits_required<bitset::word_t>() - 1;
+  if (const auto word = set_[i] << (kLastBit - bitset::bit(doc)); word) {
+    return doc - static_cast<doc_id_t>(std::countl_zero(word));
+  }
+
+  while (i) {
+    if (const auto word = set_[--i]; word) {
+      return static_cast<doc_id_t>(bitset::bit_offset(i) + kLastBit -
+                                   std::countl_zero(word));
+    }
+  }
+
+  return doc_limits::invalid();
+}
+
+std::shared_ptr<const NestedParents> NestedParentsCache::Get(
+  const SubReader& segment, std::string_view key,
+  const DocIteratorProvider& parent) {
+  return SegmentCache::Get(
+    segment, key, [&]() -> std::shared_ptr<const NestedParents> {
+      auto it = parent(segment);
+
+      if (IRS_UNLIKELY(!it)) {
+        return nullptr;
+      }
+
+      return std::make_shared<const NestedParents>(
+        *it, static_cast<doc_id_t>(segment.docs_count()));
+    });
+}
+
 class ByNestedQuery : public filter::prepared {
  public:
-  ByNestedQuery(DocIteratorProvider parent, prepared::ptr&& child,
+  ByNestedQuery(DocIteratorProvider parent,
+                std::shared_ptr<NestedParentsCache> parents_cache,
+                std::string parents_key, prepared::ptr&& child,
                 ScoreMergeType merge_type, ByNestedOptions::MatchType match,
                 score_t none_boost) noexcept
     : parent_{std::move(parent)},
+      parents_cache_{std::move(parents_cache)},
+      parents_key_{std::move(parents_key)},
       child_{std::move(child)},
       match_{std::move(match)},
       merge_type_{merge_type},
@@ -616,6 +838,8 @@ class ByNestedQuery : public filter::prepared {
 
  private:
   DocIteratorProvider parent_;
+  std::shared_ptr<NestedParentsCache> parents_cache_;
+  std::string parents_key_;
   prepared::ptr child_;
   ByNestedOptions::MatchType match_;
   ScoreMergeType merge_type_;
@@ -626,7 +850,20 @@ doc_iterator::ptr ByNestedQuery::execute(const ExecutionContext& ctx) const {
   auto& rdr = ctx.segment;
   auto& ord = ctx.scorers;
 
-  auto parent = parent_(rdr);
+  std::shared_ptr<const NestedParents> parents;
+  doc_iterator::ptr parent;
+
+  if (parents_cache_) {
+    parents = parents_cache_->Get(rdr, parents_key_, parent_);
+
+    if (IRS_UNLIKELY(!parents || !parents->size())) {
+      return doc_iterator::empty();
+    }
+
+    parent = memory::make_managed<ParentsIterator>(parents);
+  } else {
+    parent = parent_(rdr);
+  }
 
   if (IRS_UNLIKELY(!parent || doc_limits::eof(parent->value()))) {
     return doc_iterator::empty();
@@ -682,6 +919,14 @@ doc_iterator::ptr ByNestedQuery::execute(const ExecutionContext& ctx) const {
             if (doc_limits::eof(child->value())) {
               return doc_iterator::empty();
             }
+
+            if constexpr (std::is_same_v<AnyMatcher<A>, M> &&
+                          std::is_same_v<NoopAggregator, A>) {
+              if (parents) {
+                return memory::make_managed<ParentsJoin>(std::move(parents),
+                                                         std::move(child));
+              }
+            }
           }
 
           return memory::make_managed<ChildToParentJoin<M>>(
@@ -691,7 +936,8 @@ doc_iterator::ptr ByNestedQuery::execute(const ExecutionContext& ctx) const {
 }
 
 filter::prepared::ptr ByNestedFilter::prepare(const PrepareContext& ctx) const {
-  auto& [parent, child, match, merge_type] = options();
+  auto& [parent, child, match, merge_type, parents_cache, parents_key] =
+    options();
 
   if (!parent || !child || !IsValid(match)) {
     return prepared::empty();
@@ -711,9 +957,12 @@ filter::prepared::ptr ByNestedFilter::prepare(const PrepareContext& ctx) const {
     return prepared::empty();
   }
 
+  // parents of an unidentified parent filter can't be shared
+  auto cache = parents_key.empty() ? nullptr : parents_cache;
+
   return memory::make_tracked<ByNestedQuery>(
-    ctx.memory, parent, std::move(prepared_child), merge_type, match,
-    /*none_boost*/ sub_boost);
+    ctx.memory, parent, std::move(cache), parents_key,
+    std::move(prepared_child), merge_type, match, /*none_boost*/ sub_boost);
 }
 
 }  // namespace irs
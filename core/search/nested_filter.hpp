@@ -23,9 +23,12 @@
 #pragma once
 
 #include <compare>
+#include <string>
 #include <variant>
 
+#include "index/segment_cache.hpp"
 #include "search/filter.hpp"
+#include "utils/bitset.hpp"
 #include "utils/type_limits.hpp"
 
 namespace irs {
@@ -54,6 +57,42 @@ static constexpr Match kMatchAny{1};
 
 using DocIteratorProvider = std::function<doc_iterator::ptr(const SubReader&)>;
 
+// Documents matched by a parent filter in a segment, allows to navigate
+// from a child document to its parent by scanning bits.
+class NestedParents : private util::noncopyable {
+ public:
+  NestedParents(doc_iterator& parents, doc_id_t docs_count);
+
+  bool contains(doc_id_t doc) const noexcept {
+    return doc < set_.size() && set_.test(doc);
+  }
+
+  // Returns the first parent greater or equal to 'doc' or EOF.
+  doc_id_t Next(doc_id_t doc) const noexcept;
+
+  // Returns the last parent less than 'doc' or doc_limits::invalid().
+  doc_id_t Prev(doc_id_t doc) const noexcept;
+
+  // Returns total number of parents.
+  doc_id_t size() const noexcept { return size_; }
+
+ private:
+  bitset set_;
+  doc_id_t size_{};
+};
+
+// Per-segment cache of parents produced by parent filters. Parents are
+// resolved once per segment and parent filter and are shared by all queries
+// using the same cache.
+class NestedParentsCache : public SegmentCache<NestedParents> {
+ public:
+  // Returns parents of the specified segment produced by a parent filter
+  // identified by 'key', evaluates them on a miss.
+  std::shared_ptr<const NestedParents> Get(const SubReader& segment,
+                                           std::string_view key,
+                                           const DocIteratorProvider& parent);
+};
+
 // Options for ByNestedFilter filter
 struct ByNestedOptions {
   using filter_type = ByNestedFilter;
@@ -72,6 +111,18 @@ struct ByNestedOptions {
   // Score merge type.
   ScoreMergeType merge_type{ScoreMergeType::kSum};
 
+  // Optional cache of parents evaluated by the parent filter, if set along
+  // with 'parents_key', child documents are mapped to parents by scanning
+  // a parent bitset.
+  std::shared_ptr<NestedParentsCache> parents_cache;
+
+  // Identifies the parent filter within 'parents_cache', e.g. a serialized
+  // parent filter. The cache can't tell parent filters apart by itself:
+  // filters sharing a cache and a key get parents of whichever of them was
+  // evaluated first for a segment, so distinct parent filters must use
+  // distinct keys. The cache isn't used if the key is empty.
+  std::string parents_key;
+
   bool operator==(const ByNestedOptions& rhs) const noexcept {
     auto equal = [](const filter* lhs, const filter* rhs) noexcept {
       return ((!lhs && !rhs) || (lhs && rhs && *lhs == *rhs));
@@ -86,7 +137,8 @@ struct ByNestedOptions {
                return true;
              },
              match) &&
-           merge_type == rhs.merge_type && equal(child.get(), rhs.child.get());
+           merge_type == rhs.merge_type && parents_key == rhs.parents_key &&
+           equal(child.get(), rhs.child.get());
   }
 };
 
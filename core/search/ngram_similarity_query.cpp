@@ -56,32 +56,18 @@ struct PositionWithOffset : Position {
   const offset* offs;
 };
 
-template<bool IsStart, typename T>
-uint32_t GetOffset(const T& pos) noexcept {
-  if constexpr (std::is_same_v<PositionWithOffset, T>) {
-    if constexpr (IsStart) {
-      return pos.offs->start;
-    } else {
-      return pos.offs->end;
-    }
-  } else {
-    return 0;
-  }
-}
-
 struct SearchState {
-  template<typename T>
-  SearchState(uint32_t p, const T& attrs)
-    : scr{attrs.scr}, len{1}, pos{p}, offs{GetOffset<true>(attrs)} {}
+  SearchState(uint32_t p, const score* scr, uint32_t offs) noexcept
+    : scr{scr}, len{1}, pos{p}, offs{offs} {}
 
   // appending constructor
-  template<typename T>
-  SearchState(std::shared_ptr<SearchState> other, uint32_t p, const T& attrs)
+  SearchState(std::shared_ptr<SearchState> other, uint32_t p, const score* scr,
+              uint32_t offs) noexcept
     : parent{std::move(other)},
-      scr{attrs.scr},
+      scr{scr},
       len{parent->len + 1},
       pos{p},
-      offs{GetOffset<false>(attrs)} {}
+      offs{offs} {}
 
   std::shared_ptr<SearchState> parent;
   const score* scr;
@@ -220,7 +206,23 @@ class SerialPositionsChecker : public Base {
   using PositionType =
     std::conditional_t<kHasPosition, PositionWithOffset, Position>;
 
+  // Positions of a term matched by the current document
+  struct TermPositions {
+    const score* scr;
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  bool HasLongEnoughSequence(size_t potential, doc_id_t doc);
+  void LoadPositions(doc_id_t doc);
+  void AppendToSequences(std::span<const uint32_t> positions) noexcept;
+
   std::vector<PositionType> pos_;
+  std::vector<TermPositions> terms_;
+  std::vector<uint32_t> positions_;
+  std::vector<std::pair<uint32_t, uint32_t>> offsets_;
+  // tails_[i] is the minimal last position of a sequence of length i + 1
+  std::vector<uint32_t> tails_;
   std::set<size_t> used_pos_;  // longest sequence positions overlaping detector
   std::vector<const score*> longest_sequence_;
   std::vector<size_t> pos_sequence_;
@@ -232,130 +234,215 @@ class SerialPositionsChecker : public Base {
   bool collect_all_states_;
 };
 
+template<typename Base>
+void SerialPositionsChecker<Base>::AppendToSequences(
+  std::span<const uint32_t> positions) noexcept {
+  // positions of the same term are visited in descending order,
+  // so a term is never appended to a sequence ending with itself
+  for (auto it = positions.rbegin(), end = positions.rend(); it != end; ++it) {
+    const auto pos = *it;
+    // branchless lower bound, tails are few and sorted
+    size_t i = 0;
+    for (const auto tail : tails_) {
+      i += tail < pos;
+    }
+    if (i == tails_.size()) {
+      tails_.push_back(pos);
+    } else {
+      tails_[i] = pos;
+    }
+  }
+}
+
+template<typename Base>
+bool SerialPositionsChecker<Base>::HasLongEnoughSequence(size_t potential,
+                                                         doc_id_t doc) {
+  tails_.clear();
+  for (const auto& pos_iterator : pos_) {
+    if (pos_iterator.doc->value != doc) {
+      continue;
+    }
+
+    positions_.clear();
+    for (auto& pos = *pos_iterator.pos; pos.next();) {
+      positions_.emplace_back(pos.value());
+    }
+    AppendToSequences(positions_);
+
+    if (tails_.size() >= min_match_count_) {
+      return true;
+    }
+
+    if (tails_.size() + --potential < min_match_count_) {
+      return false;  // all further terms will not let us build
+                     // long enough sequence
+    }
+  }
+  return false;
+}
+
+template<typename Base>
+void SerialPositionsChecker<Base>::LoadPositions(doc_id_t doc) {
+  terms_.clear();
+  positions_.clear();
+  if constexpr (kHasPosition) {
+    offsets_.clear();
+  }
+
+  for (const auto& pos_iterator : pos_) {
+    if (pos_iterator.doc->value != doc) {
+      continue;
+    }
+
+    const auto begin = static_cast<uint32_t>(positions_.size());
+    for (auto& pos = *pos_iterator.pos; pos.next();) {
+      positions_.emplace_back(pos.value());
+      if constexpr (kHasPosition) {
+        offsets_.emplace_back(pos_iterator.offs->start, pos_iterator.offs->end);
+      }
+    }
+    terms_.push_back({pos_iterator.scr, begin,
+                      static_cast<uint32_t>(positions_.size())});
+  }
+}
+
 template<typename Base>
 bool SerialPositionsChecker<Base>::Check(size_t potential, doc_id_t doc) {
-  // how long max sequence could be in the best case
+  seq_freq_.value = 0;
+
+  // first phase: find out the length of the longest sequence,
+  // that's enough if no sequences are collected for scoring
+  if (!collect_all_states_) {
+    return HasLongEnoughSequence(potential, doc);
+  }
+
+  LoadPositions(doc);
+
+  tails_.clear();
+  for (const auto& term : terms_) {
+    AppendToSequences({positions_.data() + term.begin, term.end - term.begin});
+  }
+
+  if (tails_.size() < min_match_count_) {
+    return false;
+  }
+
+  // second phase: collect the longest sequences for scoring
   search_buf_.clear();
   uint32_t longest_sequence_len = 0;
 
-  seq_freq_.value = 0;
-  for (const auto& pos_iterator : pos_) {
-    if (pos_iterator.doc->value == doc) {
-      position& pos = *(pos_iterator.pos);
-      if (potential <= longest_sequence_len || potential < min_match_count_) {
-        // this term could not start largest (or long enough) sequence.
-        // skip it to first position to append to any existing candidates
-        IRS_ASSERT(!search_buf_.empty());
-        pos.seek(std::rbegin(search_buf_)->first + 1);
-      } else {
-        pos.next();
-      }
-      if (!pos_limits::eof(pos.value())) {
-        PosTemp swap_cache;
-        auto last_found_pos = pos_limits::invalid();
-        do {
-          const auto current_pos = pos.value();
-          if (auto found = search_buf_.lower_bound(current_pos);
-              found != std::end(search_buf_)) {
-            if (last_found_pos != found->first) {
-              last_found_pos = found->first;
-              const auto* found_state = found->second.get();
-              IRS_ASSERT(found_state);
-              auto current_sequence = found;
-              // if we hit same position - set length to 0 to force checking
-              // candidates to the left
-              uint32_t current_found_len{(found->first == current_pos ||
-                                          found_state->scr == pos_iterator.scr)
-                                           ? 0
-                                           : found_state->len + 1};
-              auto initial_found = found;
-              if (current_found_len > longest_sequence_len) {
-                longest_sequence_len = current_found_len;
-              } else {
-                // maybe some previous candidates could produce better
-                // results. lets go leftward and check if there are any
-                // candidates which could became longer if we stick this ngram
-                // to them rather than the closest one found
-                for (++found; found != std::end(search_buf_); ++found) {
-                  found_state = found->second.get();
-                  IRS_ASSERT(found_state);
-                  if (found_state->scr != pos_iterator.scr &&
-                      found_state->len + 1 > current_found_len) {
-                    // we have better option. Replace this match!
-                    current_sequence = found;
-                    current_found_len = found_state->len + 1;
-                    if (current_found_len > longest_sequence_len) {
-                      longest_sequence_len = current_found_len;
-                      break;  // this match is the best - nothing to search
-                              // further
-                    }
+  for (const auto& term : terms_) {
+    const auto* begin = positions_.data() + term.begin;
+    const auto* end = positions_.data() + term.end;
+    const auto* it = begin;
+    if (potential <= longest_sequence_len || potential < min_match_count_) {
+      // this term could not start largest (or long enough) sequence.
+      // skip it to first position to append to any existing candidates
+      IRS_ASSERT(!search_buf_.empty());
+      it = std::upper_bound(begin, end, std::rbegin(search_buf_)->first);
+    }
+    if (it != end) {
+      PosTemp swap_cache;
+      auto last_found_pos = pos_limits::invalid();
+      do {
+        const auto current_pos = *it;
+        const auto [start_offs, end_offs] =
+          kHasPosition ? offsets_[it - positions_.data()]
+                       : std::pair<uint32_t, uint32_t>{};
+        if (auto found = search_buf_.lower_bound(current_pos);
+            found != std::end(search_buf_)) {
+          if (last_found_pos != found->first) {
+            last_found_pos = found->first;
+            const auto* found_state = found->second.get();
+            IRS_ASSERT(found_state);
+            auto current_sequence = found;
+            // if we hit same position - set length to 0 to force checking
+            // candidates to the left
+            uint32_t current_found_len{
+              (found->first == current_pos || found_state->scr == term.scr)
+                ? 0
+                : found_state->len + 1};
+            auto initial_found = found;
+            if (current_found_len > longest_sequence_len) {
+              longest_sequence_len = current_found_len;
+            } else {
+              // maybe some previous candidates could produce better
+              // results. lets go leftward and check if there are any
+              // candidates which could became longer if we stick this ngram
+              // to them rather than the closest one found
+              for (++found; found != std::end(search_buf_); ++found) {
+                found_state = found->second.get();
+                IRS_ASSERT(found_state);
+                if (found_state->scr != term.scr &&
+                    found_state->len + 1 > current_found_len) {
+                  // we have better option. Replace this match!
+                  current_sequence = found;
+                  current_found_len = found_state->len + 1;
+                  if (current_found_len > longest_sequence_len) {
+                    longest_sequence_len = current_found_len;
+                    break;  // this match is the best - nothing to search
+                            // further
                   }
                 }
               }
-              if (current_found_len) {
-                auto new_candidate = std::make_shared<SearchState>(
-                  current_sequence->second, current_pos, pos_iterator);
-                const auto res = search_buf_.try_emplace(
-                  current_pos, std::move(new_candidate));
-                if (!res.second) {
-                  // pos already used. This could be if same ngram used several
-                  // times. Replace with new length through swap cache - to not
-                  // spoil candidate for following positions of same ngram
-                  swap_cache.emplace_back(current_pos,
-                                          // cppcheck-suppress accessMoved
-                                          std::move(new_candidate));
-                }
-              } else if (initial_found->second->scr == pos_iterator.scr &&
-                         potential > longest_sequence_len &&
-                         potential >= min_match_count_) {
-                // we just hit same iterator and found no better place to
-                // join, so it will produce new candidate
-                search_buf_.emplace(
-                  std::piecewise_construct, std::forward_as_tuple(current_pos),
-                  std::forward_as_tuple(
-                    std::make_shared<SearchState>(current_pos, pos_iterator)));
-              }
             }
-          } else if (potential > longest_sequence_len &&
-                     potential >= min_match_count_) {
-            // this ngram at this position  could potentially start a long
-            // enough sequence so add it to candidate list
-            search_buf_.emplace(
-              std::piecewise_construct, std::forward_as_tuple(current_pos),
-              std::forward_as_tuple(
-                std::make_shared<SearchState>(current_pos, pos_iterator)));
-            if (!longest_sequence_len) {
-              longest_sequence_len = 1;
+            if (current_found_len) {
+              auto new_candidate = std::make_shared<SearchState>(
+                current_sequence->second, current_pos, term.scr, end_offs);
+              const auto res =
+                search_buf_.try_emplace(current_pos, std::move(new_candidate));
+              if (!res.second) {
+                // pos already used. This could be if same ngram used several
+                // times. Replace with new length through swap cache - to not
+                // spoil candidate for following positions of same ngram
+                swap_cache.emplace_back(current_pos,
+                                        // cppcheck-suppress accessMoved
+                                        std::move(new_candidate));
+              }
+            } else if (initial_found->second->scr == term.scr &&
+                       potential > longest_sequence_len &&
+                       potential >= min_match_count_) {
+              // we just hit same iterator and found no better place to
+              // join, so it will produce new candidate
+              search_buf_.emplace(
+                std::piecewise_construct, std::forward_as_tuple(current_pos),
+                std::forward_as_tuple(std::make_shared<SearchState>(
+                  current_pos, term.scr, start_offs)));
             }
           }
-        } while (pos.next());
-        for (auto& p : swap_cache) {
-          auto res = search_buf_.find(p.first);
-          IRS_ASSERT(res != std::end(search_buf_));
-          std::swap(res->second, p.second);
+        } else if (potential > longest_sequence_len &&
+                   potential >= min_match_count_) {
+          // this ngram at this position  could potentially start a long
+          // enough sequence so add it to candidate list
+          search_buf_.emplace(
+            std::piecewise_construct, std::forward_as_tuple(current_pos),
+            std::forward_as_tuple(
+              std::make_shared<SearchState>(current_pos, term.scr, start_offs)));
+          if (!longest_sequence_len) {
+            longest_sequence_len = 1;
+          }
         }
+      } while (++it != end);
+      for (auto& p : swap_cache) {
+        auto res = search_buf_.find(p.first);
+        IRS_ASSERT(res != std::end(search_buf_));
+        std::swap(res->second, p.second);
       }
-      --potential;  // we are done with this term.
-                    // next will have potential one less as less matches left
-
-      if (!potential) {
-        break;  // all further terms will not add anything
-      }
+    }
+    --potential;  // we are done with this term.
+                  // next will have potential one less as less matches left
 
-      if (longest_sequence_len + potential < min_match_count_) {
-        break;  // all further terms will not let us build long enough
-                // sequence
-      }
+    if (!potential) {
+      break;  // all further terms will not add anything
+    }
 
-      // if we have no scoring - we could stop searh once we got enough
-      // matches
-      if (longest_sequence_len >= min_match_count_ && !collect_all_states_) {
-        break;
-      }
+    if (longest_sequence_len + potential < min_match_count_) {
+      break;  // all further terms will not let us build long enough
+              // sequence
     }
   }
 
-  if (longest_sequence_len >= min_match_count_ && collect_all_states_) {
+  if (longest_sequence_len >= min_match_count_) {
     if constexpr (kHasPosition) {
       static_cast<NGramPosition&>(*this).ClearOffsets();
     }
@@ -22,6 +22,7 @@
 
 #include "phrase_filter.hpp"
 
+#include "analysis/shingle.hpp"
 #include "index/field_meta.hpp"
 #include "search/collectors.hpp"
 #include "search/filter_visitor.hpp"
@@ -209,6 +210,50 @@ bool Valid(const term_reader* reader) noexcept {
                                 FixedPhraseQuery::kRequiredFeatures;
 }
 
+// Finds the rarest shingle of adjacent phrase terms.
+// Returns false if some pair of adjacent terms has no shingle,
+// i.e. phrase doesn't match any document of a segment.
+bool SeekShingle(const term_reader& reader, const by_phrase_options& options,
+                 seek_cookie::ptr& cookie) {
+  IRS_ASSERT(options.simple());
+
+  auto terms = reader.iterator(SeekMode::RANDOM_ONLY);
+
+  if (IRS_UNLIKELY(!terms)) {
+    return true;
+  }
+
+  const auto* meta = irs::get<term_meta>(*terms);
+  auto min_docs = std::numeric_limits<doc_id_t>::max();
+  bstring shingle;
+
+  for (auto prev = options.begin(), it = std::next(prev); it != options.end();
+       prev = it++) {
+    if (it->first != prev->first + 1) {
+      // not adjacent terms
+      continue;
+    }
+
+    analysis::MakeShingle(shingle,
+                          std::get<by_term_options>(prev->second).term,
+                          std::get<by_term_options>(it->second).term);
+
+    if (!terms->seek(shingle)) {
+      return false;
+    }
+
+    terms->read();
+
+    const auto docs = meta ? meta->docs_count : min_docs;
+    if (!cookie || docs < min_docs) {
+      min_docs = docs;
+      cookie = terms->cookie();
+    }
+  }
+
+  return true;
+}
+
 filter::prepared::ptr FixedPrepareCollect(const PrepareContext& ctx,
                                           std::string_view field,
                                           const by_phrase_options& options) {
@@ -255,8 +300,15 @@ filter::prepared::ptr FixedPrepareCollect(const PrepareContext& ctx,
       continue;
     }
 
+    seek_cookie::ptr shingle;
+    if (options.shingles() && !SeekShingle(*reader, options, shingle)) {
+      phrase_terms.clear();
+      continue;
+    }
+
     auto& state = phrase_states.insert(segment);
     state.terms = std::move(phrase_terms);
+    state.shingle = std::move(shingle);
     state.reader = reader;
 
     phrase_terms.reserve(phrase_size);
@@ -99,9 +99,18 @@ class by_phrase_options {
 
   // Returns true is options are equal, false - otherwise
   bool operator==(const by_phrase_options& rhs) const noexcept {
-    return phrase_ == rhs.phrase_;
+    return phrase_ == rhs.phrase_ && shingles_ == rhs.shingles_;
   }
 
+  // Denotes that a field is indexed with shingles, i.e. each pair of
+  // adjacent terms is also indexed as a single term (see
+  // analysis/shingle.hpp). Phrases of simple terms then consider only
+  // documents containing the rarest shingle of a phrase.
+  void shingles(bool value) noexcept { shingles_ = value; }
+
+  // Returns true if a field is indexed with shingles, false - otherwise
+  bool shingles() const noexcept { return shingles_; }
+
   // Clear phrase contents
   void clear() noexcept {
     phrase_.clear();
@@ -130,6 +139,7 @@ class by_phrase_options {
 
   phrase_type phrase_;
   bool is_simple_term_only_{true};
+  bool shingles_{false};
 };
 
 class by_phrase : public FilterWithField<by_phrase_options> {
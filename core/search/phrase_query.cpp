@@ -70,7 +70,19 @@ doc_iterator::ptr FixedPhraseQuery::execute(const ExecutionContext& ctx) const {
   const IndexFeatures features = ord.features() | kRequiredFeatures;
 
   ScoreAdapters itrs;
-  itrs.reserve(phrase_state->terms.size());
+  itrs.reserve(phrase_state->terms.size() + 1);
+
+  if (phrase_state->shingle) {
+    // Documents containing the rarest shingle of a phrase are candidates,
+    // conjunction is driven by the cheapest iterator, so positions
+    // are checked only for those
+    auto& docs = itrs.emplace_back(
+      reader->postings(*phrase_state->shingle, IndexFeatures::NONE));
+
+    if (IRS_UNLIKELY(!docs)) {
+      return doc_iterator::empty();
+    }
+  }
 
   std::vector<FixedTermPosition> positions;
   positions.reserve(phrase_state->terms.size());
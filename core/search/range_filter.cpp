@@ -24,6 +24,7 @@
 
 #include "analysis/token_attributes.hpp"
 #include "index/index_reader.hpp"
+#include "index/term_ordinals.hpp"
 #include "search/filter_visitor.hpp"
 #include "search/limited_sample_collector.hpp"
 #include "search/term_filter.hpp"
@@ -107,12 +108,76 @@ void VisitImpl(const SubReader& segment, const term_reader& reader,
   }
 }
 
+// Returns interval [begin, end) of ordinals of terms within a range.
+std::pair<uint32_t, uint32_t> OrdinalRange(
+  const TermOrdinals& ords, const by_range_options::range_type& rng) noexcept {
+  uint32_t begin = 0;
+  switch (rng.min_type) {
+    case BoundType::UNBOUNDED:
+      break;
+    case BoundType::INCLUSIVE:
+      begin = ords.lower_bound(rng.min);
+      break;
+    case BoundType::EXCLUSIVE:
+      begin = ords.upper_bound(rng.min);
+      break;
+  }
+
+  uint32_t end = ords.size();
+  switch (rng.max_type) {
+    case BoundType::UNBOUNDED:
+      break;
+    case BoundType::INCLUSIVE:
+      end = ords.upper_bound(rng.max);
+      break;
+    case BoundType::EXCLUSIVE:
+      end = ords.lower_bound(rng.max);
+      break;
+  }
+
+  return {begin, std::max(begin, end)};
+}
+
+template<typename Visitor>
+void VisitImpl(const SubReader& segment, const term_reader& reader,
+               const TermOrdinals& ords,
+               const by_range_options::range_type& rng, Visitor& visitor) {
+  auto [begin, end] = OrdinalRange(ords, rng);
+
+  if (begin == end) {
+    // no need to access term dictionary
+    return;
+  }
+
+  auto it = reader.iterator(SeekMode::NORMAL);
+
+  if (IRS_UNLIKELY(!it)) {
+    return;
+  }
+
+  OrdinalTermIterator terms{ords, std::move(it)};
+
+  if (!terms.seek(begin)) {
+    return;
+  }
+
+  terms.read();
+  visitor.prepare(segment, reader, terms);
+  visitor.visit(kNoBoost);
+
+  while (terms.ord() + 1 != end && terms.next()) {
+    terms.read();
+    visitor.visit(kNoBoost);
+  }
+}
+
 }  // namespace
 
 filter::prepared::ptr by_range::prepare(const PrepareContext& ctx,
                                         std::string_view field,
                                         const options_type::range_type& rng,
-                                        size_t scored_terms_limit) {
+                                        size_t scored_terms_limit,
+                                        TermOrdinalsCache* ordinals) {
   // TODO: optimize unordered case
   //  - seek to min
   //  - get ordinal position of the term
@@ -138,7 +203,12 @@ filter::prepared::ptr by_range::prepare(const PrepareContext& ctx,
 
   for (const auto& segment : ctx.index) {
     if (const auto* reader = segment.field(field); reader) {
-      VisitImpl(segment, *reader, rng, mtv);
+      if (ordinals) {
+        VisitImpl(segment, *reader, *ordinals->Get(segment, *reader), rng,
+                  mtv);
+      } else {
+        VisitImpl(segment, *reader, rng, mtv);
+      }
     }
   }
 
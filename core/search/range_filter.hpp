@@ -29,6 +29,7 @@
 namespace irs {
 
 class by_range;
+class TermOrdinalsCache;
 struct filter_visitor;
 
 struct by_range_filter_options {
@@ -57,6 +58,15 @@ struct by_range_options : by_range_filter_options {
   //////////////////////////////////////////////////////////////////////////////
   size_t scored_terms_limit{1024};
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief optional cache of term ordinals, if set, the range is resolved
+  ///        into an interval of term ordinals and terms are visited without
+  ///        comparing them to the upper bound
+  /// @note ordinals hold a copy of all terms of a field, their memory is
+  ///       charged to the resource manager of the cache
+  //////////////////////////////////////////////////////////////////////////////
+  std::shared_ptr<TermOrdinalsCache> ordinals;
+
   bool operator==(const by_range_options& rhs) const noexcept {
     return filter_options::operator==(rhs) &&
            scored_terms_limit == rhs.scored_terms_limit;
@@ -72,7 +82,8 @@ class by_range : public FilterWithField<by_range_options> {
   static prepared::ptr prepare(const PrepareContext& ctx,
                                std::string_view field,
                                const options_type::range_type& rng,
-                               size_t scored_terms_limit);
+                               size_t scored_terms_limit,
+                               TermOrdinalsCache* ordinals = nullptr);
 
   static void visit(const SubReader& segment, const term_reader& reader,
                     const options_type::range_type& rng,
@@ -80,7 +91,7 @@ class by_range : public FilterWithField<by_range_options> {
 
   prepared::ptr prepare(const PrepareContext& ctx) const final {
     return prepare(ctx.Boost(boost()), field(), options().range,
-                   options().scored_terms_limit);
+                   options().scored_terms_limit, options().ordinals.get());
   }
 };
 
@@ -43,6 +43,8 @@ struct FixedPhraseState {
 
   using Terms = ManagedVector<TermState>;
   Terms terms;
+  // The rarest shingle of the phrase, if any
+  seek_cookie::ptr shingle;
   const term_reader* reader{};
 };
 
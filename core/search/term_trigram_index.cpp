@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "term_trigram_index.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "utils/utf8_utils.hpp"
+#include "utils/wildcard_utils.hpp"
+
+namespace irs {
+namespace {
+
+constexpr size_t kTrigramSize = 3;
+
+IRS_FORCE_INLINE TermTrigramIndex::Trigram MakeTrigram(
+  const byte_type* p) noexcept {
+  return TermTrigramIndex::Trigram{p[0]} << 16 |
+         TermTrigramIndex::Trigram{p[1]} << 8 | TermTrigramIndex::Trigram{p[2]};
+}
+
+}  // namespace
+
+TermTrigramIndex::TermTrigramIndex(const term_reader& field,
+                                   IResourceManager& resource_manager)
+  : ords_{field, resource_manager},
+    postings_{PostingsMap::allocator_type{resource_manager}} {
+  for (uint32_t ord = 0, size = ords_.size(); ord < size; ++ord) {
+    const bytes_view value = ords_.term(ord);
+
+    if (value.size() < kTrigramSize) {
+      continue;
+    }
+
+    const auto* end = value.data() + value.size() - kTrigramSize + 1;
+    for (const auto* p = value.data(); p != end; ++p) {
+      auto& ords =
+        postings_.try_emplace(MakeTrigram(p), resource_manager).first->second;
+      // trigram may occur in a term multiple times
+      if (ords.empty() || ords.back() != ord) {
+        ords.emplace_back(ord);
+      }
+    }
+  }
+}
+
+std::vector<TermTrigramIndex::Trigram> TermTrigramIndex::RequiredTrigrams(
+  bytes_view pattern) {
+  std::vector<Trigram> trigrams;
+  bstring literal;
+
+  auto flush = [&] {
+    if (literal.size() >= kTrigramSize) {
+      const auto* end = literal.data() + literal.size() - kTrigramSize + 1;
+      for (const auto* p = literal.data(); p != end; ++p) {
+        trigrams.emplace_back(MakeTrigram(p));
+      }
+    }
+    literal.clear();
+  };
+
+  // literal parts are split the same way FromWildcard(...) does
+  bool escaped = false;
+  const auto* it = pattern.data();
+  const auto* end = it + pattern.size();
+  while (it != end) {
+    const auto curr = *it;
+    const auto* next = utf8_utils::Next(it, end);
+    const bytes_view label{it, static_cast<size_t>(next - it)};
+    it = next;
+
+    if (escaped) {
+      literal += label;
+      escaped = false;
+      continue;
+    }
+    switch (curr) {
+      case WildcardMatch::kAnyStr:
+      case WildcardMatch::kAnyChr:
+        flush();
+        break;
+      case WildcardMatch::kEscape:
+        escaped = true;
+        break;
+      default:
+        literal += label;
+        break;
+    }
+  }
+  flush();
+
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+  return trigrams;
+}
+
+std::vector<uint32_t> TermTrigramIndex::Candidates(
+  std::span<const Trigram> trigrams) const {
+  std::vector<uint32_t> candidates;
+
+  if (trigrams.empty()) {
+    candidates.resize(ords_.size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    return candidates;
+  }
+
+  std::vector<const Postings*> lists;
+  lists.reserve(trigrams.size());
+  for (const auto trigram : trigrams) {
+    const auto it = postings_.find(trigram);
+    if (it == postings_.end()) {
+      return candidates;
+    }
+    lists.emplace_back(&it->second);
+  }
+
+  // intersect starting from the rarest trigram
+  std::sort(lists.begin(), lists.end(),
+            [](const auto* lhs, const auto* rhs) noexcept {
+              return lhs->size() < rhs->size();
+            });
+
+  candidates.assign(lists.front()->begin(), lists.front()->end());
+  std::vector<uint32_t> buf;
+  for (auto list = lists.begin() + 1, end = lists.end();
+       list != end && !candidates.empty(); ++list) {
+    buf.clear();
+    std::set_intersection(candidates.begin(), candidates.end(),
+                          (*list)->begin(), (*list)->end(),
+                          std::back_inserter(buf));
+    candidates.swap(buf);
+  }
+
+  return candidates;
+}
+
+}  // namespace irs
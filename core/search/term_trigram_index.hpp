@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <span>
+#include <vector>
+
+#include "index/term_ordinals.hpp"
+
+namespace irs {
+
+// Side index of a term dictionary mapping byte trigrams to ordinals of terms
+// containing them. Ordinals follow the dictionary order, i.e. a term with a
+// lesser ordinal precedes a term with a greater one. Memory of the index is
+// accounted by the specified resource manager.
+class TermTrigramIndex : private util::noncopyable {
+ public:
+  using Trigram = uint32_t;
+
+  TermTrigramIndex(const term_reader& field,
+                   IResourceManager& resource_manager);
+
+  // Returns sorted unique trigrams every term matching a specified wildcard
+  // pattern contains, i.e. trigrams of its literal parts. Empty result means
+  // a pattern can't be used to prune terms.
+  static std::vector<Trigram> RequiredTrigrams(bytes_view pattern);
+
+  // Returns ordinals of terms containing all specified trigrams in ascending
+  // order.
+  std::vector<uint32_t> Candidates(std::span<const Trigram> trigrams) const;
+
+  const TermOrdinals& ordinals() const noexcept { return ords_; }
+
+ private:
+  using Postings = ManagedVector<uint32_t>;
+  using PostingsMap = absl::flat_hash_map<
+    Trigram, Postings, absl::Hash<Trigram>, std::equal_to<>,
+    ManagedTypedAllocator<std::pair<const Trigram, Postings>>>;
+
+  TermOrdinals ords_;
+  PostingsMap postings_;
+};
+
+// Declared as a class to allow forward declarations in filter headers.
+class TermTrigramIndexCache final : public FieldIndexCache<TermTrigramIndex> {
+ public:
+  using FieldIndexCache::FieldIndexCache;
+};
+
+}  // namespace irs
@@ -24,9 +24,11 @@
 
 #include "index/index_reader.hpp"
 #include "search/filter_visitor.hpp"
+#include "search/limited_sample_collector.hpp"
 #include "search/multiterm_query.hpp"
 #include "search/prefix_filter.hpp"
 #include "search/term_filter.hpp"
+#include "search/term_trigram_index.hpp"
 #include "shared.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/hash_utils.hpp"
@@ -76,6 +78,70 @@ auto ExecuteWildcard(bstring& buf, bytes_view term, Term&& t, Prefix&& p,
   }
 }
 
+// Visits terms matching an automaton among terms containing all specified
+// trigrams, candidates are verified in the dictionary order.
+template<typename Visitor>
+void VisitCandidates(const SubReader& segment, const term_reader& reader,
+                     const TermTrigramIndex& index,
+                     std::span<const TermTrigramIndex::Trigram> trigrams,
+                     const automaton& acceptor, Visitor& visitor) {
+  const auto candidates = index.Candidates(trigrams);
+
+  if (candidates.empty()) {
+    return;
+  }
+
+  auto terms = reader.iterator(SeekMode::NORMAL);
+
+  if (IRS_UNLIKELY(!terms)) {
+    return;
+  }
+
+  fst::SortedRangeExplicitMatcher<automaton> matcher{&acceptor};
+  bool prepared = false;
+  for (const auto ord : candidates) {
+    const auto term = index.ordinals().term(ord);
+
+    if (!Match(matcher, term) || !terms->seek(term)) {
+      continue;
+    }
+
+    if (!prepared) {
+      visitor.prepare(segment, reader, *terms);
+      prepared = true;
+    }
+
+    terms->read();
+
+    visitor.visit(kNoBoost);
+  }
+}
+
+filter::prepared::ptr PrepareTrigramFilter(const PrepareContext& ctx,
+                                           std::string_view field,
+                                           bytes_view pattern,
+                                           size_t scored_terms_limit,
+                                           TermTrigramIndexCache& cache) {
+  const auto trigrams = TermTrigramIndex::RequiredTrigrams(pattern);
+  const auto acceptor = FromWildcard(pattern);
+
+  if (trigrams.empty()) {
+    // nothing to prune terms by
+    return PrepareAutomatonFilter(ctx, field, acceptor, scored_terms_limit);
+  }
+
+  if (!Validate(acceptor)) {
+    return filter::prepared::empty();
+  }
+
+  return PrepareMultiTermQuery(
+    ctx, field, scored_terms_limit,
+    [&](const SubReader& segment, const term_reader& reader, auto& visitor) {
+      const auto index = cache.Get(segment, reader);
+      VisitCandidates(segment, reader, *index, trigrams, acceptor, visitor);
+    });
+}
+
 }  // namespace
 
 field_visitor by_wildcard::visitor(bytes_view term) {
@@ -122,10 +188,9 @@ field_visitor by_wildcard::visitor(bytes_view term) {
     });
 }
 
-filter::prepared::ptr by_wildcard::prepare(const PrepareContext& ctx,
-                                           std::string_view field,
-                                           bytes_view term,
-                                           size_t scored_terms_limit) {
+filter::prepared::ptr by_wildcard::prepare(
+  const PrepareContext& ctx, std::string_view field, bytes_view term,
+  size_t scored_terms_limit, TermTrigramIndexCache* trigram_index) {
   bstring buf;
   return ExecuteWildcard(
     buf, term,
@@ -136,6 +201,10 @@ filter::prepared::ptr by_wildcard::prepare(const PrepareContext& ctx,
       return by_prefix::prepare(ctx, field, term, scored_terms_limit);
     },
     [&, scored_terms_limit](bytes_view term) -> prepared::ptr {
+      if (trigram_index) {
+        return PrepareTrigramFilter(ctx, field, term, scored_terms_limit,
+                                    *trigram_index);
+      }
       return PrepareAutomatonFilter(ctx, field, FromWildcard(term),
                                     scored_terms_limit);
     });
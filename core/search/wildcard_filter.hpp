@@ -28,6 +28,7 @@
 namespace irs {
 
 class by_wildcard;
+class TermTrigramIndexCache;
 struct filter_visitor;
 
 struct by_wildcard_filter_options {
@@ -46,6 +47,11 @@ struct by_wildcard_options : by_wildcard_filter_options {
   // The maximum number of most frequent terms to consider for scoring
   size_t scored_terms_limit{1024};
 
+  // Optional cache of per-field trigram indexes, if set, terms matching
+  // a pattern with literal parts are looked up among terms containing
+  // all trigrams of the literal parts instead of the whole term dictionary.
+  std::shared_ptr<TermTrigramIndexCache> trigram_index;
+
   bool operator==(const by_wildcard_options& rhs) const noexcept {
     return filter_options::operator==(rhs) &&
            scored_terms_limit == rhs.scored_terms_limit;
@@ -57,13 +63,14 @@ class by_wildcard final : public FilterWithField<by_wildcard_options> {
  public:
   static prepared::ptr prepare(const PrepareContext& ctx,
                                std::string_view field, bytes_view term,
-                               size_t scored_terms_limit);
+                               size_t scored_terms_limit,
+                               TermTrigramIndexCache* trigram_index = nullptr);
 
   static field_visitor visitor(bytes_view term);
 
   prepared::ptr prepare(const PrepareContext& ctx) const final {
     return prepare(ctx.Boost(boost()), field(), options().term,
-                   options().scored_terms_limit);
+                   options().scored_terms_limit, options().trigram_index.get());
   }
 };
 
@@ -23,9 +23,16 @@
 
 #include "directory_attributes.hpp"
 
+#include <atomic>
+
 #include "error/error.hpp"
 
 namespace irs {
+namespace {
+
+std::atomic_uint64_t NEXT_DIRECTORY_ID{0};
+
+}  // namespace
 
 void index_file_refs::clear() {
   refs_.visit([](const auto&, size_t) { return true; }, true);
@@ -36,6 +43,8 @@ void index_file_refs::clear() {
 }
 
 directory_attributes::directory_attributes(std::unique_ptr<irs::encryption> enc)
-  : enc_{std::move(enc)}, refs_{std::make_unique<index_file_refs>()} {}
+  : enc_{std::move(enc)},
+    refs_{std::make_unique<index_file_refs>()},
+    id_{NEXT_DIRECTORY_ID.fetch_add(1, std::memory_order_relaxed)} {}
 
 }  // namespace irs
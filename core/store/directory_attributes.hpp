@@ -97,10 +97,14 @@ class directory_attributes {
 
   irs::encryption* encryption() const noexcept { return enc_.get(); }
   index_file_refs& refs() const noexcept { return *refs_; }
+  // Returns identifier of a directory unique within a process, unlike
+  // directory address it is never reused by another directory
+  uint64_t id() const noexcept { return id_; }
 
  private:
   std::unique_ptr<irs::encryption> enc_;
   std::unique_ptr<index_file_refs> refs_;
+  uint64_t id_;
 };
 
 }  // namespace irs
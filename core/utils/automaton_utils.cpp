@@ -222,24 +222,11 @@ filter::prepared::ptr PrepareAutomatonFilter(const PrepareContext& ctx,
     return filter::prepared::empty();
   }
 
-  // object for collecting order stats
-  limited_sample_collector<term_frequency> collector(
-    ctx.scorers.empty() ? 0 : scored_terms_limit);
-  MultiTermQuery::States states{ctx.memory, ctx.index.size()};
-  multiterm_visitor mtv{collector, states};
-
-  for (const auto& segment : ctx.index) {
-    if (const auto* reader = segment.field(field); reader) {
-      Visit(segment, *reader, matcher, mtv);
-    }
-  }
-
-  MultiTermQuery::Stats stats{{ctx.memory}};
-  collector.score(ctx.index, ctx.scorers, stats);
-
-  return memory::make_tracked<MultiTermQuery>(ctx.memory, std::move(states),
-                                              std::move(stats), ctx.boost,
-                                              ScoreMergeType::kSum, size_t{1});
+  return PrepareMultiTermQuery(
+    ctx, field, scored_terms_limit,
+    [&](const SubReader& segment, const term_reader& reader, auto& visitor) {
+      Visit(segment, reader, matcher, visitor);
+    });
 }
 
 }  // namespace irs
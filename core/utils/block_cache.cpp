@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "block_cache.hpp"
+
+#include <absl/strings/str_cat.h>
+
+#include "store/directory.hpp"
+#include "store/directory_attributes.hpp"
+#include "utils/assert.hpp"
+
+namespace irs {
+
+BlockCache::File::Ref::Ref(std::shared_ptr<BlockCache>&& cache,
+                           std::string_view name)
+  : cache{std::move(cache)}, name{name}, id{this->cache->Acquire(name)} {}
+
+BlockCache::File::Ref::~Ref() { cache->Release(name); }
+
+BlockCache::File::File(std::shared_ptr<BlockCache> cache,
+                       std::string_view name) {
+  if (cache) {
+    ref_ = std::make_shared<const Ref>(std::move(cache), name);
+  }
+}
+
+std::string BlockCache::MakeName(const directory& dir, std::string_view file,
+                                 std::string_view kind) {
+  // Directory identifier distinguishes indexes sharing a cache, unlike
+  // directory address it isn't reused by directories created later.
+  return absl::StrCat(dir.attributes().id(), "/", file, kind.empty() ? "" : "#",
+                      kind);
+}
+
+BlockCache::BlockCache(size_t capacity, const ResourceManagementOptions& rm,
+                       size_t num_shards)
+  : resource_manager_{*rm.readers},
+    shards_(std::max(num_shards, size_t{1})),
+    shard_capacity_{capacity / shards_.size()} {}
+
+BlockCache::~BlockCache() {
+  for (auto& shard : shards_) {
+    resource_manager_.DecreaseChecked(shard.bytes);
+  }
+}
+
+void BlockCache::Put(uint64_t file, uint64_t offset, uint64_t end,
+                     bytes_view block) {
+  const auto size = EntrySize(block.size());
+
+  if (size > shard_capacity_) {
+    return;
+  }
+
+  const Key key{file, offset};
+  auto& shard = GetShard(key);
+
+  std::lock_guard lock{shard.mutex};
+
+  if (shard.index.contains(key)) {
+    // Block is already cached by a concurrent reader
+    return;
+  }
+
+  try {
+    resource_manager_.Increase(size);
+  } catch (...) {
+    return;
+  }
+
+  try {
+    shard.lru.emplace_front(Entry{key, end, bstring{block}});
+    try {
+      shard.index.emplace(key, shard.lru.begin());
+      try {
+        shard.files[file].emplace(offset);
+      } catch (...) {
+        shard.index.erase(key);
+        if (auto it = shard.files.find(file);
+            it != shard.files.end() && it->second.empty()) {
+          shard.files.erase(it);
+        }
+        throw;
+      }
+    } catch (...) {
+      shard.lru.pop_front();
+      throw;
+    }
+  } catch (...) {
+    resource_manager_.Decrease(size);
+    return;
+  }
+
+  shard.bytes += size;
+  bytes_.fetch_add(size, std::memory_order_relaxed);
+
+  while (shard.bytes > shard_capacity_) {
+    IRS_ASSERT(!shard.lru.empty());
+    const auto victim = shard.lru.back().key;
+    auto offsets = shard.files.find(victim.file);
+    IRS_ASSERT(offsets != shard.files.end());
+    offsets->second.erase(victim.offset);
+    if (offsets->second.empty()) {
+      shard.files.erase(offsets);
+    }
+    Erase(shard, shard.index.find(victim));
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void BlockCache::Erase(Shard& shard, Index::iterator it) noexcept {
+  IRS_ASSERT(it != shard.index.end());
+  const auto size = EntrySize(it->second->block.size());
+
+  shard.lru.erase(it->second);
+  shard.index.erase(it);
+  shard.bytes -= size;
+  bytes_.fetch_sub(size, std::memory_order_relaxed);
+  resource_manager_.Decrease(size);
+}
+
+uint64_t BlockCache::Acquire(std::string_view name) {
+  std::lock_guard lock{files_mutex_};
+  auto [it, inserted] = files_.try_emplace(name, FileInfo{next_file_id_, 0});
+  if (inserted) {
+    ++next_file_id_;
+  }
+  ++it->second.refs;
+  return it->second.id;
+}
+
+void BlockCache::Release(std::string_view name) noexcept {
+  uint64_t id;
+  {
+    std::lock_guard lock{files_mutex_};
+    auto it = files_.find(name);
+    IRS_ASSERT(it != files_.end() && it->second.refs != 0);
+    if (--it->second.refs != 0) {
+      return;
+    }
+    id = it->second.id;
+    files_.erase(it);
+  }
+  // Blocks of a released file are never accessed again, a file acquired
+  // by the same name meanwhile gets a new identifier.
+  Drop(id);
+}
+
+void BlockCache::Drop(uint64_t file) noexcept {
+  for (auto& shard : shards_) {
+    std::lock_guard lock{shard.mutex};
+    auto offsets = shard.files.extract(file);
+    if (offsets.empty()) {
+      continue;
+    }
+    for (const auto offset : offsets.mapped()) {
+      Erase(shard, shard.index.find(Key{file, offset}));
+    }
+  }
+}
+
+BlockCache::Stats BlockCache::GetStats() const noexcept {
+  return {.hits = hits_.load(std::memory_order_relaxed),
+          .misses = misses_.load(std::memory_order_relaxed),
+          .evictions = evictions_.load(std::memory_order_relaxed),
+          .bytes = bytes_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace irs
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "resource_manager.hpp"
+#include "utils/string.hpp"
+
+namespace irs {
+
+struct directory;
+
+// Memory bounded LRU cache of decoded index blocks, e.g. postings blocks or
+// term dictionary blocks, identified by a file and an offset within a file.
+// Cache is split into independently locked shards and is supposed to be
+// shared by all readers of an index. Memory occupied by cached blocks is
+// accounted by the 'readers' resource manager, blocks are silently not
+// cached if the resource manager refuses an allocation.
+class BlockCache {
+ public:
+  static constexpr size_t kDefaultShards = 16;
+
+  struct Stats {
+    uint64_t hits{};
+    uint64_t misses{};
+    uint64_t evictions{};
+    uint64_t bytes{};
+
+    double HitRatio() const noexcept {
+      const auto total = hits + misses;
+      return total ? static_cast<double>(hits) / static_cast<double>(total)
+                   : 0.;
+    }
+  };
+
+  // Handle for caching blocks of a particular file. Handles created for
+  // the same file name share cached blocks, e.g. readers of the same segment
+  // opened by different index readers. Blocks of a file are dropped once
+  // the last handle referring to it is destroyed.
+  class File {
+   public:
+    File() = default;
+    // 'name' must identify immutable file contents across all users of
+    // a cache, see MakeName(...).
+    File(std::shared_ptr<BlockCache> cache, std::string_view name);
+
+    explicit operator bool() const noexcept { return ref_ != nullptr; }
+
+    template<typename Visitor>
+    bool Visit(uint64_t offset, Visitor&& visitor) const {
+      return ref_->cache->Visit(ref_->id, offset,
+                                std::forward<Visitor>(visitor));
+    }
+
+    void Put(uint64_t offset, uint64_t end, bytes_view block) const {
+      ref_->cache->Put(ref_->id, offset, end, block);
+    }
+
+   private:
+    struct Ref {
+      Ref(std::shared_ptr<BlockCache>&& cache, std::string_view name);
+      ~Ref();
+
+      std::shared_ptr<BlockCache> cache;
+      std::string name;
+      uint64_t id;
+    };
+
+    std::shared_ptr<const Ref> ref_;
+  };
+
+  // Returns a name identifying cached blocks of a specified 'file' of
+  // a directory, 'kind' distinguishes different decodings of a file.
+  static std::string MakeName(const directory& dir, std::string_view file,
+                              std::string_view kind = {});
+
+  explicit BlockCache(
+    size_t capacity,
+    const ResourceManagementOptions& rm = ResourceManagementOptions::kDefault,
+    size_t num_shards = kDefaultShards);
+  ~BlockCache();
+
+  BlockCache(const BlockCache&) = delete;
+  BlockCache& operator=(const BlockCache&) = delete;
+
+  // Calls 'visitor(block, end)' and returns 'true' if a block starting
+  // at 'offset' of a specified 'file' is cached, 'end' denotes an offset
+  // right after the block.
+  template<typename Visitor>
+  bool Visit(uint64_t file, uint64_t offset, Visitor&& visitor) {
+    const Key key{file, offset};
+    auto& shard = GetShard(key);
+    {
+      std::lock_guard lock{shard.mutex};
+      if (auto it = shard.index.find(key); it != shard.index.end()) {
+        auto& entry = *it->second;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        visitor(bytes_view{entry.block}, entry.end);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Caches a copy of a specified block.
+  void Put(uint64_t file, uint64_t offset, uint64_t end, bytes_view block);
+
+  // Returns number of files having cached blocks or live handles.
+  size_t Files() const {
+    std::lock_guard lock{files_mutex_};
+    return files_.size();
+  }
+
+  size_t Capacity() const noexcept { return shard_capacity_ * shards_.size(); }
+
+  Stats GetStats() const noexcept;
+
+ private:
+  struct Key {
+    uint64_t file;
+    uint64_t offset;
+
+    bool operator==(const Key&) const noexcept = default;
+
+    template<typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.file, key.offset);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    uint64_t end;
+    bstring block;
+  };
+
+  using Index = absl::flat_hash_map<Key, std::list<Entry>::iterator>;
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> lru;
+    Index index;
+    // Offsets of cached blocks per file, let a file be dropped without
+    // scanning blocks of other files
+    absl::flat_hash_map<uint64_t, absl::flat_hash_set<uint64_t>> files;
+    size_t bytes{};
+  };
+
+  // Approximate memory occupied by a cache entry.
+  static size_t EntrySize(size_t block_size) noexcept {
+    // list node + hash map slot + file offsets slot
+    return block_size + sizeof(Entry) + 2 * sizeof(void*) + sizeof(Key) +
+           sizeof(void*) + sizeof(uint64_t);
+  }
+
+  Shard& GetShard(const Key& key) noexcept {
+    return shards_[absl::Hash<Key>{}(key) % shards_.size()];
+  }
+
+  struct FileInfo {
+    uint64_t id;
+    size_t refs;
+  };
+
+  // Removes a cached block referenced by 'it' from a specified 'shard',
+  // offsets of the block file are maintained by the caller.
+  void Erase(Shard& shard, Index::iterator it) noexcept;
+
+  uint64_t Acquire(std::string_view name);
+  void Release(std::string_view name) noexcept;
+  // Drops all cached blocks of a specified file.
+  void Drop(uint64_t file) noexcept;
+
+  IResourceManager& resource_manager_;
+  std::vector<Shard> shards_;
+  size_t shard_capacity_;
+  mutable std::mutex files_mutex_;
+  absl::flat_hash_map<std::string, FileInfo> files_;
+  uint64_t next_file_id_{0};
+  std::atomic_uint64_t hits_{0};
+  std::atomic_uint64_t misses_{0};
+  std::atomic_uint64_t evictions_{0};
+  std::atomic_uint64_t bytes_{0};
+};
+
+}  // namespace irs
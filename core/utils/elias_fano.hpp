@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+#include "shared.hpp"
+#include "store/data_input.hpp"
+#include "store/data_output.hpp"
+#include "utils/bit_utils.hpp"
+#include "utils/math_utils.hpp"
+
+namespace irs {
+
+// ----------------------------------------------------------------------------
+// --SECTION--                             elias-fano partition encode/decode
+// ----------------------------------------------------------------------------
+//
+// Encodes a non-decreasing sequence of 'Size' 32-bit integers (a partition)
+// using the cheapest of the following representations:
+//
+// Run of consecutive values (v[i] == v[0] + i):
+//   <BlockHeader>
+//     <RUN>
+//   </BlockHeader>
+//   <FirstValue>
+//
+// Strictly increasing values stored as a plain bitmap over the universe:
+//   <BlockHeader>
+//     <BITMAP>
+//   </BlockHeader>
+//   <UniverseSize>
+//   <Bitmap>
+//
+// Elias-Fano:
+//   <BlockHeader>
+//     </NumberOfLowBits>
+//   </BlockHeader>
+//   <NumberOfHighBuckets>
+//   <LowBits>
+//   <HighBits>
+//
+// ----------------------------------------------------------------------------
+
+namespace elias_fano {
+
+inline constexpr uint32_t kRun = 0xFE;
+inline constexpr uint32_t kBitmap = 0xFF;
+
+// Max number of 64-bit words needed to store any part of an encoded partition
+// of 'Size' elements, Elias-Fano never uses more than 'Size * 34 + 1' bits and
+// bitmap representation is chosen only if it's smaller than Elias-Fano
+template<uint32_t Size>
+inline constexpr size_t kMaxWords = (34 * size_t{Size} + 1 + 63) / 64;
+
+constexpr size_t bytes_required(uint64_t bits) noexcept {
+  return (bits + 7) / 8;
+}
+
+// Number of low bits to use for a partition of 'size' elements
+// within the universe [0, 'max']
+inline uint32_t low_bits(uint32_t max, uint32_t size) noexcept {
+  IRS_ASSERT(size);
+  const uint64_t universe = uint64_t{max} + 1;
+  return universe > size ? math::log2_floor_64(universe / size) : 0;
+}
+
+namespace detail {
+
+IRS_FORCE_INLINE void write_bits(uint64_t* words, uint64_t offset,
+                                 uint64_t value, uint32_t bits) noexcept {
+  IRS_ASSERT(bits < 64);
+  const auto word = offset / 64;
+  const auto shift = offset % 64;
+  words[word] |= value << shift;
+  if (shift + bits > 64) {
+    words[word + 1] |= value >> (64 - shift);
+  }
+}
+
+IRS_FORCE_INLINE uint32_t read_bits(const uint64_t* words, uint64_t offset,
+                                    uint32_t bits) noexcept {
+  IRS_ASSERT(bits < 64);
+  const auto word = offset / 64;
+  const auto shift = offset % 64;
+  uint64_t value = words[word] >> shift;
+  if (shift + bits > 64) {
+    value |= words[word + 1] << (64 - shift);
+  }
+  return static_cast<uint32_t>(value & ((uint64_t{1} << bits) - 1));
+}
+
+IRS_FORCE_INLINE void write_words(data_output& out, const uint64_t* words,
+                                  uint64_t bits) {
+  out.write_bytes(reinterpret_cast<const byte_type*>(words),
+                  bytes_required(bits));
+}
+
+IRS_FORCE_INLINE void read_words(data_input& in, uint64_t* words,
+                                 uint64_t bits) {
+  const auto size = bytes_required(bits);
+  words[(size - 1) / sizeof(uint64_t)] = 0;  // zero trailing bytes
+  [[maybe_unused]] const auto read =
+    in.read_bytes(reinterpret_cast<byte_type*>(words), size);
+  IRS_ASSERT(read == size);
+}
+
+// Calls 'visitor' for every set bit in the first 'bits' bits of 'words'
+template<typename Visitor>
+IRS_FORCE_INLINE void visit_set_bits(const uint64_t* words, uint64_t bits,
+                                     Visitor&& visitor) {
+  const auto* end = words + (bits + 63) / 64;
+  for (uint64_t base = 0; words != end; ++words, base += 64) {
+    for (auto word = *words; word; word &= word - 1) {
+      visitor(base + std::countr_zero(word));
+    }
+  }
+}
+
+// Reads Elias-Fano representation of a partition with 'low' number of
+// low bits, the header byte must be already consumed
+template<uint32_t Size>
+void read_elias_fano(data_input& in, uint32_t low,
+                     uint32_t* IRS_RESTRICT decoded,
+                     uint64_t (&words)[kMaxWords<Size>]) {
+  const uint64_t buckets = in.read_vlong();
+
+  if (low) {
+    detail::read_words(in, words, uint64_t{Size} * low);
+    for (uint64_t i = 0; i < Size; ++i) {
+      decoded[i] = detail::read_bits(words, i * low, low);
+    }
+  } else {
+    std::memset(decoded, 0, Size * sizeof(uint32_t));
+  }
+
+  IRS_ASSERT((Size + buckets + 63) / 64 <= std::size(words));
+  detail::read_words(in, words, Size + buckets);
+
+  uint32_t i = 0;
+  detail::visit_set_bits(words, Size + buckets,
+                         [&i, low, decoded](uint64_t bit) noexcept {
+                           IRS_ASSERT(i < Size);
+                           decoded[i] |= static_cast<uint32_t>(bit - i) << low;
+                           ++i;
+                         });
+  IRS_ASSERT(i == Size);
+}
+
+}  // namespace detail
+
+// Writes a partition of 'Size' non-decreasing values to a stream.
+// Returns the header byte, i.e. type of representation
+template<uint32_t Size>
+uint32_t write_block32(data_output& out,
+                       const uint32_t* IRS_RESTRICT decoded) {
+  static_assert(Size);
+  IRS_ASSERT(std::is_sorted(decoded, decoded + Size));
+
+  const uint32_t first = decoded[0];
+  const uint32_t max = decoded[Size - 1];
+
+  if (uint64_t{max} - first + 1 == Size) {
+    out.write_byte(static_cast<byte_type>(kRun));
+    out.write_vint(first);
+    return kRun;
+  }
+
+  const uint32_t low = low_bits(max, Size);
+  const uint64_t buckets = (uint64_t{max} >> low) + 1;
+  const uint64_t ef_bits = uint64_t{Size} * low + Size + buckets;
+  const uint64_t universe = uint64_t{max} + 1;
+
+  uint64_t words[kMaxWords<Size>];
+
+  if (universe < ef_bits &&
+      std::adjacent_find(decoded, decoded + Size) == decoded + Size) {
+    IRS_ASSERT((universe + 63) / 64 <= std::size(words));
+    std::memset(words, 0, sizeof words);
+    for (auto* v = decoded, *end = decoded + Size; v != end; ++v) {
+      words[*v / 64] |= uint64_t{1} << (*v % 64);
+    }
+
+    out.write_byte(static_cast<byte_type>(kBitmap));
+    out.write_vlong(universe);
+    detail::write_words(out, words, universe);
+    return kBitmap;
+  }
+
+  out.write_byte(static_cast<byte_type>(low));
+  out.write_vlong(buckets);
+
+  // low bits
+  if (low) {
+    const uint64_t mask = (uint64_t{1} << low) - 1;
+    std::memset(words, 0, sizeof words);
+    for (uint64_t i = 0; i < Size; ++i) {
+      detail::write_bits(words, i * low, decoded[i] & mask, low);
+    }
+    detail::write_words(out, words, uint64_t{Size} * low);
+  }
+
+  // high bits, i-th element sets bit 'i + (v[i] >> low)'
+  IRS_ASSERT((Size + buckets + 63) / 64 <= std::size(words));
+  std::memset(words, 0, sizeof words);
+  for (uint64_t i = 0; i < Size; ++i) {
+    const uint64_t bit = i + (decoded[i] >> low);
+    words[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+  detail::write_words(out, words, Size + buckets);
+
+  return low;
+}
+
+// Reads a partition of 'Size' values previously written with the
+// corresponding 'write_block32' function
+template<uint32_t Size>
+void read_block32(data_input& in, uint32_t* IRS_RESTRICT decoded) {
+  static_assert(Size);
+
+  const uint32_t header = in.read_byte();
+
+  if (kRun == header) {
+    std::iota(decoded, decoded + Size, in.read_vint());
+    return;
+  }
+
+  uint64_t words[kMaxWords<Size>];
+
+  if (kBitmap == header) {
+    const uint64_t universe = in.read_vlong();
+    IRS_ASSERT((universe + 63) / 64 <= std::size(words));
+    detail::read_words(in, words, universe);
+
+    auto* out = decoded;
+    detail::visit_set_bits(words, universe, [&out](uint64_t bit) noexcept {
+      *out++ = static_cast<uint32_t>(bit);
+    });
+    IRS_ASSERT(out == decoded + Size);
+    return;
+  }
+
+  detail::read_elias_fano<Size>(in, header, decoded, words);
+}
+
+// Reads a partition of 'Size' values previously written with the
+// corresponding 'write_block32' function and sets bits 'offset + value' in
+// 'set' without decoding the partition if it's stored as a run or a bitmap and
+// all values fit into the window [0, 'limit'). In this case returns 'true' and
+// only the last element of 'decoded' is populated. Otherwise decodes the
+// partition into 'decoded' and returns 'false'.
+template<uint32_t Size, typename Word>
+bool union_block32(data_input& in, uint32_t* IRS_RESTRICT decoded,
+                   uint64_t offset, uint64_t limit, Word* IRS_RESTRICT set) {
+  static_assert(Size);
+  static_assert(sizeof(Word) == sizeof(uint64_t));
+  constexpr uint64_t kBits = bits_required<Word>();
+
+  const uint32_t header = in.read_byte();
+
+  if (kRun == header) {
+    const uint32_t first = in.read_vint();
+    if (offset + first + Size > limit) {
+      std::iota(decoded, decoded + Size, first);
+      return false;
+    }
+
+    auto begin = offset + first;
+    const auto end = begin + Size;
+    for (; begin % kBits && begin != end; ++begin) {
+      set[begin / kBits] |= Word{1} << (begin % kBits);
+    }
+    for (; begin + kBits <= end; begin += kBits) {
+      set[begin / kBits] = ~Word{0};
+    }
+    for (; begin != end; ++begin) {
+      set[begin / kBits] |= Word{1} << (begin % kBits);
+    }
+    decoded[Size - 1] = first + Size - 1;
+    return true;
+  }
+
+  if (kBitmap == header) {
+    uint64_t words[kMaxWords<Size>];
+    const uint64_t universe = in.read_vlong();
+    IRS_ASSERT((universe + 63) / 64 <= std::size(words));
+    detail::read_words(in, words, universe);
+
+    if (offset + universe > limit) {
+      auto* out = decoded;
+      detail::visit_set_bits(words, universe, [&out](uint64_t bit) noexcept {
+        *out++ = static_cast<uint32_t>(bit);
+      });
+      IRS_ASSERT(out == decoded + Size);
+      return false;
+    }
+
+    // shifted OR of the whole bitmap
+    const auto shift = offset % kBits;
+    auto* dst = set + offset / kBits;
+    for (auto* word = words, *end = words + (universe + 63) / 64; word != end;
+         ++word, ++dst) {
+      dst[0] |= Word{*word} << shift;
+      if (shift) {
+        if (const auto carry = Word{*word} >> (kBits - shift); carry) {
+          dst[1] |= carry;
+        }
+      }
+    }
+    decoded[Size - 1] = static_cast<uint32_t>(universe - 1);
+    return true;
+  }
+
+  // elias-fano partitions are sparse, nothing to gain here
+  uint64_t words[kMaxWords<Size>];
+  detail::read_elias_fano<Size>(in, header, decoded, words);
+  return false;
+}
+
+// Skips a partition of 'Size' values previously written with the
+// corresponding 'write_block32' function
+template<uint32_t Size>
+void skip_block32(index_input& in) {
+  const uint32_t header = in.read_byte();
+
+  if (kRun == header) {
+    in.read_vint();
+  } else if (kBitmap == header) {
+    const uint64_t universe = in.read_vlong();
+    in.skip(bytes_required(universe));
+  } else {
+    const uint64_t buckets = in.read_vlong();
+    in.skip(bytes_required(uint64_t{Size} * header) +
+            bytes_required(Size + buckets));
+  }
+}
+
+}  // namespace elias_fano
+}  // namespace irs
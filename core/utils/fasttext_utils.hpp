@@ -23,6 +23,7 @@
 #pragma once
 
 #include "fasttext.h"
+#include "utils/assert.hpp"
 
 namespace fasttext {
 
@@ -43,6 +44,12 @@ class ImmutableFastText : public FastText {
     return getNN(*wordVectors_, query, k, {word});
   }
 
+  // Returns normalized vectors of the dictionary words.
+  const DenseMatrix& getWordVectors() const {
+    IRS_ASSERT(wordVectors_);
+    return *wordVectors_;
+  }
+
   std::vector<std::pair<real, std::string>> getNN(
     const DenseMatrix& wordVectors, const Vector& queryVec, int32_t k,
     const std::set<std::string>& banSet) const {
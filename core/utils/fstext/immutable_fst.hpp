@@ -89,6 +89,14 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
   static std::shared_ptr<ImmutableFstImpl<Arc>> Read(irs::data_input& strm,
                                                      irs::IResourceManager& rm);
 
+  // Same as 'Read' but references weights in place if 'strm' provides
+  // direct access to its data, 'strm' must outlive the FST then.
+  static std::shared_ptr<ImmutableFstImpl<Arc>> ReadInPlace(
+    irs::index_input& strm, irs::IResourceManager& rm);
+
+  // Positions 'strm' right after the serialized FST without reading it.
+  static bool Skip(irs::index_input& strm);
+
   const Arc* Arcs(StateId s) const noexcept { return states_[s].arcs; }
 
   // Provide information needed for generic state iterator.
@@ -108,7 +116,14 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
  private:
   friend class ImmutableFst<Arc>;
 
-  enum class Version : uint8_t { MIN = 0 };
+  enum class Version : uint8_t {
+    MIN = 0,
+
+    // * Size of encoded states and arcs is stored in a header
+    STATES_SIZE = 1,
+
+    MAX = STATES_SIZE
+  };
 
   struct State {
     const Arc* arcs;  // Start of state's arcs in *arcs_.
@@ -116,9 +131,27 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
     Weight weight;    // Final weight.
   };
 
+  struct Header {
+    Version version;
+    uint64_t props;
+    size_t total_weight_size;
+    StateId nstates;
+    StateId start;
+    size_t narcs;
+    size_t states_size;  // 0 if not stored
+  };
+
   // Properties always true of this FST class.
   static constexpr std::uint64_t kStaticProperties = kExpanded;
 
+  static bool ReadHeader(irs::data_input& stream, Header& header);
+  static void SkipStates(irs::index_input& stream, const Header& header);
+  // Reads states and arcs referencing 'weights' if specified,
+  // reads weights into memory otherwise.
+  static std::shared_ptr<ImmutableFstImpl<Arc>> Read(
+    irs::data_input& stream, const Header& header, irs::IResourceManager& rm,
+    const irs::byte_type* weights);
+
   std::unique_ptr<State[]> states_;
   std::unique_ptr<Arc[]> arcs_;
   std::unique_ptr<irs::byte_type[]> weights_;
@@ -132,33 +165,115 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
   ImmutableFstImpl& operator=(const ImmutableFstImpl&) = delete;
 };
 
+template<typename Arc>
+bool ImmutableFstImpl<Arc>::ReadHeader(irs::data_input& stream,
+                                       Header& header) {
+  header.version = Version(stream.read_byte());
+  if (header.version > Version::MAX) {
+    return false;
+  }
+
+  header.props = stream.read_long();
+  header.total_weight_size = stream.read_long();
+  header.nstates = stream.read_int();
+  header.start = header.nstates - stream.read_vint();
+  header.narcs = irs::read_zvlong(stream) + header.nstates;
+  header.states_size =
+    header.version >= Version::STATES_SIZE ? stream.read_vlong() : 0;
+  return true;
+}
+
+template<typename Arc>
+void ImmutableFstImpl<Arc>::SkipStates(irs::index_input& stream,
+                                       const Header& header) {
+  if (header.version >= Version::STATES_SIZE) {
+    stream.skip(header.states_size);
+    return;
+  }
+
+  for (auto nstates = header.nstates; nstates; --nstates) {
+    size_t weight_size = stream.read_vlong();
+    if (!irs::shift_unpack_64(weight_size, weight_size)) {
+      for (size_t narcs = static_cast<uint32_t>(stream.read_byte()) + 1; narcs;
+           --narcs) {
+        stream.read_byte();
+        stream.read_vint();
+        stream.read_vlong();
+      }
+    }
+  }
+}
+
 template<typename Arc>
 std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(
   irs::data_input& stream, irs::IResourceManager& rm) {
-  auto impl = std::make_shared<ImmutableFstImpl<Arc>>();
+  Header header;
+  if (!ReadHeader(stream, header)) {
+    return nullptr;
+  }
+  return Read(stream, header, rm, nullptr);
+}
 
-  // read header
-  if (Version(stream.read_byte()) != Version::MIN) {
+template<typename Arc>
+std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::ReadInPlace(
+  irs::index_input& stream, irs::IResourceManager& rm) {
+  Header header;
+  if (!ReadHeader(stream, header)) {
     return nullptr;
   }
 
-  const uint64_t props = stream.read_long();
-  const size_t total_weight_size = stream.read_long();
-  const StateId nstates = stream.read_int();
-  const StateId start = nstates - stream.read_vint();
-  const size_t narcs = irs::read_zvlong(stream) + nstates;
+  // weights follow states and arcs, locate them first
+  const size_t states_begin = stream.file_pointer();
+  SkipStates(stream, header);
+  const auto* weights =
+    stream.read_buffer(header.total_weight_size, irs::BufferHint::PERSISTENT);
+  const size_t end = stream.file_pointer();
+  stream.seek(states_begin);
+
+  auto impl = Read(stream, header, rm, weights);
+  if (weights) {
+    stream.seek(end);
+  }
+  return impl;
+}
+
+template<typename Arc>
+bool ImmutableFstImpl<Arc>::Skip(irs::index_input& stream) {
+  Header header;
+  if (!ReadHeader(stream, header)) {
+    return false;
+  }
+
+  SkipStates(stream, header);
+  stream.skip(header.total_weight_size);
+  return true;
+}
+
+template<typename Arc>
+std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(
+  irs::data_input& stream, const Header& header, irs::IResourceManager& rm,
+  const irs::byte_type* weights_in_place) {
+  auto impl = std::make_shared<ImmutableFstImpl<Arc>>();
+
+  const auto nstates = header.nstates;
+  const auto narcs = header.narcs;
+  const size_t weights_size =
+    weights_in_place ? 0 : header.total_weight_size;
 
   size_t allocated{nstates * sizeof(State) + narcs * sizeof(Arc) +
-                   total_weight_size * sizeof(irs::byte_type)};
+                   weights_size * sizeof(irs::byte_type)};
   irs::Finally cleanup = [&]() noexcept { rm.DecreaseChecked(allocated); };
 
   rm.Increase(allocated);
   auto states = std::make_unique<State[]>(nstates);
   auto arcs = std::make_unique<Arc[]>(narcs);
-  auto weights = std::make_unique<irs::byte_type[]>(total_weight_size);
+  std::unique_ptr<irs::byte_type[]> weights;
+  if (!weights_in_place) {
+    weights = std::make_unique<irs::byte_type[]>(weights_size);
+  }
 
   // read states & arcs
-  auto* weight = weights.get();
+  const auto* weight = weights_in_place ? weights_in_place : weights.get();
   auto* arc = arcs.get();
   for (auto state = states.get(), end = state + nstates; state != end;
        ++state) {
@@ -185,18 +300,20 @@ std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(
   }
 
   // read weights
-  stream.read_bytes(weights.get(), total_weight_size);
+  if (!weights_in_place) {
+    stream.read_bytes(weights.get(), weights_size);
+  }
 
   // noexcept block
   allocated = 0;
-  impl->properties_ = props;
-  impl->start_ = start;
+  impl->properties_ = header.props;
+  impl->start_ = header.start;
   impl->nstates_ = nstates;
   impl->narcs_ = narcs;
   impl->states_ = std::move(states);
   impl->arcs_ = std::move(arcs);
   impl->weights_ = std::move(weights);
-  impl->weights_size_ = total_weight_size;
+  impl->weights_size_ = weights_size;
   impl->resource_manager_ = &rm;
   return impl;
 }
@@ -232,6 +349,14 @@ class ImmutableFst : public ImplToExpandedFst<ImmutableFstImpl<A>> {
     return impl ? new ImmutableFst<A>(std::move(impl)) : nullptr;
   }
 
+  static ImmutableFst<A>* ReadInPlace(irs::index_input& strm,
+                                      irs::IResourceManager& rm) {
+    auto impl = Impl::ReadInPlace(strm, rm);
+    return impl ? new ImmutableFst<A>(std::move(impl)) : nullptr;
+  }
+
+  static bool Skip(irs::index_input& strm) { return Impl::Skip(strm); }
+
   // OpenFST API compliance broken. But as only we use it here it is ok.
   static ImmutableFst<A>* Read(std::istream& strm, const FstReadOptions&,
                                irs::IResourceManager& rm) {
@@ -241,8 +366,12 @@ class ImmutableFst : public ImplToExpandedFst<ImmutableFstImpl<A>> {
     return Read(*rdbuf->internal(), rm);
   }
 
+  // Writes a given FST, the size of encoded states is stored in a header
+  // if 'states_size' is set, readers may skip states at once then.
+  // Readers not aware of the stored size reject such FSTs.
   template<typename FST, typename Stats>
-  static bool Write(const FST& fst, irs::data_output& strm, const Stats& stats);
+  static bool Write(const FST& fst, irs::data_output& strm, const Stats& stats,
+                    bool states_size);
 
   void InitStateIterator(StateIteratorData<Arc>* data) const final {
     GetImpl()->InitStateIterator(data);
@@ -267,7 +396,7 @@ class ImmutableFst : public ImplToExpandedFst<ImmutableFstImpl<A>> {
 template<typename A>
 template<typename FST, typename Stats>
 bool ImmutableFst<A>::Write(const FST& fst, irs::data_output& stream,
-                            const Stats& stats) {
+                            const Stats& stats, bool states_size) {
   static_assert(sizeof(StateId) == sizeof(uint32_t));
 
   auto* impl = fst.GetImpl();
@@ -276,42 +405,71 @@ bool ImmutableFst<A>::Write(const FST& fst, irs::data_output& stream,
   const auto properties =
     fst.Properties(kCopyProperties, true) | Impl::kStaticProperties;
 
+  // evaluate size of states & arcs to let readers skip them at once
+  size_t size = 0;
+  for (StateIterator<FST> siter(fst); !siter.Done(); siter.Next()) {
+    const StateId s = siter.Value();
+
+    const size_t weight_size = impl->FinalRef(s).Size();
+
+    if (IRS_UNLIKELY(weight_size > Impl::kMaxStateWeight)) {
+      IRS_ASSERT(false);
+      return false;
+    }
+
+    if (!states_size) {
+      continue;
+    }
+
+    const size_t narcs = impl->NumArcs(s);
+    size +=
+      irs::bytes_io<uint64_t>::vsize(irs::shift_pack_64(weight_size, !narcs));
+    if (narcs) {
+      size += 1 + narcs;  // number of arcs and labels
+
+      for (ArcIterator<FST> aiter(fst, s); !aiter.Done(); aiter.Next()) {
+        const auto& arc = aiter.Value();
+        size += irs::bytes_io<uint32_t>::vsize(arc.nextstate) +
+                irs::bytes_io<uint64_t>::vsize(arc.weight.Size());
+      }
+    }
+  }
+
   // write header
-  stream.write_byte(static_cast<irs::byte_type>(Impl::Version::MIN));
+  const auto version =
+    states_size ? Impl::Version::STATES_SIZE : Impl::Version::MIN;
+  stream.write_byte(static_cast<irs::byte_type>(version));
   stream.write_long(properties);
   stream.write_long(stats.total_weight_size);
   stream.write_int(static_cast<StateId>(stats.num_states));
   IRS_ASSERT(stats.num_states >= static_cast<size_t>(fst.Start()));
   stream.write_vint(static_cast<uint32_t>(stats.num_states - fst.Start()));
   irs::write_zvlong(stream, stats.num_arcs - stats.num_states);
+  if (states_size) {
+    stream.write_vlong(size);
+  }
 
   // write states & arcs
   for (StateIterator<FST> siter(fst); !siter.Done(); siter.Next()) {
     const StateId s = siter.Value();
 
-    size_t weight_size = impl->FinalRef(s).Size();
+    const size_t weight_size = impl->FinalRef(s).Size();
+    const size_t narcs = impl->NumArcs(s);
+    IRS_ASSERT(narcs <= Impl::kMaxArcs);
 
-    if (IRS_LIKELY(weight_size <= Impl::kMaxStateWeight)) {
-      const size_t narcs = impl->NumArcs(s);
-      IRS_ASSERT(narcs <= Impl::kMaxArcs);
+    stream.write_vlong(irs::shift_pack_64(weight_size, !narcs));
+    if (narcs) {
+      // -1 to fit byte_type
+      stream.write_byte(static_cast<irs::byte_type>((narcs - 1) & 0xFF));
 
-      stream.write_vlong(irs::shift_pack_64(weight_size, !narcs));
-      if (narcs) {
-        // -1 to fit byte_type
-        stream.write_byte(static_cast<irs::byte_type>((narcs - 1) & 0xFF));
+      for (ArcIterator<FST> aiter(fst, s); !aiter.Done(); aiter.Next()) {
+        const auto& arc = aiter.Value();
 
-        for (ArcIterator<FST> aiter(fst, s); !aiter.Done(); aiter.Next()) {
-          const auto& arc = aiter.Value();
-
-          IRS_ASSERT(arc.ilabel <= std::numeric_limits<uint8_t>::max());
-          stream.write_byte(static_cast<irs::byte_type>(arc.ilabel & 0xFF));
-          stream.write_vint(arc.nextstate);
-          stream.write_vlong(arc.weight.Size());
-        }
+        IRS_ASSERT(arc.ilabel <= std::numeric_limits<uint8_t>::max());
+        stream.write_byte(static_cast<irs::byte_type>(arc.ilabel & 0xFF));
+        stream.write_vint(arc.nextstate);
+        stream.write_vlong(arc.weight.Size());
       }
-    } else {
-      IRS_ASSERT(false);
-      return false;
     }
   }
 
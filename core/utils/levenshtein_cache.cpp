@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "levenshtein_cache.hpp"
+
+#include "utils/automaton.hpp"
+#include "utils/levenshtein_utils.hpp"
+
+namespace irs {
+
+std::shared_ptr<const automaton> LevenshteinAutomatonCache::Get(
+  const parametric_description& d, bool with_transpositions, bytes_view prefix,
+  bytes_view target) {
+  Key key{.value = bstring{prefix},
+          .prefix_size = prefix.size(),
+          .max_distance = d.max_distance(),
+          .with_transpositions = with_transpositions};
+  key.value += target;
+
+  {
+    std::lock_guard lock{mutex_};
+    if (auto it = index_.find(key); it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      ++hits_;
+      return it->second->second;
+    }
+    ++misses_;
+  }
+
+  // build automaton without holding a lock
+  auto acceptor = std::make_shared<const automaton>(
+    make_levenshtein_automaton(d, prefix, target));
+
+  std::lock_guard lock{mutex_};
+  if (0 == capacity_ || index_.contains(key)) {
+    // cache is disabled or automaton is cached by a concurrent query
+    return acceptor;
+  }
+
+  lru_.emplace_front(key, acceptor);
+  try {
+    index_.emplace(std::move(key), lru_.begin());
+  } catch (...) {
+    lru_.pop_front();
+    throw;
+  }
+  EvictLocked();
+
+  return acceptor;
+}
+
+void LevenshteinAutomatonCache::Capacity(size_t capacity) {
+  std::lock_guard lock{mutex_};
+  capacity_ = capacity;
+  EvictLocked();
+}
+
+size_t LevenshteinAutomatonCache::Capacity() const {
+  std::lock_guard lock{mutex_};
+  return capacity_;
+}
+
+void LevenshteinAutomatonCache::Clear() {
+  std::lock_guard lock{mutex_};
+  index_.clear();
+  lru_.clear();
+}
+
+LevenshteinAutomatonCache::Stats LevenshteinAutomatonCache::GetStats() const {
+  std::lock_guard lock{mutex_};
+  return {.hits = hits_,
+          .misses = misses_,
+          .evictions = evictions_,
+          .size = lru_.size()};
+}
+
+void LevenshteinAutomatonCache::EvictLocked() {
+  while (lru_.size() > capacity_) {
+    index_.erase(lru_.back().first);
+    lru_.pop_back();
+    ++evictions_;
+  }
+}
+
+}  // namespace irs
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "utils/automaton_decl.hpp"
+#include "utils/string.hpp"
+
+namespace irs {
+
+class parametric_description;
+
+// Bounded LRU cache of Levenshtein automata keyed by a target term, a prefix,
+// a maximum edit distance and a transpositions flag. Building an automaton
+// from a parametric description is expensive compared to intersecting it
+// with a term dictionary, so repeated typo-tolerant queries benefit from
+// reusing automata. Cached automata are immutable and may be used by
+// multiple queries concurrently.
+// Note that the key doesn't identify a parametric description, hence all
+// automata in a cache must be built by the same description provider.
+class LevenshteinAutomatonCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  struct Stats {
+    uint64_t hits{};
+    uint64_t misses{};
+    uint64_t evictions{};
+    size_t size{};
+  };
+
+  explicit LevenshteinAutomatonCache(size_t capacity = kDefaultCapacity)
+    : capacity_{capacity} {}
+
+  LevenshteinAutomatonCache(const LevenshteinAutomatonCache&) = delete;
+  LevenshteinAutomatonCache& operator=(const LevenshteinAutomatonCache&) =
+    delete;
+
+  // Returns an automaton accepting strings starting with 'prefix' followed by
+  // a string within a distance specified by a description from 'target',
+  // automaton is built and cached if absent.
+  std::shared_ptr<const automaton> Get(const parametric_description& d,
+                                       bool with_transpositions,
+                                       bytes_view prefix, bytes_view target);
+
+  // Sets maximum number of cached automata, 0 disables caching.
+  void Capacity(size_t capacity);
+  size_t Capacity() const;
+
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  struct Key {
+    bstring value;  // prefix followed by target
+    size_t prefix_size;
+    uint8_t max_distance;
+    bool with_transpositions;
+
+    bool operator==(const Key&) const = default;
+
+    template<typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.value, key.prefix_size,
+                        key.max_distance, key.with_transpositions);
+    }
+  };
+
+  using Entry = std::pair<Key, std::shared_ptr<const automaton>>;
+
+  void EvictLocked();
+
+  mutable std::mutex mutex_;
+  std::list<Entry> lru_;
+  absl::flat_hash_map<Key, std::list<Entry>::iterator> index_;
+  size_t capacity_;
+  uint64_t hits_{};
+  uint64_t misses_{};
+  uint64_t evictions_{};
+};
+
+}  // namespace irs
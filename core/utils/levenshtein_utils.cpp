@@ -753,4 +753,112 @@ bool edit_distance(size_t& distance, const parametric_description& description,
   return true;
 }
 
+bit_parallel_levenshtein::bit_parallel_levenshtein(bytes_view pattern,
+                                                   bool with_transpositions)
+  : with_transpositions_{with_transpositions} {
+  std::vector<uint32_t> chars;
+  if (!utf8_utils::ToUTF32<true>(pattern, std::back_inserter(chars)) ||
+      chars.size() > kMaxPatternSize) {
+    return;
+  }
+
+  size_ = static_cast<uint32_t>(chars.size());
+
+  for (uint64_t i = 0; i < chars.size(); ++i) {
+    const auto c = chars[i];
+    const auto bit = uint64_t{1} << i;
+
+    if (c < std::size(ascii_)) {
+      ascii_[c] |= bit;
+      continue;
+    }
+
+    auto it = std::lower_bound(
+      other_.begin(), other_.end(), c,
+      [](const auto& lhs, uint32_t rhs) noexcept { return lhs.first < rhs; });
+
+    if (it == other_.end() || it->first != c) {
+      it = other_.emplace(it, c, 0);
+    }
+    it->second |= bit;
+  }
+
+  valid_ = true;
+}
+
+uint64_t bit_parallel_levenshtein::match(uint32_t c) const noexcept {
+  if (c < std::size(ascii_)) {
+    return ascii_[c];
+  }
+
+  const auto it = std::lower_bound(
+    other_.begin(), other_.end(), c,
+    [](const auto& lhs, uint32_t rhs) noexcept { return lhs.first < rhs; });
+
+  return it != other_.end() && it->first == c ? it->second : 0;
+}
+
+uint32_t bit_parallel_levenshtein::distance(
+  bytes_view text, uint32_t max_distance) const noexcept {
+  IRS_ASSERT(valid_);
+
+  const uint32_t no_match = max_distance + 1;
+  const auto* begin = text.data();
+  const auto* end = begin + text.size();
+
+  if (0 == size_) {
+    const auto length = utf8_utils::Length(text);
+    return length <= max_distance ? static_cast<uint32_t>(length) : no_match;
+  }
+
+  // each character takes at least 1 byte
+  if (text.size() + max_distance < size_) {
+    return no_match;
+  }
+
+  const uint64_t last = uint64_t{1} << (size_ - 1);
+  uint64_t vp = size_ == 64 ? ~uint64_t{0} : (last << 1) - 1;
+  uint64_t vn = 0;
+  uint64_t d0 = 0;
+  uint64_t prev_pm = 0;
+  uint32_t score = size_;
+
+  while (begin != end) {
+    const auto c = utf8_utils::ToChar32(begin, end);
+
+    if (IRS_UNLIKELY(c == utf8_utils::kInvalidChar32)) {
+      return no_match;
+    }
+
+    const auto pm = match(c);
+    uint64_t x = pm | vn;
+    if (with_transpositions_) {
+      // diagonal is also zero where adjacent characters are swapped
+      x |= ((~d0 & pm) << 1) & prev_pm;
+      prev_pm = pm;
+    }
+    d0 = (((pm & vp) + vp) ^ vp) | x;
+    const uint64_t hp = vn | ~(d0 | vp);
+    const uint64_t hn = vp & d0;
+
+    if (hp & last) {
+      ++score;
+    } else if (hn & last) {
+      --score;
+    }
+
+    // score may decrease by at most 1 per remaining byte
+    if (score > max_distance &&
+        score - max_distance > static_cast<size_t>(end - begin)) {
+      return no_match;
+    }
+
+    const uint64_t shifted_hp = (hp << 1) | 1;
+    vn = shifted_hp & d0;
+    vp = (hn << 1) | ~(shifted_hp | d0);
+  }
+
+  return score <= max_distance ? score : no_match;
+}
+
 }  // namespace irs
@@ -309,4 +309,54 @@ inline bool edit_distance(size_t& distance,
                        rhs.data(), rhs.size());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bit-parallel evaluation of edit distance between a fixed pattern of
+///        up to 64 characters and arbitrary strings, see
+///        G. Myers "A fast bit-vector algorithm for approximate string
+///        matching based on dynamic programming" and H. Hyyro "A bit-vector
+///        algorithm for computing Levenshtein and Damerau edit distances"
+///        for the transpositions case. Unlike Levenshtein automaton doesn't
+///        require any preparation except for a pattern bitmask per character.
+////////////////////////////////////////////////////////////////////////////////
+class bit_parallel_levenshtein {
+ public:
+  static constexpr size_t kMaxPatternSize = 64;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @param pattern utf8 encoded string
+  /// @param with_transpositions count transpositions
+  ////////////////////////////////////////////////////////////////////////////////
+  bit_parallel_levenshtein(bytes_view pattern, bool with_transpositions);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @returns false if pattern isn't a valid UTF-8 sequence or is longer than
+  ///          kMaxPatternSize characters
+  ////////////////////////////////////////////////////////////////////////////////
+  bool valid() const noexcept { return valid_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @returns number of characters in a pattern
+  ////////////////////////////////////////////////////////////////////////////////
+  uint32_t size() const noexcept { return size_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluates edit distance between the pattern and a specified string
+  ///        up to 'max_distance'
+  /// @param text utf8 encoded string
+  /// @returns edit distance up to 'max_distance', 'max_distance + 1' if either
+  ///          the distance exceeds 'max_distance' or 'text' isn't a valid
+  ///          UTF-8 sequence
+  ////////////////////////////////////////////////////////////////////////////////
+  uint32_t distance(bytes_view text, uint32_t max_distance) const noexcept;
+
+ private:
+  uint64_t match(uint32_t c) const noexcept;
+
+  uint64_t ascii_[128]{};
+  std::vector<std::pair<uint32_t, uint64_t>> other_;  // sorted by character
+  uint32_t size_{};
+  bool with_transpositions_;
+  bool valid_{false};
+};
+
 }  // namespace irs
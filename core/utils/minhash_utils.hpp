@@ -22,10 +22,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <span>
 #include <vector>
 
 #include "utils/math_utils.hpp"
+#include "utils/simd_utils.hpp"
 
 #include <absl/container/flat_hash_set.h>
 
@@ -122,6 +124,19 @@ class MinHash {
     left_ = MaxSize();
   }
 
+  // Replace accumulated signature with unique `values` sorted in ascending
+  // order, e.g. a signature computed by `MinHashBuilder`.
+  void Assign(std::span<const uint64_t> values) {
+    IRS_ASSERT(values.size() <= MaxSize());
+    IRS_ASSERT(std::adjacent_find(std::begin(values), std::end(values),
+                                  std::greater_equal<>{}) == std::end(values));
+    // values in descending order form a valid heap
+    min_hashes_.assign(std::rbegin(values), std::rend(values));
+    dedup_.clear();
+    dedup_.insert(std::begin(values), std::end(values));
+    left_ = MaxSize() - values.size();
+  }
+
  private:
   std::vector<uint64_t> min_hashes_;
   absl::flat_hash_set<uint64_t> dedup_;  // guard against duplicated hash values
@@ -129,4 +144,71 @@ class MinHash {
   size_t left_;
 };
 
+// Computes MinHash signature of a large number of hash values at once.
+// Once the signature is full, hash values which aren't less than its largest
+// value are filtered out with SIMD compares, the rest is appended to a flat
+// buffer. The buffer is shrunk to the smallest unique values once it's twice
+// as large as the signature, there is neither a heap nor a hash set to
+// update per hash value.
+class MinHashBuilder {
+ public:
+  explicit MinHashBuilder(size_t size)
+    : max_size_{std::max(size, size_t{1})}, capacity_{2 * max_size_} {
+    // copy_less(...) may write a vector past the last copied value
+    buffer_.resize(capacity_ + simd::MaxLanes(HWY_FULL(uint64_t){}));
+  }
+
+  void Insert(std::span<const uint64_t> hash_values) noexcept {
+    while (!hash_values.empty()) {
+      const auto chunk = std::min(hash_values.size(), capacity_ - size_);
+      auto* out = buffer_.data() + size_;
+      if (full_) {
+        size_ += simd::copy_less(hash_values.data(), chunk, threshold_, out);
+      } else {
+        std::copy_n(hash_values.data(), chunk, out);
+        size_ += chunk;
+      }
+      hash_values = hash_values.subspan(chunk);
+      if (size_ == capacity_) {
+        Shrink();
+      }
+    }
+  }
+
+  // Return unique hash values of the signature sorted in ascending order.
+  std::span<const uint64_t> Finish() noexcept {
+    Shrink();
+    return {buffer_.data(), size_};
+  }
+
+  // Return the expected size of MinHash signature.
+  size_t MaxSize() const noexcept { return max_size_; }
+
+  // Reset builder to the initial state.
+  void Clear() noexcept {
+    size_ = 0;
+    full_ = false;
+  }
+
+ private:
+  void Shrink() noexcept {
+    const auto begin = buffer_.begin();
+    auto end = begin + size_;
+    std::sort(begin, end);
+    end = std::unique(begin, end);
+    size_ = std::min(static_cast<size_t>(end - begin), max_size_);
+    if (size_ == max_size_) {
+      full_ = true;
+      threshold_ = buffer_[size_ - 1];
+    }
+  }
+
+  std::vector<uint64_t> buffer_;
+  size_t max_size_;
+  size_t capacity_;
+  size_t size_{};
+  uint64_t threshold_{};
+  bool full_{};
+};
+
 }  // namespace irs
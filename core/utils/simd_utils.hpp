@@ -25,9 +25,11 @@
 #include <hwy/highway.h>
 
 #include <algorithm>
+#include <cstring>
 
 #include "shared.hpp"
 #include "utils/bit_packing.hpp"
+#include "utils/utf8_utils.hpp"
 
 namespace irs::simd {
 
@@ -148,6 +150,229 @@ bool all_equal(const T* begin, size_t size) noexcept {
   return true;
 }
 
+// Returns true if all bytes are 7-bit ASCII.
+inline bool all_ascii(const byte_type* begin, size_t size) noexcept {
+  constexpr HWY_FULL(uint8_t) simd_tag;
+  constexpr size_t Step = MaxLanes(simd_tag);
+  constexpr size_t Unroll = 4;
+
+  const auto end = begin + size;
+  const auto mask = Set(simd_tag, uint8_t{0x80});
+
+  for (size_t steps = size / (Unroll * Step); steps; --steps) {
+    auto oracc = LoadU(simd_tag, begin);
+    for (size_t j = 1; j < Unroll; ++j) {
+      oracc = Or(oracc, LoadU(simd_tag, begin + j * Step));
+    }
+    if (!AllTrue(simd_tag, (oracc & mask) == Zero(simd_tag))) {
+      return false;
+    }
+    begin += Unroll * Step;
+  }
+
+  byte_type tail = 0;
+  for (; begin != end; ++begin) {
+    tail |= *begin;
+  }
+
+  return 0 == (tail & 0x80);
+}
+
+// Computes offsets of the next code point for code points of UTF-8 encoded
+// 'begin', i.e. next[i] == utf8_utils::Next(begin + i, end) - begin for
+// every 'i' reachable from the beginning, other entries are unspecified.
+// ASCII blocks are processed at once, the rest symbol by symbol to handle
+// invalid input exactly like utf8_utils::Next. 'next' must have room for
+// 'size' values.
+inline void utf8_next(const byte_type* begin, size_t size,
+                      uint32_t* next) noexcept {
+  constexpr HWY_FULL(uint8_t) simd_tag;
+  constexpr HWY_FULL(uint32_t) offset_tag;
+  constexpr size_t Step = MaxLanes(simd_tag);
+  constexpr size_t OffsetStep = MaxLanes(offset_tag);
+  static_assert(0 == Step % OffsetStep);
+
+  const auto end = begin + size;
+  const auto mask = Set(simd_tag, uint8_t{0x80});
+  auto it = begin;
+
+  auto next_symbols = [&](const byte_type* until) {
+    while (it < until) {
+      const auto symbol_end = utf8_utils::Next(it, end);
+      next[it - begin] = static_cast<uint32_t>(symbol_end - begin);
+      it = symbol_end;
+    }
+  };
+
+  while (static_cast<size_t>(end - it) >= Step) {
+    const auto v = LoadU(simd_tag, it);
+    if (AllTrue(simd_tag, (v & mask) == Zero(simd_tag))) {
+      const auto offset = static_cast<uint32_t>(it - begin);
+      for (size_t j = 0; j < Step; j += OffsetStep) {
+        StoreU(Iota(offset_tag, offset + j + 1), offset_tag,
+               next + offset + j);
+      }
+      it += Step;
+    } else {
+      next_symbols(it + Step);
+    }
+  }
+
+  next_symbols(end);
+}
+
+// Compares 'size' bytes by a pair of possibly overlapping loads of type T
+// covering the first and the last sizeof(T) bytes.
+template<typename T>
+IRS_FORCE_INLINE bool equal_bytes_overlapping(const byte_type* lhs,
+                                              const byte_type* rhs,
+                                              size_t size) noexcept {
+  IRS_ASSERT(sizeof(T) <= size && size <= 2 * sizeof(T));
+  const size_t tail = size - sizeof(T);
+  T lhs_head, rhs_head, lhs_tail, rhs_tail;
+  std::memcpy(&lhs_head, lhs, sizeof(T));
+  std::memcpy(&rhs_head, rhs, sizeof(T));
+  std::memcpy(&lhs_tail, lhs + tail, sizeof(T));
+  std::memcpy(&rhs_tail, rhs + tail, sizeof(T));
+  return 0 == ((lhs_head ^ rhs_head) | (lhs_tail ^ rhs_tail));
+}
+
+// Returns true if 'size' bytes at 'lhs' and 'rhs' are equal. Values of up to
+// 32 bytes are compared by a pair of overlapping loads of a width picked by
+// 'size', so the comparison never reads beyond either value.
+inline bool equal_bytes(const byte_type* lhs, const byte_type* rhs,
+                        size_t size) noexcept {
+  if (size < 4) {
+    return 0 == size || (lhs[0] == rhs[0] && lhs[size / 2] == rhs[size / 2] &&
+                         lhs[size - 1] == rhs[size - 1]);
+  }
+  if (size < 8) {
+    return equal_bytes_overlapping<uint32_t>(lhs, rhs, size);
+  }
+  if (size <= 16) {
+    return equal_bytes_overlapping<uint64_t>(lhs, rhs, size);
+  }
+  if (size <= 32) {
+    constexpr Full128<uint8_t> simd_tag;
+    const size_t tail = size - 16;
+    const auto eq = And(LoadU(simd_tag, lhs) == LoadU(simd_tag, rhs),
+                        LoadU(simd_tag, lhs + tail) ==
+                          LoadU(simd_tag, rhs + tail));
+    return AllTrue(simd_tag, eq);
+  }
+  return 0 == std::memcmp(lhs, rhs, size);
+}
+
+// Returns dot product of 'size' floats at 'lhs' and 'rhs'. Products are
+// summed in a different order than by a scalar loop, hence the result may
+// differ in the least significant bits.
+inline float dot(const float* lhs, const float* rhs, size_t size) noexcept {
+  constexpr HWY_FULL(float) simd_tag;
+  constexpr size_t Step = MaxLanes(simd_tag);
+
+  auto acc0 = Zero(simd_tag);
+  auto acc1 = Zero(simd_tag);
+  size_t i = 0;
+  for (; i + 2 * Step <= size; i += 2 * Step) {
+    acc0 = MulAdd(LoadU(simd_tag, lhs + i), LoadU(simd_tag, rhs + i), acc0);
+    acc1 = MulAdd(LoadU(simd_tag, lhs + i + Step),
+                  LoadU(simd_tag, rhs + i + Step), acc1);
+  }
+  if (i + Step <= size) {
+    acc0 = MulAdd(LoadU(simd_tag, lhs + i), LoadU(simd_tag, rhs + i), acc0);
+    i += Step;
+  }
+
+  float sum = GetLane(SumOfLanes(simd_tag, Add(acc0, acc1)));
+  for (; i < size; ++i) {
+    sum += lhs[i] * rhs[i];
+  }
+  return sum;
+}
+
+// Computes dot products of 'size' floats at 'lhs' and 'size' floats at each
+// of 4 vectors starting at 'rhs' 'stride' floats apart, stores them to 'out'.
+// Each chunk of 'lhs' is loaded once for all of the vectors. Results are
+// the same as of dot(...) for each of the vectors.
+inline void dot4(const float* lhs, const float* rhs, size_t stride,
+                 size_t size, float* out) noexcept {
+  constexpr HWY_FULL(float) simd_tag;
+  constexpr size_t Step = MaxLanes(simd_tag);
+
+  const float* rhs0 = rhs;
+  const float* rhs1 = rhs0 + stride;
+  const float* rhs2 = rhs1 + stride;
+  const float* rhs3 = rhs2 + stride;
+
+  // the same 2 accumulators per vector as in dot(...)
+  auto acc00 = Zero(simd_tag);
+  auto acc01 = Zero(simd_tag);
+  auto acc10 = Zero(simd_tag);
+  auto acc11 = Zero(simd_tag);
+  auto acc20 = Zero(simd_tag);
+  auto acc21 = Zero(simd_tag);
+  auto acc30 = Zero(simd_tag);
+  auto acc31 = Zero(simd_tag);
+  size_t i = 0;
+  for (; i + 2 * Step <= size; i += 2 * Step) {
+    const auto lhs0 = LoadU(simd_tag, lhs + i);
+    const auto lhs1 = LoadU(simd_tag, lhs + i + Step);
+    acc00 = MulAdd(lhs0, LoadU(simd_tag, rhs0 + i), acc00);
+    acc01 = MulAdd(lhs1, LoadU(simd_tag, rhs0 + i + Step), acc01);
+    acc10 = MulAdd(lhs0, LoadU(simd_tag, rhs1 + i), acc10);
+    acc11 = MulAdd(lhs1, LoadU(simd_tag, rhs1 + i + Step), acc11);
+    acc20 = MulAdd(lhs0, LoadU(simd_tag, rhs2 + i), acc20);
+    acc21 = MulAdd(lhs1, LoadU(simd_tag, rhs2 + i + Step), acc21);
+    acc30 = MulAdd(lhs0, LoadU(simd_tag, rhs3 + i), acc30);
+    acc31 = MulAdd(lhs1, LoadU(simd_tag, rhs3 + i + Step), acc31);
+  }
+  if (i + Step <= size) {
+    const auto lhs0 = LoadU(simd_tag, lhs + i);
+    acc00 = MulAdd(lhs0, LoadU(simd_tag, rhs0 + i), acc00);
+    acc10 = MulAdd(lhs0, LoadU(simd_tag, rhs1 + i), acc10);
+    acc20 = MulAdd(lhs0, LoadU(simd_tag, rhs2 + i), acc20);
+    acc30 = MulAdd(lhs0, LoadU(simd_tag, rhs3 + i), acc30);
+    i += Step;
+  }
+
+  out[0] = GetLane(SumOfLanes(simd_tag, Add(acc00, acc01)));
+  out[1] = GetLane(SumOfLanes(simd_tag, Add(acc10, acc11)));
+  out[2] = GetLane(SumOfLanes(simd_tag, Add(acc20, acc21)));
+  out[3] = GetLane(SumOfLanes(simd_tag, Add(acc30, acc31)));
+  for (; i < size; ++i) {
+    out[0] += lhs[i] * rhs0[i];
+    out[1] += lhs[i] * rhs1[i];
+    out[2] += lhs[i] * rhs2[i];
+    out[3] += lhs[i] * rhs3[i];
+  }
+}
+
+// Copies values less than 'threshold' to 'out' preserving their order,
+// returns number of copied values. 'out' must have room for 'size' values
+// plus a single vector.
+inline size_t copy_less(const uint64_t* begin, size_t size, uint64_t threshold,
+                        uint64_t* out) noexcept {
+  constexpr HWY_FULL(uint64_t) simd_tag;
+  constexpr size_t Step = MaxLanes(simd_tag);
+
+  const auto end = begin + size;
+  const auto vthreshold = Set(simd_tag, threshold);
+  auto* p = out;
+
+  for (size_t steps = size / Step; steps; --steps) {
+    const auto v = LoadU(simd_tag, begin);
+    p += CompressStore(v, v < vthreshold, simd_tag, p);
+    begin += Step;
+  }
+
+  for (; begin != end; ++begin) {
+    *p = *begin;
+    p += *begin < threshold;
+  }
+
+  return p - out;
+}
+
 IRS_FORCE_INLINE Vec<HWY_FULL(uint32_t)> zig_zag_encode(
   Vec<HWY_FULL(int32_t)> v) noexcept {
   constexpr HWY_FULL(uint32_t) simd_tag;
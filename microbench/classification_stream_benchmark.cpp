@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+#include <fasttext.h>
+
+#include <random>
+
+#include "analysis/classification_stream.hpp"
+#include "analysis/token_batch.hpp"
+#include "tests_config.hpp"
+
+namespace {
+
+using namespace irs::analysis;
+
+constexpr size_t kNumValues = 1000;
+
+std::shared_ptr<const fasttext::FastText> Model() {
+  static const auto kModel = [] {
+    auto model = std::make_shared<fasttext::FastText>();
+    model->loadModel(IResearch_test_resource_dir "/model_cooking.bin");
+    return model;
+  }();
+  return kModel;
+}
+
+// Questions of up to 20 words drawn from the model vocabulary.
+std::vector<std::string> MakeValues() {
+  const auto dict = Model()->getDictionary();
+  std::mt19937_64 rng{42};
+  std::vector<std::string> values(kNumValues);
+  for (auto& value : values) {
+    for (size_t size = 1 + rng() % 20; size; --size) {
+      if (!value.empty()) {
+        value += ' ';
+      }
+      value += dict->getWord(static_cast<int32_t>(rng() % dict->nwords()));
+    }
+  }
+  return values;
+}
+
+// Argument: number of predicted labels.
+void BM_classification_reset(benchmark::State& state) {
+  const auto values = MakeValues();
+  classification_stream stream{
+    {.top_k = static_cast<int32_t>(state.range(0))}, Model()};
+  auto* term = irs::get<irs::term_attribute>(stream);
+
+  for (auto _ : state) {
+    for (const auto& value : values) {
+      stream.reset(value);
+      while (stream.next()) {
+        benchmark::DoNotOptimize(term->value.data());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_classification_reset)->Arg(1)->Arg(5);
+
+// Argument: number of predicted labels.
+void BM_classification_analyze(benchmark::State& state) {
+  const auto data = MakeValues();
+  const std::vector<std::string_view> values{data.begin(), data.end()};
+  classification_stream stream{
+    {.top_k = static_cast<int32_t>(state.range(0))}, Model()};
+  TokenBatch batch;
+
+  for (auto _ : state) {
+    stream.analyze(values, batch);
+    benchmark::DoNotOptimize(batch.tokens().data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_classification_analyze)->Arg(1)->Arg(5);
+
+}  // namespace
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "analysis/delimited_token_stream.hpp"
+#include "analysis/minhash_token_stream.hpp"
+#include "utils/minhash_utils.hpp"
+
+namespace {
+
+constexpr size_t kNumWords = 20000;
+
+std::vector<uint64_t> MakeHashValues(size_t size) {
+  std::mt19937_64 rng{42};
+  std::vector<uint64_t> values(size);
+  for (auto& value : values) {
+    value = rng();
+  }
+  return values;
+}
+
+// Document of 'size' words drawn from a vocabulary of 'kNumWords' words.
+std::string MakeDocument(size_t size) {
+  std::mt19937_64 rng{42};
+  std::string doc;
+  for (size_t i = 0; i < size; ++i) {
+    if (i) {
+      doc += ' ';
+    }
+    doc += 'w';
+    doc += std::to_string(rng() % kNumWords);
+  }
+  return doc;
+}
+
+void BM_minhash_insert(benchmark::State& state) {
+  const auto values = MakeHashValues(state.range(1));
+  irs::MinHash minhash{static_cast<size_t>(state.range(0))};
+
+  for (auto _ : state) {
+    minhash.Clear();
+    for (const auto value : values) {
+      minhash.Insert(value);
+    }
+    benchmark::DoNotOptimize(minhash.Size());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_minhash_insert)
+  ->ArgsProduct({{64, 128, 256, 512}, {10000, 100000}});
+
+void BM_minhash_builder(benchmark::State& state) {
+  const auto values = MakeHashValues(state.range(1));
+  irs::MinHashBuilder builder{static_cast<size_t>(state.range(0))};
+
+  for (auto _ : state) {
+    builder.Clear();
+    builder.Insert(values);
+    benchmark::DoNotOptimize(builder.Finish().size());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_minhash_builder)
+  ->ArgsProduct({{64, 128, 256, 512}, {10000, 100000}});
+
+void BM_minhash_analyzer(benchmark::State& state) {
+  const auto doc = MakeDocument(state.range(1));
+  irs::analysis::MinHashTokenStream stream{
+    {.analyzer = irs::analysis::delimited_token_stream::make(" "),
+     .num_hashes = static_cast<uint32_t>(state.range(0))}};
+
+  for (auto _ : state) {
+    stream.reset(doc);
+    while (stream.next()) {
+    }
+    benchmark::DoNotOptimize(stream.signature().Size());
+  }
+  state.SetBytesProcessed(state.iterations() * doc.size());
+}
+
+BENCHMARK(BM_minhash_analyzer)
+  ->ArgsProduct({{64, 128, 256, 512}, {10000, 100000}});
+
+}  // namespace
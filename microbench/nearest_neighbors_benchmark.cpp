@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "analysis/nearest_neighbors_stream.hpp"
+#include "tests_config.hpp"
+#include "utils/fasttext_utils.hpp"
+
+namespace {
+
+using namespace irs::analysis;
+
+// number of the most frequent words looked up
+constexpr int32_t kWords = 1000;
+
+std::shared_ptr<const fasttext::ImmutableFastText> Model() {
+  static const auto kModel = [] {
+    auto model = std::make_shared<fasttext::ImmutableFastText>();
+    model->loadModel(IResearch_test_resource_dir "/model_cooking.bin");
+    return model;
+  }();
+  return kModel;
+}
+
+void BM_nearest_neighbors(benchmark::State& state, bool table, bool graph) {
+  auto model = Model();
+
+  std::unique_ptr<const NearestNeighborsIndex> index;
+  if (table || graph) {
+    NearestNeighborsIndex::BuildOptions options;
+    options.table_words = table ? kWords : 0;
+    options.graph_degree = graph ? 16 : 0;
+    const auto path = std::filesystem::temp_directory_path() /
+                      "iresearch_nearest_neighbors_benchmark";
+    if (!NearestNeighborsIndex::Write(*model, options, path.c_str())) {
+      state.SkipWithError("Failed to build nearest neighbors index");
+      return;
+    }
+    index = NearestNeighborsIndex::Open(*model, path.c_str());
+    std::filesystem::remove(path);
+  }
+
+  nearest_neighbors_stream::options options;
+  options.top_k = 10;
+  nearest_neighbors_stream stream{options, model, std::move(index)};
+
+  // the first word is the end of line marker
+  const auto dict = model->getDictionary();
+  std::string data;
+  int64_t words = 0;
+  for (int32_t word = 1; word < kWords; word += 13, ++words) {
+    data += dict->getWord(word);
+    data += ' ';
+  }
+
+  for (auto _ : state) {
+    stream.reset(data);
+    while (bool has_next = stream.next()) {
+      benchmark::DoNotOptimize(has_next);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * words);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_nearest_neighbors, brute_force, false, false);
+BENCHMARK_CAPTURE(BM_nearest_neighbors, table, true, false);
+BENCHMARK_CAPTURE(BM_nearest_neighbors, hnsw, false, true);
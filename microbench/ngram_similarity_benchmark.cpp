@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "analysis/ngram_token_stream.hpp"
+#include "index/directory_reader.hpp"
+#include "index/index_writer.hpp"
+#include "search/boost_scorer.hpp"
+#include "search/ngram_similarity_filter.hpp"
+#include "store/memory_directory.hpp"
+
+namespace {
+
+constexpr size_t kNumDocs = 100000;
+constexpr size_t kNumQueries = 256;
+constexpr std::string_view kFieldName = "name";
+
+using NGramStream = irs::analysis::ngram_token_stream<
+  irs::analysis::ngram_token_stream_base::InputType::Binary>;
+
+const irs::analysis::ngram_token_stream_base::Options kTrigrams{3, 3, false};
+
+struct NGramField {
+  std::string_view name() const noexcept { return kFieldName; }
+
+  irs::IndexFeatures index_features() const noexcept {
+    return irs::IndexFeatures::FREQ | irs::IndexFeatures::POS;
+  }
+
+  irs::features_t features() const noexcept { return {}; }
+
+  irs::token_stream& get_tokens() const {
+    stream.reset(value);
+    return stream;
+  }
+
+  std::string_view value;
+  mutable NGramStream stream{kTrigrams};
+};
+
+// Product names like "acme phone x200 pro 256gb black"
+std::string MakeProductName(std::mt19937_64& rng) {
+  constexpr std::string_view kBrands[]{"acme",    "globex", "initech",
+                                       "umbrella", "hooli",  "stark",
+                                       "wayne",   "wonka",  "cyberdyne"};
+  constexpr std::string_view kProducts[]{
+    "phone", "laptop", "tablet", "monitor", "keyboard", "mouse", "headphones",
+    "speaker", "camera", "router", "charger", "watch"};
+  constexpr std::string_view kVariants[]{"pro", "max", "mini", "plus",
+                                         "lite", "ultra", "air", ""};
+  constexpr std::string_view kColors[]{"black", "white", "silver",
+                                       "blue",  "red",   "graphite"};
+
+  std::string name;
+  name += kBrands[rng() % std::size(kBrands)];
+  name += ' ';
+  name += kProducts[rng() % std::size(kProducts)];
+  name += " x";
+  name += std::to_string(rng() % 1000);
+  name += ' ';
+  name += kVariants[rng() % std::size(kVariants)];
+  name += ' ';
+  name += std::to_string(16 << (rng() % 6));
+  name += "gb ";
+  name += kColors[rng() % std::size(kColors)];
+  return name;
+}
+
+// Introduces a typo by replacing a character
+std::string MakeTypo(std::string name, std::mt19937_64& rng) {
+  name[rng() % name.size()] = static_cast<char>('a' + rng() % 26);
+  return name;
+}
+
+struct Dataset {
+  irs::memory_directory dir;
+  irs::DirectoryReader reader;
+  std::vector<std::string> queries;
+};
+
+const Dataset& GetDataset() {
+  static const auto dataset = [] {
+    auto dataset = std::make_unique<Dataset>();
+    auto codec = irs::formats::get("1_5simd");
+    auto writer = irs::IndexWriter::Make(dataset->dir, codec, irs::OM_CREATE);
+
+    std::mt19937_64 rng{42};
+    std::vector<std::string> names;
+    names.reserve(kNumDocs);
+    {
+      NGramField field;
+      auto ctx = writer->GetBatch();
+      for (size_t i = 0; i < kNumDocs; ++i) {
+        field.value = names.emplace_back(MakeProductName(rng));
+        ctx.Insert().Insert<irs::Action::INDEX>(field);
+      }
+    }
+    writer->Commit();
+    dataset->reader = irs::DirectoryReader{dataset->dir, codec};
+
+    for (size_t i = 0; i < kNumQueries; ++i) {
+      dataset->queries.emplace_back(
+        MakeTypo(names[rng() % names.size()], rng));
+    }
+    return dataset;
+  }();
+  return *dataset;
+}
+
+irs::by_ngram_similarity MakeFilter(std::string_view query, float threshold) {
+  irs::by_ngram_similarity filter;
+  *filter.mutable_field() = kFieldName;
+  auto& opts = *filter.mutable_options();
+  opts.threshold = threshold;
+
+  NGramStream stream{kTrigrams};
+  const auto* term = irs::get<irs::term_attribute>(stream);
+  stream.reset(query);
+  while (stream.next()) {
+    opts.ngrams.emplace_back(term->value);
+  }
+  return filter;
+}
+
+void BM_ngram_similarity(benchmark::State& state, bool scored) {
+  const auto& dataset = GetDataset();
+  const auto threshold = static_cast<float>(state.range(0)) / 100.f;
+
+  irs::BoostScore impl;
+  auto scorers = scored ? irs::Scorers::Prepare(impl) : irs::Scorers{};
+
+  std::vector<irs::filter::prepared::ptr> queries;
+  queries.reserve(dataset.queries.size());
+  for (auto& query : dataset.queries) {
+    queries.emplace_back(MakeFilter(query, threshold).prepare({
+      .index = dataset.reader,
+      .scorers = scorers,
+    }));
+  }
+
+  size_t i = 0;
+  size_t matched = 0;
+  for (auto _ : state) {
+    auto& query = *queries[i++ % queries.size()];
+    for (auto& segment : dataset.reader) {
+      auto docs = query.execute({.segment = segment, .scorers = scorers});
+      while (docs->next()) {
+        ++matched;
+      }
+    }
+  }
+  state.counters["matched"] = benchmark::Counter(
+    static_cast<double>(matched), benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_ngram_similarity, unscored, false)
+  ->Arg(50)
+  ->Arg(70)
+  ->Arg(90);
+BENCHMARK_CAPTURE(BM_ngram_similarity, scored, true)
+  ->Arg(50)
+  ->Arg(70)
+  ->Arg(90);
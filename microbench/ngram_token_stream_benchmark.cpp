@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "analysis/ngram_token_stream.hpp"
+
+namespace {
+
+using namespace irs::analysis;
+
+constexpr size_t kNumValues = 1000;
+
+// Autocomplete-like values of up to 'kMaxSymbols' symbols, 'utf8' values
+// mix ASCII with 2 and 3 byte symbols.
+std::vector<std::string> MakeValues(bool utf8) {
+  constexpr size_t kMaxSymbols = 40;
+  constexpr std::string_view kSymbols[] = {"\xd0\xb6", "\xe2\x82\xac"};
+
+  std::mt19937_64 rng{42};
+  std::vector<std::string> values(kNumValues);
+  for (auto& value : values) {
+    for (size_t size = 1 + rng() % kMaxSymbols; size; --size) {
+      if (utf8 && 0 == rng() % 4) {
+        value += kSymbols[rng() % std::size(kSymbols)];
+      } else {
+        value += static_cast<char>('a' + rng() % 26);
+      }
+    }
+  }
+  return values;
+}
+
+// Arguments: input type, whether values are UTF-8, whether to use markers.
+template<ngram_token_stream_base::InputType Type>
+void BM_ngram(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const std::string_view start_marker = state.range(1) ? "^" : "";
+  const std::string_view end_marker = state.range(1) ? "$" : "";
+  ngram_token_stream<Type> stream{ngram_token_stream_base::Options{
+    2, 8, true, Type, irs::ViewCast<irs::byte_type>(start_marker),
+    irs::ViewCast<irs::byte_type>(end_marker)}};
+  auto* term = irs::get<irs::term_attribute>(stream);
+
+  size_t bytes = 0;
+  for (const auto& value : values) {
+    bytes += value.size();
+  }
+
+  for (auto _ : state) {
+    for (const auto& value : values) {
+      stream.reset(value);
+      while (stream.next()) {
+        benchmark::DoNotOptimize(term->value.data());
+      }
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK_TEMPLATE(BM_ngram, ngram_token_stream_base::InputType::Binary)
+  ->ArgsProduct({{0}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_ngram, ngram_token_stream_base::InputType::UTF8)
+  ->ArgsProduct({{0, 1}, {0, 1}});
+
+}  // namespace
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "analysis/stopwords.hpp"
+
+namespace {
+
+constexpr std::string_view kStopwords[] = {
+  "a",       "about",   "above",   "after",   "again",   "against", "all",
+  "am",      "an",      "and",     "any",     "are",     "as",      "at",
+  "be",      "because", "been",    "before",  "being",   "below",   "between",
+  "both",    "but",     "by",      "can",     "did",     "do",      "does",
+  "doing",   "don",     "down",    "during",  "each",    "few",     "for",
+  "from",    "further", "had",     "has",     "have",    "having",  "he",
+  "her",     "here",    "hers",    "herself", "him",     "himself", "his",
+  "how",     "i",       "if",      "in",      "into",    "is",      "it",
+  "its",     "itself",  "just",    "me",      "more",    "most",    "my",
+  "myself",  "no",      "nor",     "not",     "now",     "of",      "off",
+  "on",      "once",    "only",    "or",      "other",   "our",     "ours",
+  "out",     "over",    "own",     "s",       "same",    "she",     "should",
+  "so",      "some",    "such",    "t",       "than",    "that",    "the",
+  "their",   "theirs",  "them",    "then",    "there",   "these",   "they",
+  "this",    "those",   "through", "to",      "too",     "under",   "until",
+  "up",      "very",    "was",     "we",      "were",    "what",    "when",
+  "where",   "which",   "while",   "who",     "whom",    "why",     "will",
+  "with",    "you",     "your",    "yours",   "yourself"};
+
+// Tokens of which about a half are stopwords.
+std::vector<std::string> MakeTokens() {
+  std::mt19937_64 rng{42};
+  std::vector<std::string> tokens(10000);
+  for (auto& token : tokens) {
+    if (rng() % 2) {
+      token = kStopwords[rng() % std::size(kStopwords)];
+    } else {
+      for (size_t size = 1 + rng() % 12; size; --size) {
+        token += static_cast<char>('a' + rng() % 26);
+      }
+    }
+  }
+  return tokens;
+}
+
+const irs::analysis::Stopwords::words_t kWords{std::begin(kStopwords),
+                                               std::end(kStopwords)};
+
+template<typename Set>
+void Lookup(benchmark::State& state, const Set& set) {
+  const auto tokens = MakeTokens();
+  for (auto _ : state) {
+    size_t count = 0;
+    for (const auto& token : tokens) {
+      if constexpr (std::is_same_v<Set, irs::analysis::Stopwords>) {
+        count += set.Contains(token);
+      } else {
+        count += set.contains(token);
+      }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+
+void BM_stopwords_hash_set(benchmark::State& state) { Lookup(state, kWords); }
+
+BENCHMARK(BM_stopwords_hash_set);
+
+void BM_stopwords_perfect_hash(benchmark::State& state) {
+  Lookup(state, irs::analysis::Stopwords{kWords});
+}
+
+BENCHMARK(BM_stopwords_perfect_hash);
+
+}  // namespace
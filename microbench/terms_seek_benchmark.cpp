@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "analysis/token_streams.hpp"
+#include "index/directory_reader.hpp"
+#include "index/index_writer.hpp"
+#include "store/memory_directory.hpp"
+
+namespace {
+
+constexpr size_t kNumTerms = 100000;
+constexpr size_t kNumLookups = 4096;
+constexpr std::string_view kFieldName = "field";
+
+struct StringField {
+  std::string_view name() const noexcept { return kFieldName; }
+
+  irs::IndexFeatures index_features() const noexcept {
+    return irs::IndexFeatures::NONE;
+  }
+
+  irs::features_t features() const noexcept { return {}; }
+
+  irs::token_stream& get_tokens() const {
+    stream.reset(value);
+    return stream;
+  }
+
+  std::string_view value;
+  mutable irs::string_token_stream stream;
+};
+
+enum class TermSet { kNumeric, kUuid, kWords };
+
+std::vector<std::string> MakeTerms(TermSet set) {
+  std::mt19937_64 rng{42};
+  std::vector<std::string> terms;
+  terms.reserve(kNumTerms);
+
+  switch (set) {
+    case TermSet::kNumeric:
+      // long shared prefixes, short distinct suffixes
+      for (size_t i = 0; i < kNumTerms; ++i) {
+        terms.emplace_back(std::to_string(1000000000 + i * 7));
+      }
+      break;
+    case TermSet::kUuid: {
+      // short shared prefixes, long distinct suffixes
+      constexpr std::string_view kHex = "0123456789abcdef";
+      for (size_t i = 0; i < kNumTerms; ++i) {
+        auto& term = terms.emplace_back(36, '-');
+        for (size_t j = 0; j < term.size(); ++j) {
+          if (j != 8 && j != 13 && j != 18 && j != 23) {
+            term[j] = kHex[rng() % kHex.size()];
+          }
+        }
+      }
+    } break;
+    case TermSet::kWords: {
+      // zipf-like distribution of word lengths over a small alphabet
+      std::geometric_distribution<size_t> length{0.2};
+      for (size_t i = 0; i < kNumTerms; ++i) {
+        auto& term = terms.emplace_back(2 + length(rng), 'a');
+        for (auto& c : term) {
+          c = static_cast<char>('a' + rng() % 26);
+        }
+      }
+    } break;
+  }
+
+  return terms;
+}
+
+irs::DirectoryReader MakeIndex(irs::directory& dir,
+                               const std::vector<std::string>& terms,
+                               const irs::TermsInfo& info) {
+  auto codec = irs::formats::get("1_5simd");
+
+  irs::IndexWriterOptions options;
+  options.terms_info = [info](std::string_view) { return info; };
+
+  auto writer = irs::IndexWriter::Make(dir, codec, irs::OM_CREATE, options);
+
+  StringField field;
+  {
+    auto ctx = writer->GetBatch();
+    for (auto& term : terms) {
+      field.value = term;
+      ctx.Insert().Insert<irs::Action::INDEX>(field);
+    }
+  }
+  writer->Commit();
+
+  return irs::DirectoryReader{dir, codec};
+}
+
+void BM_terms_seek(benchmark::State& state, TermSet set, irs::TermsInfo info) {
+  irs::memory_directory dir;
+  auto terms = MakeTerms(set);
+  auto reader = MakeIndex(dir, terms, info);
+  if (reader.size() != 1) {
+    state.SkipWithError("failed to build index");
+    return;
+  }
+
+  auto* field = reader[0].field(kFieldName);
+  if (!field) {
+    state.SkipWithError("field not found");
+    return;
+  }
+
+  // mix of existing and missing terms
+  std::mt19937_64 rng{43};
+  std::vector<std::string> lookups;
+  lookups.reserve(kNumLookups);
+  for (size_t i = 0; i < kNumLookups; ++i) {
+    auto term = terms[rng() % terms.size()];
+    if (i % 4 == 0) {
+      term.back() ^= 1;
+    }
+    lookups.emplace_back(std::move(term));
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto it = field->iterator(irs::SeekMode::RANDOM_ONLY);
+    benchmark::DoNotOptimize(
+      it->seek(irs::ViewCast<irs::byte_type>(
+        std::string_view{lookups[i++ % lookups.size()]})));
+  }
+
+  // size of a term index, i.e. FST
+  uint64_t index_bytes = 0;
+  dir.visit([&](std::string_view name) {
+    uint64_t length = 0;
+    if (name.ends_with(".ti") && dir.length(length, name)) {
+      index_bytes += length;
+    }
+    return true;
+  });
+  state.counters["index_bytes"] = static_cast<double>(index_bytes);
+}
+
+constexpr irs::TermsInfo kDefault{};
+constexpr irs::TermsInfo kSmall{.min_block_size = 8, .max_block_size = 16};
+constexpr irs::TermsInfo kLarge{.min_block_size = 64, .max_block_size = 128};
+constexpr irs::TermsInfo kAdaptive{.adaptive = true};
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_terms_seek, numeric_default, TermSet::kNumeric, kDefault);
+BENCHMARK_CAPTURE(BM_terms_seek, numeric_small, TermSet::kNumeric, kSmall);
+BENCHMARK_CAPTURE(BM_terms_seek, numeric_large, TermSet::kNumeric, kLarge);
+BENCHMARK_CAPTURE(BM_terms_seek, numeric_adaptive, TermSet::kNumeric,
+                  kAdaptive);
+BENCHMARK_CAPTURE(BM_terms_seek, uuid_default, TermSet::kUuid, kDefault);
+BENCHMARK_CAPTURE(BM_terms_seek, uuid_small, TermSet::kUuid, kSmall);
+BENCHMARK_CAPTURE(BM_terms_seek, uuid_large, TermSet::kUuid, kLarge);
+BENCHMARK_CAPTURE(BM_terms_seek, uuid_adaptive, TermSet::kUuid, kAdaptive);
+BENCHMARK_CAPTURE(BM_terms_seek, words_default, TermSet::kWords, kDefault);
+BENCHMARK_CAPTURE(BM_terms_seek, words_small, TermSet::kWords, kSmall);
+BENCHMARK_CAPTURE(BM_terms_seek, words_large, TermSet::kWords, kLarge);
+BENCHMARK_CAPTURE(BM_terms_seek, words_adaptive, TermSet::kWords, kAdaptive);
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "analysis/token_streams.hpp"
+#include "index/directory_reader.hpp"
+#include "index/index_writer.hpp"
+#include "search/boost_scorer.hpp"
+#include "search/terms_filter.hpp"
+#include "store/memory_directory.hpp"
+
+namespace {
+
+constexpr size_t kNumDocs = 1000000;
+constexpr size_t kNumTerms = 100000;
+constexpr std::string_view kFieldName = "field";
+
+struct StringField {
+  std::string_view name() const noexcept { return kFieldName; }
+
+  irs::IndexFeatures index_features() const noexcept {
+    return irs::IndexFeatures::NONE;
+  }
+
+  irs::features_t features() const noexcept { return {}; }
+
+  irs::token_stream& get_tokens() const {
+    stream.reset(value);
+    return stream;
+  }
+
+  std::string_view value;
+  mutable irs::string_token_stream stream;
+};
+
+std::string MakeTerm(size_t i) { return std::to_string(1000000 + i); }
+
+// Single segment where every term occurs in kNumDocs / kNumTerms documents
+const irs::DirectoryReader& Index() {
+  static irs::memory_directory dir;
+  static const irs::DirectoryReader reader = [] {
+    auto codec = irs::formats::get("1_5simd");
+    auto writer = irs::IndexWriter::Make(dir, codec, irs::OM_CREATE);
+
+    std::mt19937_64 rng{42};
+    StringField field;
+    {
+      auto ctx = writer->GetBatch();
+      for (size_t i = 0; i < kNumDocs; ++i) {
+        const auto term = MakeTerm(rng() % kNumTerms);
+        field.value = term;
+        ctx.Insert().Insert<irs::Action::INDEX>(field);
+      }
+    }
+    writer->Commit();
+    return irs::DirectoryReader{dir, codec};
+  }();
+  return reader;
+}
+
+void BM_terms_union(benchmark::State& state, bool scored) {
+  auto& reader = Index();
+  if (reader.size() != 1) {
+    state.SkipWithError("failed to build index");
+    return;
+  }
+
+  irs::by_terms filter;
+  *filter.mutable_field() = kFieldName;
+  const auto num_terms = static_cast<size_t>(state.range(0));
+  for (size_t i = 0; i < num_terms; ++i) {
+    filter.mutable_options()->terms.emplace(
+      irs::ViewCast<irs::byte_type>(std::string_view{MakeTerm(i)}));
+  }
+
+  irs::BoostScore impl;
+  auto scorers = scored ? irs::Scorers::Prepare(impl) : irs::Scorers{};
+  auto prepared = filter.prepare({.index = reader, .scorers = scorers});
+
+  size_t matched = 0;
+  for (auto _ : state) {
+    auto docs = prepared->execute({.segment = reader[0], .scorers = scorers});
+    while (docs->next()) {
+      ++matched;
+    }
+  }
+  benchmark::DoNotOptimize(matched);
+  state.SetItemsProcessed(static_cast<int64_t>(matched));
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_terms_union, unscored, false)
+  ->RangeMultiplier(10)
+  ->Range(10, kNumTerms);
+BENCHMARK_CAPTURE(BM_terms_union, scored, true)
+  ->RangeMultiplier(10)
+  ->Range(10, kNumTerms);
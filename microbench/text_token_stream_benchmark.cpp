@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "analysis/text_token_stream.hpp"
+
+namespace {
+
+using namespace irs::analysis;
+
+constexpr std::string_view kAscii =
+  "2023-05-02T10:15:00Z INFO request GET /api/v1/products?id=1234 took 3.5ms "
+  "user=john_doe agent=Mozilla/5.0 status=200 QUICK BROWN FOX JUMPS OVER";
+
+// Same text with a single non-ASCII character, the whole input is handled
+// by ICU while ASCII tokens still bypass normalization and transliteration.
+constexpr std::string_view kMostlyAscii =
+  "2023-05-02T10:15:00Z INFO request GET /api/v1/products?id=1234 took 3.5ms "
+  "user=john_doe agent=Mozilla/5.0 status=200 QUICK BROWN FOX JUMPS OVER \xC3\xA9";
+
+constexpr std::string_view kLatin =
+  "Größe Café Crème brûlée Ærøskøbing Ça va très bien naïve façade Señor "
+  "Zürich Ålesund Fête déjà vu Über ñandú";
+
+void BM_text_analyzer(benchmark::State& state, std::string_view str) {
+  text_token_stream::options_t opts;
+  opts.locale = icu::Locale::createFromName("en_US.UTF-8");
+  opts.explicit_stopwords_set = true;
+
+  text_token_stream stream(opts, opts.explicit_stopwords);
+
+  for (auto _ : state) {
+    stream.reset(str);
+    while (bool has_next = stream.next()) {
+      benchmark::DoNotOptimize(has_next);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_text_analyzer, ascii, kAscii);
+BENCHMARK_CAPTURE(BM_text_analyzer, mostly_ascii, kMostlyAscii);
+BENCHMARK_CAPTURE(BM_text_analyzer, latin, kLatin);
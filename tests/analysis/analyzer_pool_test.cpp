@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "analysis/analyzer_pool.hpp"
+
+#include <thread>
+
+#include "analysis/delimited_token_stream.hpp"
+#include "analysis/token_attributes.hpp"
+#include "tests_shared.hpp"
+
+namespace {
+
+const auto kJson = irs::type<irs::text_format::json>::get();
+
+size_t CountTokens(irs::analysis::analyzer& analyzer, std::string_view data) {
+  size_t count = 0;
+  if (analyzer.reset(data)) {
+    while (analyzer.next()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(AnalyzerPoolTest, InvalidDefinition) {
+  irs::analysis::AnalyzerPool pool;
+
+  ASSERT_FALSE(pool.Find("invalid_analyzer", kJson, "{}"));
+  ASSERT_FALSE(pool.Find("delimiter", kJson, "[]"));
+  ASSERT_EQ(nullptr, pool.Get(irs::analysis::AnalyzerPool::Handle{}));
+  ASSERT_EQ(nullptr, pool.Get("invalid_analyzer", kJson, "{}"));
+  ASSERT_FALSE(pool.Warmup(irs::analysis::AnalyzerPool::Handle{}, 1));
+
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(0, stats.definitions);
+  ASSERT_EQ(0, stats.created);
+  ASSERT_EQ(0, stats.checkouts);
+}
+
+TEST(AnalyzerPoolTest, ReuseInstances) {
+  irs::analysis::AnalyzerPool pool;
+
+  auto handle = pool.Find("delimiter", kJson, R"({"delimiter":","})");
+  ASSERT_TRUE(handle);
+
+  const irs::analysis::analyzer* instance{};
+  {
+    auto analyzer = pool.Get(handle);
+    ASSERT_NE(nullptr, analyzer);
+    ASSERT_EQ(irs::type<irs::analysis::delimited_token_stream>::id(),
+              analyzer->type());
+    ASSERT_EQ(3, CountTokens(*analyzer, "a,b,c"));
+    instance = analyzer.get();
+  }
+
+  // equivalent definition shares released instance
+  {
+    auto analyzer = pool.Get("delimiter", kJson, R"({ "delimiter" : "," })");
+    ASSERT_EQ(instance, analyzer.get());
+    ASSERT_EQ(3, CountTokens(*analyzer, "a,b,c"));
+
+    // instance is checked out, hence a new one is created
+    auto other = pool.Get(handle);
+    ASSERT_NE(nullptr, other);
+    ASSERT_NE(instance, other.get());
+  }
+
+  // different definition
+  {
+    auto analyzer = pool.Get("delimiter", kJson, R"({"delimiter":";"})");
+    ASSERT_NE(nullptr, analyzer);
+    ASSERT_EQ(1, CountTokens(*analyzer, "a,b,c"));
+  }
+
+  auto stats = pool.GetStats();
+  ASSERT_EQ(2, stats.definitions);
+  ASSERT_EQ(3, stats.created);
+  ASSERT_EQ(0, stats.failed);
+  ASSERT_EQ(4, stats.checkouts);
+
+  // idle instances are destroyed
+  pool.Clear();
+  ASSERT_NE(nullptr, pool.Get(handle));
+  stats = pool.GetStats();
+  ASSERT_EQ(2, stats.definitions);
+  ASSERT_EQ(4, stats.created);
+  ASSERT_EQ(5, stats.checkouts);
+}
+
+TEST(AnalyzerPoolTest, Warmup) {
+  irs::analysis::AnalyzerPool pool{{.pool_size = 4}};
+
+  auto handle = pool.Find("delimiter", kJson, R"({"delimiter":","})");
+  ASSERT_TRUE(handle);
+
+  // no more instances than pool can keep
+  ASSERT_TRUE(pool.Warmup(handle, 5));
+  auto stats = pool.GetStats();
+  ASSERT_EQ(4, stats.created);
+  ASSERT_EQ(0, stats.checkouts);
+
+  // idle instances are reused
+  ASSERT_TRUE(pool.Warmup(handle, 2));
+  {
+    std::vector<irs::analysis::AnalyzerPool::ptr> analyzers;
+    for (size_t i = 0; i < 4; ++i) {
+      analyzers.emplace_back(pool.Get(handle));
+      ASSERT_NE(nullptr, analyzers.back());
+    }
+  }
+  stats = pool.GetStats();
+  ASSERT_EQ(4, stats.created);
+  ASSERT_EQ(4, stats.checkouts);
+}
+
+TEST(AnalyzerPoolTest, Concurrent) {
+  constexpr size_t kNumThreads = 8;
+  constexpr size_t kNumIterations = 1000;
+
+  irs::analysis::AnalyzerPool pool{{.pool_size = kNumThreads}};
+  auto handle = pool.Find("delimiter", kJson, R"({"delimiter":","})");
+  ASSERT_TRUE(handle);
+  ASSERT_TRUE(pool.Warmup(handle, kNumThreads));
+
+  std::atomic<size_t> tokens{};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < kNumIterations; ++j) {
+        auto analyzer = pool.Get(handle);
+        ASSERT_NE(nullptr, analyzer);
+        tokens += CountTokens(*analyzer, "a,b,c");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(3 * kNumThreads * kNumIterations, tokens);
+  const auto stats = pool.GetStats();
+  ASSERT_EQ(1, stats.definitions);
+  // warmed up instances are enough for all threads
+  ASSERT_EQ(kNumThreads, stats.created);
+  ASSERT_EQ(kNumThreads * kNumIterations, stats.checkouts);
+}
@@ -23,6 +23,7 @@
 
 #include "analysis/classification_stream.hpp"
 
+#include "analysis/token_batch.hpp"
 #include "tests_shared.hpp"
 #include "velocypack/Parser.h"
 #include "velocypack/velocypack-aliases.h"
@@ -281,6 +282,61 @@ TEST(classification_stream_test, test_custom_provider) {
             irs::analysis::classification_stream::set_model_provider(nullptr));
 }
 
+TEST(classification_stream_test, test_analyze) {
+#ifdef WIN32
+  const auto model_loc =
+    test_base::resource("model_cooking.bin").generic_string();
+#else
+  const auto model_loc = test_base::resource("model_cooking.bin").string();
+#endif
+  const auto input_json =
+    "{\"model_location\": \"" + model_loc + "\", \"top_k\": 3}";
+
+  constexpr std::string_view kData[]{
+    "baking", "", "Which baking dish is best to bake a banana bread ?",
+    "How to cook rice", "bananas and apples", "xyzzy"};
+
+  // more values than predicted at once
+  std::vector<std::string_view> values;
+  for (size_t i = 0; i < 40; ++i) {
+    values.emplace_back(kData[i % std::size(kData)]);
+  }
+
+  auto stream = irs::analysis::analyzers::get(
+    "classification", irs::type<irs::text_format::json>::get(), input_json);
+  ASSERT_NE(nullptr, stream);
+
+  irs::analysis::TokenBatch batch;
+  stream->analyze(values, batch);
+  ASSERT_EQ(values.size(), batch.size());
+  ASSERT_TRUE(batch.offsets());
+  ASSERT_EQ(3, batch.tokens(0).size());
+  ASSERT_TRUE(batch.tokens(1).empty());
+
+  // batch matches value by value analysis
+  auto expected_stream = irs::analysis::analyzers::get(
+    "classification", irs::type<irs::text_format::json>::get(), input_json);
+  ASSERT_NE(nullptr, expected_stream);
+  auto* term = irs::get<irs::term_attribute>(*expected_stream);
+  auto* inc = irs::get<irs::increment>(*expected_stream);
+  auto* offset = irs::get<irs::offset>(*expected_stream);
+  for (size_t i = 0; i < values.size(); ++i) {
+    SCOPED_TRACE(values[i]);
+    ASSERT_TRUE(batch.valid(i));
+    ASSERT_TRUE(expected_stream->reset(values[i]));
+    auto tokens = batch.tokens(i);
+    auto token = tokens.begin();
+    for (; expected_stream->next(); ++token) {
+      ASSERT_NE(token, tokens.end());
+      ASSERT_EQ(term->value, batch.term(*token));
+      ASSERT_EQ(inc->value, token->increment);
+      ASSERT_EQ(offset->start, token->start);
+      ASSERT_EQ(offset->end, token->end);
+    }
+    ASSERT_EQ(token, tokens.end());
+  }
+}
+
 TEST(classification_stream_test, test_make_config_json) {
   // random extra param
   {
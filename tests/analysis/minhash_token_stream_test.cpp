@@ -22,9 +22,12 @@
 
 #include "analysis/minhash_token_stream.hpp"
 
+#include <absl/base/internal/endian.h>
+
 #include "analysis/analyzers.hpp"
 #include "analysis/segmentation_token_stream.hpp"
 #include "analysis/token_streams.hpp"
+#include "store/store_utils.hpp"
 #include "tests_shared.hpp"
 #include "velocypack/Parser.h"
 #include "velocypack/velocypack-aliases.h"
@@ -127,10 +130,11 @@ TEST(MinHashTokenStreamTest, ConstructDefault) {
     auto* impl =
       dynamic_cast<const irs::analysis::MinHashTokenStream*>(stream.get());
     ASSERT_NE(nullptr, impl);
-    const auto& [analyzer, num_hashes] = impl->options();
+    const auto& [analyzer, num_hashes, num_bands] = impl->options();
     ASSERT_NE(nullptr, analyzer);
     ASSERT_EQ(irs::type<irs::string_token_stream>::id(), analyzer->type());
     ASSERT_EQ(expected_num_hashes, num_hashes);
+    ASSERT_EQ(0, num_bands);
   };
 
   assert_analyzer(irs::analysis::analyzers::get(
@@ -187,8 +191,9 @@ TEST(MinHashTokenStreamTest, ConstructCustom) {
     auto* impl =
       dynamic_cast<const irs::analysis::MinHashTokenStream*>(stream.get());
     ASSERT_NE(nullptr, impl);
-    const auto& [analyzer, num_hashes] = impl->options();
+    const auto& [analyzer, num_hashes, num_bands] = impl->options();
     ASSERT_EQ(expected_num_hashes, num_hashes);
+    ASSERT_EQ(0, num_bands);
     ASSERT_NE(nullptr, analyzer);
     ASSERT_EQ(irs::type<irs::analysis::segmentation_token_stream>::id(),
               analyzer->type());
@@ -261,6 +266,7 @@ TEST(MinHashTokenStreamTest, CheckOptions) {
 
   ASSERT_EQ(nullptr, opts.analyzer);
   ASSERT_EQ(1, opts.num_hashes);
+  ASSERT_EQ(0, opts.num_bands);
 }
 
 TEST(MinHashTokenStreamTest, ConstructFromOptions) {
@@ -272,9 +278,10 @@ TEST(MinHashTokenStreamTest, ConstructFromOptions) {
     ASSERT_NE(nullptr, irs::get<irs::term_attribute>(stream));
     ASSERT_NE(nullptr, irs::get<irs::offset>(stream));
     ASSERT_NE(nullptr, irs::get<irs::increment>(stream));
-    const auto& [analyzer, num_hashes] = stream.options();
+    const auto& [analyzer, num_hashes, num_bands] = stream.options();
     ASSERT_NE(nullptr, analyzer);
     ASSERT_EQ(0, num_hashes);
+    ASSERT_EQ(0, num_bands);
     ASSERT_EQ(irs::type<irs::string_token_stream>::id(), analyzer->type());
   }
 
@@ -286,9 +293,10 @@ TEST(MinHashTokenStreamTest, ConstructFromOptions) {
     ASSERT_NE(nullptr, irs::get<irs::term_attribute>(stream));
     ASSERT_NE(nullptr, irs::get<irs::offset>(stream));
     ASSERT_NE(nullptr, irs::get<irs::increment>(stream));
-    const auto& [analyzer, num_hashes] = stream.options();
+    const auto& [analyzer, num_hashes, num_bands] = stream.options();
     ASSERT_NE(nullptr, analyzer);
     ASSERT_EQ(42, num_hashes);
+    ASSERT_EQ(0, num_bands);
     ASSERT_EQ(irs::type<segmentation_token_stream>::id(), analyzer->type());
   }
 
@@ -298,9 +306,10 @@ TEST(MinHashTokenStreamTest, ConstructFromOptions) {
     ASSERT_NE(nullptr, irs::get<irs::term_attribute>(stream));
     ASSERT_NE(nullptr, irs::get<irs::offset>(stream));
     ASSERT_NE(nullptr, irs::get<irs::increment>(stream));
-    const auto& [analyzer, num_hashes] = stream.options();
+    const auto& [analyzer, num_hashes, num_bands] = stream.options();
     ASSERT_NE(nullptr, analyzer);
     ASSERT_EQ(42, num_hashes);
+    ASSERT_EQ(0, num_bands);
     ASSERT_EQ(irs::type<empty_analyzer>::id(), analyzer->type());
     ASSERT_FALSE(stream.reset(""));
   }
@@ -355,3 +364,149 @@ TEST(MinHashTokenStreamTest, NextReset) {
     ASSERT_FALSE(stream.next());
   }
 }
+
+TEST(MinHashTokenStreamTest, NormalizeBands) {
+  std::string out;
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    out, "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": 21})"));
+  ASSERT_EQ(arangodb::velocypack::Parser::fromJson(
+              R"({"numHashes": 42, "numBands": 21})")
+              ->slice()
+              .toString(),
+            out);
+
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    out, "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": 0})"));
+  ASSERT_EQ(
+    arangodb::velocypack::Parser::fromJson(R"({"numHashes": 42})")
+      ->slice()
+      .toString(),
+    out);
+
+  auto stream = irs::analysis::analyzers::get(
+    "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": 21})");
+  ASSERT_NE(nullptr, stream);
+  auto* impl =
+    dynamic_cast<const irs::analysis::MinHashTokenStream*>(stream.get());
+  ASSERT_NE(nullptr, impl);
+  ASSERT_EQ(21, impl->options().num_bands);
+
+  // Failing cases
+  ASSERT_FALSE(irs::analysis::analyzers::normalize(
+    out, "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": 5})"));
+  ASSERT_FALSE(irs::analysis::analyzers::normalize(
+    out, "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": 84})"));
+  ASSERT_FALSE(irs::analysis::analyzers::normalize(
+    out, "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": "21"})"));
+  ASSERT_FALSE(irs::analysis::analyzers::normalize(
+    out, "minhash", irs::type<irs::text_format::json>::get(),
+    R"({"numHashes": 42, "numBands": -1})"));
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+                       "minhash", irs::type<irs::text_format::json>::get(),
+                       R"({"numHashes": 42, "numBands": 5})"));
+}
+
+TEST(MinHashTokenStreamTest, Bands) {
+  using namespace irs::analysis;
+
+  constexpr uint32_t kNumHashes = 8;
+  constexpr uint32_t kNumBands = 4;
+  constexpr std::string_view kData{"Hund"};
+  constexpr std::string_view kValues[]{"quick", "brown", "fox",  "jumps",
+                                       "over",  "the",   "lazy", "dog"};
+  constexpr std::string_view kShuffled[]{"dog",   "lazy", "the", "over",
+                                         "jumps", "fox",  "brown", "quick"};
+  constexpr std::string_view kOther[]{"lorem", "ipsum", "dolor", "sit",
+                                      "amet"};
+
+  auto bands = [&](const std::string_view* begin, const std::string_view* end) {
+    MinHashTokenStream stream{
+      {.analyzer = std::make_unique<ArrayStream>(kData, begin, end),
+       .num_hashes = kNumHashes,
+       .num_bands = kNumBands}};
+    auto* term = irs::get<irs::term_attribute>(stream);
+    EXPECT_NE(nullptr, term);
+    auto* inc = irs::get<irs::increment>(stream);
+    EXPECT_NE(nullptr, inc);
+
+    std::vector<std::string> tokens;
+    EXPECT_TRUE(stream.reset(kData));
+    while (stream.next()) {
+      EXPECT_EQ(tokens.empty() ? 1 : 0, inc->value);
+      tokens.emplace_back(irs::ViewCast<char>(term->value));
+    }
+    // signature is still available
+    EXPECT_EQ(std::min<size_t>(kNumHashes, end - begin),
+              stream.signature().Size());
+    return tokens;
+  };
+
+  const auto expected = bands(std::begin(kValues), std::end(kValues));
+  ASSERT_EQ(kNumBands, expected.size());
+  for (auto& token : expected) {
+    ASSERT_EQ(11, token.size());
+  }
+
+  // bands don't depend on order of values
+  ASSERT_EQ(expected, bands(std::begin(kShuffled), std::end(kShuffled)));
+
+  // disjoint sets don't share bands
+  const auto other = bands(std::begin(kOther), std::end(kOther));
+  ASSERT_FALSE(other.empty());
+  for (auto& token : other) {
+    ASSERT_EQ(std::find(expected.begin(), expected.end(), token),
+              expected.end());
+  }
+
+  // short documents leaving most of the bins empty don't share bands
+  const auto quick = bands(std::begin(kValues), std::begin(kValues) + 1);
+  const auto brown = bands(std::begin(kValues) + 1, std::begin(kValues) + 2);
+  ASSERT_EQ(kNumBands, quick.size());
+  ASSERT_EQ(kNumBands, brown.size());
+  for (auto& token : quick) {
+    ASSERT_EQ(std::find(brown.begin(), brown.end(), token), brown.end());
+  }
+}
+
+TEST(MinHashTokenStreamTest, WriteSignature) {
+  using namespace irs::analysis;
+
+  constexpr uint32_t kNumHashes = 4;
+  constexpr std::string_view kData{"Hund"};
+  constexpr std::string_view kValues[]{"quick", "brown", "fox",  "jumps",
+                                       "over",  "the",   "lazy", "dog"};
+
+  MinHashTokenStream stream{
+    {.analyzer = std::make_unique<ArrayStream>(kData, std::begin(kValues),
+                                               std::end(kValues)),
+     .num_hashes = kNumHashes,
+     .num_bands = 2}};
+
+  // band tokens don't depend on the signature being written
+  ASSERT_TRUE(stream.reset(kData));
+  size_t num_bands = 0;
+  while (stream.next()) {
+    ++num_bands;
+  }
+  ASSERT_EQ(2, num_bands);
+
+  irs::bstring buf;
+  irs::bytes_output out{buf};
+  stream.WriteSignature(out);
+  ASSERT_EQ(kNumHashes * sizeof(uint64_t), buf.size());
+
+  std::vector<uint64_t> expected{stream.signature().begin(),
+                                 stream.signature().end()};
+  std::vector<uint64_t> actual;
+  for (auto* it = buf.data(); it != buf.data() + buf.size();
+       it += sizeof(uint64_t)) {
+    actual.emplace_back(absl::little_endian::Load64(it));
+  }
+  ASSERT_EQ(expected, actual);
+}
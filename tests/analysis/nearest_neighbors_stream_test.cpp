@@ -23,7 +23,10 @@
 
 #include "analysis/nearest_neighbors_stream.hpp"
 
+#include <fstream>
+
 #include "tests_shared.hpp"
+#include "utils/fasttext_utils.hpp"
 #include "velocypack/Parser.h"
 #include "velocypack/velocypack-aliases.h"
 
@@ -340,3 +343,163 @@ TEST(nearest_neighbors_stream_test, test_make_config_json) {
       "{\"model_location\": \"" + model_loc + "\", \"top_k\": 2147483648}"));
   }
 }
+
+class nearest_neighbors_index_test : public test_base {
+ protected:
+  void SetUp() override {
+    test_base::SetUp();
+    model_.loadModel(resource("model_cooking.bin").string());
+    index_path_ = test_dir() / "neighbors";
+  }
+
+  fasttext::ImmutableFastText model_;
+  std::filesystem::path index_path_;
+};
+
+TEST_F(nearest_neighbors_index_test, lookup_and_search) {
+  using irs::analysis::NearestNeighborsIndex;
+
+  NearestNeighborsIndex::BuildOptions options;
+  options.table_words = 100;
+  options.table_top_k = 2;
+  options.graph_degree = 8;
+  options.ef_construction = 40;
+  ASSERT_TRUE(
+    NearestNeighborsIndex::Write(model_, options, index_path_.c_str()));
+  auto index = NearestNeighborsIndex::Open(model_, index_path_.c_str());
+  ASSERT_NE(nullptr, index);
+  ASSERT_TRUE(index->HasGraph());
+
+  // precomputed neighbors are the same as brute force ones
+  const auto dict = model_.getDictionary();
+  for (int32_t word = 0; word < options.table_words; ++word) {
+    const auto expected = model_.getNN(dict->getWord(word), 2);
+    const auto actual = index->Lookup(word, 2);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      ASSERT_EQ(expected[i].second, dict->getWord(actual[i].word));
+      ASSERT_EQ(expected[i].first, actual[i].similarity);
+    }
+  }
+  ASSERT_TRUE(index->Lookup(options.table_words, 2).empty());
+  ASSERT_TRUE(index->Lookup(0, 3).empty());
+
+  // approximate neighbors are mostly exact
+  NearestNeighborsIndex::Scratch scratch;
+  std::vector<NearestNeighborsIndex::Neighbor> neighbors;
+  size_t matches = 0;
+  size_t total = 0;
+  for (int32_t word = options.table_words; word < dict->nwords(); word += 10) {
+    ASSERT_TRUE(index->Search(word, 2, scratch, neighbors));
+    ASSERT_EQ(2, neighbors.size());
+    ASSERT_NE(word, neighbors[0].word);
+    ASSERT_GE(neighbors[0].similarity, neighbors[1].similarity);
+    const auto expected = model_.getNN(dict->getWord(word), 1);
+    matches += expected.front().second == dict->getWord(neighbors[0].word);
+    ++total;
+  }
+  ASSERT_GE(matches, total * 9 / 10);
+  ASSERT_FALSE(index->Search(dict->nwords(), 2, scratch, neighbors));
+
+  // index is valid for another instance of the model, but not truncated
+  {
+    fasttext::ImmutableFastText model;
+    model.loadModel(resource("model_cooking.bin").string());
+    ASSERT_NE(nullptr, NearestNeighborsIndex::Open(model, index_path_.c_str()));
+    std::filesystem::resize_file(index_path_,
+                                 std::filesystem::file_size(index_path_) - 4);
+    ASSERT_EQ(nullptr, NearestNeighborsIndex::Open(model, index_path_.c_str()));
+  }
+}
+
+TEST_F(nearest_neighbors_index_test, corrupted_links) {
+  using irs::analysis::NearestNeighborsIndex;
+
+  NearestNeighborsIndex::BuildOptions options;
+  options.table_words = 10;
+  options.graph_degree = 8;
+  ASSERT_TRUE(
+    NearestNeighborsIndex::Write(model_, options, index_path_.c_str()));
+  ASSERT_NE(nullptr, NearestNeighborsIndex::Open(model_, index_path_.c_str()));
+
+  // the last link of the file points outside the vocabulary
+  {
+    std::fstream file{index_path_,
+                      std::ios::binary | std::ios::in | std::ios::out};
+    ASSERT_TRUE(file);
+    const int32_t link = model_.getDictionary()->nwords();
+    file.seekp(-static_cast<std::streamoff>(sizeof link), std::ios::end);
+    file.write(reinterpret_cast<const char*>(&link), sizeof link);
+    ASSERT_TRUE(file);
+  }
+  ASSERT_EQ(nullptr, NearestNeighborsIndex::Open(model_, index_path_.c_str()));
+}
+
+TEST_F(nearest_neighbors_index_test, analyzer) {
+  using irs::analysis::NearestNeighborsIndex;
+
+  // words missing in the table are looked up by brute force
+  NearestNeighborsIndex::BuildOptions options;
+  options.table_words = 100;
+  options.table_top_k = 2;
+  options.graph_degree = 0;
+  ASSERT_TRUE(
+    NearestNeighborsIndex::Write(model_, options, index_path_.c_str()));
+
+  const auto model_loc = resource("model_cooking.bin").string();
+  const auto config = "{\"model_location\": \"" + model_loc +
+                      "\", \"neighbors_index\": \"" +
+                      index_path_.string() + "\", \"top_k\": 2}";
+  auto indexed = irs::analysis::analyzers::get(
+    "nearest_neighbors", irs::type<irs::text_format::json>::get(), config);
+  ASSERT_NE(nullptr, indexed);
+  auto plain = irs::analysis::analyzers::get(
+    "nearest_neighbors", irs::type<irs::text_format::json>::get(),
+    "{\"model_location\": \"" + model_loc + "\", \"top_k\": 2}");
+  ASSERT_NE(nullptr, plain);
+
+  auto* indexed_term = irs::get<irs::term_attribute>(*indexed);
+  ASSERT_NE(nullptr, indexed_term);
+  auto* indexed_inc = irs::get<irs::increment>(*indexed);
+  ASSERT_NE(nullptr, indexed_inc);
+  auto* plain_term = irs::get<irs::term_attribute>(*plain);
+  ASSERT_NE(nullptr, plain_term);
+  auto* plain_inc = irs::get<irs::increment>(*plain);
+  ASSERT_NE(nullptr, plain_inc);
+
+  // the first word is the end of line marker
+  const auto dict = model_.getDictionary();
+  std::string data;
+  for (int32_t word = 1; word < 200; word += 7) {
+    absl::StrAppend(&data, dict->getWord(word), " ");
+  }
+  ASSERT_TRUE(indexed->reset(data));
+  ASSERT_TRUE(plain->reset(data));
+  size_t count = 0;
+  while (plain->next()) {
+    ASSERT_TRUE(indexed->next());
+    ASSERT_EQ(plain_inc->value, indexed_inc->value);
+    ASSERT_EQ(plain_term->value, indexed_term->value);
+    ++count;
+  }
+  ASSERT_FALSE(indexed->next());
+  ASSERT_EQ(2 * 29, count);
+
+  std::string actual;
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    actual, "nearest_neighbors", irs::type<irs::text_format::json>::get(),
+    config));
+  ASSERT_EQ(VPackParser::fromJson(config)->toString(), actual);
+
+  // failing cases
+  ASSERT_EQ(nullptr,
+            irs::analysis::analyzers::get(
+              "nearest_neighbors", irs::type<irs::text_format::json>::get(),
+              "{\"model_location\": \"" + model_loc +
+                "\", \"neighbors_index\": \"invalid_location\"}"));
+  ASSERT_EQ(nullptr,
+            irs::analysis::analyzers::get(
+              "nearest_neighbors", irs::type<irs::text_format::json>::get(),
+              "{\"model_location\": \"" + model_loc +
+                "\", \"neighbors_index\": 42}"));
+}
@@ -28,6 +28,7 @@
 
 #include <sstream>
 
+#include "analysis/token_batch.hpp"
 #include "tests_shared.hpp"
 #include "velocypack/Parser.h"
 #include "velocypack/velocypack-aliases.h"
@@ -961,6 +962,47 @@ TEST(ngram_token_stream_test, reset_too_big) {
   ASSERT_EQ(0, offset->end);
 }
 
+TEST(ngram_token_stream_test, reset_with_markers) {
+  struct token {
+    std::string_view value;
+    uint32_t start;
+    uint32_t end;
+  };
+
+  // marked terms are views into buffers reused across values
+  irs::analysis::ngram_token_stream<
+    irs::analysis::ngram_token_stream_base::InputType::UTF8>
+    stream(irs::analysis::ngram_token_stream_base::Options(
+      1, 2, true, irs::analysis::ngram_token_stream_base::InputType::UTF8,
+      irs::ViewCast<irs::byte_type>(std::string_view{"^"}),
+      irs::ViewCast<irs::byte_type>(std::string_view{"$"})));
+
+  auto* term = irs::get<irs::term_attribute>(stream);
+  ASSERT_TRUE(term);
+  auto* offset = irs::get<irs::offset>(stream);
+  ASSERT_TRUE(offset);
+
+  auto assert_tokens = [&](std::string_view data,
+                           const std::vector<token>& expected) {
+    ASSERT_TRUE(stream.reset(data));
+    for (const auto& token : expected) {
+      ASSERT_TRUE(stream.next());
+      ASSERT_EQ(token.value, irs::ViewCast<char>(term->value));
+      ASSERT_EQ(token.start, offset->start);
+      ASSERT_EQ(token.end, offset->end);
+    }
+    ASSERT_FALSE(stream.next());
+  };
+
+  const std::vector<token> expected{
+    {"^\xc2\xa2", 0, 2},   {"^\xc2\xa2x", 0, 3}, {"^\xc2\xa2xy", 0, 4},
+    {"\xc2\xa2xy$", 0, 4}, {"x", 2, 3},          {"xy$", 2, 4},
+    {"y$", 3, 4}};
+  assert_tokens("\xc2\xa2xy", expected);
+  assert_tokens("z", {{"^z", 0, 1}, {"z$", 0, 1}});
+  assert_tokens("\xc2\xa2xy", expected);
+}
+
 TEST(ngram_token_stream_test, next) {
   struct token {
     token(std::string_view value, size_t start, size_t end) noexcept
@@ -1699,3 +1741,74 @@ TEST(ngram_token_stream_test, test_load) {
     ASSERT_FALSE(stream->next());
   }
 }
+
+TEST(ngram_token_stream_test, analyze_batch) {
+  using irs::analysis::ngram_token_stream;
+  using irs::analysis::ngram_token_stream_base;
+
+  const std::vector<std::string_view> values{
+    "", "a", "ab", "abc", "quick", "brown fox jumps",
+    "\xC3\x80\xC3\x81\xC3\x82", "caf\xC3\xA9 au lait"};
+
+  auto check = [&]<ngram_token_stream_base::InputType Type>(
+                 const ngram_token_stream_base::Options& options) {
+    SCOPED_TRACE(::testing::Message()
+                 << "min=" << options.min_gram << " max=" << options.max_gram
+                 << " original=" << options.preserve_original
+                 << " start=" << irs::ViewCast<char>(
+                                   irs::bytes_view{options.start_marker})
+                 << " end=" << irs::ViewCast<char>(
+                                 irs::bytes_view{options.end_marker}));
+    ngram_token_stream<Type> stream{options};
+    irs::analysis::TokenBatch batch;
+    stream.analyze(values, batch);
+    ASSERT_EQ(values.size(), batch.size());
+    ASSERT_TRUE(batch.offsets());
+    // stream is exhausted after a batch
+    ASSERT_FALSE(stream.next());
+
+    // batch matches token by token analysis
+    ngram_token_stream<Type> expected{options};
+    auto* term = irs::get<irs::term_attribute>(expected);
+    auto* inc = irs::get<irs::increment>(expected);
+    auto* offset = irs::get<irs::offset>(expected);
+    for (size_t i = 0; i < values.size(); ++i) {
+      SCOPED_TRACE(values[i]);
+      ASSERT_TRUE(batch.valid(i));
+      ASSERT_TRUE(expected.reset(values[i]));
+      auto tokens = batch.tokens(i);
+      auto token = tokens.begin();
+      for (; expected.next(); ++token) {
+        ASSERT_NE(token, tokens.end());
+        ASSERT_EQ(term->value, batch.term(*token));
+        ASSERT_EQ(inc->value, token->increment);
+        ASSERT_EQ(offset->start, token->start);
+        ASSERT_EQ(offset->end, token->end);
+      }
+      ASSERT_EQ(token, tokens.end());
+    }
+  };
+
+  for (size_t min = 1; min <= 3; ++min) {
+    for (const size_t max : {min, min + 1, min + 2, size_t{100}}) {
+      for (const bool original : {false, true}) {
+        for (const std::string_view start : {"", "^"}) {
+          for (const std::string_view end : {"", "$"}) {
+            const ngram_token_stream_base::Options binary{
+              min,
+              max,
+              original,
+              ngram_token_stream_base::InputType::Binary,
+              irs::ViewCast<irs::byte_type>(start),
+              irs::ViewCast<irs::byte_type>(end)};
+            check.operator()<ngram_token_stream_base::InputType::Binary>(
+              binary);
+            auto utf8 = binary;
+            utf8.stream_bytes_type = ngram_token_stream_base::InputType::UTF8;
+            check.operator()<ngram_token_stream_base::InputType::UTF8>(utf8);
+          }
+        }
+      }
+    }
+  }
+}
@@ -28,6 +28,7 @@
 #include "analysis/pipeline_token_stream.hpp"
 #include "analysis/text_token_stream.hpp"
 #include "analysis/token_attributes.hpp"
+#include "analysis/token_batch.hpp"
 #include "analysis/token_stream.hpp"
 #include "gtest/gtest.h"
 #include "tests_config.hpp"
@@ -862,3 +863,65 @@ TEST(pipeline_token_stream_test, members_visitor) {
   irs::analysis::pipeline_token_stream pipe3(std::move(pipeline_options3));
   assert_pipeline_members(pipe3, expected_nested);
 }
+
+TEST(pipeline_token_stream_test, analyze_batch) {
+  auto make_pipeline = [] {
+    irs::analysis::pipeline_token_stream::options_t pipeline_options;
+    pipeline_options.emplace_back(irs::analysis::analyzers::get(
+      "delimiter", irs::type<irs::text_format::json>::get(),
+      "{\"delimiter\":\",\"}"));
+    pipeline_options.emplace_back(irs::analysis::analyzers::get(
+      "text", irs::type<irs::text_format::json>::get(),
+      "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[\"the\"], "
+      "\"stemming\":false }"));
+    pipeline_options.emplace_back(irs::analysis::analyzers::get(
+      "ngram", irs::type<irs::text_format::json>::get(),
+      "{\"min\":2, \"max\":3, \"preserveOriginal\":true }"));
+    return std::make_unique<irs::analysis::pipeline_token_stream>(
+      std::move(pipeline_options));
+  };
+
+  const std::vector<std::string_view> values{
+    "quick broWn,, FOX  jumps,  over the lazy dog", "", "the", ",,,",
+    "A B,C", "caf\xC3\xA9 au lait"};
+
+  auto pipe = make_pipeline();
+  irs::analysis::TokenBatch batch;
+  pipe->analyze(values, batch);
+  ASSERT_EQ(values.size(), batch.size());
+  ASSERT_TRUE(batch.offsets());
+
+  // batch matches token by token analysis
+  auto expected_pipe = make_pipeline();
+  auto* term = irs::get<irs::term_attribute>(*expected_pipe);
+  auto* inc = irs::get<irs::increment>(*expected_pipe);
+  auto* offset = irs::get<irs::offset>(*expected_pipe);
+  for (size_t i = 0; i < values.size(); ++i) {
+    SCOPED_TRACE(values[i]);
+    ASSERT_TRUE(batch.valid(i));
+    ASSERT_TRUE(expected_pipe->reset(values[i]));
+    auto tokens = batch.tokens(i);
+    auto token = tokens.begin();
+    for (; expected_pipe->next(); ++token) {
+      ASSERT_NE(token, tokens.end());
+      ASSERT_EQ(term->value, batch.term(*token));
+      ASSERT_EQ(inc->value, token->increment);
+      ASSERT_EQ(offset->start, token->start);
+      ASSERT_EQ(offset->end, token->end);
+    }
+    ASSERT_EQ(token, tokens.end());
+  }
+  ASSERT_FALSE(batch.tokens(0).empty());
+  ASSERT_TRUE(batch.tokens(1).empty());
+
+  // batch is replaced
+  pipe->analyze(std::span{values}.first(1), batch);
+  ASSERT_EQ(1, batch.size());
+
+  // empty pipeline fails to analyze anything
+  irs::analysis::pipeline_token_stream empty({});
+  empty.analyze(values, batch);
+  ASSERT_EQ(values.size(), batch.size());
+  ASSERT_FALSE(batch.valid(0));
+  ASSERT_TRUE(batch.tokens().empty());
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "analysis/stopwords.hpp"
+
+#include <random>
+
+#include "tests_shared.hpp"
+
+TEST(StopwordsTest, Empty) {
+  irs::analysis::Stopwords stopwords{{}};
+  ASSERT_TRUE(stopwords.empty());
+  ASSERT_EQ(0, stopwords.size());
+  ASSERT_FALSE(stopwords.Contains(""));
+  ASSERT_FALSE(stopwords.Contains("a"));
+}
+
+TEST(StopwordsTest, Contains) {
+  const irs::analysis::Stopwords::words_t words{
+    "",
+    "a",
+    "an",
+    "the",
+    "\xd0\xb8",
+    "\xd0\xbd\xd0\xb5\xd1\x82",
+    "twelve_bytes",
+    "exactly_sixteen!",
+    "seventeen_bytes!!",
+    "a_stopword_of_exactly_32_bytes!!",
+    "a_stopword_longer_than_32_bytes_and_even_longer_than_63_bytes_abc"};
+  irs::analysis::Stopwords stopwords{words};
+  ASSERT_FALSE(stopwords.empty());
+  ASSERT_EQ(words.size(), stopwords.size());
+
+  for (const auto& word : words) {
+    ASSERT_TRUE(stopwords.Contains(word)) << word;
+    // same length, different last or first byte
+    if (!word.empty()) {
+      auto other = word;
+      other.back() ^= 1;
+      ASSERT_FALSE(stopwords.Contains(other)) << other;
+      other = word;
+      other.front() ^= 1;
+      ASSERT_FALSE(stopwords.Contains(other)) << other;
+    }
+    ASSERT_FALSE(stopwords.Contains(word + "x")) << word;
+  }
+  ASSERT_FALSE(stopwords.Contains("b"));
+  ASSERT_FALSE(stopwords.Contains("thee"));
+}
+
+TEST(StopwordsTest, ContainsRandom) {
+  std::mt19937_64 rng{42};
+  auto make_word = [&] {
+    std::string word(1 + rng() % 40, 0);
+    for (auto& c : word) {
+      c = static_cast<char>('a' + rng() % 4);
+    }
+    return word;
+  };
+
+  for (const size_t size : {1, 2, 7, 100, 1000}) {
+    irs::analysis::Stopwords::words_t words;
+    while (words.size() < size) {
+      words.emplace(make_word());
+    }
+    irs::analysis::Stopwords stopwords{words};
+    ASSERT_EQ(size, stopwords.size());
+
+    for (size_t i = 0; i < 10000; ++i) {
+      const auto word = make_word();
+      ASSERT_EQ(words.contains(word), stopwords.Contains(word)) << word;
+    }
+    for (const auto& word : words) {
+      ASSERT_TRUE(stopwords.Contains(word)) << word;
+    }
+  }
+}
+
+TEST(StopwordsTest, Make) {
+  const irs::analysis::Stopwords::words_t words{"a", "the"};
+
+  auto stopwords = irs::analysis::Stopwords::Make(words);
+  ASSERT_NE(nullptr, stopwords);
+  ASSERT_TRUE(stopwords->Contains("the"));
+
+  // same words are shared
+  ASSERT_EQ(stopwords, irs::analysis::Stopwords::Make({"the", "a"}));
+  ASSERT_NE(stopwords, irs::analysis::Stopwords::Make({"a"}));
+  ASSERT_NE(stopwords, irs::analysis::Stopwords::Make({"athe"}));
+
+  // compiled again once all users are gone
+  std::weak_ptr<const irs::analysis::Stopwords> weak = stopwords;
+  stopwords.reset();
+  ASSERT_TRUE(weak.expired());
+  stopwords = irs::analysis::Stopwords::Make(words);
+  ASSERT_TRUE(stopwords->Contains("a"));
+}
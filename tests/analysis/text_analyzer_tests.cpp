@@ -1597,3 +1597,168 @@ TEST_F(TextAnalyzerParserTestSuite, test_text_ngrams) {
     }
   }
 }
+
+TEST_F(TextAnalyzerParserTestSuite, test_text_shingles) {
+  auto stream = irs::analysis::analyzers::get(
+    "text", irs::type<irs::text_format::json>::get(),
+    "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[], \"stemming\":false, "
+    "\"shingles\":true}");
+  ASSERT_NE(nullptr, stream);
+
+  auto* term = irs::get<irs::term_attribute>(*stream);
+  ASSERT_NE(nullptr, term);
+  auto* inc = irs::get<irs::increment>(*stream);
+  ASSERT_NE(nullptr, inc);
+  auto* offset = irs::get<irs::offset>(*stream);
+  ASSERT_NE(nullptr, offset);
+  auto* derived = irs::get<irs::derived_token>(*stream);
+  ASSERT_NE(nullptr, derived);
+
+  uint32_t last_start = 0;
+  auto assert_token = [&](std::string_view expected, uint32_t expected_inc,
+                          uint32_t start, uint32_t end, bool is_derived) {
+    ASSERT_TRUE(stream->next());
+    ASSERT_EQ(expected, irs::ViewCast<char>(term->value));
+    ASSERT_EQ(expected_inc, inc->value);
+    ASSERT_EQ(start, offset->start);
+    ASSERT_EQ(end, offset->end);
+    ASSERT_EQ(is_derived, derived->value);
+    // field_data::invert rejects decreasing start offsets
+    ASSERT_LE(last_start, offset->start);
+    last_start = offset->start;
+  };
+
+  for (size_t i = 0; i < 2; ++i) {
+    last_start = 0;
+    ASSERT_TRUE(stream->reset("To be or  NOT"));
+    assert_token("to", 1, 0, 2, false);
+    assert_token("to\x1F"
+                 "be",
+                 0, 0, 5, true);
+    assert_token("be", 1, 3, 5, false);
+    assert_token("be\x1For", 0, 3, 8, true);
+    assert_token("or", 1, 6, 8, false);
+    assert_token("or\x1Fnot", 0, 6, 13, true);
+    assert_token("not", 1, 10, 13, false);
+    ASSERT_FALSE(stream->next());
+  }
+
+  // single word, no shingles
+  last_start = 0;
+  ASSERT_TRUE(stream->reset("quick"));
+  assert_token("quick", 1, 0, 5, false);
+  ASSERT_FALSE(stream->next());
+
+  // shingles aren't compatible with edge ngrams
+  ASSERT_EQ(nullptr,
+            irs::analysis::analyzers::get(
+              "text", irs::type<irs::text_format::json>::get(),
+              "{\"locale\":\"en_US.UTF-8\", \"shingles\":true, \"edgeNgram\" : "
+              "{\"min\":2, \"max\":3}}"));
+
+  // normalized config preserves shingles
+  std::string actual;
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    actual, "text", irs::type<irs::text_format::json>::get(),
+    "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[], \"shingles\":true}"));
+  ASSERT_NE(std::string::npos, actual.find("\"shingles\":true"));
+}
+
+TEST_F(TextAnalyzerParserTestSuite, test_ascii_fast_path) {
+  using Token = std::tuple<std::string, uint32_t, uint32_t>;
+
+  auto collect = [](irs::analysis::analyzer& stream, std::string_view data) {
+    std::vector<Token> tokens;
+    auto* term = irs::get<irs::term_attribute>(stream);
+    auto* offset = irs::get<irs::offset>(stream);
+    EXPECT_TRUE(stream.reset(data));
+    while (stream.next()) {
+      tokens.emplace_back(irs::ViewCast<char>(term->value), offset->start,
+                          offset->end);
+    }
+    return tokens;
+  };
+
+  constexpr std::string_view kData =
+    "The QUICK brown-fox can't jump e.g. over 3.14 or 1,000;2 lazy_dogs "
+    "_ __ x@y.com a:b 1:2 a'1 1.a \t\r\nEND.";
+
+  for (const auto* config :
+       {"{\"locale\":\"en_US.UTF-8\", \"stopwords\":[]}",
+        "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[\"the\"], "
+        "\"case\":\"upper\", \"stemming\":false}",
+        "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[], \"case\":\"none\", "
+        "\"accent\":true}",
+        "{\"locale\":\"sv\", \"stopwords\":[]}",
+        "{\"locale\":\"tr\", \"stopwords\":[]}"}) {
+    SCOPED_TRACE(config);
+    auto stream = irs::analysis::analyzers::get(
+      "text", irs::type<irs::text_format::json>::get(), config);
+    ASSERT_NE(nullptr, stream);
+
+    // non-ASCII input is tokenized by ICU
+    auto expected = collect(*stream, std::string{kData} + " \xC3\xA9");
+    ASSERT_FALSE(expected.empty());
+    expected.pop_back();
+
+    for (size_t i = 0; i < 2; ++i) {
+      ASSERT_EQ(expected, collect(*stream, kData));
+    }
+  }
+}
+
+TEST_F(TextAnalyzerParserTestSuite, test_cache) {
+  using Token = std::tuple<std::string, uint32_t, uint32_t>;
+
+  auto collect = [](irs::analysis::analyzer& stream, std::string_view data) {
+    std::vector<Token> tokens;
+    auto* term = irs::get<irs::term_attribute>(stream);
+    auto* offset = irs::get<irs::offset>(stream);
+    EXPECT_TRUE(stream.reset(data));
+    while (stream.next()) {
+      tokens.emplace_back(irs::ViewCast<char>(term->value), offset->start,
+                          offset->end);
+    }
+    return tokens;
+  };
+
+  irs::analysis::text_token_stream::options_t options;
+  options.locale = icu::Locale::createFromName("en_US.UTF-8");
+  options.explicit_stopwords.emplace("the");
+  options.explicit_stopwords_set = true;
+
+  irs::analysis::text_token_stream uncached(options,
+                                            options.explicit_stopwords);
+  options.cache_size = 16;
+  irs::analysis::text_token_stream cached(options, options.explicit_stopwords);
+
+  // ASCII input
+  constexpr std::string_view kAscii = "the running dogs run the running race";
+  ASSERT_EQ(collect(uncached, kAscii), collect(cached, kAscii));
+  ASSERT_EQ(2, cached.cache_stats().hits);  // "the", "running"
+  ASSERT_EQ(5, cached.cache_stats().misses);
+  ASSERT_EQ(0, uncached.cache_stats().hits);
+  ASSERT_EQ(0, uncached.cache_stats().misses);
+
+  // non-ASCII input
+  constexpr std::string_view kUtf8 = "the caf\xC3\xA9 running the caf\xC3\xA9";
+  ASSERT_EQ(collect(uncached, kUtf8), collect(cached, kUtf8));
+  ASSERT_EQ(6, cached.cache_stats().hits);
+  ASSERT_EQ(6, cached.cache_stats().misses);
+
+  // raw tokens of invalid UTF-8 input aren't cached
+  constexpr std::string_view kInvalid = "running \xFF running";
+  ASSERT_EQ(collect(uncached, kInvalid), collect(cached, kInvalid));
+  ASSERT_EQ(6, cached.cache_stats().hits);
+  ASSERT_EQ(6, cached.cache_stats().misses);
+
+  // normalized config preserves cache size
+  std::string actual;
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    actual, "text", irs::type<irs::text_format::json>::get(),
+    "{\"locale\":\"en_US.UTF-8\", \"stopwords\":[], \"cacheSize\":1024}"));
+  ASSERT_NE(std::string::npos, actual.find("\"cacheSize\":1024"));
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+                       "text", irs::type<irs::text_format::json>::get(),
+                       "{\"locale\":\"en_US.UTF-8\", \"cacheSize\":\"big\"}"));
+}
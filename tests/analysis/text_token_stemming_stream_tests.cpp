@@ -231,3 +231,46 @@ TEST_F(stemming_token_stream_tests, test_make_config_text) {
   ASSERT_FALSE(irs::analysis::analyzers::normalize(
     actual, "stem", irs::type<irs::text_format::text>::get(), config));
 }
+
+TEST_F(stemming_token_stream_tests, test_cache) {
+  irs::analysis::stemming_token_stream::options_t opts;
+  opts.locale = icu::Locale::createFromName("en");
+  opts.cache_size = 2;
+
+  irs::analysis::stemming_token_stream stream(opts);
+  auto* term = irs::get<irs::term_attribute>(stream);
+  ASSERT_NE(nullptr, term);
+
+  auto assert_stem = [&](std::string_view data, std::string_view expected) {
+    ASSERT_TRUE(stream.reset(data));
+    ASSERT_TRUE(stream.next());
+    ASSERT_EQ(expected, irs::ViewCast<char>(term->value));
+    ASSERT_FALSE(stream.next());
+  };
+
+  assert_stem("running", "run");
+  assert_stem("running", "run");
+  assert_stem("jumps", "jump");
+  assert_stem("jumps", "jump");
+  ASSERT_EQ(2, stream.cache_stats().hits);
+  ASSERT_EQ(2, stream.cache_stats().misses);
+
+  // cache is dropped once full
+  assert_stem("dogs", "dog");
+  assert_stem("running", "run");
+  assert_stem("dogs", "dog");
+  ASSERT_EQ(3, stream.cache_stats().hits);
+  ASSERT_EQ(4, stream.cache_stats().misses);
+
+  // normalized config preserves cache size
+  std::string actual;
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    actual, "stem", irs::type<irs::text_format::json>::get(),
+    "{\"locale\":\"en\",\"cacheSize\":1024}"));
+  ASSERT_EQ(
+    VPackParser::fromJson("{\"locale\":\"en\",\"cacheSize\":1024}")->toString(),
+    actual);
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+                       "stem", irs::type<irs::text_format::json>::get(),
+                       "{\"locale\":\"en\",\"cacheSize\":\"big\"}"));
+}
@@ -675,7 +675,8 @@ void Format15TestCase::AssertPostings(DocsView docs, uint32_t threshold) {
 }
 
 static const auto kTestFormats = ::testing::Values(
-  tests::format_info{"1_5", "1_0"}, tests::format_info{"1_5simd", "1_0"});
+  tests::format_info{"1_5", "1_0"}, tests::format_info{"1_5simd", "1_0"},
+  tests::format_info{"1_5pef", "1_0"}, tests::format_info{"1_5simdpef", "1_0"});
 
 static constexpr auto kTestDirs =
   tests::getDirectories<tests::kTypesDefault | tests::kTypesRot13_16 |
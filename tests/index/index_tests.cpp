@@ -159,6 +159,86 @@ class SubReaderMock final : public irs::SubReader {
   irs::SegmentInfo meta_;
 };
 
+// Counts bytes read from files with a given suffix
+class ReadCountingDirectory final : public tests::directory_mock {
+ public:
+  ReadCountingDirectory(irs::directory& impl, std::string_view suffix)
+    : tests::directory_mock{impl}, suffix_{suffix} {}
+
+  irs::index_input::ptr open(std::string_view name,
+                             irs::IOAdvice advice) const noexcept final {
+    auto in = tests::directory_mock::open(name, advice);
+    if (in && name.ends_with(suffix_)) {
+      return std::make_unique<Input>(std::move(in), *this);
+    }
+    return in;
+  }
+
+  size_t read() const noexcept { return read_; }
+  size_t checksummed() const noexcept { return checksummed_; }
+
+ private:
+  class Input final : public irs::index_input {
+   public:
+    Input(index_input::ptr&& impl, const ReadCountingDirectory& dir) noexcept
+      : impl_{std::move(impl)}, dir_{&dir} {}
+
+    const irs::byte_type* read_buffer(size_t offset, size_t size,
+                                      irs::BufferHint hint) final {
+      return Count(impl_->read_buffer(offset, size, hint), size);
+    }
+    const irs::byte_type* read_buffer(size_t size, irs::BufferHint hint) final {
+      return Count(impl_->read_buffer(size, hint), size);
+    }
+    irs::byte_type read_byte() final {
+      ++dir_->read_;
+      return impl_->read_byte();
+    }
+    size_t read_bytes(irs::byte_type* b, size_t count) final {
+      return Count(impl_->read_bytes(b, count));
+    }
+    size_t read_bytes(size_t offset, irs::byte_type* b, size_t count) final {
+      return Count(impl_->read_bytes(offset, b, count));
+    }
+    size_t file_pointer() const final { return impl_->file_pointer(); }
+    size_t length() const final { return impl_->length(); }
+    bool eof() const final { return impl_->eof(); }
+    ptr dup() const final {
+      return std::make_unique<Input>(impl_->dup(), *dir_);
+    }
+    ptr reopen() const final {
+      return std::make_unique<Input>(impl_->reopen(), *dir_);
+    }
+    void seek(size_t pos) final { impl_->seek(pos); }
+    int64_t checksum(size_t offset) const final {
+      ++dir_->checksummed_;
+      dir_->read_ += offset - impl_->file_pointer();
+      return impl_->checksum(offset);
+    }
+
+   private:
+    size_t Count(size_t count) const noexcept {
+      dir_->read_ += count;
+      return count;
+    }
+
+    const irs::byte_type* Count(const irs::byte_type* data,
+                                size_t count) const noexcept {
+      if (data) {
+        dir_->read_ += count;
+      }
+      return data;
+    }
+
+    index_input::ptr impl_;
+    const ReadCountingDirectory* dir_;
+  };
+
+  std::string suffix_;
+  mutable size_t read_{0};
+  mutable size_t checksummed_{0};
+};
+
 }  // namespace
 
 namespace tests {
@@ -2675,6 +2755,93 @@ TEST_P(index_test_case, europarl_docs_automaton) {
   }
 }
 
+TEST_P(index_test_case, europarl_docs_lazy_term_index) {
+  {
+    tests::europarl_doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    add_segment(gen);
+  }
+
+  auto reader = open_reader({.lazy_term_index = true});
+  tests::assert_index(reader.GetImpl(), index(), irs::IndexFeatures::FREQ);
+
+  auto acceptor = irs::FromWildcard("%ende%");
+  irs::automaton_table_matcher matcher(acceptor, true);
+  tests::assert_index(reader.GetImpl(), index(), irs::IndexFeatures::FREQ, 0,
+                      &matcher);
+}
+
+TEST_P(index_test_case, europarl_docs_lazy_term_index_open) {
+  {
+    tests::europarl_doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    add_segment(gen);
+  }
+
+  uint64_t length = 0;
+  dir().visit([&](std::string_view name) {
+    if (name.ends_with(".ti")) {
+      EXPECT_TRUE(dir().length(length, name));
+      return false;
+    }
+    return true;
+  });
+  ASSERT_LT(0, length);
+
+  // term index is verified and read in full
+  {
+    ReadCountingDirectory counting_dir{dir(), ".ti"};
+    irs::DirectoryReader reader{counting_dir, codec()};
+    ASSERT_EQ(1, reader.size());
+    ASSERT_EQ(1, counting_dir.checksummed());
+    ASSERT_LE(length, counting_dir.read());
+  }
+
+  // only field metadata is read from lazily loaded term index
+  {
+    ReadCountingDirectory counting_dir{dir(), ".ti"};
+    irs::DirectoryReader reader{counting_dir, codec(),
+                                {.lazy_term_index = true}};
+    ASSERT_EQ(1, reader.size());
+    ASSERT_EQ(0, counting_dir.checksummed());
+    ASSERT_GT(length / 2, counting_dir.read());
+
+    // FST is loaded on first access
+    auto* field = reader[0].field("body_anl");
+    ASSERT_NE(nullptr, field);
+    auto it = field->iterator(irs::SeekMode::NORMAL);
+    ASSERT_TRUE(it->next());
+    ASSERT_EQ(0, counting_dir.checksummed());
+  }
+}
+
+TEST_P(index_test_case, europarl_docs_terms_info) {
+  irs::IndexWriterOptions opts;
+  opts.terms_info = [](std::string_view name) -> irs::TermsInfo {
+    if (name == "title") {
+      return {.min_block_size = 2, .max_block_size = 2};
+    }
+    if (name == "body") {
+      return {.adaptive = true};
+    }
+    return {.min_block_size = 64, .max_block_size = 96};
+  };
+
+  {
+    tests::europarl_doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    add_segment(gen, irs::OM_CREATE, opts);
+  }
+
+  auto reader = open_reader();
+  tests::assert_index(reader.GetImpl(), index(), irs::IndexFeatures::FREQ);
+
+  auto acceptor = irs::FromWildcard("%ende%");
+  irs::automaton_table_matcher matcher(acceptor, true);
+  tests::assert_index(reader.GetImpl(), index(), irs::IndexFeatures::FREQ, 0,
+                      &matcher);
+}
+
 TEST_P(index_test_case, europarl_docs_big) {
   if (dynamic_cast<irs::FSDirectory*>(&dir()) != nullptr) {
     GTEST_SKIP() << "too long for our CI";
@@ -15975,10 +16142,11 @@ INSTANTIATE_TEST_SUITE_P(index_test_14, index_test_case_14,
 namespace {
 #if defined(IRESEARCH_SSE2)
 const auto kIndexTestCase15Formats = ::testing::Values(
-  tests::format_info{"1_5", "1_0"}, tests::format_info{"1_5simd", "1_0"});
+  tests::format_info{"1_5", "1_0"}, tests::format_info{"1_5simd", "1_0"},
+  tests::format_info{"1_5pef", "1_0"}, tests::format_info{"1_5simdpef", "1_0"});
 #else
-const auto kIndexTestCase15Formats =
-  ::testing::Values(tests::format_info{"1_5", "1_0"});
+const auto kIndexTestCase15Formats = ::testing::Values(
+  tests::format_info{"1_5", "1_0"}, tests::format_info{"1_5pef", "1_0"});
 #endif
 }  // namespace
 
@@ -23,7 +23,10 @@
 
 #include <array>
 
+#include "analysis/analyzers.hpp"
+#include "analysis/delimited_token_stream.hpp"
 #include "analysis/token_attributes.hpp"
+#include "analysis/token_batch.hpp"
 #include "index/comparer.hpp"
 #include "index/index_tests.hpp"
 #include "index/segment_writer.hpp"
@@ -540,6 +543,146 @@ TEST_F(segment_writer_tests, index_field) {
   }
 }
 
+namespace {
+
+struct field_t {
+  irs::analysis::analyzer* stream;
+  const irs::analysis::TokenBatch* batch;
+  std::string_view value;
+  size_t index;
+  irs::IndexFeatures index_features() const {
+    return irs::IndexFeatures::FREQ | irs::IndexFeatures::POS |
+           irs::IndexFeatures::OFFS;
+  }
+  irs::features_t features() const { return {}; }
+  irs::token_stream& get_tokens() {
+    stream->reset(value);
+    return *stream;
+  }
+  std::string_view name() const { return "test_field"; }
+};
+
+struct batch_field_t : field_t {
+  irs::analysis::BatchTokens get_batch_tokens() const {
+    return {.batch = batch, .value = index};
+  }
+};
+
+class segment_writer_batch_tests : public segment_writer_tests {
+ protected:
+  // Checks that values of many documents analyzed at once are indexed the
+  // same way as values analyzed one by one.
+  void assert_batch(irs::analysis::analyzer& stream,
+                    std::span<const std::string_view> values) {
+    irs::analysis::TokenBatch batch;
+    stream.analyze(values, batch);
+    ASSERT_EQ(values.size(), batch.size());
+
+    const auto expected = write(values.size(), [&](size_t i) {
+      return field_t{.stream = &stream, .value = values[i], .index = i};
+    });
+    const auto actual = write(values.size(), [&](size_t i) {
+      return batch_field_t{{.batch = &batch, .index = i}};
+    });
+    ASSERT_EQ(values.size(), expected.docs_count);
+    ASSERT_EQ(expected.docs_count, actual.docs_count);
+    ASSERT_EQ(expected.live_docs_count, actual.live_docs_count);
+    ASSERT_EQ(expected.byte_size, actual.byte_size);
+  }
+
+  template<typename MakeField>
+  irs::SegmentMeta write(size_t count, MakeField make_field) {
+    irs::memory_directory dir;
+    auto writer = irs::segment_writer::make(dir, options());
+    irs::SegmentMeta segment;
+    segment.name = "foo";
+    segment.codec = default_codec();
+    writer->reset(segment);
+
+    for (size_t i = 0; i < count; ++i) {
+      auto field = make_field(i);
+      writer->begin({});
+      EXPECT_TRUE(writer->insert<irs::Action::INDEX>(field));
+      EXPECT_TRUE(writer->valid());
+      writer->commit();
+    }
+
+    irs::IndexSegment index_segment;
+    irs::DocsMask docs_mask{.set{irs::IResourceManager::kNoop}};
+    index_segment.meta.codec = default_codec();
+    const auto doc_map = writer->flush(index_segment, docs_mask);
+    EXPECT_TRUE(doc_map.empty());
+    EXPECT_EQ(0, docs_mask.count);
+    return index_segment.meta;
+  }
+
+  irs::SegmentWriterOptions options() const {
+    return {.column_info = column_info_,
+            .feature_info = feature_info_,
+            .scorers_features = scorers_features_};
+  }
+
+ private:
+  irs::ColumnInfoProvider column_info_ = default_column_info();
+  irs::FeatureInfoProvider feature_info_ = default_feature_info();
+  irs::feature_set_t scorers_features_;
+};
+
+}  // namespace
+
+TEST_F(segment_writer_batch_tests, index_batch_field) {
+  const std::vector<std::string_view> values{"a,b,c", "", "b,,b", "c,a"};
+
+  // indexing a batch produces the same segment as indexing a stream
+  auto stream = irs::analysis::delimited_token_stream::make(",");
+  ASSERT_NE(nullptr, stream);
+  assert_batch(*stream, values);
+
+  // value failed to be analyzed
+  {
+    irs::analysis::TokenBatch failed;
+    irs::analysis::empty_analyzer{}.analyze(values, failed);
+    ASSERT_EQ(values.size(), failed.size());
+    ASSERT_FALSE(failed.valid(0));
+
+    irs::memory_directory dir;
+    auto writer = irs::segment_writer::make(dir, options());
+    irs::SegmentMeta segment;
+    segment.name = "foo";
+    segment.codec = default_codec();
+    writer->reset(segment);
+
+    batch_field_t field{{.batch = &failed, .index = 0}};
+    writer->begin({});
+    ASSERT_FALSE(writer->insert<irs::Action::INDEX>(field));
+    ASSERT_FALSE(writer->valid());
+    writer->commit();
+  }
+}
+
+TEST_F(segment_writer_batch_tests, index_classification_batch) {
+#ifdef WIN32
+  const auto model_loc = resource("model_cooking.bin").generic_string();
+#else
+  const auto model_loc = resource("model_cooking.bin").string();
+#endif
+  auto stream = irs::analysis::analyzers::get(
+    "classification", irs::type<irs::text_format::json>::get(),
+    "{\"model_location\": \"" + model_loc + "\", \"top_k\": 2}");
+  ASSERT_NE(nullptr, stream);
+
+  constexpr std::string_view kData[]{
+    "Which baking dish is best to bake a banana bread ?", "",
+    "How to cook rice", "bananas and apples"};
+
+  // values of more documents than predicted at once
+  std::vector<std::string_view> values;
+  for (size_t i = 0; i < 50; ++i) {
+    values.emplace_back(kData[i % std::size(kData)]);
+  }
+  assert_batch(*stream, values);
+}
+
 class StringComparer final : public irs::Comparer {
   int CompareImpl(irs::bytes_view lhs, irs::bytes_view rhs) const final {
     EXPECT_FALSE(irs::IsNull(lhs));
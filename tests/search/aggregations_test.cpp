@@ -0,0 +1,356 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "search/aggregations.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "filter_test_case_base.hpp"
+#include "search/all_filter.hpp"
+#include "search/term_filter.hpp"
+#include "store/store_utils.hpp"
+#include "tests_shared.hpp"
+
+namespace {
+
+// test documents store numbers as zvdouble
+bool DecodeZVDouble(irs::bytes_view value, double& out) noexcept {
+  if (value.empty()) {
+    return false;
+  }
+  irs::bytes_view_input in{value};
+  out = irs::read_zvdouble(in);
+  return true;
+}
+
+bool DecodeNaN(irs::bytes_view value, double& out) noexcept {
+  out = std::numeric_limits<double>::quiet_NaN();
+  return !value.empty();
+}
+
+// maps numbers to values beyond the range of int64_t keeping their sign
+bool DecodeHuge(irs::bytes_view value, double& out) noexcept {
+  if (!DecodeZVDouble(value, out)) {
+    return false;
+  }
+  out = std::copysign(1e30, out);
+  return true;
+}
+
+// Fails execution on the first segment, delays it on the others.
+class FailingQuery final : public irs::filter::prepared {
+ public:
+  explicit FailingQuery(const irs::IndexReader& index) noexcept
+    : first_{&index[0]} {}
+
+  irs::doc_iterator::ptr execute(
+    const irs::ExecutionContext& ctx) const final {
+    if (&ctx.segment == first_) {
+      throw std::runtime_error{"failed"};
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    ++executed;
+    return irs::doc_iterator::empty();
+  }
+
+  void visit(const irs::SubReader&, irs::PreparedStateVisitor&,
+             irs::score_t) const final {}
+
+  irs::score_t boost() const noexcept final { return irs::kNoBoost; }
+
+  mutable std::atomic<size_t> executed{0};
+
+ private:
+  const irs::SubReader* first_;
+};
+
+class aggregations_test_case : public tests::FilterTestCaseBase {
+ protected:
+  void init_index() {
+    auto writer = open_writer(irs::OM_CREATE);
+
+    std::vector<tests::doc_generator_base::ptr> gens;
+    gens.emplace_back(new tests::json_doc_generator(
+      resource("simple_sequential.json"), &tests::generic_json_field_factory));
+    gens.emplace_back(new tests::json_doc_generator(
+      resource("simple_sequential_common_prefix.json"),
+      &tests::generic_json_field_factory));
+    add_segments(*writer, gens);
+  }
+
+  // Computes expected results reading matched documents one by one.
+  static void Expected(const irs::SubReader& segment,
+                       const irs::filter::prepared& query,
+                       irs::TermsCounts& names, irs::NumericStats& stats,
+                       irs::HistogramCounts& histogram) {
+    auto docs = segment.mask(query.execute({.segment = segment}));
+    const auto* name_column = segment.column("name");
+    const auto* value_column = segment.column("value");
+    ASSERT_NE(nullptr, name_column);
+    ASSERT_NE(nullptr, value_column);
+
+    while (docs->next()) {
+      const auto doc = docs->value();
+
+      auto name_it = name_column->iterator(irs::ColumnHint::kNormal);
+      auto* name = irs::get<irs::payload>(*name_it);
+      ASSERT_NE(nullptr, name);
+      if (doc == name_it->seek(doc)) {
+        ++names.counts[irs::bstring{name->value}];
+      }
+
+      auto value_it = value_column->iterator(irs::ColumnHint::kNormal);
+      auto* value = irs::get<irs::payload>(*value_it);
+      ASSERT_NE(nullptr, value);
+      double v;
+      if (doc == value_it->seek(doc) && DecodeZVDouble(value->value, v)) {
+        ++stats.count;
+        stats.sum += v;
+        stats.min = std::min(stats.min, v);
+        stats.max = std::max(stats.max, v);
+        ++histogram.buckets[static_cast<int64_t>(std::floor((v - 5.) / 100.))];
+      }
+    }
+  }
+
+  void CheckAggregations(const irs::filter& filter) {
+    auto index = open_reader();
+    auto query = filter.prepare({.index = index});
+    ASSERT_NE(nullptr, query);
+
+    irs::DocAggregator aggregator{{
+      irs::TermsAggregation{.column = "name"},
+      irs::StatsAggregation{.column = "value", .decoder = &DecodeZVDouble},
+      irs::HistogramAggregation{.column = "value",
+                                .interval = 100.,
+                                .offset = 5.,
+                                .decoder = &DecodeZVDouble},
+      irs::TermsAggregation{.column = "missing"},
+    }};
+
+    irs::TermsCounts names;
+    irs::NumericStats stats;
+    irs::HistogramCounts histogram;
+    for (auto& segment : index) {
+      Expected(segment, *query, names, stats, histogram);
+    }
+    ASSERT_FALSE(names.counts.empty());
+
+    auto check = [&](const std::vector<irs::AggregationResult>& results) {
+      ASSERT_EQ(4, results.size());
+      ASSERT_EQ(names.counts, std::get<irs::TermsCounts>(results[0]).counts);
+      auto& actual_stats = std::get<irs::NumericStats>(results[1]);
+      ASSERT_EQ(stats.count, actual_stats.count);
+      ASSERT_DOUBLE_EQ(stats.sum, actual_stats.sum);
+      ASSERT_EQ(stats.min, actual_stats.min);
+      ASSERT_EQ(stats.max, actual_stats.max);
+      ASSERT_EQ(histogram.buckets,
+                std::get<irs::HistogramCounts>(results[2]).buckets);
+      ASSERT_TRUE(std::get<irs::TermsCounts>(results[3]).counts.empty());
+    };
+
+    check(aggregator.Execute(index, *query));
+
+    irs::DocAggregator::ThreadPool pool{2};
+    check(aggregator.Execute(index, *query, &pool));
+
+    // a stopped pool rejects tasks, segments are aggregated inline
+    pool.stop();
+    check(aggregator.Execute(index, *query, &pool));
+
+    // collect from bitsets of matched documents
+    auto results = aggregator.MakeResults();
+    for (auto& segment : index) {
+      auto docs = segment.mask(query->execute({.segment = segment}));
+      irs::bitset matched{irs::doc_limits::min() + segment.docs_count()};
+      while (docs->next()) {
+        matched.set(docs->value());
+      }
+      auto partial = aggregator.MakeResults();
+      aggregator.Collect(segment, matched, partial);
+      irs::DocAggregator::Merge(results, partial);
+    }
+    check(results);
+  }
+};
+
+TEST(aggregations_test, merge) {
+  irs::NumericStats lhs{.count = 2, .sum = 3., .min = 1., .max = 2.};
+  lhs.Merge({.count = 1, .sum = -5., .min = -5., .max = -5.});
+  ASSERT_EQ(3, lhs.count);
+  ASSERT_EQ(-2., lhs.sum);
+  ASSERT_EQ(-5., lhs.min);
+  ASSERT_EQ(2., lhs.max);
+
+  // empty stats don't affect min/max
+  lhs.Merge({});
+  ASSERT_EQ(3, lhs.count);
+  ASSERT_EQ(-5., lhs.min);
+  ASSERT_EQ(2., lhs.max);
+
+  irs::HistogramCounts histogram{.buckets = {{-1, 2}, {3, 1}}};
+  histogram.Merge({.buckets = {{3, 4}, {7, 1}}});
+  ASSERT_EQ((absl::flat_hash_map<int64_t, uint64_t>{{-1, 2}, {3, 5}, {7, 1}}),
+            histogram.buckets);
+}
+
+TEST(aggregations_test, decode) {
+  double value;
+  const double expected = 42.5;
+  ASSERT_TRUE(irs::DecodeDouble(
+    {reinterpret_cast<const irs::byte_type*>(&expected), sizeof expected},
+    value));
+  ASSERT_EQ(expected, value);
+
+  const int64_t expected_int = -7;
+  ASSERT_TRUE(irs::DecodeInt64(
+    {reinterpret_cast<const irs::byte_type*>(&expected_int),
+     sizeof expected_int},
+    value));
+  ASSERT_EQ(-7., value);
+
+  ASSERT_FALSE(irs::DecodeDouble({}, value));
+  ASSERT_FALSE(irs::DecodeInt64(
+    {reinterpret_cast<const irs::byte_type*>(&expected_int), 3}, value));
+}
+
+TEST_P(aggregations_test_case, all) {
+  init_index();
+  CheckAggregations(irs::all{});
+}
+
+TEST_P(aggregations_test_case, term) {
+  init_index();
+  irs::by_term filter;
+  *filter.mutable_field() = "same";
+  filter.mutable_options()->term =
+    irs::ViewCast<irs::byte_type>(std::string_view("xyz"));
+  CheckAggregations(filter);
+}
+
+TEST_P(aggregations_test_case, field_terms) {
+  init_index();
+  auto index = open_reader();
+
+  irs::by_term filter;
+  *filter.mutable_field() = "same";
+  filter.mutable_options()->term =
+    irs::ViewCast<irs::byte_type>(std::string_view("xyz"));
+  auto query = filter.prepare({.index = index});
+  ASSERT_NE(nullptr, query);
+
+  irs::DocAggregator aggregator{{
+    irs::FieldTermsAggregation{.field = "prefix"},
+    irs::FieldTermsAggregation{.field = "missing"},
+  }};
+
+  // count matched documents per term by postings
+  irs::TermsCounts expected;
+  for (auto& segment : index) {
+    const auto* field = segment.field("prefix");
+    ASSERT_NE(nullptr, field);
+    auto terms = field->iterator(irs::SeekMode::NORMAL);
+    while (terms->next()) {
+      terms->read();
+      auto postings = terms->postings(irs::IndexFeatures::NONE);
+      auto docs = segment.mask(query->execute({.segment = segment}));
+      while (postings->next()) {
+        if (postings->value() == docs->seek(postings->value())) {
+          ++expected.counts[irs::bstring{terms->value()}];
+        }
+      }
+    }
+  }
+  ASSERT_FALSE(expected.counts.empty());
+
+  auto results = aggregator.Execute(index, *query);
+  ASSERT_EQ(2, results.size());
+  ASSERT_EQ(expected.counts, std::get<irs::TermsCounts>(results[0]).counts);
+  ASSERT_TRUE(std::get<irs::TermsCounts>(results[1]).counts.empty());
+}
+
+TEST_P(aggregations_test_case, histogram_out_of_range) {
+  init_index();
+  auto index = open_reader();
+  auto query = irs::all{}.prepare({.index = index});
+  ASSERT_NE(nullptr, query);
+
+  irs::DocAggregator aggregator{{
+    irs::StatsAggregation{.column = "value", .decoder = &DecodeZVDouble},
+    irs::HistogramAggregation{.column = "value", .decoder = &DecodeNaN},
+    irs::HistogramAggregation{.column = "value", .decoder = &DecodeHuge},
+  }};
+
+  auto results = aggregator.Execute(index, *query);
+  ASSERT_EQ(3, results.size());
+  const auto& stats = std::get<irs::NumericStats>(results[0]);
+  ASSERT_NE(0, stats.count);
+
+  // non-finite keys are skipped
+  ASSERT_TRUE(std::get<irs::HistogramCounts>(results[1]).buckets.empty());
+
+  // keys out of range fall into the outermost buckets
+  uint64_t count = 0;
+  for (const auto& [key, key_count] :
+       std::get<irs::HistogramCounts>(results[2]).buckets) {
+    ASSERT_TRUE(key == std::numeric_limits<int64_t>::min() ||
+                key == std::numeric_limits<int64_t>::max());
+    count += key_count;
+  }
+  ASSERT_EQ(stats.count, count);
+}
+
+TEST_P(aggregations_test_case, collect_failure) {
+  init_index();
+  auto index = open_reader();
+  ASSERT_LT(1, index.size());
+
+  irs::DocAggregator aggregator{{
+    irs::StatsAggregation{.column = "value", .decoder = &DecodeZVDouble},
+  }};
+
+  {
+    FailingQuery query{index};
+    ASSERT_THROW(aggregator.Execute(index, query), std::runtime_error);
+    ASSERT_EQ(0, query.executed);
+  }
+
+  // all segments are processed before the error is rethrown
+  irs::DocAggregator::ThreadPool pool{2};
+  FailingQuery query{index};
+  ASSERT_THROW(aggregator.Execute(index, query, &pool), std::runtime_error);
+  ASSERT_EQ(index.size() - 1, query.executed);
+}
+
+static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
+
+INSTANTIATE_TEST_SUITE_P(
+  aggregations_test, aggregations_test_case,
+  ::testing::Combine(::testing::ValuesIn(kTestDirs),
+                     ::testing::Values(tests::format_info{"1_0"},
+                                       tests::format_info{"1_4", "1_4simd"})),
+  aggregations_test_case::to_string);
+
+}  // namespace
@@ -30,6 +30,7 @@
 #include "search/all_iterator.hpp"
 #include "search/bm25.hpp"
 #include "search/boolean_filter.hpp"
+#include "search/boolean_query.hpp"
 #include "search/conjunction.hpp"
 #include "search/disjunction.hpp"
 #include "search/exclusion.hpp"
@@ -184,6 +185,68 @@ class basic_doc_iterator : public irs::doc_iterator, irs::score_ctx {
   irs::document doc_;
 };
 
+// Iterator exposing 'doc_bitmap' attribute
+class bitmap_doc_iterator : public irs::doc_iterator {
+ public:
+  explicit bitmap_doc_iterator(const std::vector<irs::doc_id_t>& docs)
+    : first_{docs.begin()},
+      last_{docs.end()},
+      est_{docs.size()},
+      bitmap_{this, &fill} {}
+
+  irs::doc_id_t value() const final { return doc_.value; }
+
+  bool next() final {
+    if (first_ == last_) {
+      doc_.value = irs::doc_limits::eof();
+      return false;
+    }
+
+    doc_.value = *first_++;
+    return true;
+  }
+
+  irs::doc_id_t seek(irs::doc_id_t target) final {
+    return irs::seek(*this, target);
+  }
+
+  irs::attribute* get_mutable(irs::type_info::type_id type) noexcept final {
+    if (irs::type<irs::document>::id() == type) {
+      return &doc_;
+    }
+    if (irs::type<irs::cost>::id() == type) {
+      return &est_;
+    }
+    return irs::type<irs::doc_bitmap>::id() == type ? &bitmap_ : nullptr;
+  }
+
+  static size_t fill_count;
+
+ private:
+  static bool fill(void* ctx, irs::doc_id_t base, irs::doc_id_t max,
+                   uint64_t* words) {
+    ++fill_count;
+    auto& self = *static_cast<bitmap_doc_iterator*>(ctx);
+    EXPECT_LE(base, self.doc_.value);
+    while (self.doc_.value < max) {
+      const auto offset = self.doc_.value - base;
+      irs::set_bit(words[offset / 64], offset % 64);
+      if (!self.next()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<irs::doc_id_t>::const_iterator first_;
+  std::vector<irs::doc_id_t>::const_iterator last_;
+  irs::cost est_;
+  irs::document doc_;
+  irs::doc_bitmap bitmap_;
+};
+
+size_t bitmap_doc_iterator::fill_count = 0;
+
 std::vector<irs::doc_id_t> union_all(
   const std::vector<std::vector<irs::doc_id_t>>& docs) {
   std::vector<irs::doc_id_t> result;
@@ -11396,6 +11459,86 @@ TEST(block_disjunction_test, scored_seek_next_no_readahead) {
   }
 }
 
+TEST(block_disjunction_test, next_bitmap) {
+  using disjunction = irs::block_disjunction<
+    irs::doc_iterator::ptr, irs::NoopAggregator,
+    irs::block_disjunction_traits<irs::MatchType::kMatch, false, 2>>;
+
+  std::vector<std::vector<irs::doc_id_t>> docs{
+    {1, 2, 5, 7, 9, 11, 45, 65, 78, 127, 128, 129, 1145, 111165},
+    {3, 4, 5, 127, 130, 131, 256, 1145, 1146},
+    {2, 300, 301, 302, 303, 111111127}};
+  for (irs::doc_id_t doc = 2000; doc < 4000; doc += 3) {
+    docs[1].emplace_back(doc);
+  }
+  std::sort(docs[1].begin(), docs[1].end());
+
+  const auto expected = detail::union_all(docs);
+
+  // all sub-iterators expose bitmap
+  {
+    detail::bitmap_doc_iterator::fill_count = 0;
+    disjunction::doc_iterators_t itrs;
+    for (auto& part : docs) {
+      itrs.emplace_back(
+        irs::memory::make_managed<detail::bitmap_doc_iterator>(part));
+    }
+
+    disjunction it{std::move(itrs)};
+    std::vector<irs::doc_id_t> result;
+    while (it.next()) {
+      result.emplace_back(it.value());
+    }
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    ASSERT_EQ(expected, result);
+    ASSERT_NE(0, detail::bitmap_doc_iterator::fill_count);
+  }
+
+  // mixed sub-iterators
+  {
+    disjunction::doc_iterators_t itrs;
+    itrs.emplace_back(
+      irs::memory::make_managed<detail::bitmap_doc_iterator>(docs[0]));
+    itrs.emplace_back(irs::memory::make_managed<detail::basic_doc_iterator>(
+      docs[1].begin(), docs[1].end()));
+    itrs.emplace_back(
+      irs::memory::make_managed<detail::bitmap_doc_iterator>(docs[2]));
+
+    disjunction it{std::move(itrs)};
+    std::vector<irs::doc_id_t> result;
+    while (it.next()) {
+      result.emplace_back(it.value());
+    }
+    ASSERT_EQ(expected, result);
+  }
+
+  // conjunction of bitmap iterators
+  {
+    std::vector<std::vector<irs::doc_id_t>> conj_docs{
+      {1, 5, 127, 128, 1145, 2003, 2004, 3998},
+      {5, 127, 1145, 2003, 2006, 3998, 3999}};
+    std::vector<irs::doc_id_t> conj_expected{5, 127, 1145, 2003, 3998};
+
+    std::vector<irs::ScoreAdapter<>> conj_itrs;
+    for (auto& part : conj_docs) {
+      conj_itrs.emplace_back(
+        irs::memory::make_managed<detail::bitmap_doc_iterator>(part));
+    }
+    auto conj = irs::MakeConjunction({}, irs::NoopAggregator{},
+                                     std::move(conj_itrs));
+    ASSERT_NE(nullptr, irs::get<irs::doc_bitmap>(*conj));
+
+    disjunction::doc_iterators_t itrs;
+    itrs.emplace_back(std::move(conj));
+    disjunction it{std::move(itrs)};
+    std::vector<irs::doc_id_t> result;
+    while (it.next()) {
+      result.emplace_back(it.value());
+    }
+    ASSERT_EQ(conj_expected, result);
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--    disjunction (iterator0 OR iterator1 OR iterator2 OR ...)
 // ----------------------------------------------------------------------------
@@ -16843,6 +16986,263 @@ TEST(Or_test, boosted_not) {
   ASSERT_FALSE(docs->next());
 }
 
+namespace detail {
+
+// Segment having only a number of documents
+struct sized_sub_reader final : irs::SubReader {
+  explicit sized_sub_reader(uint64_t docs_count) {
+    meta.docs_count = docs_count;
+    meta.live_docs_count = docs_count;
+  }
+
+  uint64_t CountMappedMemory() const final { return 0; }
+  irs::column_iterator::ptr columns() const final {
+    return irs::column_iterator::empty();
+  }
+  const irs::column_reader* column(irs::field_id) const final {
+    return nullptr;
+  }
+  const irs::column_reader* column(std::string_view) const final {
+    return nullptr;
+  }
+  const irs::SegmentInfo& Meta() const final { return meta; }
+  const irs::DocumentMask* docs_mask() const final { return nullptr; }
+  irs::doc_iterator::ptr docs_iterator() const final {
+    return irs::doc_iterator::empty();
+  }
+  const irs::term_reader* field(std::string_view) const final {
+    return nullptr;
+  }
+  irs::field_iterator::ptr fields() const final {
+    return irs::field_iterator::empty();
+  }
+  const irs::column_reader* sort() const final { return nullptr; }
+
+  irs::SegmentInfo meta;
+};
+
+std::vector<irs::doc_id_t> collect(irs::doc_iterator& it) {
+  std::vector<irs::doc_id_t> docs;
+  while (it.next()) {
+    docs.emplace_back(it.value());
+  }
+  return docs;
+}
+
+}  // namespace detail
+
+TEST(boolean_query_plan, and_flatten_push_down) {
+  irs::And root;
+  root.add<detail::boosted>().docs = {1, 2, 3, 5, 8, 13};
+  {
+    auto& sub = root.add<irs::And>();
+    sub.add<detail::boosted>().docs = {2, 3, 5, 8, 13, 21};
+    sub.add<detail::boosted>().docs = {3, 5, 13};
+    sub.add<irs::Not>().filter<detail::boosted>().docs = {5, 6, 7};
+  }
+  // boosted nested conjunction isn't flattened
+  {
+    auto& sub = root.add<irs::And>();
+    sub.boost(2.f);
+    sub.add<detail::boosted>().docs = {1, 3, 5, 13};
+    sub.add<detail::boosted>().docs = {3, 5, 8, 13};
+  }
+
+  auto prep = root.prepare({.index = irs::SubReader::empty()});
+  auto* query = dynamic_cast<const irs::BooleanQuery*>(prep.get());
+  ASSERT_NE(nullptr, query);
+
+  // excluded documents cover the whole segment
+  {
+    detail::sized_sub_reader segment{6};
+    const auto plan = query->Explain({.segment = segment});
+    ASSERT_EQ(irs::BooleanStrategy::kConjunction, plan.strategy);
+    ASSERT_EQ("conjunction", irs::ToString(plan.strategy));
+    ASSERT_EQ((std::vector<irs::cost::cost_t>{6, 6, 3, 4}), plan.costs);
+    ASSERT_EQ(2, plan.driver);
+    ASSERT_TRUE(plan.exclusion_pushed_down);
+
+    auto docs = prep->execute({.segment = segment});
+    ASSERT_EQ((std::vector<irs::doc_id_t>{3, 13}), detail::collect(*docs));
+  }
+
+  // excluded documents are rare
+  {
+    detail::sized_sub_reader segment{1000};
+    const auto plan = query->Explain({.segment = segment});
+    ASSERT_EQ(irs::BooleanStrategy::kConjunction, plan.strategy);
+    ASSERT_EQ(4, plan.costs.size());
+    ASSERT_FALSE(plan.exclusion_pushed_down);
+
+    auto docs = prep->execute({.segment = segment});
+    ASSERT_EQ((std::vector<irs::doc_id_t>{3, 13}), detail::collect(*docs));
+  }
+}
+
+TEST(boolean_query_plan, or_flatten) {
+  irs::Or root;
+  root.add<detail::boosted>().docs = {1};
+  {
+    auto& sub = root.add<irs::Or>();
+    sub.add<detail::boosted>().docs = {2};
+    sub.add<detail::boosted>().docs = {3};
+  }
+  // nested exclusion isn't flattened
+  {
+    auto& sub = root.add<irs::Or>();
+    sub.add<detail::boosted>().docs = {4};
+    sub.add<irs::Not>().filter<detail::boosted>().docs = {4};
+  }
+  // nested min match isn't flattened
+  {
+    auto& sub = root.add<irs::Or>();
+    sub.min_match_count(2);
+    sub.add<detail::boosted>().docs = {5, 6};
+    sub.add<detail::boosted>().docs = {6};
+  }
+
+  auto prep = root.prepare({.index = irs::SubReader::empty()});
+  auto* query = dynamic_cast<const irs::BooleanQuery*>(prep.get());
+  ASSERT_NE(nullptr, query);
+
+  const auto plan = query->Explain({.segment = irs::SubReader::empty()});
+  ASSERT_EQ(5, plan.costs.size());
+}
+
+TEST(boolean_query_plan, or_strategies) {
+  const std::vector<std::vector<irs::doc_id_t>> docs{
+    {1, 64, 65}, {2, 3, 700}, {4, 800, 900}, {5, 6, 7, 8},
+    {9, 1000},   {5, 10},     {11, 640, 999}};
+
+  auto expected = [&](size_t count) {
+    return detail::union_all({docs.begin(), docs.begin() + count});
+  };
+
+  tests::sort::boost sort;
+  auto pord = irs::Scorers::Prepare(sort);
+
+  struct {
+    size_t count;
+    uint64_t docs_count;
+    bool scored;
+    irs::BooleanStrategy strategy;
+  } cases[]{
+    {1, 1024, false, irs::BooleanStrategy::kUnary},
+    {2, 1024, false, irs::BooleanStrategy::kSmallDisjunction},
+    // sparse
+    {4, 1 << 16, false, irs::BooleanStrategy::kSmallDisjunction},
+    {4, 1 << 16, true, irs::BooleanStrategy::kSmallDisjunction},
+    // dense
+    {4, 1024, false, irs::BooleanStrategy::kBlockDisjunction},
+    {7, 1024, false, irs::BooleanStrategy::kBitset},
+    {7, 1024, true, irs::BooleanStrategy::kBlockDisjunction},
+    // sparse
+    {7, 1 << 16, false, irs::BooleanStrategy::kBlockDisjunction},
+  };
+
+  for (auto& c : cases) {
+    SCOPED_TRACE(testing::Message("Count: ")
+                 << c.count << ", Docs: " << c.docs_count
+                 << ", Scored: " << c.scored);
+
+    const auto& scorers = c.scored ? pord : irs::Scorers::kUnordered;
+    detail::sized_sub_reader segment{c.docs_count};
+    irs::Or root;
+    for (size_t i = 0; i < c.count; ++i) {
+      root.add<detail::boosted>().docs = docs[i];
+    }
+    auto prep = root.prepare({.index = segment, .scorers = scorers});
+
+    if (auto* query = dynamic_cast<const irs::BooleanQuery*>(prep.get());
+        query) {
+      const auto plan = query->Explain({.segment = segment, .scorers = scorers});
+      ASSERT_EQ(c.strategy, plan.strategy);
+      ASSERT_EQ(c.count, plan.costs.size());
+    } else {
+      ASSERT_EQ(irs::BooleanStrategy::kUnary, c.strategy);
+    }
+
+    auto it = prep->execute({.segment = segment, .scorers = scorers});
+    ASSERT_EQ(expected(c.count), detail::collect(*it));
+  }
+
+  // costs aren't evaluated to choose a strategy
+  {
+    irs::Or root;
+    for (size_t i = 0; i < 7; ++i) {
+      root.add<detail::estimated>().est = 100;
+    }
+    detail::sized_sub_reader segment{1024};
+    auto prep = root.prepare({.index = segment});
+    auto* query = dynamic_cast<const irs::BooleanQuery*>(prep.get());
+    ASSERT_NE(nullptr, query);
+    const auto plan = query->Explain({.segment = segment});
+    ASSERT_EQ(irs::BooleanStrategy::kBlockDisjunction, plan.strategy);
+    ASSERT_EQ(7, plan.costs.size());
+    for (auto est : plan.costs) {
+      ASSERT_EQ(irs::cost::kMax, est);
+    }
+    for (auto& filter : root) {
+      ASSERT_FALSE(dynamic_cast<const detail::estimated&>(*filter).evaluated);
+    }
+  }
+}
+
+TEST(boolean_query_plan, or_bitset_doc_bitmap) {
+  // materialized disjunction consumes bitmaps of sub-iterators
+  struct bitmap_filter final : irs::filter {
+    struct prepared : irs::filter::prepared {
+      explicit prepared(const std::vector<irs::doc_id_t>& docs) : docs{docs} {}
+
+      irs::doc_iterator::ptr execute(
+        const irs::ExecutionContext&) const final {
+        return irs::memory::make_managed<detail::bitmap_doc_iterator>(docs);
+      }
+
+      void visit(const irs::SubReader&, irs::PreparedStateVisitor&,
+                 irs::score_t) const final {}
+
+      irs::score_t boost() const noexcept final { return irs::kNoBoost; }
+
+      const std::vector<irs::doc_id_t>& docs;
+    };
+
+    irs::filter::prepared::ptr prepare(const irs::PrepareContext&) const final {
+      return irs::memory::make_managed<prepared>(docs);
+    }
+
+    irs::type_info::type_id type() const noexcept final {
+      return irs::type<bitmap_filter>::id();
+    }
+
+    std::vector<irs::doc_id_t> docs;
+  };
+
+  std::vector<std::vector<irs::doc_id_t>> docs(8);
+  for (irs::doc_id_t doc = 1; doc <= 4096; ++doc) {
+    if (doc % 3) {
+      docs[doc % docs.size()].emplace_back(doc);
+    }
+  }
+
+  irs::Or root;
+  for (auto& part : docs) {
+    root.add<bitmap_filter>().docs = part;
+  }
+
+  detail::sized_sub_reader segment{4096};
+  auto prep = root.prepare({.index = segment});
+  auto* query = dynamic_cast<const irs::BooleanQuery*>(prep.get());
+  ASSERT_NE(nullptr, query);
+  ASSERT_EQ(irs::BooleanStrategy::kBitset,
+            query->Explain({.segment = segment}).strategy);
+
+  detail::bitmap_doc_iterator::fill_count = 0;
+  auto it = prep->execute({.segment = segment});
+  ASSERT_EQ(detail::union_all(docs), detail::collect(*it));
+  ASSERT_EQ(docs.size(), detail::bitmap_doc_iterator::fill_count);
+}
+
 static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
 
 INSTANTIATE_TEST_SUITE_P(boolean_filter_test, boolean_filter_test_case,
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "search/impact_postings.hpp"
+
+#include "filter_test_case_base.hpp"
+#include "search/bm25.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+#include "tests_shared.hpp"
+
+namespace {
+
+class impact_postings_test_case : public tests::FilterTestCaseBase {
+ protected:
+  void init_index() {
+    auto writer = open_writer(irs::OM_CREATE);
+
+    std::vector<tests::doc_generator_base::ptr> gens;
+    gens.emplace_back(new tests::json_doc_generator(
+      resource("simple_sequential.json"), &tests::generic_json_field_factory));
+    gens.emplace_back(new tests::json_doc_generator(
+      resource("simple_sequential_common_prefix.json"),
+      &tests::generic_json_field_factory));
+    add_segments(*writer, gens);
+  }
+
+  static irs::bytes_view Term(std::string_view value) noexcept {
+    return irs::ViewCast<irs::byte_type>(value);
+  }
+
+  // Computes exact scores of a disjunction of 'terms'.
+  static std::map<std::pair<size_t, irs::doc_id_t>, irs::score_t> Exact(
+    const irs::IndexReader& index, std::string_view field,
+    std::span<const irs::bytes_view> terms, const irs::Scorers& scorers) {
+    std::map<std::pair<size_t, irs::doc_id_t>, irs::score_t> scores;
+    for (const auto term : terms) {
+      auto query = irs::by_term::prepare(
+        {.index = index, .scorers = scorers}, field, term);
+      for (size_t i = 0; i < index.size(); ++i) {
+        auto& segment = index[i];
+        auto docs = segment.mask(
+          query->execute({.segment = segment, .scorers = scorers}));
+        auto* score = irs::get<irs::score>(*docs);
+        EXPECT_NE(nullptr, score);
+        while (docs->next()) {
+          irs::score_t value;
+          score->Score(&value);
+          scores[{i, docs->value()}] += value;
+        }
+      }
+    }
+    return scores;
+  }
+};
+
+TEST_P(impact_postings_test_case, groups) {
+  init_index();
+  auto index = open_reader();
+  auto& segment = index[0];
+  const auto* field = segment.field("same");
+  ASSERT_NE(nullptr, field);
+
+  SimpleMemoryAccounter memory;
+  irs::ImpactPostings postings{*field, Term("xyz"), memory, 4};
+  ASSERT_EQ(segment.docs_count(), postings.size());
+  ASSERT_LT(0, memory.counter_);
+  ASSERT_FALSE(postings.groups().empty());
+  ASSERT_LE(postings.groups().size(), 4);
+
+  size_t size = 0;
+  uint32_t freq = std::numeric_limits<uint32_t>::max();
+  for (auto& group : postings.groups()) {
+    ASSERT_LT(group.freq, freq);
+    ASSERT_LE(group.freq, 4);
+    freq = group.freq;
+    auto docs = postings.docs(group);
+    ASSERT_FALSE(docs.empty());
+    ASSERT_TRUE(std::is_sorted(docs.begin(), docs.end()));
+    size += docs.size();
+  }
+  ASSERT_EQ(postings.size(), size);
+
+  // a single level gets a single group
+  irs::ImpactPostings flat{*field, Term("xyz"), memory, 1};
+  ASSERT_EQ(1, flat.groups().size());
+  ASSERT_EQ(1, flat.groups().front().freq);
+  ASSERT_EQ(postings.size(), flat.size());
+
+  irs::ImpactPostings missing{*field, Term("missing"), memory};
+  ASSERT_TRUE(missing.groups().empty());
+  ASSERT_EQ(0, missing.size());
+}
+
+TEST_P(impact_postings_test_case, anytime_search) {
+  init_index();
+  auto index = open_reader();
+  irs::BM25 scorer;
+  auto scorers = irs::Scorers::Prepare(scorer);
+
+  const std::array terms{Term("abcd"), Term("vczc"), Term("xyz"),
+                         Term("missing")};
+  const auto exact = Exact(index, "duplicated", terms, scorers);
+  ASSERT_FALSE(exact.empty());
+
+  // postings read to build impact ordered postings and documents scored to
+  // estimate impacts of their groups
+  size_t built = 0;
+  size_t estimated = 0;
+  for (auto& segment : index) {
+    if (const auto* field = segment.field("duplicated"); field) {
+      for (const auto term : terms) {
+        irs::ImpactPostings postings{*field, term,
+                                     irs::IResourceManager::kNoop};
+        built += postings.size();
+        estimated += postings.groups().size();
+      }
+    }
+  }
+  ASSERT_EQ(exact.size(), built);
+
+  SimpleMemoryAccounter memory;
+  irs::ImpactPostingsCache cache{memory};
+
+  // without a budget scores are exact
+  {
+    auto result = irs::AnytimeSearch(index, "duplicated", terms, scorers,
+                                     cache, {.top_k = 1000});
+    ASSERT_TRUE(result.complete);
+    ASSERT_EQ(exact.size(), result.hits.size());
+    ASSERT_EQ(built + estimated + exact.size(), result.postings);
+    ASSERT_LT(0, memory.counter_);
+    for (size_t i = 0; i < result.hits.size(); ++i) {
+      auto& hit = result.hits[i];
+      auto it = exact.find({hit.segment, hit.doc});
+      ASSERT_NE(it, exact.end());
+      ASSERT_NEAR(it->second, hit.score, 1e-5f);
+      if (i) {
+        ASSERT_GE(result.hits[i - 1].score, hit.score);
+      }
+    }
+  }
+
+  // only the first segment has the field
+  ASSERT_EQ(terms.size(), cache.size());
+
+  // top-K
+  {
+    auto result = irs::AnytimeSearch(index, "duplicated", terms, scorers,
+                                     cache, {.top_k = 3});
+    ASSERT_TRUE(result.complete);
+    ASSERT_EQ(3, result.hits.size());
+  }
+
+  // posting budget stops after a single posting
+  {
+    auto result =
+      irs::AnytimeSearch(index, "duplicated", terms, scorers, cache,
+                         {.top_k = 10, .max_postings = estimated + 1});
+    ASSERT_FALSE(result.complete);
+    ASSERT_EQ(estimated + 1, result.postings);
+    ASSERT_EQ(1, result.hits.size());
+    auto& hit = result.hits.front();
+    auto it = exact.find({hit.segment, hit.doc});
+    ASSERT_NE(it, exact.end());
+    ASSERT_GT(hit.score, 0.f);
+    ASSERT_LE(hit.score, it->second + 1e-5f);
+  }
+
+  // building impact ordered postings counts against the budget
+  {
+    irs::ImpactPostingsCache cold_cache{memory};
+    auto result = irs::AnytimeSearch(index, "duplicated", terms, scorers,
+                                     cold_cache, {.max_postings = 1});
+    ASSERT_FALSE(result.complete);
+    ASSERT_LT(1, result.postings);
+    ASSERT_TRUE(result.hits.empty());
+    ASSERT_EQ(1, cold_cache.size());
+  }
+
+  // bounded cache evicts postings, results are the same
+  {
+    irs::ImpactPostingsCache bounded_cache{memory, 1};
+    auto result = irs::AnytimeSearch(index, "duplicated", terms, scorers,
+                                     bounded_cache, {.top_k = 1000});
+    ASSERT_TRUE(result.complete);
+    ASSERT_EQ(exact.size(), result.hits.size());
+    ASSERT_EQ(1, bounded_cache.size());
+  }
+
+  // time budget
+  {
+    auto result = irs::AnytimeSearch(
+      index, "duplicated", terms, scorers, cache,
+      {.max_time = std::chrono::steady_clock::duration{0}});
+    ASSERT_FALSE(result.complete);
+    ASSERT_EQ(0, result.postings);
+    ASSERT_TRUE(result.hits.empty());
+  }
+
+  // documents are collected without scorers as well
+  {
+    auto result = irs::AnytimeSearch(index, "duplicated", terms,
+                                     irs::Scorers::kUnordered, cache,
+                                     {.top_k = 1000});
+    ASSERT_TRUE(result.complete);
+    ASSERT_EQ(exact.size(), result.hits.size());
+    for (auto& hit : result.hits) {
+      ASSERT_EQ(0.f, hit.score);
+      ASSERT_TRUE(exact.contains({hit.segment, hit.doc}));
+    }
+  }
+
+  // cached postings don't depend on scorers
+  {
+    irs::ImpactPostingsCache empty_cache{memory};
+    auto expected = irs::AnytimeSearch(index, "duplicated", terms, scorers,
+                                       empty_cache);
+    auto result =
+      irs::AnytimeSearch(index, "duplicated", terms, scorers, cache);
+    ASSERT_EQ(expected.postings, built + result.postings);
+    ASSERT_EQ(expected.hits.size(), result.hits.size());
+    for (size_t j = 0; j < result.hits.size(); ++j) {
+      ASSERT_EQ(expected.hits[j].segment, result.hits[j].segment);
+      ASSERT_EQ(expected.hits[j].doc, result.hits[j].doc);
+      ASSERT_EQ(expected.hits[j].score, result.hits[j].score);
+    }
+  }
+}
+
+static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
+
+INSTANTIATE_TEST_SUITE_P(
+  impact_postings_test, impact_postings_test_case,
+  ::testing::Combine(::testing::ValuesIn(kTestDirs),
+                     ::testing::Values(tests::format_info{"1_0"},
+                                       tests::format_info{"1_4", "1_4simd"})),
+  impact_postings_test_case::to_string);
+
+}  // namespace
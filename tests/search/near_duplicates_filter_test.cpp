@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "search/near_duplicates_filter.hpp"
+
+#include "analysis/delimited_token_stream.hpp"
+#include "analysis/minhash_token_stream.hpp"
+#include "filter_test_case_base.hpp"
+#include "tests_shared.hpp"
+
+namespace {
+
+constexpr uint32_t kNumHashes = 64;
+constexpr uint32_t kNumBands = 16;
+
+irs::analysis::MinHashTokenStream MakeStream() {
+  return irs::analysis::MinHashTokenStream{
+    {.analyzer = irs::analysis::delimited_token_stream::make(" "),
+     .num_hashes = kNumHashes,
+     .num_bands = kNumBands}};
+}
+
+// Indexes LSH bands of a text, stores MinHash signature of the text.
+class MinHashField final : public tests::field_base {
+ public:
+  MinHashField(std::string_view name, std::string_view value)
+    : stream_{MakeStream()}, value_{value} {
+    this->name(std::string{name});
+  }
+
+  irs::token_stream& get_tokens() const final {
+    stream_.reset(value_);
+    return stream_;
+  }
+
+  // field is stored after it has been indexed
+  bool write(irs::data_output& out) const final {
+    stream_.WriteSignature(out);
+    return true;
+  }
+
+ private:
+  mutable irs::analysis::MinHashTokenStream stream_;
+  std::string value_;
+};
+
+class NearDuplicatesFilterTestCase : public tests::FilterTestCaseBase {
+ protected:
+  static constexpr std::string_view kText =
+    "the quick brown fox jumps over the lazy dog while a small bird sings "
+    "in the old oak tree next to the quiet river bank";
+
+  static irs::ByNearDuplicatesOptions MakeOptions(std::string_view value,
+                                                  double threshold) {
+    auto stream = MakeStream();
+    auto* term = irs::get<irs::term_attribute>(stream);
+    EXPECT_NE(nullptr, term);
+    EXPECT_TRUE(stream.reset(value));
+
+    irs::ByNearDuplicatesOptions options;
+    while (stream.next()) {
+      options.bands.emplace_back(term->value);
+    }
+    options.signature.assign(stream.signature().begin(),
+                             stream.signature().end());
+    options.threshold = threshold;
+    return options;
+  }
+
+  void InitDataSet() {
+    auto writer = open_writer(irs::OM_CREATE);
+    ASSERT_NE(nullptr, writer);
+
+    const std::string_view values[]{
+      // exact copy
+      kText,
+      // single word changed
+      "the quick brown fox jumps over the lazy cat while a small bird sings "
+      "in the old oak tree next to the quiet river bank",
+      // half of words changed
+      "the quick brown fox jumps over the lazy dog while a large crow "
+      "screams on a young pine bush far from the noisy city street",
+      // disjoint
+      "lorem ipsum dolor sit amet consectetur adipiscing elit sed do "
+      "eiusmod tempor incididunt ut labore et dolore magna aliqua"};
+
+    {
+      auto trx = writer->GetBatch();
+      for (const auto value : values) {
+        auto doc = trx.Insert();
+        ASSERT_TRUE(
+          doc.Insert<irs::Action::INDEX | irs::Action::STORE>(
+            MinHashField{"text", value}));
+        ASSERT_TRUE(doc);
+      }
+      // exact copy without a signature
+      auto doc = trx.Insert();
+      ASSERT_TRUE(
+        doc.Insert<irs::Action::INDEX>(MinHashField{"text", kText}));
+      ASSERT_TRUE(doc);
+    }
+    ASSERT_TRUE(writer->Commit());
+  }
+};
+
+TEST(NearDuplicatesFilterTest, options) {
+  irs::ByNearDuplicatesOptions opts;
+  ASSERT_TRUE(opts.bands.empty());
+  ASSERT_TRUE(opts.signature.empty());
+  ASSERT_EQ(0.8, opts.threshold);
+
+  irs::ByNearDuplicatesOptions other;
+  ASSERT_EQ(opts, other);
+  other.threshold = 0.5;
+  ASSERT_NE(opts, other);
+}
+
+TEST(NearDuplicatesFilterTest, ctor) {
+  irs::ByNearDuplicates q;
+  ASSERT_EQ(irs::type<irs::ByNearDuplicates>::id(), q.type());
+  ASSERT_EQ(irs::ByNearDuplicatesOptions{}, q.options());
+  ASSERT_TRUE(q.field().empty());
+  ASSERT_EQ(irs::kNoBoost, q.boost());
+}
+
+TEST_P(NearDuplicatesFilterTestCase, near_duplicates) {
+  InitDataSet();
+  auto rdr = open_reader();
+
+  // empty options
+  {
+    irs::ByNearDuplicates filter;
+    *filter.mutable_field() = "text";
+    CheckQuery(filter, Docs{}, Costs{0}, rdr, SOURCE_LOCATION);
+  }
+
+  auto opts = MakeOptions(kText, 0.8);
+  ASSERT_FALSE(opts.bands.empty());
+  ASSERT_LE(opts.bands.size(), kNumBands);
+
+  // exact copy and a copy with a single word changed
+  {
+    irs::ByNearDuplicates filter;
+    *filter.mutable_field() = "text";
+    *filter.mutable_options() = opts;
+    CheckQuery(filter, Docs{1, 2}, rdr, SOURCE_LOCATION);
+  }
+
+  // exact copy only
+  {
+    irs::ByNearDuplicates filter;
+    *filter.mutable_field() = "text";
+    *filter.mutable_options() = opts;
+    filter.mutable_options()->threshold = 1.;
+    CheckQuery(filter, Docs{1}, rdr, SOURCE_LOCATION);
+  }
+
+  // missing field
+  {
+    irs::ByNearDuplicates filter;
+    *filter.mutable_field() = "missing";
+    *filter.mutable_options() = opts;
+    CheckQuery(filter, Docs{}, Costs{0}, rdr, SOURCE_LOCATION);
+  }
+}
+
+static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
+
+INSTANTIATE_TEST_SUITE_P(
+  near_duplicates_filter_test, NearDuplicatesFilterTestCase,
+  ::testing::Combine(::testing::ValuesIn(kTestDirs),
+                     ::testing::Values(tests::format_info{"1_5", "1_0"})),
+  NearDuplicatesFilterTestCase::to_string);
+
+}  // namespace
@@ -219,6 +219,42 @@ TEST(NestedFilterTest, CheckMatch) {
                 irs::kMatchAny.IsMinMatch());
 }
 
+TEST(NestedFilterTest, NestedParents) {
+  irs::bitset::word_t words[3]{};
+  irs::set_bit<6>(words[0]);
+  irs::set_bit<63>(words[0]);
+  irs::set_bit<0>(words[1]);
+  irs::set_bit<2>(words[2]);
+
+  irs::bitset_doc_iterator it{std::begin(words), std::end(words)};
+  const irs::NestedParents parents{it, 150};
+  ASSERT_EQ(4, parents.size());
+
+  ASSERT_FALSE(parents.contains(irs::doc_limits::invalid()));
+  ASSERT_TRUE(parents.contains(6));
+  ASSERT_FALSE(parents.contains(7));
+  ASSERT_TRUE(parents.contains(130));
+  ASSERT_FALSE(parents.contains(irs::doc_limits::eof()));
+
+  ASSERT_EQ(6, parents.Next(irs::doc_limits::min()));
+  ASSERT_EQ(6, parents.Next(6));
+  ASSERT_EQ(63, parents.Next(7));
+  ASSERT_EQ(64, parents.Next(64));
+  ASSERT_EQ(130, parents.Next(65));
+  ASSERT_TRUE(irs::doc_limits::eof(parents.Next(131)));
+  ASSERT_TRUE(irs::doc_limits::eof(parents.Next(1000)));
+
+  ASSERT_EQ(irs::doc_limits::invalid(), parents.Prev(irs::doc_limits::min()));
+  ASSERT_EQ(irs::doc_limits::invalid(), parents.Prev(6));
+  ASSERT_EQ(6, parents.Prev(7));
+  ASSERT_EQ(6, parents.Prev(63));
+  ASSERT_EQ(63, parents.Prev(64));
+  ASSERT_EQ(64, parents.Prev(65));
+  ASSERT_EQ(64, parents.Prev(130));
+  ASSERT_EQ(130, parents.Prev(131));
+  ASSERT_EQ(130, parents.Prev(irs::doc_limits::eof()));
+}
+
 TEST(NestedFilterTest, CheckOptions) {
   {
     irs::ByNestedOptions opts;
@@ -468,6 +504,95 @@ TEST_P(NestedFilterTestCase, JoinAny1) {
   }
 }
 
+TEST_P(NestedFilterTestCase, JoinAnyCached) {
+  InitDataSet();
+  auto reader = open_reader();
+
+  auto cache = std::make_shared<irs::NestedParentsCache>();
+
+  irs::ByNestedFilter filter;
+  auto& opts = *filter.mutable_options();
+  opts.child = MakeByTerm("item", "Mouse");
+  opts.parent = MakeParentProvider("customer");
+  opts.parents_cache = cache;
+
+  // Parents of a filter without a key aren't cached
+  CheckQuery(filter, Docs{6, 13, 20}, Costs{3}, reader, SOURCE_LOCATION);
+  ASSERT_EQ(0, cache->size());
+
+  opts.parents_key = "customer";
+  CheckQuery(filter, Docs{6, 13, 20}, Costs{3}, reader, SOURCE_LOCATION);
+  ASSERT_EQ(1, cache->size());
+
+  {
+    const Tests tests = {
+      {Seek{6}, 6}, {Seek{7}, 13}, {Seek{7}, 13}, {Seek{16}, 20}};
+
+    CheckQuery(filter, {}, {tests}, reader, SOURCE_LOCATION);
+  }
+
+  {
+    const Tests tests = {
+      {Seek{irs::doc_limits::invalid()}, irs::doc_limits::invalid()},
+      {Seek{2}, 6},
+      {Next{}, 13},
+      {Next{}, 20},
+      {Next{}, irs::doc_limits::eof()},
+      {Seek{2}, irs::doc_limits::eof()},
+      {Next{}, irs::doc_limits::eof()}};
+    CheckQuery(filter, {}, {tests}, reader, SOURCE_LOCATION);
+  }
+
+  {
+    std::array<irs::Scorer::ptr, 2> scorers{std::make_unique<DocIdScorer>(),
+                                            std::make_unique<DocIdScorer>()};
+
+    const Tests tests = {
+      {Next{}, 6, {2.f, 2.f}},
+      {Next{}, 13, {9.f, 9.f}},
+      {Next{}, 20, {14.f, 14.f}},
+      {Next{}, irs::doc_limits::eof()},
+    };
+
+    CheckQuery(filter, scorers, {tests}, reader, SOURCE_LOCATION);
+  }
+
+  // Child query matches parents only
+  opts.child = MakeByColumnExistence("customer");
+  CheckQuery(filter, Docs{}, Costs{4}, reader, SOURCE_LOCATION);
+
+  // Child query matches everything
+  opts.child = std::make_unique<irs::all>();
+  CheckQuery(filter, Docs{6, 8, 13, 20}, Costs{20}, reader, SOURCE_LOCATION);
+  ASSERT_EQ(1, cache->size());
+
+  // Parents of another parent filter are cached separately
+  {
+    irs::ByNestedFilter other;
+    auto& other_opts = *other.mutable_options();
+    other_opts.child = std::make_unique<irs::all>();
+    other_opts.parent = [](const irs::SubReader&) {
+      return irs::doc_iterator::empty();
+    };
+    other_opts.parents_cache = cache;
+    other_opts.parents_key = "none";
+    ASSERT_NE(opts, other_opts);
+
+    CheckQuery(other, Docs{}, reader, SOURCE_LOCATION);
+    ASSERT_EQ(2, cache->size());
+    CheckQuery(filter, Docs{6, 8, 13, 20}, Costs{20}, reader, SOURCE_LOCATION);
+    ASSERT_EQ(2, cache->size());
+
+    // Different parent filters colliding on a key share cached parents
+    other_opts.parents_key = opts.parents_key;
+    CheckQuery(other, Docs{6, 8, 13, 20}, reader, SOURCE_LOCATION);
+    ASSERT_EQ(2, cache->size());
+  }
+
+  cache->Retain(irs::SubReader::empty());
+  ASSERT_EQ(0, cache->size());
+}
+
 TEST_P(NestedFilterTestCase, JoinAny2) {
   InitDataSet();
   auto reader = open_reader();
@@ -679,6 +804,35 @@ TEST_P(NestedFilterTestCase, JoinMin0) {
   }
 }
 
+TEST_P(NestedFilterTestCase, JoinMinCached) {
+  InitDataSet();
+  auto reader = open_reader();
+
+  irs::ByNestedFilter filter;
+  auto& opts = *filter.mutable_options();
+  opts.child = MakeByNumericTerm("count", 2);
+  opts.parent = MakeParentProvider("customer");
+  opts.parents_cache = std::make_shared<irs::NestedParentsCache>();
+  opts.match = irs::Match{3};
+
+  CheckQuery(filter, Docs{13, 20}, Costs{11}, reader, SOURCE_LOCATION);
+
+  {
+    opts.merge_type = irs::ScoreMergeType::kMin;
+
+    std::array<irs::Scorer::ptr, 2> scorers{std::make_unique<DocIdScorer>(),
+                                            std::make_unique<DocIdScorer>()};
+
+    const Tests tests = {
+      {Next{}, 13, {9.f, 9.f}},
+      {Next{}, 20, {14.f, 14.f}},
+      {Next{}, irs::doc_limits::eof()},
+    };
+
+    CheckQuery(filter, scorers, {tests}, reader, SOURCE_LOCATION);
+  }
+}
+
 TEST_P(NestedFilterTestCase, JoinMin1) {
   InitDataSet();
   auto reader = open_reader();
@@ -21,6 +21,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <functional>
+#include <map>
+#include <random>
+
+#include <absl/strings/str_cat.h>
 
 #include "filter_test_case_base.hpp"
 #include "index/norm.hpp"
@@ -62,6 +66,20 @@ irs::score_t GetFilterBoost(const irs::doc_iterator::ptr& doc) {
   return filter_boost != nullptr ? filter_boost->value : 1.F;
 }
 
+// Length of the longest common subsequence of specified strings
+size_t LongestCommonSubsequence(std::string_view lhs, std::string_view rhs) {
+  std::vector<size_t> row(rhs.size() + 1, 0);
+  for (const auto c : lhs) {
+    size_t diagonal = 0;
+    for (size_t j = 1; j <= rhs.size(); ++j) {
+      const auto up = row[j];
+      row[j] = c == rhs[j - 1] ? diagonal + 1 : std::max(up, row[j - 1]);
+      diagonal = up;
+    }
+  }
+  return row.back();
+}
+
 }  // namespace
 
 TEST(ngram_similarity_base_test, options) {
@@ -1526,6 +1544,110 @@ TEST_P(ngram_similarity_filter_test_case, seek) {
   counter.Reset();
 }
 
+TEST_P(ngram_similarity_filter_test_case, random_sequences) {
+  // the longest sequence of query ngrams found in a document in query order
+  // is the longest common subsequence of a query and a document, evaluated
+  // here in a straightforward way
+  constexpr size_t kDocs = 300;
+  constexpr size_t kQueries = 200;
+  constexpr std::string_view kAlphabet = "012345";
+
+  std::mt19937 rng{42};
+  auto random_sequence = [&](size_t min_size, size_t max_size) {
+    std::string seq(min_size + rng() % (max_size - min_size + 1), 0);
+    for (auto& c : seq) {
+      c = kAlphabet[rng() % kAlphabet.size()];
+    }
+    return seq;
+  };
+
+  std::vector<std::string> sequences;
+  {
+    std::string json = "[";
+    for (size_t i = 0; i < kDocs; ++i) {
+      auto& seq = sequences.emplace_back(random_sequence(1, 20));
+      absl::StrAppend(&json, i ? "," : "", R"({ "seq": )", i,
+                      R"(, "field": [)");
+      for (size_t j = 0; auto c : seq) {
+        absl::StrAppend(&json, j++ ? "," : "", "\"", std::string_view{&c, 1},
+                        "\"");
+      }
+      json += "] }";
+    }
+    json += "]";
+
+    tests::json_doc_generator gen(json.c_str(),
+                                  &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+  ASSERT_EQ(kDocs, segment.docs_count());
+
+  CustomNgramScorer sort;
+  auto scorers = irs::Scorers::Prepare(sort);
+
+  for (size_t i = 0; i < kQueries; ++i) {
+    const auto query = random_sequence(2, 8);
+    const auto threshold = static_cast<float_t>(1 + rng() % 10) / 10.f;
+    SCOPED_TRACE(testing::Message("Query: ") << query << ", threshold "
+                                             << threshold);
+
+    std::vector<std::string_view> ngrams;
+    for (auto& c : query) {
+      ngrams.emplace_back(&c, 1);
+    }
+    const auto filter = make_filter("field", ngrams, threshold, false);
+    const auto min_match_count = std::clamp(
+      static_cast<size_t>(std::ceil(static_cast<float_t>(ngrams.size()) *
+                                    threshold)),
+      size_t{1}, ngrams.size());
+
+    std::map<irs::doc_id_t, irs::score_t> expected;
+    for (size_t j = 0; j < kDocs; ++j) {
+      const auto longest = LongestCommonSubsequence(query, sequences[j]);
+      if (longest >= min_match_count) {
+        expected.emplace(irs::doc_limits::min() + j,
+                         static_cast<irs::score_t>(longest) /
+                           static_cast<irs::score_t>(query.size()));
+      }
+    }
+
+    // unscored queries stop at the length of the longest sequence
+    {
+      auto prepared = filter.prepare({.index = rdr});
+      auto docs = prepared->execute({.segment = segment});
+      std::vector<irs::doc_id_t> actual;
+      while (docs->next()) {
+        actual.emplace_back(docs->value());
+      }
+      ASSERT_EQ(expected.size(), actual.size());
+      ASSERT_TRUE(std::equal(actual.begin(), actual.end(), expected.begin(),
+                             [](auto lhs, const auto& rhs) noexcept {
+                               return lhs == rhs.first;
+                             }));
+    }
+
+    // scored queries collect the longest sequences
+    {
+      auto prepared = filter.prepare({.index = rdr, .scorers = scorers});
+      auto docs = prepared->execute({.segment = segment, .scorers = scorers});
+      auto* frequency = irs::get<irs::frequency>(*docs);
+      ASSERT_NE(nullptr, frequency);
+      auto expected_doc = expected.begin();
+      for (; docs->next(); ++expected_doc) {
+        ASSERT_NE(expected.end(), expected_doc);
+        ASSERT_EQ(expected_doc->first, docs->value());
+        ASSERT_EQ(expected_doc->second, GetFilterBoost(docs));
+        ASSERT_LE(1, frequency->value);
+      }
+      ASSERT_EQ(expected.end(), expected_doc);
+    }
+  }
+}
+
 static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
 
 INSTANTIATE_TEST_SUITE_P(
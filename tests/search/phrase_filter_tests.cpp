@@ -8379,12 +8379,107 @@ TEST_P(phrase_filter_test_case, sequential_several_terms) {
   }
 }
 
+TEST_P(phrase_filter_test_case, sequential_shingles) {
+  class shingles_field : public tests::field_base {
+   public:
+    shingles_field(std::string name, std::string_view value)
+      : stream_{irs::analysis::analyzers::get(
+          "text", irs::type<irs::text_format::json>::get(),
+          R"({"locale":"C", "stopwords":[], "shingles":true})")},
+        value_{value} {
+      this->name(std::move(name));
+      // offsets make sure shingles don't break offset ordering
+      index_features_ = irs::IndexFeatures::FREQ | irs::IndexFeatures::POS |
+                        irs::IndexFeatures::OFFS;
+    }
+
+    irs::token_stream& get_tokens() const final {
+      stream_->reset(value_);
+      return *stream_;
+    }
+
+    bool write(irs::data_output&) const final { return false; }
+
+   private:
+    irs::analysis::analyzer::ptr stream_;
+    std::string value_;
+  };
+
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("phrase_sequential.json"),
+      [](tests::document& doc, const std::string& name,
+         const tests::json_doc_generator::json_value& data) {
+        tests::analyzed_json_field_factory(doc, name, data);
+        if (data.is_string()) {
+          doc.indexed.push_back(
+            std::make_shared<shingles_field>(name + "_shl", data.str));
+        }
+      });
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+
+  auto execute = [&](std::string_view field,
+                     const std::vector<std::pair<std::string_view, size_t>>&
+                       phrase,
+                     bool shingles) {
+    irs::by_phrase q;
+    *q.mutable_field() = field;
+    q.mutable_options()->shingles(shingles);
+    for (auto& [term, offs] : phrase) {
+      q.mutable_options()->push_back<irs::by_term_options>(offs).term =
+        irs::ViewCast<irs::byte_type>(term);
+    }
+
+    auto prepared = q.prepare({.index = rdr});
+    EXPECT_NE(nullptr, prepared);
+
+    std::vector<irs::doc_id_t> docs;
+    for (auto& segment : rdr) {
+      auto it = prepared->execute({.segment = segment});
+      while (it->next()) {
+        docs.emplace_back(it->value());
+      }
+    }
+    return docs;
+  };
+
+  const std::vector<std::vector<std::pair<std::string_view, size_t>>>
+    phrases{{{"quick", 0}, {"brown", 0}},
+            {{"quick", 0}, {"brown", 0}, {"fox", 0}},
+            {{"we", 0}, {"are", 0}, {"looking", 0}, {"forward", 0}},
+            {{"as", 0}, {"in", 0}, {"the", 0}, {"past", 0}},
+            {{"quick", 0}, {"fox", 1}},
+            {{"we", 0}, {"do", 0}, {"see", 1}},
+            {{"brown", 0}, {"quick", 0}},
+            {{"fox", 0}, {"fox", 0}},
+            {{"missing", 0}, {"fox", 0}}};
+
+  for (auto& phrase : phrases) {
+    const auto expected = execute("phrase_anl", phrase, false);
+    ASSERT_EQ(expected, execute("phrase_shl", phrase, false));
+    ASSERT_EQ(expected, execute("phrase_shl", phrase, true));
+  }
+
+  ASSERT_FALSE(execute("phrase_shl", phrases[0], true).empty());
+  ASSERT_TRUE(execute("phrase_shl", phrases[6], true).empty());
+}
+
 TEST(by_phrase_test, options) {
   irs::by_phrase_options opts;
   ASSERT_TRUE(opts.simple());
   ASSERT_TRUE(opts.empty());
+  ASSERT_FALSE(opts.shingles());
   ASSERT_EQ(0, opts.size());
   ASSERT_EQ(opts.begin(), opts.end());
+
+  irs::by_phrase_options shingles;
+  shingles.shingles(true);
+  ASSERT_TRUE(shingles.shingles());
+  ASSERT_NE(opts, shingles);
 }
 
 TEST(by_phrase_test, options_clear) {
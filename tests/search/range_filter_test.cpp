@@ -24,6 +24,7 @@
 #include "search/range_filter.hpp"
 
 #include "filter_test_case_base.hpp"
+#include "index/term_ordinals.hpp"
 #include "tests_shared.hpp"
 
 namespace {
@@ -1301,6 +1302,90 @@ TEST_P(range_filter_test_case, visit) {
   visitor.reset();
 }
 
+TEST_P(range_filter_test_case, term_ordinals) {
+  // add segment
+  {
+    tests::json_doc_generator gen(resource("simple_sequential.json"),
+                                  &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto index = open_reader();
+  ASSERT_EQ(1, index.size());
+  auto& segment = index[0];
+  const auto* reader = segment.field("prefix");
+  ASSERT_NE(nullptr, reader);
+
+  TestResourceManager rm;
+
+  // ordinals follow dictionary order
+  {
+    irs::TermOrdinals ords{*reader, rm.readers};
+    ASSERT_LT(0, rm.readers.counter_);
+    ASSERT_EQ(reader->size(), ords.size());
+    auto term = [](std::string_view value) {
+      return irs::ViewCast<irs::byte_type>(value);
+    };
+    ASSERT_EQ(0, ords.find(term("abc")));
+    ASSERT_EQ(4, ords.find(term("abcy")));
+    ASSERT_EQ(irs::TermOrdinals::kInvalid, ords.find(term("abcz")));
+    ASSERT_EQ(5, ords.lower_bound(term("abcz")));
+    ASSERT_EQ(5, ords.upper_bound(term("abcy")));
+    ASSERT_EQ(ords.size(), ords.lower_bound(term("c")));
+    ASSERT_EQ(ords.size(), ords.upper_bound(term("c")));
+    ASSERT_EQ(0, ords.lower_bound(term("")));
+
+    auto it = ords.iterator(*reader);
+    auto& ord_it = static_cast<irs::OrdinalTermIterator&>(*it);
+    ASSERT_EQ(irs::TermOrdinals::kInvalid, ord_it.ord());
+    for (uint32_t ord = 0; it->next(); ++ord) {
+      ASSERT_EQ(ord, ord_it.ord());
+      ASSERT_EQ(ords.term(ord), it->value());
+    }
+    ASSERT_TRUE(ord_it.seek(uint32_t{6}));
+    ASSERT_EQ("ahtrtrt", irs::ViewCast<char>(it->value()));
+    ASSERT_EQ(irs::SeekResult::NOT_FOUND, it->seek_ge(term("abcz")));
+    ASSERT_EQ(5, ord_it.ord());
+    ASSERT_EQ("abde", irs::ViewCast<char>(it->value()));
+    ASSERT_FALSE(ord_it.seek(ords.size()));
+    ASSERT_EQ(irs::TermOrdinals::kInvalid, ord_it.ord());
+    // ordinal is restored by the next term
+    ASSERT_TRUE(it->next());
+    ASSERT_EQ(6, ord_it.ord());
+    ASSERT_FALSE(it->seek(term("abcz")));
+    ASSERT_EQ(irs::TermOrdinals::kInvalid, ord_it.ord());
+  }
+  ASSERT_EQ(0, rm.readers.counter_);
+
+  // same results as without ordinals
+  auto cache = std::make_shared<irs::TermOrdinalsCache>(rm.readers);
+  const std::string_view bounds[]{"", "a", "abc", "abcde", "abcz", "b", "c"};
+  const irs::BoundType types[]{irs::BoundType::UNBOUNDED,
+                               irs::BoundType::INCLUSIVE,
+                               irs::BoundType::EXCLUSIVE};
+  for (auto min : bounds) {
+    for (auto max : bounds) {
+      for (auto min_type : types) {
+        for (auto max_type : types) {
+          auto filter =
+            make_filter("prefix", irs::ViewCast<irs::byte_type>(min), min_type,
+                        irs::ViewCast<irs::byte_type>(max), max_type);
+          Docs expected;
+          MakeResult(filter, {}, index, expected, false);
+          std::sort(expected.begin(), expected.end());
+
+          filter.mutable_options()->ordinals = cache;
+          CheckQuery(filter, expected, index);
+        }
+      }
+    }
+  }
+  ASSERT_EQ(1, cache->size());
+  ASSERT_LT(0, rm.readers.counter_);
+  cache->Clear();
+  ASSERT_EQ(0, rm.readers.counter_);
+}
+
 static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
 
 INSTANTIATE_TEST_SUITE_P(
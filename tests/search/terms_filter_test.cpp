@@ -24,6 +24,7 @@
 
 #include "filter_test_case_base.hpp"
 #include "index/doc_generator.hpp"
+#include "search/bitset_doc_iterator.hpp"
 #include "search/boost_scorer.hpp"
 #include "tests_shared.hpp"
 
@@ -373,6 +374,58 @@ TEST_P(terms_filter_test_case, simple_sequential) {
   }
 }
 
+TEST_P(terms_filter_test_case, unscored_bitset_union) {
+  // add segment
+  {
+    tests::json_doc_generator gen(resource("simple_sequential.json"),
+                                  &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+
+  const auto filter =
+    make_filter("name", {{"A", 1.f}, {"C", 1.f}, {"E", 1.f}, {"F", 1.f}});
+  const Docs expected{1, 3, 5, 6};
+
+  // unscored, union is materialized into a bitset
+  {
+    auto prepared = filter.prepare({.index = *rdr});
+    ASSERT_NE(nullptr, prepared);
+    auto docs = prepared->execute({.segment = segment});
+    ASSERT_NE(nullptr, docs);
+    ASSERT_NE(nullptr, dynamic_cast<irs::bitset_doc_iterator*>(docs.get()));
+    ASSERT_EQ(expected.size(), irs::cost::extract(*docs));
+
+    Docs actual;
+    while (docs->next()) {
+      actual.emplace_back(docs->value());
+    }
+    ASSERT_EQ(expected, actual);
+  }
+
+  // scored, regular disjunction
+  {
+    irs::Scorer::ptr impl{std::make_unique<irs::BoostScore>()};
+    auto scorers = irs::Scorers::Prepare(std::span{&impl, 1});
+    auto prepared = filter.prepare({.index = *rdr, .scorers = scorers});
+    ASSERT_NE(nullptr, prepared);
+    auto docs = prepared->execute({.segment = segment, .scorers = scorers});
+    ASSERT_NE(nullptr, docs);
+    ASSERT_EQ(nullptr, dynamic_cast<irs::bitset_doc_iterator*>(docs.get()));
+
+    Docs actual;
+    while (docs->next()) {
+      actual.emplace_back(docs->value());
+    }
+    ASSERT_EQ(expected, actual);
+  }
+
+  CheckQuery(filter, expected, Costs{expected.size()}, rdr);
+}
+
 TEST_P(terms_filter_test_case, min_match) {
   // write segments
   auto writer = open_writer(irs::OM_CREATE);
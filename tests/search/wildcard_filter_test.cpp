@@ -27,6 +27,7 @@
 #include "search/multiterm_query.hpp"
 #include "search/prefix_filter.hpp"
 #include "search/term_filter.hpp"
+#include "search/term_trigram_index.hpp"
 #include "tests_shared.hpp"
 
 namespace {
@@ -102,6 +103,31 @@ TEST(by_wildcard_test, boost) {
   counter.Reset();
 }
 
+TEST(by_wildcard_test, required_trigrams) {
+  auto trigrams = [](std::string_view pattern) {
+    std::vector<std::string> result;
+    for (const auto trigram : irs::TermTrigramIndex::RequiredTrigrams(
+           irs::ViewCast<irs::byte_type>(pattern))) {
+      result.push_back({static_cast<char>(trigram >> 16),
+                        static_cast<char>(trigram >> 8),
+                        static_cast<char>(trigram)});
+    }
+    return result;
+  };
+
+  using Trigrams = std::vector<std::string>;
+  ASSERT_EQ(Trigrams{}, trigrams(""));
+  ASSERT_EQ(Trigrams{}, trigrams("%e%"));
+  ASSERT_EQ(Trigrams{}, trigrams("ab_cd%"));
+  ASSERT_EQ((Trigrams{"abc", "bcd"}), trigrams("%abcd%"));
+  ASSERT_EQ((Trigrams{"abc", "bcd"}), trigrams("%bcd%abc"));
+  ASSERT_EQ((Trigrams{"abc", "xyz"}), trigrams("abc_xyz%ab"));
+  ASSERT_EQ((Trigrams{"a%b"}), trigrams("%a\\%b%"));
+  ASSERT_EQ((Trigrams{"a_b"}), trigrams("%a\\_b"));
+  ASSERT_EQ((Trigrams{"\xB9\xD0\xB2", "\xD0\xB9\xD0"}),
+            trigrams("%\xD0\xB9\xD0\xB2%"));
+}
+
 #ifdef __clang__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpotentially-evaluated-expression"
@@ -614,6 +640,54 @@ TEST_P(wildcard_filter_test_case, visit) {
   }
 }
 
+TEST_P(wildcard_filter_test_case, trigram_index) {
+  // add segment
+  {
+    tests::json_doc_generator gen(resource("simple_sequential.json"),
+                                  &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+
+  TestResourceManager rm;
+  auto cache = std::make_shared<irs::TermTrigramIndexCache>(rm.readers);
+  auto make_indexed_filter = [&](std::string_view term) {
+    auto filter = make_filter("prefix", term);
+    filter.mutable_options()->trigram_index = cache;
+    return filter;
+  };
+
+  CheckQuery(make_indexed_filter("%bcd%"), Docs{1, 4, 9, 26}, rdr);
+  CheckQuery(make_indexed_filter("%cd%e%"), Docs{4, 26}, rdr);
+  CheckQuery(make_indexed_filter("_bc_"), Docs{1, 31, 32}, rdr);
+  CheckQuery(make_indexed_filter("%trt%"), Docs{29}, rdr);
+  CheckQuery(make_indexed_filter("%bcd"), Docs{1, 9}, rdr);
+  CheckQuery(make_indexed_filter("%xyz%"), Docs{}, rdr);
+  CheckQuery(make_indexed_filter("%abc_%"), Docs{1, 4, 26, 31, 32}, rdr);
+  ASSERT_EQ(1, cache->size());
+  // ordinals and trigram postings are accounted
+  ASSERT_LT(0, rm.readers.counter_);
+
+  // no trigrams to prune terms by
+  CheckQuery(make_indexed_filter("%d%"), Docs{1, 4, 9, 16, 24, 26}, rdr);
+
+  // same results as without index
+  for (std::string_view pattern :
+       {"%a%", "%bcd%", "a%d%", "%rtr%", "%sfa_d%"}) {
+    Docs expected;
+    MakeResult(make_filter("prefix", pattern), {}, rdr, expected, false);
+    std::sort(expected.begin(), expected.end());
+    CheckQuery(make_indexed_filter(pattern), expected, rdr);
+  }
+
+  cache->Retain(rdr);
+  ASSERT_EQ(1, cache->size());
+  cache->Retain(irs::SubReader::empty());
+  ASSERT_EQ(0, cache->size());
+  ASSERT_EQ(0, rm.readers.counter_);
+}
+
 static constexpr auto kTestDirs = tests::getDirectories<tests::kTypesDefault>();
 
 INSTANTIATE_TEST_SUITE_P(
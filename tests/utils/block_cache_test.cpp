@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <optional>
+
+#include "store/memory_directory.hpp"
+#include "tests_shared.hpp"
+#include "utils/block_cache.hpp"
+
+namespace {
+
+irs::bstring MakeBlock(size_t size, irs::byte_type value) {
+  return irs::bstring(size, value);
+}
+
+bool Lookup(const irs::BlockCache::File& file, uint64_t offset,
+            irs::bstring& block, uint64_t& end) {
+  return file.Visit(offset, [&](irs::bytes_view cached, uint64_t cached_end) {
+    block.assign(cached);
+    end = cached_end;
+  });
+}
+
+}  // namespace
+
+TEST(block_cache_test, put_visit) {
+  TestResourceManager rm;
+  auto cache = std::make_shared<irs::BlockCache>(1 << 20, rm.options, 4);
+  ASSERT_EQ(1 << 20, cache->Capacity());
+
+  irs::BlockCache::File file0{cache, "file0"};
+  irs::BlockCache::File file1{cache, "file1"};
+  ASSERT_TRUE(file0);
+  ASSERT_FALSE(irs::BlockCache::File{});
+
+  irs::bstring block;
+  uint64_t end{};
+  ASSERT_FALSE(Lookup(file0, 42, block, end));
+
+  file0.Put(42, 100, MakeBlock(58, 1));
+  ASSERT_TRUE(Lookup(file0, 42, block, end));
+  ASSERT_EQ(MakeBlock(58, 1), block);
+  ASSERT_EQ(100, end);
+
+  // same offset of another file
+  ASSERT_FALSE(Lookup(file1, 42, block, end));
+  file1.Put(42, 50, MakeBlock(8, 2));
+  ASSERT_TRUE(Lookup(file1, 42, block, end));
+  ASSERT_EQ(MakeBlock(8, 2), block);
+  ASSERT_EQ(50, end);
+
+  // already cached block isn't replaced
+  file1.Put(42, 60, MakeBlock(18, 3));
+  ASSERT_TRUE(Lookup(file1, 42, block, end));
+  ASSERT_EQ(MakeBlock(8, 2), block);
+
+  const auto stats = cache->GetStats();
+  ASSERT_EQ(3, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(0, stats.evictions);
+  ASSERT_DOUBLE_EQ(0.6, stats.HitRatio());
+  ASSERT_LT(58 + 8, stats.bytes);
+  ASSERT_EQ(stats.bytes, rm.readers.counter_);
+
+  file0 = {};
+  file1 = {};
+  cache.reset();
+  ASSERT_EQ(0, rm.readers.counter_);
+}
+
+TEST(block_cache_test, evict_lru) {
+  constexpr size_t kBlockSize = 1000;
+  constexpr size_t kBlocks = 4;
+
+  TestResourceManager rm;
+  irs::bstring block;
+  uint64_t end{};
+
+  // measure memory consumed by a single entry
+  size_t entry_size{};
+  {
+    auto cache = std::make_shared<irs::BlockCache>(1 << 20, rm.options, 1);
+    irs::BlockCache::File file{cache, "file"};
+    file.Put(0, kBlockSize, MakeBlock(kBlockSize, 0));
+    entry_size = cache->GetStats().bytes;
+  }
+  ASSERT_EQ(0, rm.readers.counter_);
+
+  auto cache =
+    std::make_shared<irs::BlockCache>(kBlocks * entry_size, rm.options, 1);
+  irs::BlockCache::File file{cache, "file"};
+
+  for (size_t i = 0; i < kBlocks; ++i) {
+    file.Put(i * kBlockSize, (i + 1) * kBlockSize,
+             MakeBlock(kBlockSize, static_cast<irs::byte_type>(i)));
+  }
+  ASSERT_EQ(kBlocks * entry_size, rm.readers.counter_);
+  ASSERT_EQ(0, cache->GetStats().evictions);
+
+  // touch the first block, the second one becomes least recently used
+  ASSERT_TRUE(Lookup(file, 0, block, end));
+
+  file.Put(kBlocks * kBlockSize, (kBlocks + 1) * kBlockSize,
+           MakeBlock(kBlockSize, kBlocks));
+  ASSERT_EQ(1, cache->GetStats().evictions);
+  ASSERT_EQ(kBlocks * entry_size, rm.readers.counter_);
+
+  ASSERT_TRUE(Lookup(file, 0, block, end));
+  ASSERT_EQ(MakeBlock(kBlockSize, 0), block);
+  ASSERT_FALSE(Lookup(file, kBlockSize, block, end));
+  for (size_t i = 2; i <= kBlocks; ++i) {
+    ASSERT_TRUE(Lookup(file, i * kBlockSize, block, end));
+    ASSERT_EQ((i + 1) * kBlockSize, end);
+  }
+
+  // blocks exceeding capacity aren't cached
+  file.Put(42, 42 + 5 * kBlocks * kBlockSize,
+           MakeBlock(5 * kBlocks * kBlockSize, 0));
+  ASSERT_FALSE(Lookup(file, 42, block, end));
+  ASSERT_EQ(1, cache->GetStats().evictions);
+}
+
+TEST(block_cache_test, resource_manager_refused) {
+  TestResourceManager rm;
+  auto cache = std::make_shared<irs::BlockCache>(1 << 20, rm.options);
+  irs::BlockCache::File file{cache, "file"};
+
+  rm.readers.result_ = false;
+  file.Put(0, 10, MakeBlock(10, 0));
+
+  irs::bstring block;
+  uint64_t end{};
+  ASSERT_FALSE(Lookup(file, 0, block, end));
+  ASSERT_EQ(0, cache->GetStats().bytes);
+
+  rm.readers.result_ = true;
+  file.Put(0, 10, MakeBlock(10, 0));
+  ASSERT_TRUE(Lookup(file, 0, block, end));
+}
+
+TEST(block_cache_test, share_release) {
+  TestResourceManager rm;
+  auto cache = std::make_shared<irs::BlockCache>(1 << 20, rm.options, 4);
+
+  irs::bstring block;
+  uint64_t end{};
+
+  auto file0 = std::make_unique<irs::BlockCache::File>(cache, "file");
+  file0->Put(0, 10, MakeBlock(10, 1));
+  ASSERT_EQ(1, cache->Files());
+
+  // handles of the same file share cached blocks
+  irs::BlockCache::File file1{cache, "file"};
+  ASSERT_TRUE(Lookup(file1, 0, block, end));
+  ASSERT_EQ(MakeBlock(10, 1), block);
+  ASSERT_EQ(1, cache->Files());
+
+  irs::BlockCache::File other{cache, "other"};
+  ASSERT_FALSE(Lookup(other, 0, block, end));
+  other.Put(0, 20, MakeBlock(20, 2));
+  ASSERT_EQ(2, cache->Files());
+
+  // blocks stay cached while a file has handles
+  file0.reset();
+  ASSERT_TRUE(Lookup(file1, 0, block, end));
+
+  // blocks are dropped with the last handle
+  const auto bytes = cache->GetStats().bytes;
+  file1 = {};
+  ASSERT_EQ(1, cache->Files());
+  ASSERT_GT(bytes, cache->GetStats().bytes);
+  ASSERT_EQ(cache->GetStats().bytes, rm.readers.counter_);
+  ASSERT_EQ(0, cache->GetStats().evictions);
+
+  irs::BlockCache::File reopened{cache, "file"};
+  ASSERT_FALSE(Lookup(reopened, 0, block, end));
+  ASSERT_TRUE(Lookup(other, 0, block, end));
+
+  other = {};
+  reopened = {};
+  ASSERT_EQ(0, cache->Files());
+  ASSERT_EQ(0, cache->GetStats().bytes);
+  ASSERT_EQ(0, rm.readers.counter_);
+}
+
+TEST(block_cache_test, drop_file) {
+  constexpr size_t kBlocks = 100;
+
+  TestResourceManager rm;
+  auto cache = std::make_shared<irs::BlockCache>(1 << 20, rm.options, 4);
+
+  irs::bstring block;
+  uint64_t end{};
+
+  irs::BlockCache::File file0{cache, "file0"};
+  irs::BlockCache::File file1{cache, "file1"};
+  for (size_t i = 0; i < kBlocks; ++i) {
+    file0.Put(i * 10, (i + 1) * 10, MakeBlock(10, 0));
+    file1.Put(i * 10, (i + 1) * 10, MakeBlock(20, 1));
+  }
+  const auto bytes = cache->GetStats().bytes;
+
+  // blocks of a released file are dropped from all shards
+  file0 = {};
+  ASSERT_EQ(1, cache->Files());
+  ASSERT_GT(bytes, cache->GetStats().bytes);
+  ASSERT_EQ(cache->GetStats().bytes, rm.readers.counter_);
+  for (size_t i = 0; i < kBlocks; ++i) {
+    ASSERT_TRUE(Lookup(file1, i * 10, block, end));
+    ASSERT_EQ(MakeBlock(20, 1), block);
+  }
+
+  file0 = irs::BlockCache::File{cache, "file0"};
+  for (size_t i = 0; i < kBlocks; ++i) {
+    ASSERT_FALSE(Lookup(file0, i * 10, block, end));
+  }
+  ASSERT_EQ(0, cache->GetStats().evictions);
+
+  file1 = {};
+  ASSERT_EQ(0, cache->GetStats().bytes);
+  ASSERT_EQ(0, rm.readers.counter_);
+}
+
+TEST(block_cache_test, make_name) {
+  std::optional<irs::memory_directory> dir0;
+  dir0.emplace();
+  const auto name = irs::BlockCache::MakeName(*dir0, "file");
+  ASSERT_EQ(name, irs::BlockCache::MakeName(*dir0, "file"));
+  ASSERT_NE(name, irs::BlockCache::MakeName(*dir0, "other"));
+  ASSERT_NE(name, irs::BlockCache::MakeName(*dir0, "file", "docs"));
+
+  irs::memory_directory dir1;
+  ASSERT_NE(name, irs::BlockCache::MakeName(dir1, "file"));
+
+  // directory created at the same address doesn't see cached blocks
+  dir0.reset();
+  dir0.emplace();
+  ASSERT_NE(name, irs::BlockCache::MakeName(*dir0, "file"));
+}
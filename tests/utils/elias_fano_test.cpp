@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+
+#include "store/store_utils.hpp"
+#include "tests_shared.hpp"
+#include "utils/elias_fano.hpp"
+
+namespace {
+
+constexpr uint32_t kSize = 128;
+
+template<typename Generator>
+void AssertBlock(Generator&& gen, uint32_t& header) {
+  uint32_t values[kSize];
+  uint32_t value = 0;
+  for (auto& v : values) {
+    value += gen();
+    v = value;
+  }
+
+  irs::bstring buf;
+  irs::bytes_output out{buf};
+  header = irs::elias_fano::write_block32<kSize>(out, values);
+  constexpr irs::byte_type kMarker = 0x42;
+  out.write_byte(kMarker);
+
+  {
+    irs::bytes_view_input in{buf};
+    uint32_t decoded[kSize];
+    irs::elias_fano::read_block32<kSize>(in, decoded);
+    ASSERT_TRUE(std::equal(std::begin(values), std::end(values),
+                           std::begin(decoded)));
+    ASSERT_EQ(kMarker, in.read_byte());
+  }
+
+  {
+    irs::bytes_view_input in{buf};
+    irs::elias_fano::skip_block32<kSize>(in);
+    ASSERT_EQ(kMarker, in.read_byte());
+  }
+}
+
+}  // namespace
+
+TEST(elias_fano_tests, low_bits) {
+  ASSERT_EQ(0, irs::elias_fano::low_bits(0, 1));
+  ASSERT_EQ(0, irs::elias_fano::low_bits(127, 128));
+  ASSERT_EQ(1, irs::elias_fano::low_bits(255, 128));
+  ASSERT_EQ(25, irs::elias_fano::low_bits(std::numeric_limits<uint32_t>::max(),
+                                          128));
+}
+
+TEST(elias_fano_tests, run) {
+  uint32_t i = 0;
+  uint32_t header;
+  AssertBlock([&]() { return i++ ? 1 : 5; }, header);
+  ASSERT_EQ(irs::elias_fano::kRun, header);
+}
+
+TEST(elias_fano_tests, bitmap) {
+  std::mt19937 rng{42};
+  uint32_t i = 0;
+  uint32_t header;
+  AssertBlock([&]() { return i++ ? 1 + rng() % 2 : 0; }, header);
+  ASSERT_EQ(irs::elias_fano::kBitmap, header);
+}
+
+TEST(elias_fano_tests, sparse) {
+  std::mt19937 rng{42};
+  uint32_t header;
+  AssertBlock([&]() { return 1 + rng() % 100000; }, header);
+  // ~50000 on average between values
+  ASSERT_EQ(15, header);
+}
+
+TEST(elias_fano_tests, duplicates) {
+  std::mt19937 rng{42};
+  uint32_t i = 0;
+  uint32_t header;
+  AssertBlock([&]() { return i++ ? rng() % 2 : 0; }, header);
+  ASSERT_EQ(0, header);
+}
+
+TEST(elias_fano_tests, random) {
+  std::mt19937 rng{42};
+  for (size_t i = 0; i < 1000; ++i) {
+    const uint32_t max_delta = 1 + rng() % 10000000;
+
+    uint32_t values[kSize];
+    uint32_t value = rng() % 1000;
+    for (auto& v : values) {
+      v = value;
+      value += rng() % max_delta;
+    }
+
+    irs::bstring buf;
+    irs::bytes_output out{buf};
+    irs::elias_fano::write_block32<kSize>(out, values);
+
+    irs::bytes_view_input in{buf};
+    uint32_t decoded[kSize];
+    irs::elias_fano::read_block32<kSize>(in, decoded);
+    ASSERT_TRUE(std::equal(std::begin(values), std::end(values),
+                           std::begin(decoded)));
+    ASSERT_EQ(buf.size(), in.file_pointer());
+  }
+}
+
+TEST(elias_fano_tests, union_block) {
+  std::mt19937 rng{42};
+  for (size_t i = 0; i < 1000; ++i) {
+    // mix of dense (bitmap, run) and sparse (elias-fano) partitions
+    const uint32_t max_delta = 1 + rng() % (i % 2 ? 3 : 1000);
+
+    uint32_t values[kSize];
+    uint32_t value = 1 + rng() % 100;
+    for (auto& v : values) {
+      v = value;
+      value += 1 + rng() % max_delta;
+    }
+
+    irs::bstring buf;
+    irs::bytes_output out{buf};
+    const auto header = irs::elias_fano::write_block32<kSize>(out, values);
+
+    const uint64_t offset = rng() % 1000;
+    const uint64_t limit = offset + values[kSize - 1] + 1 - (i % 3 ? 0 : 1);
+    std::vector<size_t> set((limit + 63) / 64 + 1, 0);
+
+    irs::bytes_view_input in{buf};
+    uint32_t decoded[kSize];
+    const bool unioned = irs::elias_fano::union_block32<kSize>(
+      in, decoded, offset, limit, set.data());
+    ASSERT_EQ(buf.size(), in.file_pointer());
+
+    const bool dense =
+      header == irs::elias_fano::kRun || header == irs::elias_fano::kBitmap;
+    ASSERT_EQ(dense && 0 != i % 3, unioned);
+
+    if (unioned) {
+      ASSERT_EQ(values[kSize - 1], decoded[kSize - 1]);
+      std::vector<size_t> expected(set.size(), 0);
+      for (const auto v : values) {
+        irs::set_bit(expected[(offset + v) / 64], (offset + v) % 64);
+      }
+      ASSERT_EQ(expected, set);
+    } else {
+      ASSERT_TRUE(std::equal(std::begin(values), std::end(values),
+                             std::begin(decoded)));
+      ASSERT_TRUE(std::all_of(set.begin(), set.end(),
+                              [](size_t word) { return 0 == word; }));
+    }
+  }
+}
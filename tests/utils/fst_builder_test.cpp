@@ -98,8 +98,9 @@ std::vector<std::pair<irs::bstring, irs::bstring>> read_fst_input(
   return data;
 }
 
-void assert_fst_read_write(const std::string& resource) {
+void assert_fst_read_write(const std::string& resource, bool states_size) {
   SCOPED_TRACE(resource);
+  SCOPED_TRACE(states_size);
   auto expected_data = read_fst_input(test_base::resource(resource));
   ASSERT_FALSE(expected_data.empty());
   irs::vector_byte_fst fst{{irs::IResourceManager::kNoop}};
@@ -134,9 +135,12 @@ void assert_fst_read_write(const std::string& resource) {
 
   SimpleMemoryAccounter writer_memory;
   irs::memory_output out(writer_memory);
-  irs::immutable_byte_fst::Write(fst, out.stream, stats);
+  ASSERT_TRUE(
+    irs::immutable_byte_fst::Write(fst, out.stream, stats, states_size));
   out.stream.flush();
   ASSERT_GT(writer_memory.counter_, 0);
+  // FSTs without stored size of states are readable by older versions
+  ASSERT_EQ(states_size ? 1 : 0, irs::memory_index_input{out.file}.read_byte());
   SimpleMemoryAccounter immutable_fst_memory;
   irs::memory_index_input in(out.file);
   std::unique_ptr<irs::immutable_byte_fst> read_fst(
@@ -197,6 +201,56 @@ void assert_fst_read_write(const std::string& resource) {
       ASSERT_EQ(irs::bytes_view(actual_weight), irs::bytes_view(data.second));
     }
   }
+  // read in place, weights reference input data
+  {
+    irs::bstring data(out.file.length(), 0);
+    irs::memory_index_input{out.file}.read_bytes(0, data.data(), data.size());
+    irs::bytes_view_input data_in{data};
+    ASSERT_TRUE(irs::immutable_byte_fst::Skip(data_in));
+    ASSERT_EQ(data.size(), data_in.file_pointer());
+
+    data_in.seek(0);
+    SimpleMemoryAccounter in_place_memory;
+    std::unique_ptr<irs::immutable_byte_fst> in_place_fst(
+      irs::immutable_byte_fst::ReadInPlace(data_in, in_place_memory));
+    ASSERT_NE(nullptr, in_place_fst);
+    ASSERT_EQ(data.size(), data_in.file_pointer());
+    ASSERT_LT(in_place_memory.counter_, immutable_fst_memory.counter_);
+    ASSERT_EQ(read_fst->NumStates(), in_place_fst->NumStates());
+    ASSERT_EQ(read_fst->Start(), in_place_fst->Start());
+
+    auto in_data = [&](irs::bytes_view weight) {
+      return weight.empty() || (data.data() <= weight.data() &&
+                                weight.data() + weight.size() <=
+                                  data.data() + data.size());
+    };
+
+    for (fst::StateIterator<irs::immutable_byte_fst> it(*read_fst); !it.Done();
+         it.Next()) {
+      const auto s = it.Value();
+      ASSERT_EQ(read_fst->NumArcs(s), in_place_fst->NumArcs(s));
+      const irs::bytes_view final_weight = in_place_fst->Final(s);
+      ASSERT_EQ(static_cast<irs::bytes_view>(read_fst->Final(s)),
+                final_weight);
+      ASSERT_TRUE(in_data(final_weight));
+
+      fst::ArcIterator<irs::immutable_byte_fst> expected_arcs(*read_fst, s);
+      fst::ArcIterator<irs::immutable_byte_fst> actual_arcs(*in_place_fst, s);
+      for (; !expected_arcs.Done(); expected_arcs.Next(), actual_arcs.Next()) {
+        auto& expected_arc = expected_arcs.Value();
+        auto& actual_arc = actual_arcs.Value();
+        ASSERT_EQ(expected_arc.ilabel, actual_arc.ilabel);
+        ASSERT_EQ(expected_arc.nextstate, actual_arc.nextstate);
+        const irs::bytes_view weight = actual_arc.weight;
+        ASSERT_EQ(static_cast<irs::bytes_view>(expected_arc.weight), weight);
+        ASSERT_TRUE(in_data(weight));
+      }
+    }
+
+    in_place_fst.reset();
+    ASSERT_EQ(0, in_place_memory.counter_);
+  }
+
   read_fst.reset();
   ASSERT_EQ(0, immutable_fst_memory.counter_);
 }
@@ -373,8 +427,13 @@ TEST(fst_builder_test, build_fst_bug) {
 }
 
 TEST(fst_builder_test, test_read_write) {
-  assert_fst_read_write("fst");
-  assert_fst_read_write("fst_binary");
+  assert_fst_read_write("fst", true);
+  assert_fst_read_write("fst_binary", true);
+}
+
+TEST(fst_builder_test, test_read_write_without_states_size) {
+  assert_fst_read_write("fst", false);
+  assert_fst_read_write("fst_binary", false);
 }
 
 }  // namespace
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "utils/levenshtein_cache.hpp"
+
+#include "tests_shared.hpp"
+#include "utils/automaton.hpp"
+#include "utils/levenshtein_utils.hpp"
+
+using namespace std::literals;
+
+namespace {
+
+std::shared_ptr<const irs::automaton> Get(irs::LevenshteinAutomatonCache& cache,
+                                          const irs::parametric_description& d,
+                                          bool with_transpositions,
+                                          std::string_view prefix,
+                                          std::string_view target) {
+  return cache.Get(d, with_transpositions, irs::ViewCast<irs::byte_type>(prefix),
+                   irs::ViewCast<irs::byte_type>(target));
+}
+
+}  // namespace
+
+TEST(levenshtein_cache_test, get) {
+  const auto d1 = irs::make_parametric_description(1, false);
+  const auto d2 = irs::make_parametric_description(2, false);
+  const auto d1t = irs::make_parametric_description(1, true);
+
+  irs::LevenshteinAutomatonCache cache;
+  ASSERT_EQ(irs::LevenshteinAutomatonCache::kDefaultCapacity,
+            cache.Capacity());
+
+  auto a0 = Get(cache, d1, false, "", "foo");
+  ASSERT_NE(nullptr, a0);
+  ASSERT_EQ(a0, Get(cache, d1, false, "", "foo"));
+
+  // every component of a key matters
+  ASSERT_NE(a0, Get(cache, d2, false, "", "foo"));
+  ASSERT_NE(a0, Get(cache, d1t, true, "", "foo"));
+  ASSERT_NE(a0, Get(cache, d1, false, "f", "oo"));
+  ASSERT_NE(a0, Get(cache, d1, false, "", "fo"));
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(5, stats.misses);
+  ASSERT_EQ(0, stats.evictions);
+  ASSERT_EQ(5, stats.size);
+
+  // cached automaton is equal to a freshly built one
+  const auto expected = irs::make_levenshtein_automaton(
+    d1, irs::bytes_view{}, irs::ViewCast<irs::byte_type>("foo"sv));
+  ASSERT_EQ(expected.NumStates(), a0->NumStates());
+
+  cache.Clear();
+  ASSERT_EQ(0, cache.GetStats().size);
+  ASSERT_NE(a0, Get(cache, d1, false, "", "foo"));
+}
+
+TEST(levenshtein_cache_test, evict_lru) {
+  const auto d = irs::make_parametric_description(1, true);
+
+  irs::LevenshteinAutomatonCache cache{2};
+  auto foo = Get(cache, d, true, "", "foo");
+  auto bar = Get(cache, d, true, "", "bar");
+
+  // touch "foo", "bar" becomes least recently used
+  ASSERT_EQ(foo, Get(cache, d, true, "", "foo"));
+  auto baz = Get(cache, d, true, "", "baz");
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(1, stats.evictions);
+  ASSERT_EQ(2, stats.size);
+  ASSERT_EQ(foo, Get(cache, d, true, "", "foo"));
+  ASSERT_EQ(baz, Get(cache, d, true, "", "baz"));
+  ASSERT_NE(bar, Get(cache, d, true, "", "bar"));
+
+  // evicted automaton remains valid while referenced
+  ASSERT_LT(0, bar->NumStates());
+
+  cache.Capacity(1);
+  stats = cache.GetStats();
+  ASSERT_EQ(1, stats.size);
+  ASSERT_EQ(3, stats.evictions);
+}
+
+TEST(levenshtein_cache_test, disabled) {
+  const auto d = irs::make_parametric_description(1, false);
+
+  irs::LevenshteinAutomatonCache cache{0};
+  auto a0 = Get(cache, d, false, "", "foo");
+  ASSERT_NE(nullptr, a0);
+  ASSERT_NE(a0, Get(cache, d, false, "", "foo"));
+
+  const auto stats = cache.GetStats();
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(0, stats.size);
+}
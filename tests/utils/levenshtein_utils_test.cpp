@@ -1396,3 +1396,69 @@ TEST(levenshtein_utils_test, test_description_invalid) {
     ASSERT_EQ(0, description.max_distance());
   }
 }
+
+TEST(levenshtein_utils_test, test_bit_parallel_distance) {
+  const std::vector<std::string_view> words{
+    "", "a", "ab", "ba", "abc", "acb", "bca", "elephant", "relevant",
+    "elepahnt", "alphabet", "alphabte", "aec", "abcd",
+    "\xD0\xBF\xD1\x83\xD1\x82\xD0\xB8\xD0\xBD",
+    "\xD1\x85\xD1\x83\xD0\xB9\xD0\xBB\xD0\xBE",
+    "\xD0\xBF\xD1\x83\xD1\x82\xD0\xBD\xD0\xB8"};
+
+  for (uint8_t max_distance = 0; max_distance <= 3; ++max_distance) {
+    for (const bool with_transpositions : {false, true}) {
+      const auto description =
+        irs::make_parametric_description(max_distance, with_transpositions);
+      ASSERT_TRUE(description);
+
+      for (auto pattern : words) {
+        const irs::bit_parallel_levenshtein bp{
+          irs::ViewCast<irs::byte_type>(pattern), with_transpositions};
+        ASSERT_TRUE(bp.valid());
+        ASSERT_EQ(irs::utf8_utils::Length(
+                    irs::ViewCast<irs::byte_type>(pattern)),
+                  bp.size());
+
+        for (auto text : words) {
+          SCOPED_TRACE(testing::Message("Pattern: '")
+                       << pattern << "', Text: '" << text
+                       << "', Distance: " << size_t{max_distance}
+                       << ", Transpositions: " << with_transpositions);
+
+          const auto expected = irs::edit_distance(
+            description, irs::ViewCast<irs::byte_type>(pattern),
+            irs::ViewCast<irs::byte_type>(text));
+          ASSERT_EQ(std::min<size_t>(expected, max_distance + 1),
+                    bp.distance(irs::ViewCast<irs::byte_type>(text),
+                                max_distance));
+        }
+      }
+    }
+  }
+
+  // transposition costs 1 only if enabled
+  {
+    const auto pattern = irs::ViewCast<irs::byte_type>("elephant"sv);
+    const auto text = irs::ViewCast<irs::byte_type>("elepahnt"sv);
+    ASSERT_EQ(1, irs::bit_parallel_levenshtein(pattern, true).distance(text, 2));
+    ASSERT_EQ(2,
+              irs::bit_parallel_levenshtein(pattern, false).distance(text, 2));
+  }
+
+  // too long pattern
+  {
+    const std::string pattern(irs::bit_parallel_levenshtein::kMaxPatternSize + 1,
+                              'a');
+    ASSERT_FALSE(irs::bit_parallel_levenshtein(
+                   irs::ViewCast<irs::byte_type>(std::string_view{pattern}),
+                   false)
+                   .valid());
+  }
+
+  // invalid utf8 text is never accepted
+  {
+    const irs::bit_parallel_levenshtein bp{
+      irs::ViewCast<irs::byte_type>("ab"sv), false};
+    ASSERT_EQ(3, bp.distance(irs::ViewCast<irs::byte_type>("ab\xD0"sv), 2));
+  }
+}
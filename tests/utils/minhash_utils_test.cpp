@@ -22,6 +22,9 @@
 
 #include "utils/minhash_utils.hpp"
 
+#include <numeric>
+#include <random>
+
 #include "tests_shared.hpp"
 
 TEST(MinHashTest, MaxSize) {
@@ -152,3 +155,73 @@ TEST(MinHashTest, Jaccard) {
   assert_jaccard(make(1), make(42), 1. / 42);
   assert_jaccard(make(100), make(42), 42. / 100);
 }
+
+TEST(MinHashTest, Assign) {
+  constexpr size_t kNumHashes = 42;
+  constexpr uint64_t kValues[]{1, 5, 7, 42, 100};
+
+  irs::MinHash mh{kNumHashes};
+  mh.Assign(kValues);
+  ASSERT_EQ(std::size(kValues), mh.Size());
+  ASSERT_DOUBLE_EQ(1., mh.Jaccard(kValues));
+
+  // Signature is still updatable
+  for (size_t i = 0; i < 100; ++i) {
+    mh.Insert(i);
+  }
+  ASSERT_EQ(kNumHashes, mh.Size());
+  std::vector signature(std::begin(mh), std::end(mh));
+  std::sort(std::begin(signature), std::end(signature));
+  for (size_t i = 0; i < kNumHashes; ++i) {
+    ASSERT_EQ(i, signature[i]);
+  }
+
+  // Full signature
+  std::vector<uint64_t> values(kNumHashes);
+  std::iota(std::begin(values), std::end(values), 1000);
+  mh.Assign(values);
+  ASSERT_EQ(kNumHashes, mh.Size());
+  mh.Insert(0);
+  ASSERT_EQ(kNumHashes, mh.Size());
+  signature.assign(std::begin(mh), std::end(mh));
+  std::sort(std::begin(signature), std::end(signature));
+  ASSERT_EQ(0, signature.front());
+  ASSERT_EQ(1000 + kNumHashes - 2, signature.back());
+}
+
+TEST(MinHashTest, Builder) {
+  std::mt19937_64 rng{42};
+
+  for (const size_t num_hashes : {0, 1, 7, 64, 100, 512}) {
+    for (const size_t size : {0, 1, 5, 63, 64, 65, 1000, 100000}) {
+      // Values with plenty of duplicates
+      std::vector<uint64_t> values(size);
+      for (auto& value : values) {
+        value = rng() % (3 * size + 1);
+      }
+
+      irs::MinHash expected{num_hashes};
+      for (const auto value : values) {
+        expected.Insert(value);
+      }
+      std::vector<uint64_t> expected_values{std::begin(expected),
+                                            std::end(expected)};
+      std::sort(std::begin(expected_values), std::end(expected_values));
+
+      irs::MinHashBuilder builder{num_hashes};
+      ASSERT_EQ(expected.MaxSize(), builder.MaxSize());
+      for (size_t i = 0; i < 2; ++i) {
+        builder.Clear();
+        // Insert values in batches of different size
+        for (size_t begin = 0, batch = 1; begin < size; begin += batch++) {
+          builder.Insert(std::span{values}.subspan(
+            begin, std::min(batch, size - begin)));
+        }
+        const auto actual = builder.Finish();
+        ASSERT_TRUE(std::equal(std::begin(actual), std::end(actual),
+                               std::begin(expected_values),
+                               std::end(expected_values)));
+      }
+    }
+  }
+}
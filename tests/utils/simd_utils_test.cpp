@@ -216,3 +216,101 @@ TEST(simd_utils_test, maxbits) {
               irs::simd::maxbits<true>(values, std::size(values)));
   }
 }
+
+TEST(simd_utils_test, copy_less) {
+  constexpr size_t BLOCK_SIZE = 128;
+  uint64_t values[BLOCK_SIZE + 3];
+  std::iota(std::begin(values), std::end(values), 0);
+  std::reverse(std::begin(values), std::end(values));
+
+  for (const uint64_t threshold :
+       {uint64_t{0}, uint64_t{1}, uint64_t{42}, uint64_t{BLOCK_SIZE + 3},
+        std::numeric_limits<uint64_t>::max()}) {
+    for (const size_t size : {size_t{0}, size_t{1}, size_t{7}, BLOCK_SIZE,
+                              std::size(values)}) {
+      std::vector<uint64_t> expected;
+      std::copy_if(std::begin(values), std::begin(values) + size,
+                   std::back_inserter(expected),
+                   [&](uint64_t value) { return value < threshold; });
+
+      std::vector<uint64_t> actual(size + 64);
+      actual.resize(
+        irs::simd::copy_less(values, size, threshold, actual.data()));
+      ASSERT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(simd_utils_test, utf8_next) {
+  // ASCII blocks, multi-byte symbols crossing blocks and invalid input
+  std::string value(100, 'a');
+  value.replace(15, 2, "\xD0\x96");
+  value.replace(40, 4, "\xF0\x9F\x98\x80");
+  value[70] = '\x80';
+  value[97] = '\xF0';
+
+  for (size_t size = 0; size <= value.size(); ++size) {
+    const auto* begin = reinterpret_cast<const irs::byte_type*>(value.data());
+    const auto* end = begin + size;
+
+    std::vector<uint32_t> next(size);
+    irs::simd::utf8_next(begin, size, next.data());
+
+    for (auto it = begin; it != end;) {
+      const auto symbol_end = irs::utf8_utils::Next(it, end);
+      ASSERT_EQ(symbol_end - begin, next[it - begin]);
+      it = symbol_end;
+    }
+  }
+}
+
+TEST(simd_utils_test, equal_bytes) {
+  for (size_t size = 0; size <= 70; ++size) {
+    std::vector<irs::byte_type> lhs(size);
+    std::iota(lhs.begin(), lhs.end(), 1);
+    auto rhs = lhs;
+    ASSERT_TRUE(irs::simd::equal_bytes(lhs.data(), rhs.data(), size));
+
+    for (size_t i = 0; i < size; ++i) {
+      rhs[i] ^= 0x80;
+      ASSERT_FALSE(irs::simd::equal_bytes(lhs.data(), rhs.data(), size));
+      rhs[i] ^= 0x80;
+    }
+  }
+}
+
+TEST(simd_utils_test, dot) {
+  for (size_t size = 0; size <= 70; ++size) {
+    // small integers are summed exactly in any order
+    std::vector<float> lhs(size);
+    std::vector<float> rhs(size);
+    float expected = 0;
+    for (size_t i = 0; i < size; ++i) {
+      lhs[i] = static_cast<float>(i % 7) - 3;
+      rhs[i] = static_cast<float>(i % 5) + 1;
+      expected += lhs[i] * rhs[i];
+    }
+    ASSERT_EQ(expected, irs::simd::dot(lhs.data(), rhs.data(), size));
+  }
+}
+
+TEST(simd_utils_test, dot4) {
+  for (size_t size = 0; size <= 70; ++size) {
+    const size_t stride = size + 3;
+    std::vector<float> lhs(size);
+    std::vector<float> rhs(4 * stride);
+    for (size_t i = 0; i < size; ++i) {
+      lhs[i] = 1.f / static_cast<float>(i + 1);
+    }
+    for (size_t i = 0; i < rhs.size(); ++i) {
+      rhs[i] = static_cast<float>(i % 11) / 7.f - 0.5f;
+    }
+    float out[4];
+    irs::simd::dot4(lhs.data(), rhs.data(), stride, size, out);
+    // bitwise equal to separately computed dot products
+    for (size_t j = 0; j < 4; ++j) {
+      ASSERT_EQ(irs::simd::dot(lhs.data(), rhs.data() + j * stride, size),
+                out[j]);
+    }
+  }
+}
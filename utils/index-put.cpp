@@ -739,8 +739,9 @@ int put(int argc, char* argv[]) {
   cmdput.add(INDEX_DIR, 0, "Path to index directory", true, std::string());
   cmdput.add(DIR_TYPE, 0, "Directory type (fs|mmap)", false,
              std::string("mmap"));
-  cmdput.add(FORMAT, 0, "Format (1_0|1_1|1_2|1_2simd)", false,
-             std::string("1_0"));
+  cmdput.add(FORMAT, 0,
+             "Format (1_0|1_1|1_2|1_2simd|1_5|1_5simd|1_5pef|1_5simdpef)",
+             false, std::string("1_0"));
   cmdput.add(INPUT, 0, "Input file", true, std::string());
   cmdput.add(BATCH_SIZE, 0, "Lines per batch", false, size_t(0));
   cmdput.add(CONSOLIDATE_ALL, 0, "Consolidate all segments into one", false,
@@ -899,8 +899,9 @@ int search(int argc, char* argv[]) {
   cmdsearch.add<std::string>(INDEX_DIR, 0, "Path to index directory", true);
   cmdsearch.add<std::string>(DIR_TYPE, 0, "Directory type (fs|mmap)", false,
                              std::string("mmap"));
-  cmdsearch.add(FORMAT, 0, "Format (1_0|1_1|1_2|1_2simd)", false,
-                std::string("1_0"));
+  cmdsearch.add(FORMAT, 0,
+                "Format (1_0|1_1|1_2|1_2simd|1_5|1_5simd|1_5pef|1_5simdpef)",
+                false, std::string("1_0"));
   cmdsearch.add<std::string>(INPUT, 0, "Task file", true);
   cmdsearch.add<std::string>(OUTPUT, 0, "Stats file", false);
   cmdsearch.add<size_t>(MAX, 0, "Maximum tasks per category", false, size_t(1));